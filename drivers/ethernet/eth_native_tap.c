@@ -52,9 +52,38 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #define ETH_HDR_LEN sizeof(struct net_eth_hdr)
 #endif
 
+#if defined(CONFIG_ETH_NATIVE_TAP_OFFLOAD)
+/* Same layout as struct virtio_net_hdr of the host, which cannot be
+ * included here. The fields are in host byte order.
+ */
+struct vnet_hdr {
+	uint8_t flags;
+	uint8_t gso_type;
+	uint16_t hdr_len;
+	uint16_t gso_size;
+	uint16_t csum_start;
+	uint16_t csum_offset;
+} __packed;
+
+#define VNET_HDR_F_NEEDS_CSUM 1
+#define VNET_HDR_GSO_TCPV4 1
+#define VNET_HDR_GSO_TCPV6 4
+
+/* Offsets of the TCP data offset and checksum fields */
+#define TCP_OFFSET_POS 12
+#define TCP_CHKSUM_POS 16
+
+#define VNET_HDR_LEN sizeof(struct vnet_hdr)
+/* Leave room for the IP and TCP headers of a super-packet */
+#define ETH_SEND_LEN (CONFIG_NET_TCP_GSO_MAX_SIZE + NET_ETH_MTU + ETH_HDR_LEN)
+#else
+#define VNET_HDR_LEN 0
+#define ETH_SEND_LEN (NET_ETH_MTU + ETH_HDR_LEN)
+#endif
+
 struct eth_context {
-	uint8_t recv[NET_ETH_MTU + ETH_HDR_LEN];
-	uint8_t send[NET_ETH_MTU + ETH_HDR_LEN];
+	uint8_t recv[VNET_HDR_LEN + NET_ETH_MTU + ETH_HDR_LEN];
+	uint8_t send[VNET_HDR_LEN + ETH_SEND_LEN];
 	uint8_t mac_addr[6];
 	struct net_linkaddr ll_addr;
 	struct net_if *iface;
@@ -178,22 +207,89 @@ static void update_gptp(struct net_if *iface, struct net_pkt *pkt,
 #define update_gptp(iface, pkt, send)
 #endif /* CONFIG_NET_GPTP */
 
+#if defined(CONFIG_ETH_NATIVE_TAP_OFFLOAD)
+static uint32_t vnet_sum(uint32_t sum, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i += 2) {
+		sum += (data[i] << 8) | data[i + 1];
+	}
+
+	return sum;
+}
+
+/* Describe a TCP super-packet to the host kernel so that it splits the
+ * frame into gso_size sized segments and computes their checksums.
+ */
+static void vnet_hdr_fill(struct net_pkt *pkt, uint8_t *buf, int count)
+{
+	struct vnet_hdr *hdr = (struct vnet_hdr *)buf;
+	uint8_t *frame = buf + VNET_HDR_LEN;
+	size_t l3_off = sizeof(struct net_eth_hdr);
+	size_t l4_off, tcp_len;
+	uint32_t sum;
+
+	memset(hdr, 0, sizeof(*hdr));
+
+	if (net_pkt_gso_size(pkt) == 0U) {
+		return;
+	}
+
+	if (ntohs(((struct net_eth_hdr *)frame)->type) == NET_ETH_PTYPE_VLAN) {
+		l3_off = sizeof(struct net_eth_vlan_hdr);
+	}
+
+	l4_off = l3_off + net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	tcp_len = count - l4_off;
+
+	/* The checksum field has to contain the pseudo header sum */
+	if (net_pkt_family(pkt) == AF_INET) {
+		hdr->gso_type = VNET_HDR_GSO_TCPV4;
+		sum = vnet_sum(IPPROTO_TCP + tcp_len,
+			       frame + l3_off + offsetof(struct net_ipv4_hdr, src),
+			       2 * sizeof(struct in_addr));
+	} else {
+		hdr->gso_type = VNET_HDR_GSO_TCPV6;
+		sum = vnet_sum(IPPROTO_TCP + tcp_len,
+			       frame + l3_off + offsetof(struct net_ipv6_hdr, src),
+			       2 * sizeof(struct in6_addr));
+	}
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+	sys_put_be16(sum, frame + l4_off + TCP_CHKSUM_POS);
+
+	hdr->flags = VNET_HDR_F_NEEDS_CSUM;
+	hdr->hdr_len = l4_off + ((frame[l4_off + TCP_OFFSET_POS] >> 4) * 4U);
+	hdr->gso_size = net_pkt_gso_size(pkt);
+	hdr->csum_start = l4_off;
+	hdr->csum_offset = TCP_CHKSUM_POS;
+}
+#else
+#define vnet_hdr_fill(pkt, buf, count)
+#endif /* CONFIG_ETH_NATIVE_TAP_OFFLOAD */
+
 static int eth_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct eth_context *ctx = dev->data;
 	int count = net_pkt_get_len(pkt);
 	int ret;
 
-	ret = net_pkt_read(pkt, ctx->send, count);
+	if ((size_t)count > sizeof(ctx->send) - VNET_HDR_LEN) {
+		return -EMSGSIZE;
+	}
+
+	ret = net_pkt_read(pkt, ctx->send + VNET_HDR_LEN, count);
 	if (ret) {
 		return ret;
 	}
 
+	vnet_hdr_fill(pkt, ctx->send, count);
+
 	update_gptp(net_pkt_iface(pkt), pkt, true);
 
 	LOG_DBG("Send pkt %p len %d", pkt, count);
 
-	ret = nsi_host_write(ctx->dev_fd, ctx->send, count);
+	ret = nsi_host_write(ctx->dev_fd, ctx->send, count + VNET_HDR_LEN);
 	if (ret < 0) {
 		LOG_DBG("Cannot send pkt %p (%d)", pkt, ret);
 	}
@@ -221,7 +317,7 @@ static struct net_pkt *prepare_pkt(struct eth_context *ctx,
 		return NULL;
 	}
 
-	if (net_pkt_write(pkt, ctx->recv, count)) {
+	if (net_pkt_write(pkt, ctx->recv + VNET_HDR_LEN, count)) {
 		net_pkt_unref(pkt);
 		*status = -ENOBUFS;
 		return NULL;
@@ -242,10 +338,15 @@ static int read_data(struct eth_context *ctx, int fd)
 	int count;
 
 	count = nsi_host_read(fd, ctx->recv, sizeof(ctx->recv));
-	if (count <= 0) {
+	if (count <= (int)VNET_HDR_LEN) {
 		return 0;
 	}
 
+	/* No receive offloads are enabled, so the virtio-net header carries
+	 * no information and is skipped.
+	 */
+	count -= VNET_HDR_LEN;
+
 	pkt = prepare_pkt(ctx, count, &status);
 	if (!pkt) {
 		return status;
@@ -398,7 +499,8 @@ static void eth_iface_init(struct net_if *iface)
 	}
 #endif
 
-	ctx->dev_fd = eth_iface_create(CONFIG_ETH_NATIVE_POSIX_DEV_NAME, ctx->if_name, false);
+	ctx->dev_fd = eth_iface_create(CONFIG_ETH_NATIVE_POSIX_DEV_NAME, ctx->if_name, false,
+				       IS_ENABLED(CONFIG_ETH_NATIVE_TAP_OFFLOAD));
 	if (ctx->dev_fd < 0) {
 		LOG_ERR("Cannot create %s (%d/%s)", ctx->if_name, ctx->dev_fd,
 			strerror(-ctx->dev_fd));
@@ -427,6 +529,9 @@ static enum ethernet_hw_caps eth_native_tap_get_capabilities(const struct device
 #endif
 #if defined(CONFIG_NET_LLDP)
 		| ETHERNET_LLDP
+#endif
+#if defined(CONFIG_ETH_NATIVE_TAP_OFFLOAD)
+		| ETHERNET_HW_TSO
 #endif
 		;
 }
@@ -39,7 +39,8 @@
 /* Note that we cannot create the TUN/TAP device from the setup script
  * as we need to get a file descriptor to communicate with the interface.
  */
-int eth_iface_create(const char *dev_name, const char *if_name, bool tun_only)
+int eth_iface_create(const char *dev_name, const char *if_name, bool tun_only,
+		     bool vnet_hdr)
 {
 	struct ifreq ifr;
 	int fd, ret = -EINVAL;
@@ -54,6 +55,13 @@ int eth_iface_create(const char *dev_name, const char *if_name, bool tun_only)
 #ifdef __linux
 	ifr.ifr_flags = (tun_only ? IFF_TUN : IFF_TAP) | IFF_NO_PI;
 
+	/* Every frame is prefixed with a struct virtio_net_hdr, which lets
+	 * the host kernel segment TCP packets larger than the MTU.
+	 */
+	if (vnet_hdr) {
+		ifr.ifr_flags |= IFF_VNET_HDR;
+	}
+
 	strncpy(ifr.ifr_name, if_name, IFNAMSIZ - 1);
 
 	ret = ioctl(fd, TUNSETIFF, (void *)&ifr);
@@ -11,7 +11,8 @@
 #ifndef ZEPHYR_DRIVERS_ETHERNET_ETH_NATIVE_TAP_PRIV_H_
 #define ZEPHYR_DRIVERS_ETHERNET_ETH_NATIVE_TAP_PRIV_H_
 
-int eth_iface_create(const char *dev_name, const char *if_name, bool tun_only);
+int eth_iface_create(const char *dev_name, const char *if_name, bool tun_only,
+		     bool vnet_hdr);
 int eth_iface_remove(int fd);
 int eth_wait_data(int fd);
 int eth_clock_gettime(uint64_t *second, uint32_t *nanosecond);
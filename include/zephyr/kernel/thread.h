@@ -249,6 +249,18 @@ typedef struct k_thread_runtime_stats {
 #endif
 }  k_thread_runtime_stats_t;
 
+#ifdef CONFIG_PROFILING_LATENCY
+/* Instrumented functions entered by the thread, with their entry time */
+struct _thread_latency {
+	uint32_t generation;
+	uint32_t depth;
+	struct {
+		void *func;
+		uint64_t entry;
+	} calls[CONFIG_PROFILING_LATENCY_DEPTH];
+};
+#endif /* CONFIG_PROFILING_LATENCY */
+
 struct z_poller {
 	bool is_polling;
 	uint8_t mode;
@@ -369,6 +381,11 @@ struct k_thread {
 	struct k_obj_core  obj_core;
 #endif /* CONFIG_OBJ_CORE_THREAD */
 
+#ifdef CONFIG_PROFILING_LATENCY
+	/** Function latency instrumentation call stack */
+	struct _thread_latency latency;
+#endif /* CONFIG_PROFILING_LATENCY */
+
 #ifdef CONFIG_SMP
 	/** threads waiting in k_thread_suspend() */
 	_wait_q_t  halt_queue;
@@ -295,6 +295,63 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage);
  */
 int log_mem_get_max_usage(uint32_t *max);
 
+/**
+ * @brief Get number of messages dropped on a CPU.
+ *
+ * Requires CONFIG_LOG_PER_CPU_BUFFERS option.
+ *
+ * @param[in] cpu CPU index.
+ * @param[out] dropped Number of messages logged from the CPU and dropped
+ * since the system start.
+ *
+ * @retval -EINVAL if CPU index is invalid.
+ * @retval -ENOTSUP if per-CPU buffers are not enabled.
+ * @retval 0 successfully read the number of dropped messages.
+ */
+int log_cpu_dropped_get(unsigned int cpu, uint32_t *dropped);
+
+/**
+ * @brief Set rate limits of a source of the local domain.
+ *
+ * Requires CONFIG_LOG_RATE_LIMIT option.
+ *
+ * @param source_id	Source (module or instance) ID.
+ * @param config	Rate limits.
+ *
+ * @retval -EINVAL if source ID, burst or sample is invalid.
+ * @retval -ENOTSUP if rate limiting is not enabled.
+ * @retval 0 successfully set the rate limits.
+ */
+int log_rate_limit_set(int16_t source_id, const struct log_rate_limit_config *config);
+
+/**
+ * @brief Get rate limits of a source of the local domain.
+ *
+ * Requires CONFIG_LOG_RATE_LIMIT option.
+ *
+ * @param source_id	Source (module or instance) ID.
+ * @param[out] config	Rate limits.
+ *
+ * @retval -EINVAL if source ID is invalid.
+ * @retval -ENOTSUP if rate limiting is not enabled.
+ * @retval 0 successfully read the rate limits.
+ */
+int log_rate_limit_get(int16_t source_id, struct log_rate_limit_config *config);
+
+/**
+ * @brief Get rate limiting statistics of a source of the local domain.
+ *
+ * Requires CONFIG_LOG_RATE_LIMIT option.
+ *
+ * @param source_id	Source (module or instance) ID.
+ * @param[out] stats	Statistics since the system start.
+ *
+ * @retval -EINVAL if source ID is invalid.
+ * @retval -ENOTSUP if rate limiting is not enabled.
+ * @retval 0 successfully read the statistics.
+ */
+int log_rate_limit_stats_get(int16_t source_id, struct log_rate_limit_stats *stats);
+
 #if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MODE_MINIMAL)
 #define LOG_CORE_INIT() log_core_init()
 #define LOG_PANIC() log_panic()
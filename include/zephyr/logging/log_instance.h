@@ -7,7 +7,11 @@
 #define ZEPHYR_INCLUDE_LOGGING_LOG_INSTANCE_H_
 
 #include <zephyr/types.h>
+#include <stdbool.h>
 #include <zephyr/sys/iterable_sections.h>
+#ifdef CONFIG_LOG_RATE_LIMIT
+#include <zephyr/spinlock.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,9 +30,59 @@ struct log_source_const_data {
 #endif
 };
 
+/** @brief Rate limits of the source of log messages. */
+struct log_rate_limit_config {
+	/** Messages per second, 0 if not limited. */
+	uint16_t rate;
+	/** Maximum number of messages logged at once. */
+	uint16_t burst;
+	/** Only 1 in @p sample messages is logged. */
+	uint16_t sample;
+	/** Suppress messages identical to the previous one. */
+	bool duplicates;
+};
+
+/** @brief Rate limiting statistics of the source of log messages. */
+struct log_rate_limit_stats {
+	/** Messages which passed the rate limits. */
+	uint32_t logged;
+	/** Messages dropped because the source exceeded its rate. */
+	uint32_t rate_dropped;
+	/** Messages dropped by sampling. */
+	uint32_t sampled_out;
+	/** Duplicates of the previous message which were suppressed. */
+	uint32_t repeated;
+};
+
+#ifdef CONFIG_LOG_RATE_LIMIT
+/** @brief Rate limiting state of the source of log messages. */
+struct log_source_rate_limit {
+	/** Protects the state, sources are limited independently. */
+	struct k_spinlock lock;
+	struct log_rate_limit_config config;
+	uint32_t sample_cnt;
+	/** Available messages, in thousandths of a message. */
+	uint32_t tokens;
+	/** Uptime of the last update of the tokens, in milliseconds. */
+	uint32_t refill;
+	/** Key of the last logged message, 0 if none. */
+	uint32_t last_key;
+	/** Messages dropped since the last logged message. */
+	uint32_t dropped;
+	/** Duplicates of the last logged message suppressed since it was logged. */
+	uint32_t repeated;
+	/** Uptime of the last suppressed message, in milliseconds. */
+	uint32_t suppressed;
+	struct log_rate_limit_stats stats;
+};
+#endif /* CONFIG_LOG_RATE_LIMIT */
+
 /** @brief Dynamic data associated with the source of log messages. */
 struct log_source_dynamic_data {
 	uint32_t filters;
+#ifdef CONFIG_LOG_RATE_LIMIT
+	struct log_source_rate_limit rate_limit;
+#endif
 #ifdef CONFIG_NIOS2
 	/* Workaround alert! Dummy data to ensure that structure is >8 bytes.
 	 * Nios2 uses global pointer register for structures <=8 bytes and
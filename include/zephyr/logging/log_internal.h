@@ -60,6 +60,33 @@ void z_log_free(void *buf);
 /* Initialize runtime filters */
 void z_log_runtime_filters_init(void);
 
+/* Initialize rate limits of the sources to the default ones. */
+void z_log_rate_limit_init(void);
+
+/** @brief Check the rate limits of the source of a message being created.
+ *
+ * @param source Source of the message, dynamic data.
+ * @param key Key of the message for duplicate detection, 0 if the message
+ * cannot be compared.
+ * @param[out] dropped Number of messages dropped since the last logged message
+ * of the source, set if the message is accepted.
+ * @param[out] repeated Number of suppressed duplicates of the last logged
+ * message of the source, set if the message is accepted.
+ *
+ * @retval true if the message is accepted.
+ * @retval false if the message must be dropped.
+ */
+bool z_log_rate_limit_check(const void *source, uint32_t key,
+			    uint32_t *dropped, uint32_t *repeated);
+
+/** @brief Log the number of messages suppressed by the rate limits of a source.
+ *
+ * @param source Source of the messages, dynamic data.
+ * @param dropped Number of dropped messages.
+ * @param repeated Number of suppressed duplicates.
+ */
+void z_log_rate_limit_report(const void *source, uint32_t dropped, uint32_t repeated);
+
 /* Initialize links. */
 void z_log_links_initiate(void);
 
@@ -520,7 +520,9 @@ do { \
 	bool has_rw_str = CBPRINTF_MUST_RUNTIME_PACKAGE( \
 					Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt), \
 					__VA_ARGS__); \
-	if (IS_ENABLED(CONFIG_LOG_SPEED) && (_try_0cpy) && ((_dlen) == 0) && !has_rw_str) {\
+	/* Zero-copy messages are allocated inline, without checking rate limits. */ \
+	if (IS_ENABLED(CONFIG_LOG_SPEED) && !IS_ENABLED(CONFIG_LOG_RATE_LIMIT) && \
+	    (_try_0cpy) && ((_dlen) == 0) && !has_rw_str) {\
 		LOG_MSG_DBG("create zero-copy message\n");\
 		Z_LOG_MSG_SIMPLE_CREATE(_cstr_cnt, _domain_id, _source, \
 					_level, Z_LOG_FMT_ARGS(_fmt, ##__VA_ARGS__)); \
@@ -90,6 +90,10 @@ struct log_output_control_block {
 	atomic_t offset;
 	void *ctx;
 	const char *hostname;
+#ifdef CONFIG_LOG_DICTIONARY_STREAM
+	uint16_t dict_seq;
+	log_timestamp_t dict_timestamp;
+#endif
 };
 
 /** @brief Log_output instance structure. */
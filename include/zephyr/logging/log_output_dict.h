@@ -23,8 +23,45 @@ extern "C" {
 enum log_dict_output_msg_type {
 	MSG_NORMAL = 0,
 	MSG_DROPPED_MSG = 1,
+	MSG_NORMAL_COMPACT = 2,
 };
 
+/** First byte of the start of frame marker of the dictionary log stream. */
+#define LOG_DICT_OUTPUT_FRAME_SOF0 0x5A
+/** Second byte of the start of frame marker of the dictionary log stream. */
+#define LOG_DICT_OUTPUT_FRAME_SOF1 0x4C
+
+/**
+ * Header of one frame of the dictionary log stream, used if
+ * CONFIG_LOG_DICTIONARY_STREAM is enabled.
+ *
+ * The header is followed by @p len bytes holding one message, and by the
+ * CRC-16/CCITT-FALSE of @p seq, @p len and the message, all multi-byte
+ * values being in the target endianness.
+ */
+struct log_dict_output_frame_hdr_t {
+	uint8_t sof[2];
+	uint16_t seq;
+	uint16_t len;
+} __packed;
+
+/**
+ * Maximum length of the compact header of one dictionary based log message,
+ * used in frames:
+ *
+ * - type (uint8_t), MSG_NORMAL_COMPACT,
+ * - domain in bits 0 to 3 and level in bits 4 to 7 (uint8_t),
+ * - source ID,
+ * - timestamp, shifted left by one bit. Bit 0 is set if the timestamp is
+ *   the full one, otherwise it is the difference with the timestamp of the
+ *   message in the previous frame,
+ * - package length,
+ * - data length.
+ *
+ * All the fields after the first two are unsigned LEB128 values.
+ */
+#define LOG_DICT_OUTPUT_COMPACT_HDR_MAX_LEN (2 + 10 + 10 + 3 + 3)
+
 /**
  * Output header for one dictionary based log message.
  */
@@ -306,6 +306,16 @@ struct coap_observer {
 	uint8_t tkl;
 };
 
+/**
+ * @brief Location of an option in a CoAP packet.
+ *
+ * Entry of the option index, see @kconfig{CONFIG_COAP_OPTION_INDEX}.
+ */
+struct coap_option_index {
+	uint16_t code;   /**< Option number */
+	uint16_t offset; /**< Offset of the option header in the packet data */
+};
+
 /**
  * @brief Representation of a CoAP Packet.
  */
@@ -316,6 +326,15 @@ struct coap_packet {
 	uint8_t hdr_len;  /**< CoAP header length */
 	uint16_t opt_len; /**< Total options length (delta + len + value) */
 	uint16_t delta;   /**< Used for delta calculation in CoAP packet */
+#if defined(CONFIG_COAP_OPTION_INDEX) || defined(DOXYGEN)
+	/**
+	 * Index of the options in the packet, NULL if options are not indexed.
+	 * Only available when @kconfig{CONFIG_COAP_OPTION_INDEX} is enabled.
+	 */
+	struct coap_option_index *opt_index;
+	uint8_t opt_index_len;  /**< Number of options in the index */
+	uint8_t opt_index_size; /**< Number of entries available in the index */
+#endif
 #if defined(CONFIG_COAP_KEEP_USER_DATA) || defined(DOXYGEN)
 	/**
 	 * Application specific user data.
@@ -504,6 +523,56 @@ bool coap_uri_path_match(const char * const *path,
 int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 		      struct coap_option *options, uint8_t opt_num);
 
+/**
+ * @brief Parses the CoAP packet in data like coap_packet_parse(), and builds
+ * an index of the options in @a index.
+ *
+ * The index is used by the option getters, such as coap_find_options(), to
+ * access an option without parsing all options preceding it. Options added
+ * or removed later on update the index. @a index must remain valid while
+ * @a cpkt is used. If the packet has more options than @a index_len, the
+ * options are not indexed.
+ *
+ * Without @kconfig{CONFIG_COAP_OPTION_INDEX} this is the same as
+ * coap_packet_parse().
+ *
+ * @param cpkt Packet to be initialized from received @a data.
+ * @param data Data containing a CoAP packet, its @a data pointer is
+ * positioned on the start of the CoAP packet.
+ * @param len Length of the data
+ * @param options Parse options and cache its details.
+ * @param opt_num Number of options
+ * @param index Memory for the option index
+ * @param index_len Number of entries in @a index
+ *
+ * @retval 0 in case of success.
+ * @retval -EINVAL in case of invalid input args.
+ * @retval -EBADMSG in case of malformed coap packet header.
+ * @retval -EILSEQ in case of malformed coap options.
+ */
+int coap_packet_parse_indexed(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
+			      struct coap_option *options, uint8_t opt_num,
+			      struct coap_option_index *index, uint8_t index_len);
+
+/**
+ * @brief Index the options of a CoAP packet.
+ *
+ * Builds an index of the options already present in @a cpkt, for instance
+ * after coap_packet_init(), and keeps it updated when options are added or
+ * removed. See coap_packet_parse_indexed().
+ *
+ * @param cpkt Packet to index
+ * @param index Memory for the option index
+ * @param index_len Number of entries in @a index
+ *
+ * @retval 0 in case of success.
+ * @retval -ENOTSUP if @kconfig{CONFIG_COAP_OPTION_INDEX} is disabled.
+ * @retval -ENOMEM if the options do not fit in @a index.
+ * @retval -EILSEQ in case of malformed coap options.
+ */
+int coap_packet_set_option_index(struct coap_packet *cpkt,
+				 struct coap_option_index *index, uint8_t index_len);
+
 /**
  * @brief Parses provided coap path (with/without query) or query and appends
  * that as options to the @a cpkt.
@@ -1251,6 +1320,49 @@ void coap_replies_clear(struct coap_reply *replies, size_t len);
  */
 int coap_resource_notify(struct coap_resource *resource);
 
+/**
+ * @brief Initialize a notification that is shared by all observers of a
+ * resource.
+ *
+ * The age of the resource is incremented and the notification is initialized
+ * without a token and with the Observe option set to the new age. Options
+ * with a higher number than Observe and the payload can then be appended as
+ * usual. The notification is encoded only once, the header for each observer
+ * is created with coap_notification_header().
+ *
+ * @param cpkt Notification to be initialized
+ * @param resource Resource that was updated
+ * @param data Data buffer of the notification
+ * @param max_len Size of @p data
+ * @param type Type of the notification, CON or NON
+ * @param code Response code of the notification
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_notification_init(struct coap_packet *cpkt, struct coap_resource *resource,
+			   uint8_t *data, uint16_t max_len, uint8_t type, uint8_t code);
+
+/**
+ * @brief Create the header of a shared notification for one observer.
+ *
+ * The header of @p cpkt is written to @p buf with the token of @p observer
+ * and the message ID @p id. Sending it followed by the options and payload of
+ * @p cpkt, which start at offset @ref coap_packet.hdr_len, gives the
+ * notification for this observer.
+ *
+ * @param cpkt Notification initialized with coap_notification_init()
+ * @param observer Observer the notification is sent to
+ * @param id Message ID of the notification
+ * @param buf Buffer for the header
+ * @param len Size of @p buf, at least 4 + COAP_TOKEN_MAX_LEN bytes
+ *
+ * @return Length of the header in case of success or negative in case of
+ * error.
+ */
+int coap_notification_header(const struct coap_packet *cpkt,
+			     const struct coap_observer *observer, uint16_t id,
+			     uint8_t *buf, size_t len);
+
 /**
  * @brief Returns if this request is enabling observing a resource.
  *
@@ -260,6 +260,25 @@ int coap_resource_send(const struct coap_resource *resource, const struct coap_p
 		       const struct sockaddr *addr, socklen_t addr_len,
 		       const struct coap_transmission_parameters *params);
 
+/**
+ * @brief Send a notification to all observers of the provided @p resource .
+ *
+ * The notification is encoded once with @ref coap_notification_init, only the token and the
+ * message ID differ per observer. Compared to encoding a notification for each observer from
+ * the resource's notify callback, this saves an encoding pass per observer. The notifications
+ * are sent back to back while the service is locked.
+ *
+ * @note This function is suitable for a @p resource defined with @ref COAP_RESOURCE_DEFINE.
+ *
+ * @param resource Pointer to CoAP resource
+ * @param cpkt Notification to send, initialized with @ref coap_notification_init
+ * @param params Pointer to transmission parameters structure or NULL to use default values.
+ * @return Number of observers notified in case of success or negative in case of error.
+ */
+int coap_resource_send_notification(struct coap_resource *resource,
+				    const struct coap_packet *cpkt,
+				    const struct coap_transmission_parameters *params);
+
 /**
  * @brief Parse a CoAP observe request for the provided @p resource .
  *
@@ -420,6 +420,14 @@ struct dns_resolve_context {
 		 * cannot be used to find correct pending query.
 		 */
 		uint16_t query_hash;
+
+#if defined(CONFIG_DNS_RESOLVER_COALESCE_QUERIES) || defined(__DOXYGEN__)
+		/** Pending query this query joined instead of being sent, its
+		 * results are delivered to this query as well. NULL if this
+		 * query was sent.
+		 */
+		struct dns_pending_query *coalesced_with;
+#endif /* CONFIG_DNS_RESOLVER_COALESCE_QUERIES */
 	} queries[DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
@@ -658,6 +666,35 @@ static inline int dns_cancel_addr_info(uint16_t dns_id)
 	return dns_resolve_cancel(dns_resolve_get_default(), dns_id);
 }
 
+/** @brief DNS resolver cache statistics. */
+struct dns_resolve_cache_stats {
+	/** Lookups answered with cached addresses */
+	uint32_t hits;
+	/** Lookups without cached addresses */
+	uint32_t misses;
+	/** Misses answered with a cached negative answer */
+	uint32_t negative_hits;
+	/** Entries replaced before their expiry because the cache was full */
+	uint32_t evictions;
+	/** Queries sent to refresh popular entries before their expiry */
+	uint32_t prefetches;
+	/** Lookups that joined an identical pending query */
+	uint32_t coalesced;
+};
+
+/**
+ * @brief Get the DNS resolver cache statistics.
+ *
+ * @details The statistics cover all the DNS contexts, as they share the
+ * cache.
+ *
+ * @param stats Statistics of the DNS resolver cache.
+ *
+ * @return 0 if ok, -ENOTSUP if CONFIG_DNS_RESOLVER_CACHE is disabled,
+ * <0 if error.
+ */
+int dns_resolve_cache_stats_get(struct dns_resolve_cache_stats *stats);
+
 /**
  * @}
  */
@@ -214,6 +214,12 @@ enum ethernet_hw_caps {
 
 	/** 5 Gbits link supported */
 	ETHERNET_LINK_5000BASE_T	= BIT(22),
+
+	/** TCP segmentation offload, large TCP packets are split by the device */
+	ETHERNET_HW_TSO			= BIT(23),
+
+	/** Large receive offload, the device may deliver coalesced TCP segments */
+	ETHERNET_HW_LRO			= BIT(24),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -12,6 +12,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 #define ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -104,6 +105,17 @@ enum http_hpack_static_key {
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE 0
 #endif
 
+#if defined(CONFIG_HTTP_SERVER)
+#define HTTP_SERVER_HPACK_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE
+#else
+#define HTTP_SERVER_HPACK_TABLE_SIZE 0
+#endif
+
+/* Dynamic table size a peer may use until it has acknowledged the
+ * SETTINGS_HEADER_TABLE_SIZE setting, RFC 7540 ch 6.5.2.
+ */
+#define HTTP_HPACK_DEFAULT_TABLE_SIZE 4096
+
 /** @endcond */
 
 /** HTTP2 header field with decoding buffer. */
@@ -127,16 +139,56 @@ struct http_hpack_header_buf {
 	size_t datalen;
 };
 
+/** HPACK dynamic table, one is needed for each direction of a connection. */
+struct http_hpack_table {
+	/** Size of the table as defined in RFC 7541, ch 4.1. */
+	uint16_t size;
+
+	/** Current maximum size of the table. */
+	uint16_t max_size;
+
+	/** Largest maximum size a dynamic table size update may set (decoder).
+	 * While it is below max_size, the next header field must be a table
+	 * size update.
+	 */
+	uint16_t limit;
+
+	/** Number of bytes used in the data buffer. */
+	uint16_t used;
+
+	/** Number of entries in the table. */
+	uint16_t count;
+
+	/** Size of the data buffer. */
+	uint16_t data_size;
+
+	/** A table size update must be sent with the next header (encoder). */
+	bool size_update;
+
+	/** Table entries, newest first. */
+	uint8_t *data;
+};
+
 /** @cond INTERNAL_HIDDEN */
 
+void http_hpack_table_init(struct http_hpack_table *table, uint8_t *data,
+			   size_t data_size, size_t max_size);
+void http_hpack_table_resize(struct http_hpack_table *table, size_t max_size);
+void http_hpack_table_set_limit(struct http_hpack_table *table, size_t limit);
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen);
 int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 			      uint8_t *buf, size_t buflen);
+/* The dynamic table is optional, with a NULL table only the static table is
+ * used. Decoded header fields can point into the table, and remain valid
+ * until the next call.
+ */
 int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
-			     struct http_hpack_header_buf *header);
+			     struct http_hpack_header_buf *header,
+			     struct http_hpack_table *table);
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
-			     struct http_hpack_header_buf *header);
+			     struct http_hpack_header_buf *header,
+			     struct http_hpack_table *table);
 
 /** @endcond */
 
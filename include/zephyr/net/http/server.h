@@ -440,6 +440,22 @@ struct http_client_ctx {
 	/** HTTP/2 header parser context. */
 	struct http_hpack_header_buf header_field;
 
+#if CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE > 0
+	/** HPACK dynamic table used to decode the request headers. */
+	struct http_hpack_table hpack_decoder;
+
+	/** HPACK dynamic table used to encode the response headers. */
+	struct http_hpack_table hpack_encoder;
+
+	/** Entries of the decoder table, which can use the default size until
+	 * the client acknowledges our settings.
+	 */
+	uint8_t hpack_decoder_data[HTTP_HPACK_DEFAULT_TABLE_SIZE];
+
+	/** Entries of the encoder table. */
+	uint8_t hpack_encoder_data[CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE];
+#endif
+
 	/** HTTP/2 streams context. */
 	struct http2_stream_ctx streams[HTTP_SERVER_MAX_STREAMS];
 
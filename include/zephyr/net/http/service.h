@@ -67,6 +67,11 @@ struct http_resource_desc {
 
 struct http_service_runtime_data {
 	int num_clients;
+#if defined(CONFIG_HTTP_SERVER_ROUTE_TRIE)
+	uint16_t route_root;
+	uint16_t route_wildcards;
+	int8_t route_state;
+#endif
 };
 
 struct http_service_desc {
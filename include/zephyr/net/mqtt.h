@@ -255,6 +255,46 @@ struct mqtt_topic_alias {
 #endif /* CONFIG_MQTT_VERSION_5_0 */
 };
 
+/** @brief Outbound PUBLISH queue entry. */
+struct mqtt_publish_queue_entry {
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE) || defined(__DOXYGEN__)
+	/** Offset of the encoded packet in the publish queue buffer. */
+	uint32_t offset;
+
+	/** Length of the encoded packet. */
+	uint32_t len;
+
+	/** Wall clock value (in milliseconds) of the last transmission. */
+	uint32_t sent_time;
+
+	/** Message identifier, zero for QoS 0 messages. */
+	uint16_t message_id;
+
+	/** Transmission state of the packet. */
+	uint8_t state;
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+};
+
+/** @brief Outbound PUBLISH queue. */
+struct mqtt_publish_queue {
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE) || defined(__DOXYGEN__)
+	/** Queued packets, in transmission order. */
+	struct mqtt_publish_queue_entry entries[CONFIG_MQTT_PUBLISH_QUEUE_SIZE];
+
+	/** Number of bytes used in the publish queue buffer. */
+	uint32_t used;
+
+	/** Last message identifier assigned by the queue. */
+	uint16_t last_message_id;
+
+	/** Number of queued packets. */
+	uint8_t count;
+
+	/** Number of QoS 1 and QoS 2 packets sent and not acknowledged yet. */
+	uint8_t inflight;
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+};
+
 /** @brief Abstracts MQTT UTF-8 encoded topic that can be subscribed
  *         to or published.
  */
@@ -884,6 +924,11 @@ struct mqtt_internal {
 	/** Internal. MQTT 5.0 disconnect reason set in case of processing errors. */
 	enum mqtt_disconnect_reason_code disconnect_reason;
 #endif /* CONFIG_MQTT_VERSION_5_0 */
+
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE) || defined(__DOXYGEN__)
+	/** Internal. Outbound PUBLISH queue. */
+	struct mqtt_publish_queue pub_queue;
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
 };
 
 /**
@@ -966,6 +1011,16 @@ struct mqtt_client {
 	/** Size of transmit buffer. */
 	uint32_t tx_buf_size;
 
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE) || defined(__DOXYGEN__)
+	/** Buffer holding the PUBLISH packets queued with
+	 *  @ref mqtt_publish_enqueue until they are sent and acknowledged.
+	 */
+	uint8_t *pub_queue_buf;
+
+	/** Size of the publish queue buffer. */
+	uint32_t pub_queue_buf_size;
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+
 	/** Keepalive interval for this client in seconds.
 	 *  Default is CONFIG_MQTT_KEEPALIVE.
 	 */
@@ -1081,6 +1136,55 @@ int mqtt_connect(struct mqtt_client *client);
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to queue a message for publishing.
+ *
+ * The message is encoded into the publish queue buffer, it is sent by the
+ * next @ref mqtt_publish_flush call along with the other queued messages,
+ * in a single transport write. At most
+ * @kconfig{CONFIG_MQTT_PUBLISH_INFLIGHT_MAX} QoS 1 and QoS 2 messages are
+ * awaiting an acknowledgment at a time. The library tracks the
+ * acknowledgments, replies to PUBREC with PUBREL and retransmits the
+ * messages that are not acknowledged in time. The application is still
+ * notified with the MQTT_EVT_PUBACK and MQTT_EVT_PUBCOMP events. The
+ * MQTT_EVT_PUBREC event is not reported for queued messages the library
+ * released, so the application never sends PUBREL for them. It is reported
+ * for a PUBREC with an MQTT 5.0 error reason code, which ends the flow.
+ * With MQTT 5.0, unacknowledged messages are only sent again after
+ * reconnecting, regardless of @kconfig{CONFIG_MQTT_PUBLISH_RETRANSMIT_TIMEOUT}.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] param Parameters to be used for the publish message.
+ *                  Shall not be NULL. A message identifier is assigned to
+ *                  QoS 1 and QoS 2 messages if @p param has none. The topic
+ *                  and the payload are copied, they do not need to be kept.
+ *
+ * @return Message identifier (zero for QoS 0 messages) or a negative error
+ *         code (errno.h) indicating reason of failure. -ENOMEM is returned
+ *         when the queue is full, -EEXIST when the message identifier given
+ *         in @p param belongs to a message already in the queue.
+ */
+int mqtt_publish_enqueue(struct mqtt_client *client,
+			 const struct mqtt_publish_param *param);
+
+/**
+ * @brief API to send the queued messages.
+ *
+ * Sends the messages queued with @ref mqtt_publish_enqueue, as long as the
+ * inflight window allows, and retransmits the messages that were not
+ * acknowledged within @kconfig{CONFIG_MQTT_PUBLISH_RETRANSMIT_TIMEOUT}.
+ * QoS 0 messages are removed from the queue once sent, QoS 1 and QoS 2
+ * messages once acknowledged. This is also done by @ref mqtt_live.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return Number of packets sent or a negative error code (errno.h)
+ *         indicating reason of failure.
+ */
+int mqtt_publish_flush(struct mqtt_client *client);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -169,6 +169,35 @@ typedef void (*net_context_connect_cb_t)(struct net_context *context,
 					 int status,
 					 void *user_data);
 
+/**
+ * @typedef net_context_zerocopy_cb_t
+ * @brief Zero-copy transmit completion callback.
+ *
+ * @details The callback is called when the network stack has released the
+ * last reference to an application buffer that was sent with the
+ * ZSOCK_MSG_ZEROCOPY flag. After this the application is free to reuse
+ * or release the buffer. The callback can be called from the TX or RX
+ * thread, or from the TCP work queue, so keep processing in the callback
+ * minimal.
+ *
+ * @param buf Start of the application buffer that was released.
+ * @param len Length of the released buffer.
+ * @param user_data The user data given when setting the NET_OPT_ZEROCOPY
+ * option.
+ */
+typedef void (*net_context_zerocopy_cb_t)(const void *buf, size_t len,
+					  void *user_data);
+
+/**
+ * @brief Zero-copy transmit option value, used with NET_OPT_ZEROCOPY.
+ */
+struct net_context_zerocopy {
+	/** Completion callback, NULL disables zero-copy transmission. */
+	net_context_zerocopy_cb_t cb;
+	/** User data passed to the completion callback. */
+	void *user_data;
+};
+
 /* The net_pkt_get_slab_func_t is here in order to avoid circular
  * dependency between net_pkt.h and net_context.h
  */
@@ -401,6 +430,10 @@ __net_socket struct net_context {
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMPING)
 		/** Enable RX, TX or both timestamps of packets send through sockets. */
 		uint8_t timestamping;
+#endif
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+		/** Zero-copy transmit completion notification */
+		struct net_context_zerocopy zerocopy;
 #endif
 	} options;
 
@@ -1399,6 +1432,7 @@ enum net_context_option {
 	NET_OPT_LOCAL_PORT_RANGE  = 21, /**< Clamp local port range */
 	NET_OPT_IPV6_MCAST_LOOP	  = 22, /**< IPV6 multicast loop */
 	NET_OPT_IPV4_MCAST_LOOP	  = 23, /**< IPV4 multicast loop */
+	NET_OPT_ZEROCOPY          = 24, /**< Zero-copy transmit completion */
 };
 
 /**
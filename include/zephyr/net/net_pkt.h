@@ -240,6 +240,11 @@ struct net_pkt {
 #if defined(CONFIG_NET_IP_FRAGMENT)
 	uint8_t ip_reassembled : 1; /* Packet is a reassembled IP packet. */
 #endif
+#if defined(CONFIG_NET_TCP_GRO)
+	uint8_t gro : 1; /* Packet is coalesced from TCP segments whose
+			  * checksums have already been verified.
+			  */
+#endif
 #if defined(CONFIG_NET_PKT_TIMESTAMP)
 	uint8_t tx_timestamping : 1; /** Timestamp transmitted packet */
 	uint8_t rx_timestamping : 1; /** Timestamp received packet */
@@ -360,6 +365,20 @@ struct net_pkt {
 	uint8_t ipv4_pmtu : 1;
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* If non-zero, this is a TCP super-packet that must be split into
+	 * segments of this size before it is sent to the network.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+	/* Flow hash or hardware queue number given by the driver, 0 if the
+	 * hash is to be calculated by the stack.
+	 */
+	uint32_t rx_hash;
+#endif /* CONFIG_NET_TC_RX_FLOW_STEERING */
+
 	/* @endcond */
 };
 
@@ -872,6 +891,56 @@ static inline void net_pkt_set_ipv4_pmtu(struct net_pkt *pkt, bool value)
 }
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0U;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	pkt->rx_hash = hash;
+}
+#else
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0U;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+}
+#endif /* CONFIG_NET_TC_RX_FLOW_STEERING */
+
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
 static inline uint16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
 {
@@ -1047,6 +1116,31 @@ static inline void net_pkt_set_ip_reassembled(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IP_FRAGMENT */
 
+#if defined(CONFIG_NET_TCP_GRO)
+static inline bool net_pkt_is_gro(struct net_pkt *pkt)
+{
+	return !!(pkt->gro);
+}
+
+static inline void net_pkt_set_gro(struct net_pkt *pkt, bool is_gro)
+{
+	pkt->gro = is_gro;
+}
+#else /* CONFIG_NET_TCP_GRO */
+static inline bool net_pkt_is_gro(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+
+static inline void net_pkt_set_gro(struct net_pkt *pkt, bool is_gro)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(is_gro);
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 static inline uint8_t net_pkt_priority(struct net_pkt *pkt)
 {
 	return pkt->priority;
@@ -2688,6 +2782,29 @@ static inline int net_pkt_acknowledge_data(struct net_pkt *pkt,
 	return net_pkt_skip(pkt, access->size);
 }
 
+/**
+ * @brief Get a direct pointer to a header and move the cursor past it
+ *
+ * @details This is a zero-copy alternative to net_pkt_get_data() followed
+ *          by net_pkt_acknowledge_data(). The returned pointer always
+ *          points into the packet buffers, so it stays valid and any
+ *          modification is done in place. If the header straddles buffer
+ *          fragments, it is moved once into a single fragment. Data before
+ *          the cursor is never moved, so pointers to previous headers
+ *          obtained this way remain valid. Buffers shared with another
+ *          packet, e.g. a shallow clone, are not modified: the packet gets
+ *          its own copy of the data first, and pointers to previous headers
+ *          then refer to the shared buffers.
+ *          Packet needs to be set to overwrite mode.
+ *
+ * @param pkt The network packet holding the header.
+ * @param len Length of the header.
+ *
+ * @return a pointer to the header, NULL if the packet is too short or the
+ *         header could not be made contiguous.
+ */
+void *net_pkt_hdr_pull(struct net_pkt *pkt, size_t len);
+
 /**
  * @}
  */
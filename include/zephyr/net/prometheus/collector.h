@@ -89,6 +89,16 @@ struct prometheus_collector {
 				   GET_ARGS_LESS_N(1, __VA_ARGS__)))),	\
 	}
 
+#if defined(CONFIG_PROMETHEUS_SYSTEM_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Collector of the kernel statistics
+ *
+ * Available with CONFIG_PROMETHEUS_SYSTEM_STATS, the metrics are read from
+ * the kernel object core statistics when the collector is scraped.
+ */
+extern struct prometheus_collector prometheus_kernel_stats;
+#endif
+
 /**
  * @brief Register a metric with a Prometheus collector
  *
@@ -127,7 +137,7 @@ enum prometheus_walk_state {
 struct prometheus_collector_walk_context {
 	struct prometheus_collector *collector;
 	struct prometheus_metric *metric;
-	struct prometheus_metric *tmp;
+	int line;
 	enum prometheus_walk_state state;
 };
 
@@ -137,12 +147,18 @@ struct prometheus_collector_walk_context {
  * @brief Walk through all metrics in a Prometheus collector and format them
  *        into a buffer.
  *
+ * Each call fills the buffer with as many complete lines of the exposition
+ * as fit, so that the buffer only needs to hold the longest line. The
+ * buffer can be sent as a chunk of the HTTP response as is. The buffer is
+ * NUL terminated.
+ *
  * @param ctx Pointer to the walker context.
  * @param buffer Pointer to the buffer to store the formatted metrics.
  * @param buffer_size Size of the buffer.
  * @return 0 if successful and we went through all metrics, -EAGAIN if we
  *	 need to call this function again, any other negative error code
  *	 means an error occurred.
+ * @retval -ENOMEM A single line does not fit in the buffer.
  */
 int prometheus_collector_walk_metrics(struct prometheus_collector_walk_context *ctx,
 				      uint8_t *buffer, size_t buffer_size);
@@ -165,7 +181,7 @@ static inline int prometheus_collector_walk_init(struct prometheus_collector_wal
 	ctx->collector = collector;
 	ctx->state = PROMETHEUS_WALK_START;
 	ctx->metric = NULL;
-	ctx->tmp = NULL;
+	ctx->line = 0;
 
 	return 0;
 }
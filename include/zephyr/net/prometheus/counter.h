@@ -31,8 +31,18 @@
 struct prometheus_counter {
 	/** Base of the Prometheus counter metric */
 	struct prometheus_metric base;
-	/** Value of the Prometheus counter metric */
+	/**
+	 * Value of the Prometheus counter metric. With
+	 * CONFIG_PROMETHEUS_PER_CPU_METRICS this is only a part of the value,
+	 * use prometheus_counter_get() to read the counter.
+	 */
 	uint64_t value;
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS) || defined(__DOXYGEN__)
+	/** Increments done by each CPU, added to value when the counter is read */
+	uint64_t cpu_value[CONFIG_MP_MAX_NUM_CPUS];
+	/** Sequence counters of the cells of each CPU */
+	uint32_t cpu_seq[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 	/** User data */
 	void *user_data;
 };
@@ -104,6 +114,15 @@ static inline int prometheus_counter_inc(struct prometheus_counter *counter)
  */
 int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value);
 
+/**
+ * @brief Get the value of a Prometheus counter metric
+ * With CONFIG_PROMETHEUS_PER_CPU_METRICS, the increments done by each CPU are
+ * summed at this point, the value field alone is not the counter value.
+ * @param counter Pointer to the counter metric.
+ * @return Value of the counter.
+ */
+uint64_t prometheus_counter_get(const struct prometheus_counter *counter);
+
 /**
  * @}
  */
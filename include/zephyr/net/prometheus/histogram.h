@@ -30,8 +30,16 @@
 struct prometheus_histogram_bucket {
 	/** Upper bound value of bucket */
 	double upper_bound;
-	/** Cumulative count of observations in the bucket */
+	/**
+	 * Cumulative count of observations in the bucket. With
+	 * CONFIG_PROMETHEUS_PER_CPU_METRICS this is only a part of the count,
+	 * use prometheus_histogram_get_bucket_count() to read it.
+	 */
 	unsigned long count;
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS) || defined(__DOXYGEN__)
+	/** Observations of each CPU, added to count when the bucket is read */
+	unsigned long cpu_count[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
 /**
@@ -47,10 +55,26 @@ struct prometheus_histogram {
 	struct prometheus_histogram_bucket *buckets;
 	/** Number of buckets in the histogram */
 	size_t num_buckets;
-	/** Sum of all observed values in the histogram */
+	/**
+	 * Sum of all observed values in the histogram. With
+	 * CONFIG_PROMETHEUS_PER_CPU_METRICS this is only a part of the sum,
+	 * use prometheus_histogram_get_sum() to read it.
+	 */
 	double sum;
-	/** Total count of observations in the histogram */
+	/**
+	 * Total count of observations in the histogram. With
+	 * CONFIG_PROMETHEUS_PER_CPU_METRICS this is only a part of the count,
+	 * use prometheus_histogram_get_count() to read it.
+	 */
 	unsigned long count;
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS) || defined(__DOXYGEN__)
+	/** Sum of the values observed by each CPU */
+	double cpu_sum[CONFIG_MP_MAX_NUM_CPUS];
+	/** Count of the observations of each CPU */
+	unsigned long cpu_count[CONFIG_MP_MAX_NUM_CPUS];
+	/** Sequence counters of the cells of each CPU */
+	uint32_t cpu_seq[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 	/** User data */
 	void *user_data;
 };
@@ -105,6 +129,35 @@ struct prometheus_histogram {
  */
 int prometheus_histogram_observe(struct prometheus_histogram *histogram, double value);
 
+/**
+ * @brief Get the sum of the values observed in a Prometheus histogram metric
+ * With CONFIG_PROMETHEUS_PER_CPU_METRICS, the values observed by each CPU are
+ * summed at this point, the sum field alone is not the histogram sum.
+ * @param histogram Pointer to the histogram metric.
+ * @return Sum of the observed values.
+ */
+double prometheus_histogram_get_sum(const struct prometheus_histogram *histogram);
+
+/**
+ * @brief Get the count of observations in a Prometheus histogram metric
+ * With CONFIG_PROMETHEUS_PER_CPU_METRICS, the observations of each CPU are
+ * summed at this point, the count field alone is not the histogram count.
+ * @param histogram Pointer to the histogram metric.
+ * @return Count of observations.
+ */
+unsigned long prometheus_histogram_get_count(const struct prometheus_histogram *histogram);
+
+/**
+ * @brief Get the count of observations in a bucket of a Prometheus histogram metric
+ * With CONFIG_PROMETHEUS_PER_CPU_METRICS, the observations of each CPU are
+ * summed at this point, the count field of the bucket alone is not its count.
+ * @param histogram Pointer to the histogram metric.
+ * @param bucket Index of the bucket in the buckets array of the histogram.
+ * @return Count of observations in the bucket, 0 if there is no such bucket.
+ */
+unsigned long prometheus_histogram_get_bucket_count(const struct prometheus_histogram *histogram,
+						    size_t bucket);
+
 /**
  * @}
  */
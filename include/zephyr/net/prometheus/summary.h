@@ -49,10 +49,26 @@ struct prometheus_summary {
 	struct prometheus_summary_quantile *quantiles;
 	/** Number of quantiles associated with the Prometheus summary metric */
 	size_t num_quantiles;
-	/** Sum of all observed values in the summary metric */
+	/**
+	 * Sum of all observed values in the summary metric. With
+	 * CONFIG_PROMETHEUS_PER_CPU_METRICS this is only a part of the sum,
+	 * use prometheus_summary_get_sum() to read it.
+	 */
 	double sum;
-	/** Total count of observations in the summary metric */
+	/**
+	 * Total count of observations in the summary metric. With
+	 * CONFIG_PROMETHEUS_PER_CPU_METRICS this is only a part of the count,
+	 * use prometheus_summary_get_count() to read it.
+	 */
 	unsigned long count;
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS) || defined(__DOXYGEN__)
+	/** Sum of the values observed by each CPU */
+	double cpu_sum[CONFIG_MP_MAX_NUM_CPUS];
+	/** Count of the observations of each CPU */
+	unsigned long cpu_count[CONFIG_MP_MAX_NUM_CPUS];
+	/** Sequence counters of the cells of each CPU */
+	uint32_t cpu_seq[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 	/** User data */
 	void *user_data;
 };
@@ -123,6 +139,24 @@ int prometheus_summary_observe(struct prometheus_summary *summary, double value)
 int prometheus_summary_observe_set(struct prometheus_summary *summary,
 				   double value, unsigned long count);
 
+/**
+ * @brief Get the sum of the values observed in a Prometheus summary metric
+ * With CONFIG_PROMETHEUS_PER_CPU_METRICS, the values observed by each CPU are
+ * summed at this point, the sum field alone is not the summary sum.
+ * @param summary Pointer to the summary metric.
+ * @return Sum of the observed values.
+ */
+double prometheus_summary_get_sum(const struct prometheus_summary *summary);
+
+/**
+ * @brief Get the count of observations in a Prometheus summary metric
+ * With CONFIG_PROMETHEUS_PER_CPU_METRICS, the observations of each CPU are
+ * summed at this point, the count field alone is not the summary count.
+ * @param summary Pointer to the summary metric.
+ * @return Count of observations.
+ */
+unsigned long prometheus_summary_get_count(const struct prometheus_summary *summary);
+
 /**
  * @}
  */
@@ -77,6 +77,10 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_send/zsock_sendto/zsock_sendmsg: Transmit directly from the
+ *  caller buffer without copying it, see @ref SO_ZEROCOPY.
+ */
+#define ZSOCK_MSG_ZEROCOPY 0x4000000
 /** @} */
 
 /**
@@ -517,6 +521,67 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_pkt;
+
+/**
+ * @brief Receive a network packet from a socket without copying the data
+ *
+ * @details
+ * Dequeue the next received network packet from a native UDP or TCP socket
+ * and hand it over to the caller. The packet cursor points to the first
+ * unread payload byte, so the data can be accessed with net_pkt_read() or
+ * by walking the packet fragments directly. The caller owns the packet and
+ * must release it with net_pkt_unref() when done.
+ *
+ * For stream sockets the receive window is opened as soon as the packet is
+ * handed over, and 0 is returned (with @p pkt set to NULL) when the peer has
+ * closed the connection.
+ *
+ * Only the ZSOCK_MSG_DONTWAIT flag is supported. This function is only
+ * available to supervisor threads and for sockets provided by the native
+ * network stack (i.e. not for TLS or offloaded sockets).
+ *
+ * @param sock Socket to receive from.
+ * @param pkt Location where to store the received packet.
+ * @param flags Receive flags.
+ *
+ * @return Number of payload bytes available in the packet, or -1 with
+ *         errno set on error.
+ */
+ssize_t zsock_recv_pkt(int sock, struct net_pkt **pkt, int flags);
+
+struct fs_file_t;
+
+/**
+ * @brief Send data from a file to a socket
+ *
+ * @details
+ * Send up to @p count bytes read from @p file to a connected socket. For
+ * native TCP sockets the file data is read directly into the TCP send
+ * buffers, avoiding the intermediate copy done when the data is first read
+ * into an application buffer and then passed to zsock_send(). For other
+ * sockets (e.g. TLS or offloaded ones) the data is sent in chunks through
+ * zsock_send().
+ *
+ * If @p offset is not NULL, the data is read starting from @p offset, which
+ * is updated to point past the last byte sent, and the file position is left
+ * unchanged. Otherwise the data is read from the current file position, which
+ * is advanced by the number of bytes sent.
+ *
+ * This function is only available to supervisor threads and if
+ * @kconfig{CONFIG_FILE_SYSTEM} is enabled.
+ *
+ * @param sock Socket to send to.
+ * @param file Open file to read the data from.
+ * @param offset Optional file offset to start reading from.
+ * @param count Maximum number of bytes to send.
+ *
+ * @return Number of bytes sent, which is less than @p count if the end of
+ *         the file was reached, or -1 with errno set on error.
+ */
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -896,6 +961,17 @@ struct ifreq {
 /** Socket TX time (same as SO_TXTIME) */
 #define SCM_TXTIME SO_TXTIME
 
+/**
+ * Zero-copy transmit completion notification (struct zsock_zerocopy).
+ * Data sent with ZSOCK_MSG_ZEROCOPY is referenced by the network stack
+ * until the completion callback is called for it.
+ *
+ * Linux uses 60, which is already taken by SO_SOCKS5 here. The option
+ * value also differs from Linux: completions are reported through a
+ * callback instead of the socket error queue.
+ */
+#define SO_ZEROCOPY 62
+
 /** Timestamp generation flags */
 
 /** Request RX timestamps generated by network adapter. */
@@ -908,6 +984,19 @@ struct ifreq {
 
 /** */
 
+/** Zero-copy transmit completion callback, see @ref SO_ZEROCOPY. */
+typedef void (*zsock_zerocopy_cb_t)(const void *buf, size_t len, void *user_data);
+
+/** Option value for @ref SO_ZEROCOPY */
+struct zsock_zerocopy {
+	/** Called when the network stack no longer references @p buf.
+	 *  Setting this to NULL disables zero-copy transmission.
+	 */
+	zsock_zerocopy_cb_t cb;
+	/** User data passed to the callback */
+	void *user_data;
+};
+
 /** @} */
 
 /**
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_LATENCY_H_
+#define ZEPHYR_INCLUDE_PROFILING_LATENCY_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup latency Function latency
+ *  @ingroup os_services
+ *  @brief Function latency histograms
+ *
+ *  Functions are instrumented by the compiler, and the time between the entry
+ *  and the exit of each call is measured with the timing functions.
+ *  @{
+ */
+
+/** @brief Latency statistics of a function.
+ *
+ * Latencies are in timing cycles, see timing_cycles_to_ns(). They are
+ * measured between the entry and the exit of each call, so they include the
+ * time during which the thread was preempted or blocked.
+ */
+struct latency_stats {
+	/** Number of calls. */
+	uint32_t count;
+	/** Minimum latency. */
+	uint64_t min;
+	/** Maximum latency. */
+	uint64_t max;
+	/** Sum of the latencies. */
+	uint64_t total;
+	/** Number of calls per latency bucket. Bucket 0 counts the calls of 0
+	 * cycles and bucket i the calls of 2^(i-1) to 2^i - 1 cycles. The last
+	 * bucket also counts the longer calls.
+	 */
+	uint32_t histogram[CONFIG_PROFILING_LATENCY_BUCKETS];
+};
+
+/** @brief Callback called for each function.
+ *
+ * @param func Address of the function.
+ * @param stats Latency statistics of the function.
+ * @param user_data User data.
+ *
+ * @retval 0 to continue with the next function.
+ * @retval Other value to stop, returned by latency_foreach().
+ */
+typedef int (*latency_cb_t)(void *func, const struct latency_stats *stats, void *user_data);
+
+/** @brief Start measuring the latency of the instrumented functions.
+ *
+ * Calls entered before the measurement is started are not measured.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if the latencies are already measured.
+ */
+int latency_start(void);
+
+/** @brief Stop measuring the latency of the instrumented functions.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if the latencies are not measured.
+ */
+int latency_stop(void);
+
+/** @brief Check if the latency of the instrumented functions is measured.
+ *
+ * @retval true if the latencies are measured.
+ * @retval false if the latencies are not measured.
+ */
+bool latency_is_running(void);
+
+/** @brief Discard the latency statistics of all functions. */
+void latency_clear(void);
+
+/** @brief Iterate over the functions with latency statistics.
+ *
+ * The statistics of each function are copied before the callback is called,
+ * so this can be called while the latencies are measured.
+ *
+ * @param cb Callback.
+ * @param user_data User data passed to the callback.
+ *
+ * @retval 0 on success.
+ * @retval Other value returned by the callback to stop.
+ */
+int latency_foreach(latency_cb_t cb, void *user_data);
+
+/** @brief Get the number of calls which were not measured.
+ *
+ * Calls are not measured when they are nested deeper than
+ * CONFIG_PROFILING_LATENCY_DEPTH or when the function table is full.
+ *
+ * @return Number of calls not measured since the last latency_clear().
+ */
+uint32_t latency_dropped_get(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_LATENCY_H_ */
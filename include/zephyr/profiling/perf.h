@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_PERF_H_
+#define ZEPHYR_INCLUDE_PROFILING_PERF_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup perf Perf
+ *  @ingroup os_services
+ *  @brief Sampling profiler
+ *
+ *  Perf samples the stack trace of the interrupted code from a timer.
+ *  @{
+ */
+
+/** @brief Callback called for each sample.
+ *
+ * @param thread Thread the sample was taken in, NULL if samples are not
+ * aggregated.
+ * @param count Number of identical samples.
+ * @param trace Return addresses, starting with the address where the sample
+ * was taken.
+ * @param length Number of return addresses.
+ * @param user_data User data.
+ *
+ * @retval 0 to continue with the next sample.
+ * @retval Other value to stop, returned by perf_foreach_sample().
+ */
+typedef int (*perf_sample_cb_t)(k_tid_t thread, uint32_t count, const uintptr_t *trace,
+				size_t length, void *user_data);
+
+/** @brief Start recording samples.
+ *
+ * Recording stops after @p duration, when the buffer is full or when
+ * perf_stop() is called.
+ *
+ * @param frequency Sampling frequency in Hz.
+ * @param duration Duration of the recording, K_FOREVER to record until
+ * perf_stop() is called.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the frequency is invalid.
+ * @retval -EINPROGRESS if perf is already recording.
+ * @retval -ENOBUFS if the buffer is full.
+ */
+int perf_start(uint32_t frequency, k_timeout_t duration);
+
+/** @brief Stop recording samples.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if perf is not recording.
+ */
+int perf_stop(void);
+
+/** @brief Check if perf is recording samples.
+ *
+ * @retval true if perf is recording.
+ * @retval false if perf is not recording.
+ */
+bool perf_is_running(void);
+
+/** @brief Discard the recorded samples.
+ *
+ * @retval 0 on success.
+ * @retval -EINPROGRESS if perf is recording.
+ */
+int perf_clear(void);
+
+/** @brief Iterate over the recorded samples.
+ *
+ * With CONFIG_PROFILING_PERF_AGGREGATE, the callback is called once for each
+ * thread and stack trace, with the number of samples. Otherwise, it is called
+ * for each sample. The samples can then be exported to a file or over the
+ * network, as the perf shell command does to the shell.
+ *
+ * @param cb Callback.
+ * @param user_data User data passed to the callback.
+ *
+ * @retval 0 on success.
+ * @retval -EINPROGRESS if perf is recording.
+ * @retval Other value returned by the callback to stop.
+ */
+int perf_foreach_sample(perf_sample_cb_t cb, void *user_data);
+
+/** @brief Get the number of dropped samples.
+ *
+ * With CONFIG_PROFILING_PERF_AGGREGATE, samples are dropped when their stack
+ * trace is too deep or when the table is full. Otherwise, recording stops when
+ * the buffer is full. Samples of a context the architecture cannot trace, such
+ * as an interrupt on Cortex-M, are always dropped.
+ *
+ * @return Number of dropped samples since the last perf_clear().
+ */
+uint32_t perf_dropped_get(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_PERF_H_ */
@@ -582,6 +582,10 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 #ifdef CONFIG_EVENTS
 	new_thread->no_wake_on_timeout = false;
 #endif /* CONFIG_EVENTS */
+#ifdef CONFIG_PROFILING_LATENCY
+	new_thread->latency.generation = 0U;
+	new_thread->latency.depth = 0U;
+#endif /* CONFIG_PROFILING_LATENCY */
 #ifdef CONFIG_THREAD_MONITOR
 	new_thread->entry.pEntry = entry;
 	new_thread->entry.parameter1 = p1;
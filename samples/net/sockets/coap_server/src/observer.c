@@ -21,27 +21,15 @@ static int send_notification_packet(struct coap_resource *resource,
 				    const struct sockaddr *addr,
 				    socklen_t addr_len,
 				    uint16_t age, uint16_t id,
-				    const uint8_t *token, uint8_t tkl,
-				    bool is_response)
+				    const uint8_t *token, uint8_t tkl)
 {
 	uint8_t data[CONFIG_COAP_SERVER_MESSAGE_SIZE];
 	struct coap_packet response;
 	char payload[14];
-	uint8_t type;
 	int r;
 
-	if (is_response) {
-		type = COAP_TYPE_ACK;
-	} else {
-		type = COAP_TYPE_CON;
-	}
-
-	if (!is_response) {
-		id = coap_next_id();
-	}
-
 	r = coap_packet_init(&response, data, sizeof(data),
-			     COAP_VERSION_1, type, tkl, token,
+			     COAP_VERSION_1, COAP_TYPE_ACK, tkl, token,
 			     COAP_RESPONSE_CODE_CONTENT, id);
 	if (r < 0) {
 		return r;
@@ -109,17 +97,7 @@ static int obs_get(struct coap_resource *resource,
 
 	return send_notification_packet(resource, addr, addr_len,
 					r == 0 ? resource->age : 0,
-					id, token, tkl, true);
-}
-
-static void obs_notify(struct coap_resource *resource,
-		       struct coap_observer *observer)
-{
-	send_notification_packet(resource,
-				 &observer->addr,
-				 sizeof(observer->addr),
-				 resource->age, 0,
-				 observer->token, observer->tkl, false);
+					id, token, tkl);
 }
 
 static const char * const obs_path[] = { "obs", NULL };
@@ -127,14 +105,50 @@ COAP_RESOURCE_DEFINE(obs, coap_server,
 {
 	.get = obs_get,
 	.path = obs_path,
-	.notify = obs_notify,
 });
 
 static void update_counter(struct k_work *work)
 {
-	obs_counter++;
+	uint8_t data[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet notification;
+	char payload[14];
+	int r;
 
-	coap_resource_notify(&obs);
+	obs_counter++;
 
 	k_work_reschedule(&obs_work, K_SECONDS(5));
+
+	if (sys_slist_is_empty(&obs.observers)) {
+		return;
+	}
+
+	/* Encoded once and sent to every observer with its own token */
+	r = coap_notification_init(&notification, &obs, data, sizeof(data),
+				   COAP_TYPE_CON, COAP_RESPONSE_CODE_CONTENT);
+	if (r < 0) {
+		return;
+	}
+
+	r = coap_append_option_int(&notification, COAP_OPTION_CONTENT_FORMAT,
+				   COAP_CONTENT_FORMAT_TEXT_PLAIN);
+	if (r < 0) {
+		return;
+	}
+
+	r = coap_packet_append_payload_marker(&notification);
+	if (r < 0) {
+		return;
+	}
+
+	r = snprintk(payload, sizeof(payload), "Counter: %d\n", obs_counter);
+	if (r < 0) {
+		return;
+	}
+
+	r = coap_packet_append_payload(&notification, (uint8_t *)payload, strlen(payload));
+	if (r < 0) {
+		return;
+	}
+
+	(void)coap_resource_send_notification(&obs, &notification, NULL);
 }
@@ -25,6 +25,17 @@ def test_shell_perf(dut: DeviceAdapter, shell: Shell):
     logger.info('send "perf printbuf" command')
     lines = shell.exec_command('perf printbuf')
     lines = lines[1:-1]
+    match = re.match(r"Perf stacks (\d+) dropped (\d+)", lines[0])
+    if match is not None:
+        length = int(match.group(1))
+        lines = lines[1:]
+        assert length != 0, '0 length'
+        assert length == len(lines), 'length dose not match with count of lines'
+        for line in lines:
+            # count, thread and at least one address
+            assert len(line.split()) >= 3, 'one of the stacks is too short'
+        return
+
     match = re.match(r"Perf buf length (\d+)", lines[0])
     assert match is not None, 'expected response not found'
     length = int(match.group(1))
@@ -265,6 +265,11 @@ def process_kconfigs(elf, database):
         database.add_kconfig("CONFIG_LOG_TIMESTAMP_64BIT",
                              kconfigs['CONFIG_LOG_TIMESTAMP_64BIT'])
 
+    # Messages in frames?
+    if "CONFIG_LOG_DICTIONARY_STREAM" in kconfigs:
+        database.add_kconfig("CONFIG_LOG_DICTIONARY_STREAM",
+                             kconfigs['CONFIG_LOG_DICTIONARY_STREAM'])
+
 
 def extract_logging_subsys_information(elf, database, string_mappings):
     """
@@ -21,6 +21,7 @@ import colorama
 from colorama import Fore
 
 from .log_parser import (LogParser, get_log_level_str_color, formalize_fmt_string)
+from .log_stream import LogStreamDecoder
 from .data_types import DataTypes
 
 
@@ -55,6 +56,18 @@ FMT_MSG_TIMESTAMP_64 = "Q"
 # Keep message types in sync with include/logging/log_output_dict.h
 MSG_TYPE_NORMAL = 0
 MSG_TYPE_DROPPED = 1
+MSG_TYPE_NORMAL_COMPACT = 2
+
+# Compact message header, used with CONFIG_LOG_DICTIONARY_STREAM:
+#
+# - type (uint8_t)
+# - domain in bits 0 to 3 and level in bits 4 to 7 (uint8_t)
+# - source ID (LEB128)
+# - timestamp shifted left by one bit, bit 0 set if it is the full
+#   timestamp, otherwise the difference with the previous one (LEB128)
+# - package length (LEB128)
+# - data length (LEB128)
+FMT_MSG_DOMAIN_LVL = "B"
 
 # Number of dropped messages
 FMT_DROPPED_CNT = "H"
@@ -88,6 +101,15 @@ class LogParserV3(LogParser):
         else:
             self.fmt_msg_timestamp = endian + FMT_MSG_TIMESTAMP_32
 
+        # Messages are in frames, which are decoded as they are received
+        if "CONFIG_LOG_DICTIONARY_STREAM" in self.database.get_kconfigs():
+            self.stream = LogStreamDecoder(self.is_big_endian)
+        else:
+            self.stream = None
+
+        # Timestamp of the previous compact message, None if unknown
+        self.timestamp = None
+
 
     def __get_string(self, arg, arg_offset, string_tbl):
         one_str = self.database.find_string(arg)
@@ -282,6 +304,58 @@ class LogParserV3(LogParser):
             domain_id = domain_lvl & 0x0F
             level = (domain_lvl >> 4) & 0x0F
 
+        return self.parse_msg_body(logdata, offset, (domain_id, level, source_id, timestamp),
+                                   pkg_len, data_len)
+
+
+    @staticmethod
+    def decode_leb128(logdata, offset):
+        """Decode an unsigned LEB128 value, return it with the offset after it"""
+        value = 0
+        shift = 0
+
+        while True:
+            byte = logdata[offset]
+            offset += 1
+
+            value |= (byte & 0x7F) << shift
+            shift += 7
+
+            if not byte & 0x80:
+                return value, offset
+
+
+    def parse_one_compact_msg(self, logdata, offset):
+        """Parse one log message with compact header and print the encoded message"""
+        domain_lvl = struct.unpack_from(FMT_MSG_DOMAIN_LVL, logdata, offset)[0]
+        offset += struct.calcsize(FMT_MSG_DOMAIN_LVL)
+
+        domain_id = domain_lvl & 0x0F
+        level = (domain_lvl >> 4) & 0x0F
+
+        source_id, offset = self.decode_leb128(logdata, offset)
+        timestamp, offset = self.decode_leb128(logdata, offset)
+        pkg_len, offset = self.decode_leb128(logdata, offset)
+        data_len, offset = self.decode_leb128(logdata, offset)
+
+        if timestamp & 1:
+            timestamp >>= 1
+        elif self.timestamp is not None:
+            timestamp = self.timestamp + (timestamp >> 1)
+        else:
+            # Relative to a message in a lost frame
+            timestamp = None
+
+        self.timestamp = timestamp
+
+        return self.parse_msg_body(logdata, offset, (domain_id, level, source_id, timestamp),
+                                   pkg_len, data_len)
+
+
+    def parse_msg_body(self, logdata, offset, msg_hdr, pkg_len, data_len):
+        """Parse package and data of one log message and print the encoded message"""
+        domain_id, level, source_id, timestamp = msg_hdr
+
         level_str, color = get_log_level_str_color(level)
         source_id_str = self.database.get_log_source_string(domain_id, source_id)
 
@@ -343,7 +417,8 @@ class LogParserV3(LogParser):
             print(f"{log_msg}", end='')
             log_prefix = ""
         else:
-            log_prefix = f"[{timestamp:>10}] <{level_str}> {source_id_str}: "
+            timestamp_str = "?" if timestamp is None else timestamp
+            log_prefix = f"[{timestamp_str:>10}] <{level_str}> {source_id_str}: "
             print(f"{color}%s%s{Fore.RESET}" % (log_prefix, log_msg))
 
         if data_len > 0:
@@ -356,6 +431,25 @@ class LogParserV3(LogParser):
 
     def parse_log_data(self, logdata, debug=False):
         """Parse binary log data and print the encoded log messages"""
+        if self.stream is None:
+            return self.parse_msgs(logdata)
+
+        # Data may end in the middle of a frame, which is then parsed on
+        # next call with the following data.
+        for lost, msg in self.stream.feed(logdata):
+            if lost > 0:
+                # Timestamps are relative to the previous message
+                self.timestamp = None
+                print(f"--- {lost} frames lost ---")
+
+            if not self.parse_msgs(msg):
+                return False
+
+        return True
+
+
+    def parse_msgs(self, logdata):
+        """Parse binary log messages and print them"""
         offset = 0
 
         while offset < len(logdata):
@@ -376,6 +470,13 @@ class LogParserV3(LogParser):
 
                 offset = ret
 
+            elif msg_type == MSG_TYPE_NORMAL_COMPACT:
+                ret = self.parse_one_compact_msg(logdata, offset)
+                if ret is None:
+                    return False
+
+                offset = ret
+
             else:
                 logger.error("------ Unknown message type: %s", msg_type)
                 return False
@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Frame decoder for the dictionary-based log stream
+
+With CONFIG_LOG_DICTIONARY_STREAM, each log message is sent in a frame.
+This extracts the messages from the frames, which may be received in
+arbitrary chunks, skipping corrupted data and counting lost frames.
+"""
+
+import binascii
+import struct
+
+# Need to keep sync with struct log_dict_output_frame_hdr_t in
+# include/zephyr/logging/log_output_dict.h.
+#
+# struct log_dict_output_frame_hdr_t {
+#     uint8_t sof[2];
+#     uint16_t seq;
+#     uint16_t len;
+# } __packed;
+#
+# The frame header is followed by the message and a CRC-16/CCITT-FALSE of
+# the sequence number, the length and the message.
+FRAME_SOF = b"\x5a\x4c"
+FMT_FRAME_HDR = "HH"
+FMT_FRAME_CRC = "H"
+
+FRAME_SEQ_MOD = 1 << 16
+
+
+class LogStreamDecoder:
+    """Incremental decoder of the frames of the dictionary-based log stream"""
+    def __init__(self, is_big_endian):
+        endian = ">" if is_big_endian else "<"
+
+        self.fmt_frame_hdr = endian + FMT_FRAME_HDR
+        self.fmt_frame_crc = endian + FMT_FRAME_CRC
+        self.hdr_len = len(FRAME_SOF) + struct.calcsize(self.fmt_frame_hdr)
+        self.crc_len = struct.calcsize(self.fmt_frame_crc)
+
+        self.buf = bytearray()
+        self.next_seq = None
+
+        # Statistics
+        self.frames = 0
+        self.lost_frames = 0
+        self.corrupted_bytes = 0
+
+
+    def check_frame(self, pos):
+        """
+        Return the length of the frame at the position in the buffer,
+        0 if the frame is incomplete or None if there is no valid frame.
+        """
+        if len(self.buf) < pos + self.hdr_len:
+            return 0
+
+        msg_len = struct.unpack_from(self.fmt_frame_hdr, self.buf, pos + len(FRAME_SOF))[1]
+        frame_len = self.hdr_len + msg_len + self.crc_len
+
+        if len(self.buf) < pos + frame_len:
+            return 0
+
+        crc = struct.unpack_from(self.fmt_frame_crc, self.buf, pos + self.hdr_len + msg_len)[0]
+        if binascii.crc_hqx(self.buf[pos + len(FRAME_SOF):pos + self.hdr_len + msg_len],
+                            0xFFFF) != crc:
+            return None
+
+        return frame_len
+
+
+    def resync(self):
+        """
+        Look for a valid frame after the incomplete one at the start of the
+        buffer, whose length may be corrupted, and drop the data before it.
+        Return True if such a frame was found.
+        """
+        pos = self.buf.find(FRAME_SOF, 1)
+
+        while pos > 0:
+            if self.check_frame(pos):
+                self.corrupted_bytes += pos
+                del self.buf[:pos]
+                return True
+
+            pos = self.buf.find(FRAME_SOF, pos + 1)
+
+        return False
+
+
+    def feed(self, data):
+        """
+        Add received data to the stream and return a list of tuples
+        (number of frames lost before the message, message), for each
+        message of the complete frames received so far.
+        """
+        self.buf += data
+        msgs = []
+
+        while True:
+            idx = self.buf.find(FRAME_SOF)
+            if idx < 0:
+                # Keep a possible first byte of the marker
+                keep = 1 if self.buf[-1:] == FRAME_SOF[:1] else 0
+                self.corrupted_bytes += len(self.buf) - keep
+                del self.buf[:len(self.buf) - keep]
+                break
+
+            if idx > 0:
+                self.corrupted_bytes += idx
+                del self.buf[:idx]
+
+            frame_len = self.check_frame(0)
+            if frame_len is None:
+                # Not a frame, or a corrupted one: look for the next marker
+                self.corrupted_bytes += 1
+                del self.buf[:1]
+                continue
+
+            if frame_len == 0:
+                if self.resync():
+                    continue
+                break
+
+            seq, msg_len = struct.unpack_from(self.fmt_frame_hdr, self.buf, len(FRAME_SOF))
+
+            # Sequence number back to 0 is taken as a target restart
+            lost = 0
+            if self.next_seq is not None and seq != 0:
+                lost = (seq - self.next_seq) % FRAME_SEQ_MOD
+
+            self.next_seq = (seq + 1) % FRAME_SEQ_MOD
+            self.frames += 1
+            self.lost_frames += lost
+
+            msgs.append((lost, bytes(self.buf[self.hdr_len:self.hdr_len + msg_len])))
+            del self.buf[:frame_len]
+
+        return msgs
@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Live Log Parser for Dictionary-based Logging
+
+This uses the JSON database file to decode the binary log data
+received from a serial port, a TCP connection (e.g. RTT telnet
+server), UDP datagrams (network backend), a file being written
+(e.g. file system backend) or the standard input, and prints the
+log messages as they arrive.
+
+With CONFIG_LOG_DICTIONARY_STREAM, corrupted data is skipped and
+lost frames are reported.
+"""
+
+import argparse
+import logging
+import socket
+import sys
+import time
+
+import parserlib
+
+LOGGER_FORMAT = "%(message)s"
+logger = logging.getLogger("parser")
+
+READ_SIZE = 4096
+POLL_INTERVAL = 0.2
+
+
+def parse_args():
+    """Parse command line arguments"""
+    argparser = argparse.ArgumentParser(allow_abbrev=False)
+
+    argparser.add_argument("dbfile", help="Dictionary Logging Database file")
+    argparser.add_argument("source",
+                           help="Log data source: serial:<port>[:<baudrate>], "
+                                "tcp:<host>:<port>, udp:[<host>:]<port>, "
+                                "file:<path> or - for standard input")
+    argparser.add_argument("--debug", action="store_true",
+                           help="Print extra debugging information")
+
+    return argparser.parse_args()
+
+
+def read_serial(port, baudrate):
+    """Read data from a serial port"""
+    import serial  # pylint: disable=import-outside-toplevel
+
+    with serial.Serial(port, baudrate, timeout=POLL_INTERVAL) as ser:
+        while True:
+            data = ser.read(max(1, ser.in_waiting))
+            if data:
+                yield data
+
+
+def read_tcp(host, port):
+    """Read data from a TCP connection"""
+    with socket.create_connection((host, port)) as sock:
+        while True:
+            data = sock.recv(READ_SIZE)
+            if not data:
+                return
+            yield data
+
+
+def read_udp(host, port):
+    """Read data from UDP datagrams"""
+    with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as sock:
+        sock.bind((host, port))
+        while True:
+            yield sock.recv(65535)
+
+
+def read_file(path):
+    """Read data from a file, following data appended to it"""
+    with open(path, "rb") as logfile:
+        while True:
+            data = logfile.read(READ_SIZE)
+            if data:
+                yield data
+            else:
+                time.sleep(POLL_INTERVAL)
+
+
+def read_stdin():
+    """Read data from the standard input"""
+    while True:
+        data = sys.stdin.buffer.read1(READ_SIZE)
+        if not data:
+            return
+        yield data
+
+
+def open_source(source):
+    """Return a generator of the data received from the source"""
+    kind, _, addr = source.partition(":")
+
+    if source == "-":
+        return read_stdin()
+
+    if kind == "serial":
+        port, _, baudrate = addr.partition(":")
+        return read_serial(port, int(baudrate) if baudrate else 115200)
+
+    if kind == "tcp":
+        host, _, port = addr.rpartition(":")
+        return read_tcp(host, int(port))
+
+    if kind == "udp":
+        host, _, port = addr.rpartition(":")
+        return read_udp(host or "0.0.0.0", int(port))
+
+    if kind == "file":
+        return read_file(addr)
+
+    logger.error("ERROR: invalid log data source: %s, exiting...", source)
+    sys.exit(1)
+
+
+def main():
+    """Main function of live log parser"""
+    args = parse_args()
+
+    logging.basicConfig(format=LOGGER_FORMAT)
+    if args.debug:
+        logger.setLevel(logging.DEBUG)
+    else:
+        logger.setLevel(logging.INFO)
+
+    # The same parser is used for all the data, as frames may be split
+    # across reads.
+    log_parser = parserlib.get_log_parser(args.dbfile, logger)
+    if log_parser is None:
+        sys.exit(1)
+
+    try:
+        for data in open_source(args.source):
+            parserlib.parse_data(log_parser, data, logger)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    stream = getattr(log_parser, "stream", None)
+    if stream is not None:
+        logger.debug("# Frames: %d, lost: %d, corrupted bytes: %d",
+                     stream.frames, stream.lost_frames, stream.corrupted_bytes)
+
+
+if __name__ == "__main__":
+    main()
@@ -50,6 +50,12 @@ def main():
     else:
         logger.setLevel(logging.INFO)
 
+    # The same parser is used for all the data, as a framed log stream
+    # may be split across reads.
+    log_parser = parserlib.get_log_parser(args.dbfile, logger)
+    if log_parser is None:
+        sys.exit(1)
+
     # Parse the log every second from serial port
     with serial.Serial(args.serialPort, args.baudrate) as ser:
         ser.timeout = 2
@@ -57,7 +63,7 @@ def main():
             size = ser.inWaiting()
             if size:
                 data = ser.read(size)
-                parserlib.parser(data, args.dbfile, logger)
+                parserlib.parse_data(log_parser, data, logger)
             time.sleep(1)
 
 if __name__ == "__main__":
@@ -19,8 +19,8 @@ import dictionary_parser
 from dictionary_parser.log_database import LogDatabase
 
 
-def parser(logdata, dbfile, logger):
-    """function of serial parser"""
+def get_log_parser(dbfile, logger):
+    """Get the parser matching the database, which keeps the state of a log stream"""
     # Read from database file
     database = LogDatabase.read_json_database(dbfile)
 
@@ -31,10 +31,6 @@ def parser(logdata, dbfile, logger):
         logger.error("ERROR: Cannot open database file:  exiting...")
         sys.exit(1)
 
-    if logdata is None:
-        logger.error("ERROR: cannot read log from file:  exiting...")
-        sys.exit(1)
-
     log_parser = dictionary_parser.get_parser(database)
     if log_parser is not None:
         logger.debug("# Build ID: %s", database.get_build_id())
@@ -43,10 +39,26 @@ def parser(logdata, dbfile, logger):
             logger.debug("# Endianness: Little")
         else:
             logger.debug("# Endianness: Big")
-
-        ret = log_parser.parse_log_data(logdata)
-        if not ret:
-            logger.error("ERROR: there were error(s) parsing log data")
-            sys.exit(1)
     else:
         logger.error("ERROR: Cannot find a suitable parser matching database version!")
+
+    return log_parser
+
+
+def parse_data(log_parser, logdata, logger):
+    """Parse log data with a parser returned by get_log_parser()"""
+    if logdata is None:
+        logger.error("ERROR: cannot read log from file:  exiting...")
+        sys.exit(1)
+
+    ret = log_parser.parse_log_data(logdata)
+    if not ret:
+        logger.error("ERROR: there were error(s) parsing log data")
+        sys.exit(1)
+
+
+def parser(logdata, dbfile, logger):
+    """function of serial parser"""
+    log_parser = get_log_parser(dbfile, logger)
+    if log_parser is not None:
+        parse_data(log_parser, logdata, logger)
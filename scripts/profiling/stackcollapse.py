@@ -10,7 +10,9 @@ Stack compressor for FlameGraph
 
 This translate stack samples captured by perf subsystem into format
 used by flamegraph.pl. Translation uses .elf file to get function names
-from addresses
+from addresses. Samples aggregated on target with
+CONFIG_PROFILING_PERF_AGGREGATE are printed with their count, under a
+root frame for their thread.
 
 Usage:
     ./script/perf/stackcollapse.py <file with perf printbuf output> <ELF file>
@@ -35,31 +37,51 @@ def addr_to_sym(addr, elf):
     return "[unknown]"
 
 
+def collapse_trace(addrs, elf):
+    func_trace = reversed(list(map(lambda a: addr_to_sym(a, elf), addrs)))
+    prev_func = next(func_trace)
+    line = prev_func
+    # merge dublicate functions
+    for func in func_trace:
+        if prev_func != func:
+            prev_func = func
+            line += ";" + func
+
+    return line
+
+
 def collapse(buf, elf):
     while buf:
         count, = struct.unpack_from(">Q", buf)
         assert count > 0
         addrs = struct.unpack_from(f">{count}Q", buf, 8)
 
-        func_trace = reversed(list(map(lambda a: addr_to_sym(a, elf), addrs)))
-        prev_func = next(func_trace)
-        line = prev_func
-        # merge dublicate functions
-        for func in func_trace:
-            if prev_func != func:
-                prev_func = func
-                line += ";" + func
-
-        print(line, 1)
+        print(collapse_trace(addrs, elf), 1)
         buf = buf[8 + 8 * count:]
 
 
+def collapse_stacks(lines, elf):
+    for line in lines:
+        fields = line.split()
+        count = int(fields[0], 16)
+        thread = int(fields[1], 16)
+        addrs = [int(addr, 16) for addr in fields[2:]]
+
+        print(f"[thread 0x{thread:x}];" + collapse_trace(addrs, elf), count)
+
+
 if __name__ == "__main__":
     elf = ELFFile(open(sys.argv[2], "rb"))
     with open(sys.argv[1], "r") as f:
         inp = f.read()
 
     lines = inp.splitlines()
+    stacks = re.match(r"Perf stacks (\d+) dropped (\d+)", lines[0])
+    if stacks:
+        assert int(stacks.group(1)) == len(lines) - 1
+        collapse_stacks(lines[1:], elf)
+        sys.exit(0)
+
     assert int(re.match(r"Perf buf length (\d+)", lines[0]).group(1)) == len(lines) - 1
     buf = binascii.unhexlify("".join(lines[1:]))
     collapse(buf, elf)
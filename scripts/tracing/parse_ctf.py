@@ -16,8 +16,17 @@ Generate trace using samples/subsys/tracing for example:
     cp build/channel0_0 ctf/
     cp subsys/tracing/ctf/tsdl/metadata ctf/
     ./scripts/tracing/parse_ctf.py -t ctf
+
+With CONFIG_TRACING_PER_CPU_BUFFERS, the captured data is made of packets of
+the streams of the CPUs. Capture it outside of the trace directory and split
+it to one stream per CPU before parsing:
+
+    ./scripts/tracing/parse_ctf.py -t ctf -s channel0_0
 """
 
+import os
+import re
+import struct
 import sys
 import datetime
 import colorama
@@ -28,6 +37,91 @@ try:
 except ImportError:
     sys.exit("Missing dependency: You need to install python bindings of babeltrace.")
 
+# Need to keep sync with struct ctf_packet_header in subsys/tracing/ctf/ctf_top.c
+#
+# struct ctf_packet_header {
+#     uint32_t magic;
+#     uint8_t stream_instance_id;
+#     uint32_t timestamp_begin;
+#     uint32_t timestamp_end;
+#     uint32_t content_size;
+#     uint32_t packet_size;
+#     uint8_t cpu_id;
+# } __packed;
+FMT_PACKET_HEADER = "<IBIIIIB"
+CTF_PACKET_MAGIC = 0xC1FC1FC1
+
+# Declarations of the packets of the per-CPU streams, added to the metadata.
+# Timestamps are in nanoseconds and wrap around on 32 bits, babeltrace
+# handles the wrap around as long as the streams have events often enough.
+PACKET_TSDL = """clock {
+	name = monotonic;
+	freq = 1000000000;
+};
+
+typealias integer { size = 32; align = 8; signed = false; map = clock.monotonic.value; } := uint32_clock_monotonic_t;
+
+struct packet_header {
+	uint32_t magic;
+	uint8_t stream_instance_id;
+};
+
+struct packet_context {
+	uint32_clock_monotonic_t timestamp_begin;
+	uint32_clock_monotonic_t timestamp_end;
+	uint32_t content_size;
+	uint32_t packet_size;
+	uint8_t cpu_id;
+};
+
+"""
+
+def add_packet_metadata(metadata):
+    """Add the declarations of the packets of the per-CPU streams"""
+    if "packet.header" in metadata:
+        return metadata
+
+    metadata = metadata.replace("struct event_header {", PACKET_TSDL + "struct event_header {", 1)
+    metadata = re.sub(r"(struct event_header \{\s*)uint32_t timestamp;",
+                      r"\1uint32_clock_monotonic_t timestamp;", metadata, count=1)
+    metadata = re.sub(r"(\ntrace \{.*?)(\n\};)",
+                      r"\1\n\tpacket.header := struct packet_header;\2",
+                      metadata, count=1, flags=re.DOTALL)
+    metadata = re.sub(r"(\nstream \{.*?)(\n\};)",
+                      r"\1\n\tpacket.context := struct packet_context;\2",
+                      metadata, count=1, flags=re.DOTALL)
+    return metadata
+
+def split_streams(trace, stream_file):
+    """Split the packets of the per-CPU streams to one file per CPU"""
+    with open(stream_file, "rb") as f:
+        data = f.read()
+
+    streams = {}
+    hdr_len = struct.calcsize(FMT_PACKET_HEADER)
+    pos = 0
+
+    while pos + hdr_len <= len(data):
+        magic, _, _, _, _, packet_size, cpu = struct.unpack_from(FMT_PACKET_HEADER, data, pos)
+        packet_len = packet_size // 8
+
+        if magic != CTF_PACKET_MAGIC or packet_len < hdr_len or pos + packet_len > len(data):
+            print(f"Invalid or truncated packet at offset {pos}, ignoring the rest of the data")
+            break
+
+        streams.setdefault(cpu, bytearray()).extend(data[pos:pos + packet_len])
+        pos += packet_len
+
+    for cpu, stream in streams.items():
+        with open(os.path.join(trace, f"channel0_{cpu}"), "wb") as f:
+            f.write(stream)
+
+    metadata_file = os.path.join(trace, "metadata")
+    with open(metadata_file, "r") as f:
+        metadata = f.read()
+    with open(metadata_file, "w") as f:
+        f.write(add_packet_metadata(metadata))
+
 def parse_args():
     parser = argparse.ArgumentParser(
             description=__doc__,
@@ -35,6 +129,9 @@ def parse_args():
     parser.add_argument("-t", "--trace",
             required=True,
             help="tracing data (directory with metadata and trace file)")
+    parser.add_argument("-s", "--split",
+            help="data captured with per-CPU buffers, to split to one stream per CPU "
+                 "in the tracing data directory before parsing")
     args = parser.parse_args()
     return args
 
@@ -43,6 +140,9 @@ def main():
 
     args = parse_args()
 
+    if args.split:
+        split_streams(args.trace, args.split)
+
     msg_it = bt2.TraceCollectionMessageIterator(args.trace)
     last_event_ns_from_origin = None
     timeline = []
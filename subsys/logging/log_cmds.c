@@ -429,6 +429,148 @@ static int cmd_log_mem(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+static int rate_limit_arg_get(const struct shell *sh, const char *str, unsigned long min,
+			      uint16_t *val)
+{
+	unsigned long tmp;
+	int err = 0;
+
+	tmp = shell_strtoul(str, 0, &err);
+	if ((err != 0) || (tmp < min) || (tmp > UINT16_MAX)) {
+		shell_error(sh, "Invalid value: %s", str);
+		return -EINVAL;
+	}
+
+	*val = (uint16_t)tmp;
+
+	return 0;
+}
+
+static void rate_limit_update(struct log_rate_limit_config *config, const uint16_t *val)
+{
+	config->rate = val[0];
+	config->burst = val[1];
+}
+
+static void sample_update(struct log_rate_limit_config *config, const uint16_t *val)
+{
+	config->sample = val[0];
+}
+
+static void duplicates_update(struct log_rate_limit_config *config, const uint16_t *val)
+{
+	config->duplicates = val[0] != 0;
+}
+
+/* Arguments following the values are interpreted as module names, all modules
+ * if there are none.
+ */
+static int rate_limit_modules_set(const struct shell *sh, size_t argc, char **argv,
+				  size_t first,
+				  void (*update)(struct log_rate_limit_config *config,
+						 const uint16_t *val),
+				  const uint16_t *val)
+{
+	bool all = argc == first;
+	int cnt = all ? log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID) : argc - first;
+
+	for (int i = 0; i < cnt; i++) {
+		int id = all ? i : module_id_get(argv[first + i]);
+		struct log_rate_limit_config config;
+		int err;
+
+		if (id < 0) {
+			shell_error(sh, "%s: unknown source name.", argv[first + i]);
+			continue;
+		}
+
+		err = log_rate_limit_get(id, &config);
+		if (err == 0) {
+			update(&config, val);
+			err = log_rate_limit_set(id, &config);
+		}
+
+		if (err < 0) {
+			shell_error(sh, "Failed to set rate limit (err %d)", err);
+			return -ENOEXEC;
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_log_rate_limit(const struct shell *sh, size_t argc, char **argv)
+{
+	uint16_t val[2];
+
+	if ((rate_limit_arg_get(sh, argv[1], 0, &val[0]) < 0) ||
+	    (rate_limit_arg_get(sh, argv[2], 1, &val[1]) < 0)) {
+		return -ENOEXEC;
+	}
+
+	return rate_limit_modules_set(sh, argc, argv, 3, rate_limit_update, val);
+}
+
+static int cmd_log_sample(const struct shell *sh, size_t argc, char **argv)
+{
+	uint16_t val;
+
+	if (rate_limit_arg_get(sh, argv[1], 1, &val) < 0) {
+		return -ENOEXEC;
+	}
+
+	return rate_limit_modules_set(sh, argc, argv, 2, sample_update, &val);
+}
+
+static int cmd_log_duplicates(const struct shell *sh, size_t argc, char **argv)
+{
+	uint16_t val;
+
+	if (strcmp(argv[1], "on") == 0) {
+		val = 1;
+	} else if (strcmp(argv[1], "off") == 0) {
+		val = 0;
+	} else {
+		shell_error(sh, "Invalid value: %s", argv[1]);
+		return -ENOEXEC;
+	}
+
+	return rate_limit_modules_set(sh, argc, argv, 2, duplicates_update, &val);
+}
+
+static int cmd_log_rate_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t modules_cnt = log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID);
+
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "%-40s | rate  | burst | sample | dup | logged     | dropped    "
+		      "| sampled    | repeated\r\n",
+		      "module_name");
+	shell_fprintf(sh, SHELL_NORMAL,
+	      "----------------------------------------------------------"
+	      "-------------------------------------------------------------------\r\n");
+
+	for (int16_t i = 0U; i < modules_cnt; i++) {
+		struct log_rate_limit_config config;
+		struct log_rate_limit_stats stats;
+
+		if ((log_rate_limit_get(i, &config) < 0) ||
+		    (log_rate_limit_stats_get(i, &stats) < 0)) {
+			shell_error(sh, "Failed to get rate limit");
+			return -ENOEXEC;
+		}
+
+		shell_fprintf(sh, SHELL_NORMAL,
+			      "%-40s | %-5u | %-5u | %-6u | %-3s | %-10u | %-10u | %-10u | %u\r\n",
+			      log_source_name_get(Z_LOG_LOCAL_DOMAIN_ID, i),
+			      config.rate, config.burst, config.sample,
+			      config.duplicates ? "on" : "off", stats.logged,
+			      stats.rate_dropped, stats.sampled_out, stats.repeated);
+	}
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_backend,
 	SHELL_CMD_ARG(disable, &dsub_module_name,
 		  "'log disable <module_0> .. <module_n>' disables logs in "
@@ -488,6 +630,22 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		       cmd_log_self_status),
 	SHELL_COND_CMD(CONFIG_LOG_MODE_DEFERRED, mem, NULL, "Logger memory usage",
 		       cmd_log_mem),
+	SHELL_COND_CMD_ARG(CONFIG_LOG_RATE_LIMIT, rate_limit, &dsub_module_name,
+			   "'log rate_limit <rate> <burst> <module_0> .. <module_n>' limits "
+			   "specified modules (all if no modules specified) to <rate> messages "
+			   "per second, 0 for no limit.",
+			   cmd_log_rate_limit, 3, 255),
+	SHELL_COND_CMD_ARG(CONFIG_LOG_RATE_LIMIT, sample, &dsub_module_name,
+			   "'log sample <n> <module_0> .. <module_n>' logs 1 in <n> messages "
+			   "of specified modules (all if no modules specified).",
+			   cmd_log_sample, 2, 255),
+	SHELL_COND_CMD_ARG(CONFIG_LOG_RATE_LIMIT, duplicates, &dsub_module_name,
+			   "'log duplicates <on|off> <module_0> .. <module_n>' suppresses "
+			   "duplicate messages in specified modules (all if no modules "
+			   "specified).",
+			   cmd_log_duplicates, 2, 255),
+	SHELL_COND_CMD(CONFIG_LOG_RATE_LIMIT, rate_stats, NULL,
+		       "Rate limits and statistics of modules", cmd_log_rate_stats),
 	SHELL_COND_CMD(CONFIG_LOG_FRONTEND, FRONTEND_NAME, &sub_log_backend,
 		"Frontend control", NULL),
 	SHELL_SUBCMD_SET_END);
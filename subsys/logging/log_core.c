@@ -116,21 +116,53 @@ static atomic_t unordered_cnt;
 static uint64_t last_failure_report;
 static struct k_spinlock process_lock;
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+#define LOG_CPU_BUFFERS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define LOG_CPU_BUFFERS 1
+#endif
+
 static STRUCT_SECTION_ITERABLE(log_msg_ptr, log_msg_ptr);
 static STRUCT_SECTION_ITERABLE_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer);
 static struct mpsc_pbuf_buffer *curr_log_buffer;
 
+#if LOG_CPU_BUFFERS > 1
+/* Buffers of the CPUs other than the first one, which uses log_buffer. Being
+ * in the same sections as the buffers dedicated to links, messages are
+ * claimed from them in timestamp order.
+ */
+static STRUCT_SECTION_ITERABLE_ARRAY(log_msg_ptr, log_cpu_msg_ptr, LOG_CPU_BUFFERS - 1);
+static STRUCT_SECTION_ITERABLE_ARRAY_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer,
+					       log_cpu_buffer, LOG_CPU_BUFFERS - 1);
+#endif
+
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+static atomic_t cpu_dropped_cnt[LOG_CPU_BUFFERS];
+#endif
+
 #ifdef CONFIG_MPSC_PBUF
+/* Each buffer is rounded down so that all of them start aligned for messages. */
+#define LOG_CPU_BUFFER_WLEN \
+	(ROUND_DOWN(CONFIG_LOG_BUFFER_SIZE / LOG_CPU_BUFFERS, Z_LOG_MSG_ALIGNMENT) / sizeof(int))
+
+BUILD_ASSERT(LOG_CPU_BUFFER_WLEN > 0, "CONFIG_LOG_BUFFER_SIZE too small for the CPU buffers");
+
 static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
-	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+	buf32[LOG_CPU_BUFFERS][LOG_CPU_BUFFER_WLEN];
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+static void cpu_notify_drop(const struct mpsc_pbuf_buffer *buffer,
+			    const union mpsc_pbuf_generic *item);
+#else
 static void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
 			      const union mpsc_pbuf_generic *item);
+#endif
 
 static const struct mpsc_pbuf_buffer_config mpsc_config = {
-	.buf = (uint32_t *)buf32,
-	.size = ARRAY_SIZE(buf32),
-	.notify_drop = z_log_notify_drop,
+	.buf = (uint32_t *)buf32[0],
+	.size = ARRAY_SIZE(buf32[0]),
+	.notify_drop = COND_CODE_1(CONFIG_LOG_PER_CPU_BUFFERS,
+				   (cpu_notify_drop), (z_log_notify_drop)),
 	.get_wlen = log_msg_generic_get_wlen,
 	.flags = (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
 		  MPSC_PBUF_MODE_OVERWRITE : 0) |
@@ -289,6 +321,10 @@ void log_core_init(void)
 		z_log_runtime_filters_init();
 	}
 
+	if (IS_ENABLED(CONFIG_LOG_RATE_LIMIT)) {
+		z_log_rate_limit_init();
+	}
+
 	STRUCT_SECTION_FOREACH(log_backend, backend) {
 		uint32_t id;
 		/* As first slot in filtering mask is reserved, backend ID has offset.*/
@@ -620,8 +656,60 @@ uint32_t z_vrfy_log_buffered_cnt(void)
 #include <zephyr/syscalls/log_buffered_cnt_mrsh.c>
 #endif
 
+static struct mpsc_pbuf_buffer *cpu_buffer(unsigned int cpu)
+{
+#if LOG_CPU_BUFFERS > 1
+	if (cpu > 0) {
+		return &log_cpu_buffer[cpu - 1];
+	}
+#else
+	ARG_UNUSED(cpu);
+#endif
+
+	return &log_buffer;
+}
+
+static unsigned int curr_cpu(void)
+{
+	unsigned int key;
+	unsigned int cpu;
+
+	if (LOG_CPU_BUFFERS == 1) {
+		return 0;
+	}
+
+	/* The thread may migrate afterwards. Its messages then go to the buffer
+	 * of another CPU, which is correct, only contended.
+	 */
+	key = arch_irq_lock();
+	cpu = CPU_ID;
+	arch_irq_unlock(key);
+
+	return cpu;
+}
+
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+static void cpu_notify_drop(const struct mpsc_pbuf_buffer *buffer,
+			    const union mpsc_pbuf_generic *item)
+{
+	ARG_UNUSED(item);
+
+	/* Messages in the buffer of a CPU were logged from that CPU. */
+	atomic_inc(&cpu_dropped_cnt[(buffer->buf - (uint32_t *)buf32[0]) /
+				    ARRAY_SIZE(buf32[0])]);
+	z_log_dropped(true);
+}
+#endif
+
 void z_log_dropped(bool buffered)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	if (!buffered) {
+		/* Message could not be allocated in the buffer of this CPU. */
+		atomic_inc(&cpu_dropped_cnt[curr_cpu()]);
+	}
+#endif
+
 	atomic_inc(&dropped_cnt);
 	if (buffered) {
 		atomic_dec(&buffered_cnt);
@@ -646,7 +734,13 @@ bool z_log_dropped_pending(void)
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
-	mpsc_pbuf_init(&log_buffer, &mpsc_config);
+	for (unsigned int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = (uint32_t *)buf32[i];
+		mpsc_pbuf_init(cpu_buffer(i), &config);
+	}
+
 	curr_log_buffer = &log_buffer;
 #endif
 }
@@ -666,7 +760,23 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(cpu_buffer(curr_cpu()), wlen);
+}
+
+/* Get the buffer in which a message was allocated. */
+static struct mpsc_pbuf_buffer *msg_buffer(const struct log_msg *msg)
+{
+#if defined(CONFIG_MPSC_PBUF) && (LOG_CPU_BUFFERS > 1)
+	ptrdiff_t offset = (const uint32_t *)msg - (const uint32_t *)buf32[0];
+
+	if (offset >= 0 && offset < ARRAY_SIZE(buf32) * ARRAY_SIZE(buf32[0])) {
+		return cpu_buffer(offset / ARRAY_SIZE(buf32[0]));
+	}
+#else
+	ARG_UNUSED(msg);
+#endif
+
+	return &log_buffer;
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -698,7 +808,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_buffer(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -785,7 +895,7 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || LOG_CPU_BUFFERS > 1) && len > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -820,7 +930,7 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if ((!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && LOG_CPU_BUFFERS == 1) || (len == 1)) {
 		return msg_pending(&log_buffer);
 	}
 
@@ -900,7 +1010,17 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
-	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+	*buf_size = 0;
+	*usage = 0;
+
+	for (unsigned int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		uint32_t cpu_size;
+		uint32_t cpu_usage;
+
+		mpsc_pbuf_get_utilization(cpu_buffer(i), &cpu_size, &cpu_usage);
+		*buf_size += cpu_size;
+		*usage += cpu_usage;
+	}
 
 	return 0;
 }
@@ -913,7 +1033,41 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
-	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+	*max = 0;
+
+	/* With per-CPU buffers, the sum of the maximum usage of each buffer. */
+	for (unsigned int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		uint32_t cpu_max;
+		int err;
+
+		err = mpsc_pbuf_get_max_utilization(cpu_buffer(i), &cpu_max);
+		if (err < 0) {
+			return err;
+		}
+
+		*max += cpu_max;
+	}
+
+	return 0;
+}
+
+int log_cpu_dropped_get(unsigned int cpu, uint32_t *dropped)
+{
+	__ASSERT_NO_MSG(dropped != NULL);
+
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	if (cpu >= LOG_CPU_BUFFERS) {
+		return -EINVAL;
+	}
+
+	*dropped = atomic_get(&cpu_dropped_cnt[cpu]);
+
+	return 0;
+#else
+	ARG_UNUSED(cpu);
+
+	return -ENOTSUP;
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
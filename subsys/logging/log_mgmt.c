@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log_internal.h>
 #include <zephyr/logging/log_ctrl.h>
 #include <zephyr/internal/syscall_handler.h>
@@ -379,6 +380,262 @@ int log_source_id_get(const char *name)
 	return -1;
 }
 
+#ifdef CONFIG_LOG_RATE_LIMIT
+/* Rate limits are checked for every message, from any context, so each source
+ * has its own lock.
+ */
+#define RATE_LIMIT_TOKEN 1000U
+
+static void rate_limit_report_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(rate_limit_report_work, rate_limit_report_handler);
+
+BUILD_ASSERT(!IS_ENABLED(CONFIG_64BIT) || ((sizeof(struct log_source_dynamic_data) % 8) == 0),
+	     "Dynamic data size must be a multiple of 8 bytes");
+
+static struct log_source_rate_limit *rate_limit_get(int16_t source_id)
+{
+	if ((source_id < 0) || (source_id >= z_log_sources_count())) {
+		return NULL;
+	}
+
+	return &TYPE_SECTION_START(log_dynamic)[source_id].rate_limit;
+}
+
+static void rate_limit_reset(struct log_source_rate_limit *rl, uint32_t now)
+{
+	rl->sample_cnt = 0;
+	rl->tokens = rl->config.burst * RATE_LIMIT_TOKEN;
+	rl->refill = now;
+}
+
+static void rate_limit_refill(struct log_source_rate_limit *rl, uint32_t now)
+{
+	uint32_t max = rl->config.burst * RATE_LIMIT_TOKEN;
+	uint64_t tokens = rl->tokens + (uint64_t)(now - rl->refill) * rl->config.rate;
+
+	rl->tokens = MIN(tokens, max);
+	rl->refill = now;
+}
+
+void z_log_rate_limit_init(void)
+{
+	for (int16_t i = 0; i < z_log_sources_count(); i++) {
+		struct log_source_rate_limit *rl = rate_limit_get(i);
+
+		*rl = (struct log_source_rate_limit) {
+			.config = {
+				.rate = CONFIG_LOG_RATE_LIMIT_DEFAULT_RATE,
+				.burst = CONFIG_LOG_RATE_LIMIT_DEFAULT_BURST,
+				.sample = CONFIG_LOG_RATE_LIMIT_DEFAULT_SAMPLE,
+				.duplicates = IS_ENABLED(CONFIG_LOG_RATE_LIMIT_DUPLICATES),
+			},
+		};
+		/* System clock is not running yet, the tokens are refilled up to
+		 * the burst on the first message anyway.
+		 */
+		rate_limit_reset(rl, 0);
+	}
+}
+
+bool z_log_rate_limit_check(const void *source, uint32_t key,
+			    uint32_t *dropped, uint32_t *repeated)
+{
+	struct log_source_dynamic_data *dynamic = (struct log_source_dynamic_data *)source;
+	struct log_source_rate_limit *rl;
+	k_spinlock_key_t lock_key;
+	bool accept = true;
+	bool report = false;
+	uint32_t now;
+
+	/* Source pointer may come from user mode, only sources of the local
+	 * domain are limited.
+	 */
+	if ((dynamic < TYPE_SECTION_START(log_dynamic)) ||
+	    (dynamic >= TYPE_SECTION_END(log_dynamic))) {
+		*dropped = 0;
+		*repeated = 0;
+		return true;
+	}
+
+	rl = &TYPE_SECTION_START(log_dynamic)[log_dynamic_source_id(dynamic)].rate_limit;
+	now = k_is_pre_kernel() ? 0U : k_uptime_get_32();
+	lock_key = k_spin_lock(&rl->lock);
+
+	if (!rl->config.duplicates) {
+		key = 0;
+	}
+
+	/* Duplicates do not use the rate of the source. */
+	if ((key != 0) && (key == rl->last_key)) {
+		rl->repeated++;
+		rl->stats.repeated++;
+		accept = false;
+	} else if (rl->config.sample > 1) {
+		/* Only the first message of every sample is logged. */
+		if (rl->sample_cnt++ != 0) {
+			rl->dropped++;
+			rl->stats.sampled_out++;
+			accept = false;
+		}
+
+		if (rl->sample_cnt >= rl->config.sample) {
+			rl->sample_cnt = 0;
+		}
+	}
+
+	/* The rate is only limited once the system clock is running. */
+	if (accept && (rl->config.rate != 0) && !k_is_pre_kernel()) {
+		rate_limit_refill(rl, now);
+
+		if (rl->tokens < RATE_LIMIT_TOKEN) {
+			rl->dropped++;
+			rl->stats.rate_dropped++;
+			accept = false;
+		} else {
+			rl->tokens -= RATE_LIMIT_TOKEN;
+		}
+	}
+
+	if (accept) {
+		*dropped = rl->dropped;
+		*repeated = rl->repeated;
+		rl->dropped = 0;
+		rl->repeated = 0;
+		rl->last_key = key;
+		rl->stats.logged++;
+	} else {
+		/* First message suppressed since the last report */
+		report = (rl->dropped + rl->repeated) == 1U;
+		rl->suppressed = now;
+	}
+
+	k_spin_unlock(&rl->lock, lock_key);
+
+	if (report && !k_is_pre_kernel()) {
+		(void)k_work_schedule(&rate_limit_report_work,
+				      K_MSEC(CONFIG_LOG_RATE_LIMIT_REPORT_DELAY));
+	}
+
+	return accept;
+}
+
+/* Report the messages suppressed by the sources which have stayed quiet since,
+ * they would otherwise only be reported with the next message of the source.
+ */
+static void rate_limit_report_handler(struct k_work *work)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t next = 0U;
+
+	ARG_UNUSED(work);
+
+	for (int16_t i = 0; i < z_log_sources_count(); i++) {
+		struct log_source_rate_limit *rl = rate_limit_get(i);
+		uint32_t dropped = 0U;
+		uint32_t repeated = 0U;
+		k_spinlock_key_t key;
+
+		key = k_spin_lock(&rl->lock);
+
+		if ((rl->dropped != 0U) || (rl->repeated != 0U)) {
+			uint32_t elapsed = now - rl->suppressed;
+
+			if (elapsed >= CONFIG_LOG_RATE_LIMIT_REPORT_DELAY) {
+				dropped = rl->dropped;
+				repeated = rl->repeated;
+				rl->dropped = 0U;
+				rl->repeated = 0U;
+			} else {
+				elapsed = CONFIG_LOG_RATE_LIMIT_REPORT_DELAY - elapsed;
+				next = (next == 0U) ? elapsed : MIN(next, elapsed);
+			}
+		}
+
+		k_spin_unlock(&rl->lock, key);
+
+		if ((dropped != 0U) || (repeated != 0U)) {
+			z_log_rate_limit_report(&TYPE_SECTION_START(log_dynamic)[i],
+						dropped, repeated);
+		}
+	}
+
+	if (next != 0U) {
+		(void)k_work_schedule(&rate_limit_report_work, K_MSEC(next));
+	}
+}
+#endif /* CONFIG_LOG_RATE_LIMIT */
+
+int log_rate_limit_set(int16_t source_id, const struct log_rate_limit_config *config)
+{
+#ifdef CONFIG_LOG_RATE_LIMIT
+	struct log_source_rate_limit *rl = rate_limit_get(source_id);
+	k_spinlock_key_t key;
+
+	if ((rl == NULL) || (config->burst == 0) || (config->sample == 0)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&rl->lock);
+	rl->config = *config;
+	rl->last_key = 0;
+	rate_limit_reset(rl, k_uptime_get_32());
+	k_spin_unlock(&rl->lock, key);
+
+	return 0;
+#else
+	ARG_UNUSED(source_id);
+	ARG_UNUSED(config);
+
+	return -ENOTSUP;
+#endif
+}
+
+int log_rate_limit_get(int16_t source_id, struct log_rate_limit_config *config)
+{
+#ifdef CONFIG_LOG_RATE_LIMIT
+	struct log_source_rate_limit *rl = rate_limit_get(source_id);
+	k_spinlock_key_t key;
+
+	if (rl == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&rl->lock);
+	*config = rl->config;
+	k_spin_unlock(&rl->lock, key);
+
+	return 0;
+#else
+	ARG_UNUSED(source_id);
+	ARG_UNUSED(config);
+
+	return -ENOTSUP;
+#endif
+}
+
+int log_rate_limit_stats_get(int16_t source_id, struct log_rate_limit_stats *stats)
+{
+#ifdef CONFIG_LOG_RATE_LIMIT
+	struct log_source_rate_limit *rl = rate_limit_get(source_id);
+	k_spinlock_key_t key;
+
+	if (rl == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&rl->lock);
+	*stats = rl->stats;
+	k_spin_unlock(&rl->lock, key);
+
+	return 0;
+#else
+	ARG_UNUSED(source_id);
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+#endif
+}
+
 static uint32_t max_filter_get(uint32_t filters)
 {
 	uint32_t max_filter = LOG_LEVEL_NONE;
@@ -74,6 +74,89 @@ static bool frontend_runtime_filtering(const void *source, uint32_t level)
 	return level <= f_level;
 }
 
+static void msg_runtime_vcreate(uint8_t domain_id, const void *source,
+				uint8_t level, const void *data, size_t dlen,
+				uint32_t package_flags, const char *fmt, va_list ap,
+				bool frontend, bool backends);
+
+#ifdef CONFIG_LOG_RATE_LIMIT
+/* FNV-1a hash of the message content used to detect duplicates. */
+#define RATE_LIMIT_KEY_INIT 2166136261U
+
+static uint32_t rate_limit_key_update(uint32_t key, const void *buf, size_t len)
+{
+	const uint8_t *p = buf;
+
+	for (size_t i = 0; i < len; i++) {
+		key = (key ^ p[i]) * 16777619U;
+	}
+
+	return key;
+}
+
+static void rate_limit_notice(const void *source, const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	msg_runtime_vcreate(Z_LOG_LOCAL_DOMAIN_ID, source, LOG_LEVEL_WRN, NULL, 0, 0, fmt, ap,
+			    false, true);
+	va_end(ap);
+}
+
+void z_log_rate_limit_report(const void *source, uint32_t dropped, uint32_t repeated)
+{
+	if (repeated > 0) {
+		rate_limit_notice(source, "last message repeated %u times", repeated);
+	}
+
+	if (dropped > 0) {
+		rate_limit_notice(source, "%u messages dropped by rate limiting", dropped);
+	}
+}
+
+/* Check the rate limits of the source before the message is allocated. Messages
+ * suppressed since the last logged message of the source are reported before
+ * the accepted one.
+ */
+static bool rate_limit_accept(uint8_t domain_id, const void *source, uint32_t key)
+{
+	uint32_t dropped;
+	uint32_t repeated;
+
+	if ((source == NULL) || !z_log_is_local_domain(domain_id)) {
+		return true;
+	}
+
+	if (!z_log_rate_limit_check(source, key, &dropped, &repeated)) {
+		return false;
+	}
+
+	z_log_rate_limit_report(source, dropped, repeated);
+
+	return true;
+}
+#else
+#define RATE_LIMIT_KEY_INIT 0U
+
+static inline uint32_t rate_limit_key_update(uint32_t key, const void *buf, size_t len)
+{
+	ARG_UNUSED(buf);
+	ARG_UNUSED(len);
+
+	return key;
+}
+
+static inline bool rate_limit_accept(uint8_t domain_id, const void *source, uint32_t key)
+{
+	ARG_UNUSED(domain_id);
+	ARG_UNUSED(source);
+	ARG_UNUSED(key);
+
+	return true;
+}
+#endif /* CONFIG_LOG_RATE_LIMIT */
+
 /** @brief Create a log message using simplified method.
  *
  * Simple log message has 0-2 32 bit word arguments so creating cbprintf package
@@ -92,6 +175,14 @@ static bool frontend_runtime_filtering(const void *source, uint32_t level)
  */
 static void z_log_msg_simple_create(const void *source, uint32_t level, uint32_t *data, size_t len)
 {
+	uint32_t key = IS_ENABLED(CONFIG_LOG_RATE_LIMIT) ?
+		       rate_limit_key_update(RATE_LIMIT_KEY_INIT, data, len * sizeof(uint32_t)) :
+		       0;
+
+	if (!rate_limit_accept(Z_LOG_LOCAL_DOMAIN_ID, source, key)) {
+		return;
+	}
+
 	/* Package length (in words) is increased by the header. */
 	size_t plen32 = len + CBPRINTF_DESC_SIZE32;
 	/* Package length in bytes. */
@@ -292,6 +383,18 @@ void z_impl_z_log_msg_static_create(const void *source,
 	struct log_msg_desc out_desc = desc;
 	int inlen = desc.package_len;
 	struct log_msg *msg;
+	uint32_t key = 0;
+
+	/* Read-write strings may change between messages, they are not compared. */
+	if (IS_ENABLED(CONFIG_LOG_RATE_LIMIT) &&
+	    ((inlen == 0) || (((union cbprintf_package_hdr *)package)->desc.rw_str_cnt == 0))) {
+		key = rate_limit_key_update(RATE_LIMIT_KEY_INIT, package, inlen);
+		key = rate_limit_key_update(key, data, desc.data_len);
+	}
+
+	if (!rate_limit_accept(desc.domain, source, key)) {
+		return;
+	}
 
 	if (inlen > 0) {
 		uint32_t flags = CBPRINTF_PACKAGE_CONVERT_RW_STR |
@@ -342,9 +445,10 @@ static inline void z_vrfy_z_log_msg_static_create(const void *source,
 #include <zephyr/syscalls/z_log_msg_static_create_mrsh.c>
 #endif
 
-void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
+static void msg_runtime_vcreate(uint8_t domain_id, const void *source,
 				uint8_t level, const void *data, size_t dlen,
-				uint32_t package_flags, const char *fmt, va_list ap)
+				uint32_t package_flags, const char *fmt, va_list ap,
+				bool frontend, bool backends)
 {
 	int plen;
 
@@ -372,7 +476,7 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 	struct log_msg_desc desc =
 		Z_LOG_MSG_DESC_INITIALIZER(domain_id, level, plen, dlen);
 
-	if (IS_ENABLED(CONFIG_LOG_MODE_DEFERRED) && BACKENDS_IN_USE()) {
+	if (IS_ENABLED(CONFIG_LOG_MODE_DEFERRED) && backends) {
 		msg = z_log_msg_alloc(msg_wlen);
 		if (IS_ENABLED(CONFIG_LOG_FRONTEND) && msg == NULL) {
 			pkg = alloca(plen);
@@ -389,14 +493,31 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 		__ASSERT_NO_MSG(plen >= 0);
 	}
 
-	if (IS_ENABLED(CONFIG_LOG_FRONTEND) && frontend_runtime_filtering(source, desc.level)) {
+	if (IS_ENABLED(CONFIG_LOG_FRONTEND) && frontend) {
 		log_frontend_msg(source, desc, pkg, data);
 	}
 
-	if (BACKENDS_IN_USE()) {
+	if (backends) {
 		z_log_msg_finalize(msg, source, desc, data);
 	}
 }
+
+void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
+				uint8_t level, const void *data, size_t dlen,
+				uint32_t package_flags, const char *fmt, va_list ap)
+{
+	bool frontend = IS_ENABLED(CONFIG_LOG_FRONTEND) &&
+			frontend_runtime_filtering(source, level);
+	/* Arguments are not known before the package is created, messages
+	 * created at runtime are not compared.
+	 */
+	bool backends = BACKENDS_IN_USE() && rate_limit_accept(domain_id, source, 0);
+
+	if (frontend || backends) {
+		msg_runtime_vcreate(domain_id, source, level, data, dlen, package_flags,
+				    fmt, ap, frontend, backends);
+	}
+}
 EXPORT_SYMBOL(z_log_msg_runtime_vcreate);
 
 int16_t log_msg_get_source_id(struct log_msg *msg)
@@ -12,8 +12,117 @@
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/util.h>
 
-void log_dict_output_msg_process(const struct log_output *output,
-				 struct log_msg *msg, uint32_t flags)
+#ifdef CONFIG_LOG_DICTIONARY_STREAM
+static size_t leb128_encode(uint8_t *buf, uint64_t value)
+{
+	size_t len = 0;
+
+	do {
+		buf[len] = value & 0x7F;
+		value >>= 7;
+		if (value != 0U) {
+			buf[len] |= 0x80;
+		}
+		len++;
+	} while (value != 0U);
+
+	return len;
+}
+
+/* CRC-16/CCITT-FALSE, computed bitwise as the CRC library may not be enabled
+ * and log frames are short.
+ */
+static uint16_t frame_crc(uint16_t crc, const uint8_t *buf, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= (uint16_t)buf[i] << 8;
+
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+
+	return crc;
+}
+
+/* Write a frame made of a header, and of the package and data of a message. */
+static void frame_write(const struct log_output *output, uint8_t *hdr, size_t hdr_len,
+			uint8_t *package, size_t package_len, uint8_t *data, size_t data_len)
+{
+	struct log_output_control_block *control_block = output->control_block;
+	struct log_dict_output_frame_hdr_t frame = {
+		.sof = { LOG_DICT_OUTPUT_FRAME_SOF0, LOG_DICT_OUTPUT_FRAME_SOF1 },
+		.seq = control_block->dict_seq++,
+		.len = hdr_len + package_len + data_len,
+	};
+	uint16_t crc;
+
+	__ASSERT_NO_MSG(hdr_len + package_len + data_len <= UINT16_MAX);
+
+	/* The start of frame marker is not covered by the CRC. */
+	crc = frame_crc(0xFFFF, (uint8_t *)&frame + sizeof(frame.sof),
+			sizeof(frame) - sizeof(frame.sof));
+	crc = frame_crc(crc, hdr, hdr_len);
+	crc = frame_crc(crc, package, package_len);
+	crc = frame_crc(crc, data, data_len);
+
+	log_output_write(output->func, (uint8_t *)&frame, sizeof(frame),
+			 (void *)control_block->ctx);
+	log_output_write(output->func, hdr, hdr_len, (void *)control_block->ctx);
+
+	if (package_len > 0U) {
+		log_output_write(output->func, package, package_len,
+				 (void *)control_block->ctx);
+	}
+
+	if (data_len > 0U) {
+		log_output_write(output->func, data, data_len, (void *)control_block->ctx);
+	}
+
+	log_output_write(output->func, (uint8_t *)&crc, sizeof(crc),
+			 (void *)control_block->ctx);
+}
+
+static void stream_msg_process(const struct log_output *output, struct log_msg *msg)
+{
+	struct log_output_control_block *control_block = output->control_block;
+	uint8_t hdr[LOG_DICT_OUTPUT_COMPACT_HDR_MAX_LEN];
+	void *source = (void *)log_msg_get_source(msg);
+	log_timestamp_t timestamp = msg->hdr.timestamp;
+	size_t package_len;
+	size_t data_len;
+	uint8_t *package = log_msg_get_package(msg, &package_len);
+	uint8_t *data = log_msg_get_data(msg, &data_len);
+	size_t hdr_len = 0;
+	uint64_t ts;
+
+	hdr[hdr_len++] = MSG_NORMAL_COMPACT;
+	hdr[hdr_len++] = (msg->hdr.desc.domain & 0x0F) | (msg->hdr.desc.level << 4);
+	hdr_len += leb128_encode(&hdr[hdr_len],
+				 (source != NULL) ? log_source_id(source) : 0U);
+
+	/* Full timestamps are sent periodically, for the host to recover from
+	 * lost frames, and when timestamps are not in order.
+	 */
+	if ((control_block->dict_seq % CONFIG_LOG_DICTIONARY_STREAM_TIMESTAMP_PERIOD) == 0U ||
+	    timestamp < control_block->dict_timestamp) {
+		ts = ((uint64_t)timestamp << 1) | 1U;
+	} else {
+		ts = (uint64_t)(timestamp - control_block->dict_timestamp) << 1;
+	}
+
+	control_block->dict_timestamp = timestamp;
+
+	hdr_len += leb128_encode(&hdr[hdr_len], ts);
+	hdr_len += leb128_encode(&hdr[hdr_len], package_len);
+	hdr_len += leb128_encode(&hdr[hdr_len], data_len);
+
+	frame_write(output, hdr, hdr_len, package, package_len, data, data_len);
+
+	log_output_flush(output);
+}
+#else
+static void raw_msg_process(const struct log_output *output, struct log_msg *msg)
 {
 	struct log_dict_output_normal_msg_hdr_t output_hdr;
 	void *source = (void *)log_msg_get_source(msg);
@@ -45,6 +154,17 @@ void log_dict_output_msg_process(const struct log_output *output,
 
 	log_output_flush(output);
 }
+#endif /* CONFIG_LOG_DICTIONARY_STREAM */
+
+void log_dict_output_msg_process(const struct log_output *output,
+				 struct log_msg *msg, uint32_t flags)
+{
+#ifdef CONFIG_LOG_DICTIONARY_STREAM
+	stream_msg_process(output, msg);
+#else
+	raw_msg_process(output, msg);
+#endif
+}
 
 void log_dict_output_dropped_process(const struct log_output *output, uint32_t cnt)
 {
@@ -53,6 +173,10 @@ void log_dict_output_dropped_process(const struct log_output *output, uint32_t c
 	msg.type = MSG_DROPPED_MSG;
 	msg.num_dropped_messages = MIN(cnt, 9999);
 
+#ifdef CONFIG_LOG_DICTIONARY_STREAM
+	frame_write(output, (uint8_t *)&msg, sizeof(msg), NULL, 0, NULL, 0);
+#else
 	log_output_write(output->func, (uint8_t *)&msg, sizeof(msg),
 			 (void *)output->control_block->ctx);
+#endif
 }
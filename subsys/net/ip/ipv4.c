@@ -242,9 +242,6 @@ int net_ipv4_parse_hdr_options(struct net_pkt *pkt,
 
 enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback)
 {
-	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
-	NET_PKT_DATA_ACCESS_DEFINE(udp_access, struct net_udp_hdr);
-	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
 	int real_len = net_pkt_get_len(pkt);
 	enum net_verdict verdict = NET_DROP;
 	union net_proto_header proto_hdr;
@@ -254,15 +251,9 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback)
 	uint8_t opts_len;
 	int pkt_len;
 
-#if defined(CONFIG_NET_L2_IPIP)
-	struct net_pkt_cursor hdr_start;
-
-	net_pkt_cursor_backup(pkt, &hdr_start);
-#endif
-
 	net_stats_update_ipv4_recv(net_pkt_iface(pkt));
 
-	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	hdr = (struct net_ipv4_hdr *)net_pkt_hdr_pull(pkt, sizeof(*hdr));
 	if (!hdr) {
 		NET_DBG("DROP: no buffer");
 		goto drop;
@@ -361,8 +352,6 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback)
 		goto drop;
 	}
 
-	net_pkt_acknowledge_data(pkt, &ipv4_access);
-
 	if (opts_len) {
 		/* Only few options are handled in EchoRequest, rest skipped */
 		if (net_pkt_skip(pkt, opts_len)) {
@@ -407,13 +396,13 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback)
 		return verdict;
 #endif
 	case IPPROTO_TCP:
-		proto_hdr.tcp = net_tcp_input(pkt, &tcp_access);
+		proto_hdr.tcp = net_tcp_input(pkt);
 		if (proto_hdr.tcp) {
 			verdict = NET_OK;
 		}
 		break;
 	case IPPROTO_UDP:
-		proto_hdr.udp = net_udp_input(pkt, &udp_access);
+		proto_hdr.udp = net_udp_input(pkt);
 		if (proto_hdr.udp) {
 			verdict = NET_OK;
 		}
@@ -432,7 +421,7 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback)
 					   sizeof(struct sockaddr_in));
 
 		/* Get rid of the old IP header */
-		net_pkt_cursor_restore(pkt, &hdr_start);
+		net_pkt_cursor_init(pkt);
 		net_pkt_pull(pkt, net_pkt_ip_hdr_len(pkt) +
 			     net_pkt_ipv4_opts_len(pkt));
 
@@ -143,6 +143,7 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 	struct net_ipv4_hdr *ipv4_hdr;
 	struct net_pkt *pkt;
 	struct net_buf *last;
+	uint16_t len;
 	int i;
 
 	k_work_cancel_delayable(&reass->timer);
@@ -196,12 +197,17 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 		goto error;
 	}
 
-	/* Fix the total length, offset and checksum of the IPv4 packet */
-	ipv4_hdr->len = htons(net_pkt_get_len(pkt));
+	/* Fix the total length, offset and checksum of the IPv4 packet. The
+	 * header of the first fragment has been verified already, so the
+	 * checksum can be updated incrementally.
+	 */
+	len = htons(net_pkt_get_len(pkt));
+	ipv4_hdr->chksum = net_chksum_update16(ipv4_hdr->chksum, ipv4_hdr->len, len);
+	ipv4_hdr->chksum = net_chksum_update16(ipv4_hdr->chksum,
+					       UNALIGNED_GET((uint16_t *)ipv4_hdr->offset), 0);
+	ipv4_hdr->len = len;
 	ipv4_hdr->offset[0] = 0;
 	ipv4_hdr->offset[1] = 0;
-	ipv4_hdr->chksum = 0;
-	ipv4_hdr->chksum = net_calc_chksum_ipv4(pkt);
 
 	net_pkt_set_data(pkt, &ipv4_access);
 	net_pkt_set_ip_reassembled(pkt, true);
@@ -648,7 +654,8 @@ use_interface_mtu:
 			mtu = MAX(NET_IPV4_MTU, mtu);
 		}
 
-		if (pkt_len > mtu) {
+		/* TCP super-packets are segmented at the L2 boundary instead */
+		if (pkt_len > mtu && net_pkt_gso_size(pkt) == 0U) {
 			ret = net_ipv4_send_fragmented_pkt(net_pkt_iface(pkt), pkt, pkt_len, mtu);
 
 			if (ret < 0) {
@@ -476,9 +476,6 @@ static inline bool is_src_non_tentative_itself(struct in6_addr *src)
 
 enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 {
-	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access, struct net_ipv6_hdr);
-	NET_PKT_DATA_ACCESS_DEFINE(udp_access, struct net_udp_hdr);
-	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
 	struct net_if *pkt_iface = net_pkt_iface(pkt);
 	enum net_verdict verdict = NET_DROP;
 	int real_len = net_pkt_get_len(pkt);
@@ -491,15 +488,9 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 	union net_ip_header ip;
 	int pkt_len;
 
-#if defined(CONFIG_NET_L2_IPIP)
-	struct net_pkt_cursor hdr_start;
-
-	net_pkt_cursor_backup(pkt, &hdr_start);
-#endif
-
 	net_stats_update_ipv6_recv(pkt_iface);
 
-	hdr = (struct net_ipv6_hdr *)net_pkt_get_data(pkt, &ipv6_access);
+	hdr = (struct net_ipv6_hdr *)net_pkt_hdr_pull(pkt, sizeof(*hdr));
 	if (!hdr) {
 		NET_DBG("DROP: no buffer");
 		goto drop;
@@ -659,8 +650,6 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 		}
 	}
 
-	net_pkt_acknowledge_data(pkt, &ipv6_access);
-
 	current_hdr = hdr->nexthdr;
 	ext_bitmap = extension_to_bitmap(current_hdr, ext_bitmap);
 	/* Offset of "nexthdr" in the IPv6 header */
@@ -775,7 +764,7 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 		verdict = net_icmpv6_input(pkt, hdr);
 		break;
 	case IPPROTO_TCP:
-		proto_hdr.tcp = net_tcp_input(pkt, &tcp_access);
+		proto_hdr.tcp = net_tcp_input(pkt);
 		if (proto_hdr.tcp) {
 			verdict = NET_OK;
 		}
@@ -783,7 +772,7 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 		NET_DBG("%s verdict %s", "TCP", net_verdict2str(verdict));
 		break;
 	case IPPROTO_UDP:
-		proto_hdr.udp = net_udp_input(pkt, &udp_access);
+		proto_hdr.udp = net_udp_input(pkt);
 		if (proto_hdr.udp) {
 			verdict = NET_OK;
 		}
@@ -804,7 +793,7 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 					   sizeof(struct sockaddr_in6));
 
 		/* Get rid of the old IP header */
-		net_pkt_cursor_restore(pkt, &hdr_start);
+		net_pkt_cursor_init(pkt);
 		net_pkt_pull(pkt, net_pkt_ip_hdr_len(pkt) +
 			     net_pkt_ipv6_ext_len(pkt));
 
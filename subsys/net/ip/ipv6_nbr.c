@@ -434,6 +434,7 @@ static struct net_nbr *nbr_new(struct net_if *iface,
 	}
 
 	nbr_init(nbr, iface, addr, is_router, state);
+	net_route_cache_flush();
 
 	NET_DBG("nbr %p iface %p/%d state %d IPv6 %s",
 		nbr, iface, net_if_get_by_iface(iface), state,
@@ -656,12 +657,14 @@ void net_neighbor_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
-	return;
+	net_route_cache_flush();
 }
 
 void net_neighbor_table_clear(struct net_nbr_table *table)
 {
 	NET_DBG("Neighbor table %p cleared", table);
+
+	net_route_cache_flush();
 }
 
 struct in6_addr *net_ipv6_nbr_lookup_by_index(struct net_if *iface,
@@ -819,7 +822,8 @@ use_interface_mtu:
 			mtu = MAX(NET_IPV6_MTU, mtu);
 		}
 
-		if (mtu < pkt_len) {
+		/* TCP super-packets are segmented at the L2 boundary instead */
+		if (mtu < pkt_len && net_pkt_gso_size(pkt) == 0U) {
 			ret = net_ipv6_send_fragmented_pkt(net_pkt_iface(pkt),
 							   pkt, pkt_len, mtu);
 			if (ret < 0) {
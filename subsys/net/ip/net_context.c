@@ -1939,6 +1939,26 @@ static int get_context_timestamping(struct net_context *context,
 #endif
 }
 
+static int get_context_zerocopy(struct net_context *context,
+				void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	*((struct net_context_zerocopy *)value) = context->options.zerocopy;
+
+	if (len) {
+		*len = sizeof(struct net_context_zerocopy);
+	}
+
+	return 0;
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
 static int get_context_mtu(struct net_context *context,
 			   void *value, size_t *len)
 {
@@ -2073,6 +2093,174 @@ static int get_context_ipv6_mcast_loop(struct net_context *context,
 #endif
 }
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/* Book-keeping for an application buffer that is attached to a network
+ * packet without copying it.
+ */
+struct zerocopy_info {
+	net_context_zerocopy_cb_t cb;
+	void *user_data;
+	const void *data;
+	size_t len;
+};
+
+static void zerocopy_buf_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_FIXED_DEFINE(zerocopy_pool, CONFIG_NET_CONTEXT_ZEROCOPY_BUF_COUNT,
+			  0, sizeof(struct zerocopy_info), zerocopy_buf_destroy);
+
+static void zerocopy_buf_destroy(struct net_buf *buf)
+{
+	struct zerocopy_info info = *(struct zerocopy_info *)net_buf_user_data(buf);
+
+	/* Return the descriptor first so that the callback can already
+	 * queue the released buffer again.
+	 */
+	net_buf_destroy(buf);
+
+	if (info.cb != NULL) {
+		info.cb(info.data, info.len, info.user_data);
+	}
+}
+
+struct net_buf *net_context_zerocopy_frag(struct net_context *context,
+					  const void *data, size_t len,
+					  k_timeout_t timeout)
+{
+	struct zerocopy_info *info;
+	struct net_buf *frag;
+
+	/* The data is only read by the stack, the const qualifier is
+	 * dropped because net_buf does not have a read-only variant.
+	 */
+	frag = net_buf_alloc_with_data(&zerocopy_pool, (void *)data, len,
+				       timeout);
+	if (frag == NULL) {
+		return NULL;
+	}
+
+	info = net_buf_user_data(frag);
+	info->cb = context->options.zerocopy.cb;
+	info->user_data = context->options.zerocopy.user_data;
+	info->data = data;
+	info->len = len;
+
+	return frag;
+}
+
+/* A segment references a part of a zero-copy fragment while it is
+ * transmitted. The fragment, and so the application buffer, is kept until
+ * all its references are released.
+ */
+static void zerocopy_ref_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_FIXED_DEFINE(zerocopy_ref_pool, CONFIG_NET_CONTEXT_ZEROCOPY_BUF_COUNT,
+			  0, sizeof(struct net_buf *), zerocopy_ref_destroy);
+
+static void zerocopy_ref_destroy(struct net_buf *buf)
+{
+	struct net_buf *frag = *(struct net_buf **)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+	net_buf_unref(frag);
+}
+
+bool net_context_zerocopy_is_frag(const struct net_buf *buf)
+{
+	return net_buf_pool_get(buf->pool_id) == &zerocopy_pool;
+}
+
+struct net_buf *net_context_zerocopy_ref(struct net_buf *frag, size_t offset,
+					 size_t len, k_timeout_t timeout)
+{
+	struct net_buf *ref;
+
+	__ASSERT_NO_MSG(net_context_zerocopy_is_frag(frag));
+	__ASSERT_NO_MSG(offset + len <= frag->len);
+
+	ref = net_buf_alloc_with_data(&zerocopy_ref_pool, frag->data + offset,
+				      len, timeout);
+	if (ref == NULL) {
+		return NULL;
+	}
+
+	*(struct net_buf **)net_buf_user_data(ref) = net_buf_ref(frag);
+
+	return ref;
+}
+
+static bool context_use_zerocopy(struct net_context *context, int flags)
+{
+	return (flags & ZSOCK_MSG_ZEROCOPY) &&
+		context->options.zerocopy.cb != NULL;
+}
+
+/* Attach the application data as external fragments instead of copying
+ * it into the packet buffers.
+ */
+static int context_write_data_zerocopy(struct net_context *context,
+				       struct net_pkt *pkt, const void *buf,
+				       size_t buf_len,
+				       const struct msghdr *msghdr)
+{
+	struct net_buf *frag;
+
+	if (msghdr == NULL) {
+		frag = net_context_zerocopy_frag(context, buf, buf_len,
+						 PKT_WAIT_TIME);
+		if (frag == NULL) {
+			return -ENOBUFS;
+		}
+
+		net_pkt_append_buffer(pkt, frag);
+
+		return 0;
+	}
+
+	for (int i = 0; i < msghdr->msg_iovlen && buf_len > 0; i++) {
+		size_t len = MIN(msghdr->msg_iov[i].iov_len, buf_len);
+
+		if (len == 0) {
+			continue;
+		}
+
+		frag = net_context_zerocopy_frag(context,
+						 msghdr->msg_iov[i].iov_base,
+						 len, PKT_WAIT_TIME);
+		if (frag == NULL) {
+			return -ENOBUFS;
+		}
+
+		net_pkt_append_buffer(pkt, frag);
+		buf_len -= len;
+	}
+
+	return 0;
+}
+#else
+static inline bool context_use_zerocopy(struct net_context *context, int flags)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(flags);
+
+	return false;
+}
+
+static inline int context_write_data_zerocopy(struct net_context *context,
+					      struct net_pkt *pkt,
+					      const void *buf, size_t buf_len,
+					      const struct msghdr *msghdr)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(buf_len);
+	ARG_UNUSED(msghdr);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
@@ -2112,7 +2300,8 @@ static int context_setup_udp_packet(struct net_context *context,
 				    size_t len,
 				    const struct msghdr *msg,
 				    const struct sockaddr *dst_addr,
-				    socklen_t addrlen)
+				    socklen_t addrlen,
+				    int flags)
 {
 	int ret = -EINVAL;
 	uint16_t dst_port = 0U;
@@ -2150,7 +2339,12 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	if (context_use_zerocopy(context, flags)) {
+		ret = context_write_data_zerocopy(context, pkt, buf, len, msg);
+	} else {
+		ret = context_write_data(pkt, buf, len, msg);
+	}
+
 	if (ret) {
 		return ret;
 	}
@@ -2298,11 +2492,13 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
-			  bool sendto)
+			  bool sendto,
+			  int flags)
 {
 	const struct msghdr *msghdr = NULL;
 	struct net_if *iface = NULL;
 	struct net_pkt *pkt = NULL;
+	bool zerocopy = false;
 	sa_family_t family;
 	size_t tmp_len;
 	int ret;
@@ -2568,7 +2764,15 @@ static int context_sendto(struct net_context *context,
 		goto skip_alloc;
 	}
 
-	pkt = context_alloc_pkt(context, family, len, PKT_WAIT_TIME);
+	/* With zero-copy the payload is attached as external fragments,
+	 * so only the headers need to be allocated.
+	 */
+	zerocopy = context_use_zerocopy(context, flags) &&
+		   net_context_get_proto(context) == IPPROTO_UDP &&
+		   !net_if_is_ip_offloaded(net_context_get_iface(context));
+
+	pkt = context_alloc_pkt(context, family, zerocopy ? 0 : len,
+				PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
 		return -ENOBUFS;
@@ -2576,7 +2780,7 @@ static int context_sendto(struct net_context *context,
 
 	tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_proto(context));
-	if (tmp_len < len) {
+	if (!zerocopy && tmp_len < len) {
 		if (net_context_get_type(context) == SOCK_DGRAM ||
 		    net_context_get_type(context) == SOCK_RAW) {
 			NET_ERR("Available payload buffer (%zu) is not enough for requested DGRAM (%zu)",
@@ -2639,7 +2843,8 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, family, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       dst_addr, addrlen,
+					       zerocopy ? flags : 0);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2650,7 +2855,9 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_proto(context) == IPPROTO_TCP) {
 
-		ret = net_tcp_queue(context, buf, len, msghdr);
+		ret = net_tcp_queue(context, buf, len, msghdr,
+				    context_use_zerocopy(context, flags) ?
+				    ZSOCK_MSG_ZEROCOPY : 0);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2832,7 +3039,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, false, 0);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -2851,7 +3058,7 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, flags);
 
 	k_mutex_unlock(&context->lock);
 
@@ -2872,7 +3079,7 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, 0);
 
 	k_mutex_unlock(&context->lock);
 
@@ -3661,6 +3868,26 @@ static int set_context_timestamping(struct net_context *context,
 #endif
 }
 
+static int set_context_zerocopy(struct net_context *context,
+				const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	if (len != sizeof(struct net_context_zerocopy)) {
+		return -EINVAL;
+	}
+
+	context->options.zerocopy = *((const struct net_context_zerocopy *)value);
+
+	return 0;
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
 static int set_context_mcast_ifindex(struct net_context *context,
 				     const void *value, size_t len)
 {
@@ -3853,6 +4080,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_IPV4_MCAST_LOOP:
 		ret = set_context_ipv4_mcast_loop(context, value, len);
 		break;
+	case NET_OPT_ZEROCOPY:
+		ret = set_context_zerocopy(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -3944,6 +4174,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_IPV4_MCAST_LOOP:
 		ret = get_context_ipv4_mcast_loop(context, value, len);
 		break;
+	case NET_OPT_ZEROCOPY:
+		ret = get_context_zerocopy(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -65,7 +65,8 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 
 #if defined(CONFIG_NET_NATIVE)
 static inline enum net_verdict process_data(struct net_pkt *pkt,
-					    bool is_loopback)
+					    bool is_loopback,
+					    struct net_gro *gro)
 {
 	int ret;
 	bool locally_routed = false;
@@ -130,6 +131,13 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 		/* IP version and header length. */
 		uint8_t vtc_vhl = NET_IPV6_HDR(pkt)->vtc & 0xf0;
 
+		if (IS_ENABLED(CONFIG_NET_TCP_GRO) && gro != NULL) {
+			ret = net_gro_receive(gro, pkt, is_loopback);
+			if (ret != NET_CONTINUE) {
+				return ret;
+			}
+		}
+
 		if (IS_ENABLED(CONFIG_NET_IPV6) && vtc_vhl == 0x60) {
 			return net_ipv6_input(pkt, is_loopback);
 		} else if (IS_ENABLED(CONFIG_NET_IPV4) && vtc_vhl == 0x40) {
@@ -148,10 +156,11 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	return NET_DROP;
 }
 
-static void processing_data(struct net_pkt *pkt, bool is_loopback)
+static void processing_data(struct net_pkt *pkt, bool is_loopback,
+			    struct net_gro *gro)
 {
 again:
-	switch (process_data(pkt, is_loopback)) {
+	switch (process_data(pkt, is_loopback, gro)) {
 	case NET_CONTINUE:
 		if (IS_ENABLED(CONFIG_NET_L2_VIRTUAL)) {
 			/* If we have a tunneling packet, feed it back
@@ -426,7 +435,15 @@ int net_try_send_data(struct net_pkt *pkt, k_timeout_t timeout)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
-		processing_data(pkt, true);
+
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) > 0U) {
+			ret = net_gso_finalize_local(pkt);
+			if (ret < 0) {
+				goto err;
+			}
+		}
+
+		processing_data(pkt, true, NULL);
 		ret = 0;
 		goto err;
 	}
@@ -484,7 +501,8 @@ err:
 	return ret;
 }
 
-static void net_rx(struct net_if *iface, struct net_pkt *pkt)
+static void net_rx(struct net_if *iface, struct net_pkt *pkt,
+		   struct net_gro *gro)
 {
 	bool is_loopback = false;
 	size_t pkt_len;
@@ -503,26 +521,30 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 #endif
 	}
 
-	processing_data(pkt, is_loopback);
+	processing_data(pkt, is_loopback, gro);
 
 	net_print_statistics();
 	net_pkt_print();
 }
 
-void net_process_rx_packet(struct net_pkt *pkt)
+void net_process_rx_packet(struct net_pkt *pkt, struct net_gro *gro)
 {
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
 	net_capture_pkt(net_pkt_iface(pkt), pkt);
 
-	net_rx(net_pkt_iface(pkt), pkt);
+	net_rx(net_pkt_iface(pkt), pkt, gro);
 }
 
 static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 {
 	size_t len = net_pkt_get_len(pkt);
 	uint8_t prio = net_pkt_priority(pkt);
-	uint8_t tc = net_rx_priority2tc(prio);
+	int tc = net_rx_flow2tc(pkt);
+
+	if (tc < 0) {
+		tc = net_rx_priority2tc(prio);
+	}
 
 #if NET_TC_RX_COUNT > 1
 	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
@@ -530,7 +552,7 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 
 	if ((IS_ENABLED(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO) &&
 	     prio >= NET_PRIORITY_CA) || NET_TC_RX_COUNT == 0) {
-		net_process_rx_packet(pkt);
+		net_process_rx_packet(pkt, NULL);
 	} else {
 		if (net_tc_submit_to_rx_queue(tc, pkt) != NET_OK) {
 			goto drop;
@@ -0,0 +1,341 @@
+/** @file
+ * @brief TCP generic receive offload
+ *
+ * Coalesce back-to-back in-order TCP segments of one connection before
+ * passing them to the IP and TCP input processing.
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_gro, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ethernet.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+/* Parsed headers of a segment. The IP and TCP headers are always in the
+ * first fragment of a GRO candidate.
+ */
+struct gro_hdrs {
+	union {
+		struct net_ipv4_hdr *ipv4;
+		struct net_ipv6_hdr *ipv6;
+	};
+	struct net_tcp_hdr *tcp;
+	size_t hdr_len;
+	size_t payload_len;
+	uint32_t seq;
+	uint8_t family;
+};
+
+static bool gro_parse_ipv4(struct net_pkt *pkt, struct gro_hdrs *hdrs)
+{
+	struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)pkt->buffer->data;
+	size_t len;
+
+	if (!IS_ENABLED(CONFIG_NET_IPV4) ||
+	    pkt->buffer->len < sizeof(*hdr) ||
+	    hdr->vhl != 0x45 || hdr->proto != IPPROTO_TCP ||
+	    (sys_get_be16(hdr->offset) &
+	     (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) != 0U) {
+		return false;
+	}
+
+	len = ntohs(hdr->len);
+	if (len > net_pkt_get_len(pkt)) {
+		return false;
+	}
+
+	if (!net_ipv4_is_my_addr((struct in_addr *)hdr->dst) &&
+	    !net_ipv4_is_addr_loopback((struct in_addr *)hdr->dst)) {
+		/* Packets that are forwarded must keep their size */
+		return false;
+	}
+
+	/* Remove possible link layer padding */
+	if (len < net_pkt_get_len(pkt) && net_pkt_update_length(pkt, len) < 0) {
+		return false;
+	}
+
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(*hdr));
+	net_pkt_set_ipv4_opts_len(pkt, 0);
+
+	if (net_if_need_calc_rx_checksum(net_pkt_iface(pkt),
+					 NET_IF_CHECKSUM_IPV4_HEADER) &&
+	    net_calc_chksum_ipv4(pkt) != 0U) {
+		return false;
+	}
+
+	hdrs->ipv4 = hdr;
+	hdrs->hdr_len = sizeof(*hdr);
+	hdrs->payload_len = len - sizeof(*hdr);
+	hdrs->family = AF_INET;
+
+	return true;
+}
+
+static bool gro_parse_ipv6(struct net_pkt *pkt, struct gro_hdrs *hdrs)
+{
+	struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)pkt->buffer->data;
+	size_t len;
+
+	if (!IS_ENABLED(CONFIG_NET_IPV6) ||
+	    pkt->buffer->len < sizeof(*hdr) ||
+	    hdr->nexthdr != IPPROTO_TCP) {
+		return false;
+	}
+
+	len = ntohs(hdr->len) + sizeof(*hdr);
+	if (len > net_pkt_get_len(pkt)) {
+		return false;
+	}
+
+	if (!net_ipv6_is_my_addr((struct in6_addr *)hdr->dst) &&
+	    !net_ipv6_is_addr_loopback((struct in6_addr *)hdr->dst)) {
+		return false;
+	}
+
+	if (len < net_pkt_get_len(pkt) && net_pkt_update_length(pkt, len) < 0) {
+		return false;
+	}
+
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(*hdr));
+	net_pkt_set_ipv6_ext_len(pkt, 0);
+
+	hdrs->ipv6 = hdr;
+	hdrs->hdr_len = sizeof(*hdr);
+	hdrs->payload_len = len - sizeof(*hdr);
+	hdrs->family = AF_INET6;
+
+	return true;
+}
+
+/* Check if the packet is a plain in-order data segment that can be merged */
+static bool gro_parse(struct net_pkt *pkt, struct gro_hdrs *hdrs)
+{
+	enum net_if_checksum_type type;
+	uint8_t vtc_vhl = pkt->buffer->data[0] & 0xf0;
+	size_t tcp_len;
+
+	if (vtc_vhl == 0x40) {
+		if (!gro_parse_ipv4(pkt, hdrs)) {
+			return false;
+		}
+
+		type = NET_IF_CHECKSUM_IPV4_TCP;
+	} else if (vtc_vhl == 0x60) {
+		if (!gro_parse_ipv6(pkt, hdrs)) {
+			return false;
+		}
+
+		type = NET_IF_CHECKSUM_IPV6_TCP;
+	} else {
+		return false;
+	}
+
+	if (pkt->buffer->len < hdrs->hdr_len + sizeof(struct net_tcp_hdr)) {
+		return false;
+	}
+
+	hdrs->tcp = (struct net_tcp_hdr *)(pkt->buffer->data + hdrs->hdr_len);
+
+	tcp_len = (hdrs->tcp->offset >> 4) * 4U;
+	if (tcp_len < sizeof(struct net_tcp_hdr) ||
+	    tcp_len >= hdrs->payload_len ||
+	    pkt->buffer->len < hdrs->hdr_len + tcp_len) {
+		return false;
+	}
+
+	/* Only pure data segments are merged, anything changing the state
+	 * of the connection is passed as is.
+	 */
+	if ((hdrs->tcp->flags & ~PSH) != ACK) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
+	    net_if_need_calc_rx_checksum(net_pkt_iface(pkt), type) &&
+	    net_calc_chksum_tcp(pkt) != 0U) {
+		return false;
+	}
+
+	hdrs->hdr_len += tcp_len;
+	hdrs->payload_len -= tcp_len;
+	hdrs->seq = sys_get_be32(hdrs->tcp->seq);
+
+	return true;
+}
+
+static bool gro_same_flow(struct net_gro *gro, struct net_pkt *pkt,
+			  bool is_loopback, struct gro_hdrs *hdrs)
+{
+	struct net_pkt *held = gro->pkt;
+	struct net_tcp_hdr *tcp;
+	size_t ip_len;
+
+	if (net_pkt_iface(held) != net_pkt_iface(pkt) ||
+	    net_pkt_family(held) != hdrs->family ||
+	    gro->is_loopback != is_loopback ||
+	    gro->next_seq != hdrs->seq) {
+		return false;
+	}
+
+	if (hdrs->family == AF_INET) {
+		struct net_ipv4_hdr *ipv4 = NET_IPV4_HDR(held);
+
+		if (ipv4->tos != hdrs->ipv4->tos || ipv4->ttl != hdrs->ipv4->ttl ||
+		    memcmp(ipv4->src, hdrs->ipv4->src, 2 * NET_IPV4_ADDR_SIZE) != 0) {
+			return false;
+		}
+
+		ip_len = ntohs(ipv4->len);
+	} else {
+		struct net_ipv6_hdr *ipv6 = NET_IPV6_HDR(held);
+
+		if (memcmp(ipv6, hdrs->ipv6, offsetof(struct net_ipv6_hdr, len)) != 0 ||
+		    ipv6->hop_limit != hdrs->ipv6->hop_limit ||
+		    memcmp(ipv6->src, hdrs->ipv6->src, 2 * NET_IPV6_ADDR_SIZE) != 0) {
+			return false;
+		}
+
+		ip_len = ntohs(ipv6->len);
+	}
+
+	/* The merged packet must still fit into the IP length field */
+	if (ip_len + hdrs->payload_len > UINT16_MAX) {
+		return false;
+	}
+
+	tcp = (struct net_tcp_hdr *)(held->buffer->data + net_pkt_ip_hdr_len(held));
+
+	/* Same ports, same acknowledgment and identical options */
+	return tcp->src_port == hdrs->tcp->src_port &&
+	       tcp->dst_port == hdrs->tcp->dst_port &&
+	       memcmp(tcp->ack, hdrs->tcp->ack, sizeof(tcp->ack)) == 0 &&
+	       tcp->offset == hdrs->tcp->offset &&
+	       memcmp(tcp->optdata, hdrs->tcp->optdata,
+		      ((tcp->offset >> 4) * 4U) - sizeof(*tcp)) == 0;
+}
+
+static void gro_merge(struct net_gro *gro, struct net_pkt *pkt,
+		      struct gro_hdrs *hdrs)
+{
+	struct net_pkt *held = gro->pkt;
+	struct net_tcp_hdr *tcp;
+	struct net_buf *frag;
+
+	tcp = (struct net_tcp_hdr *)(held->buffer->data + net_pkt_ip_hdr_len(held));
+	tcp->flags |= hdrs->tcp->flags & PSH;
+	memcpy(tcp->wnd, hdrs->tcp->wnd, sizeof(tcp->wnd));
+
+	if (hdrs->family == AF_INET) {
+		struct net_ipv4_hdr *ipv4 = NET_IPV4_HDR(held);
+		uint16_t len = htons(ntohs(ipv4->len) + hdrs->payload_len);
+
+		ipv4->chksum = net_chksum_update16(ipv4->chksum, ipv4->len, len);
+		ipv4->len = len;
+	} else {
+		struct net_ipv6_hdr *ipv6 = NET_IPV6_HDR(held);
+
+		ipv6->len = htons(ntohs(ipv6->len) + hdrs->payload_len);
+	}
+
+	/* Strip the headers and chain the payload to the held packet */
+	frag = pkt->buffer;
+	pkt->buffer = NULL;
+
+	net_buf_pull(frag, hdrs->hdr_len);
+	if (frag->len == 0U) {
+		frag = net_buf_frag_del(NULL, frag);
+	}
+
+	if (frag != NULL) {
+		net_pkt_append_buffer(held, frag);
+	}
+
+	net_pkt_unref(pkt);
+
+	net_pkt_set_gro(held, true);
+	gro->next_seq += hdrs->payload_len;
+	gro->count++;
+}
+
+enum net_verdict net_gro_receive(struct net_gro *gro, struct net_pkt *pkt,
+				 bool is_loopback)
+{
+	struct gro_hdrs hdrs;
+	bool push;
+
+	if (net_if_eth_hw_caps_supported(net_pkt_iface(pkt), ETHERNET_HW_LRO) ||
+	    !gro_parse(pkt, &hdrs)) {
+		net_gro_flush(gro);
+		return NET_CONTINUE;
+	}
+
+	push = (hdrs.tcp->flags & PSH) != 0U;
+
+	if (gro->pkt != NULL && gro_same_flow(gro, pkt, is_loopback, &hdrs)) {
+		gro_merge(gro, pkt, &hdrs);
+
+		if (push || gro->count >= CONFIG_NET_TCP_GRO_MAX_SEGMENTS) {
+			net_gro_flush(gro);
+		}
+
+		return NET_OK;
+	}
+
+	net_gro_flush(gro);
+
+	if (push) {
+		/* Nothing would be merged into this one */
+		return NET_CONTINUE;
+	}
+
+	gro->pkt = pkt;
+	gro->is_loopback = is_loopback;
+	gro->next_seq = hdrs.seq + hdrs.payload_len;
+	gro->count = 1U;
+
+	return NET_OK;
+}
+
+void net_gro_flush(struct net_gro *gro)
+{
+	struct net_pkt *pkt = gro->pkt;
+	enum net_verdict verdict;
+
+	if (pkt == NULL) {
+		return;
+	}
+
+	gro->pkt = NULL;
+
+	NET_DBG("Flushing pkt %p (%u segments)", pkt, gro->count);
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_family(pkt) == AF_INET) {
+		verdict = net_ipv4_input(pkt, gro->is_loopback);
+	} else {
+		verdict = net_ipv6_input(pkt, gro->is_loopback);
+	}
+
+	if (verdict != NET_OK) {
+		net_pkt_unref(pkt);
+	}
+}
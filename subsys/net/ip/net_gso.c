@@ -0,0 +1,311 @@
+/** @file
+ * @brief TCP generic segmentation offload
+ *
+ * Split TCP super-packets into MSS sized segments at the L2 boundary.
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_gso, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_l2.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+#include "net_stats.h"
+
+#define GSO_ALLOC_TIMEOUT K_MSEC(CONFIG_NET_TCP_PKT_ALLOC_TIMEOUT)
+
+static void gso_copy_attributes(struct net_pkt *seg, struct net_pkt *pkt)
+{
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_ttl(seg, net_pkt_ipv4_ttl(pkt));
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_hop_limit(seg, net_pkt_ipv6_hop_limit(pkt));
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+}
+
+static int gso_update_ip_hdr(struct net_pkt *seg, uint16_t index)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+		struct net_ipv4_hdr *ipv4_hdr;
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(seg, &ipv4_access);
+		if (!ipv4_hdr) {
+			return -ENOBUFS;
+		}
+
+		/* Each segment is a datagram of its own and gets the next ID */
+		ipv4_hdr->len = htons(net_pkt_get_len(seg));
+		sys_put_be16(sys_get_be16(ipv4_hdr->id) + index, ipv4_hdr->id);
+		ipv4_hdr->chksum = 0U;
+
+		if (net_if_need_calc_tx_checksum(net_pkt_iface(seg),
+						 NET_IF_CHECKSUM_IPV4_HEADER)) {
+			ipv4_hdr->chksum = net_calc_chksum_ipv4(seg);
+		}
+
+		return net_pkt_set_data(seg, &ipv4_access);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(seg) == AF_INET6) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access, struct net_ipv6_hdr);
+		struct net_ipv6_hdr *ipv6_hdr;
+
+		ipv6_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(seg, &ipv6_access);
+		if (!ipv6_hdr) {
+			return -ENOBUFS;
+		}
+
+		ipv6_hdr->len = htons(net_pkt_get_len(seg) -
+				      sizeof(struct net_ipv6_hdr));
+
+		return net_pkt_set_data(seg, &ipv6_access);
+	}
+
+	return -EINVAL;
+}
+
+/* Checksum of the segment from the pseudo header, the TCP header and the sum
+ * of the payload that was computed while copying it.
+ */
+static uint16_t gso_tcp_chksum(struct net_pkt *seg, struct net_tcp_hdr *tcp_hdr,
+			       size_t tcp_len, size_t payload_len, uint16_t sum)
+{
+	const uint8_t *ip_hdr = seg->buffer->data;
+	size_t addr_len;
+	uint32_t acc;
+
+	if (net_pkt_family(seg) == AF_INET) {
+		addr_len = 2 * sizeof(struct in_addr);
+		ip_hdr += offsetof(struct net_ipv4_hdr, src);
+	} else {
+		addr_len = 2 * sizeof(struct in6_addr);
+		ip_hdr += offsetof(struct net_ipv6_hdr, src);
+	}
+
+	acc = sum + tcp_len + payload_len + IPPROTO_TCP;
+	sum = (acc & 0xffff) + (acc >> 16);
+
+	sum = calc_chksum(sum, ip_hdr, addr_len);
+	sum = calc_chksum(sum, (uint8_t *)tcp_hdr, tcp_len);
+	sum = (sum == 0U) ? 0xffff : htons(sum);
+
+	return ~sum;
+}
+
+static struct net_pkt *gso_segment(struct net_pkt *pkt, size_t hdr_len,
+				   size_t offset, size_t len, uint32_t seq,
+				   uint8_t flags, uint16_t index)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_if *iface = net_pkt_iface(pkt);
+	enum net_if_checksum_type type;
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *seg;
+	uint16_t sum = 0U;
+
+	seg = net_pkt_alloc_on_iface(iface, GSO_ALLOC_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	if (net_pkt_alloc_buffer_raw(seg, hdr_len + len, GSO_ALLOC_TIMEOUT) < 0) {
+		goto fail;
+	}
+
+	gso_copy_attributes(seg, pkt);
+
+	/* Headers first, then the payload of this segment which is summed
+	 * while it is copied.
+	 */
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy_chksum(seg, pkt, len, &sum)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (gso_update_ip_hdr(seg, index) < 0 ||
+	    net_pkt_skip(seg, net_pkt_ip_opts_len(seg))) {
+		goto fail;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		goto fail;
+	}
+
+	sys_put_be32(seq, tcp_hdr->seq);
+	tcp_hdr->flags = flags;
+
+	type = net_pkt_family(seg) == AF_INET ? NET_IF_CHECKSUM_IPV4_TCP :
+						NET_IF_CHECKSUM_IPV6_TCP;
+
+	if (seg->buffer->len >= hdr_len) {
+		/* All the headers are in the first buffer */
+		tcp_hdr->chksum = 0U;
+
+		if (net_if_need_calc_tx_checksum(iface, type)) {
+			tcp_hdr->chksum = gso_tcp_chksum(seg, tcp_hdr,
+							 hdr_len - net_pkt_ip_hdr_len(seg) -
+							 net_pkt_ip_opts_len(seg),
+							 len, sum);
+		}
+
+		if (net_pkt_set_data(seg, &tcp_access) < 0) {
+			goto fail;
+		}
+	} else if (net_tcp_finalize(seg, false) < 0) {
+		/* net_tcp_finalize() expects the cursor to be on the TCP header */
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, false);
+
+	return seg;
+
+fail:
+	net_pkt_unref(seg);
+	return NULL;
+}
+
+int net_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	const struct net_l2 *l2 = net_if_l2(iface);
+	uint16_t mss = net_pkt_gso_size(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t ip_hdr_len, hdr_len, pkt_len, offset;
+	uint32_t seq;
+	uint8_t flags;
+	uint16_t index = 0U;
+	int sent = 0;
+	int ret;
+
+	ip_hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_hdr_len)) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_hdr_len + ((tcp_hdr->offset >> 4) * 4U);
+	seq = sys_get_be32(tcp_hdr->seq);
+	flags = tcp_hdr->flags;
+	pkt_len = net_pkt_get_len(pkt);
+
+	if (pkt_len <= hdr_len || mss == 0U) {
+		return -EINVAL;
+	}
+
+	NET_DBG("Segmenting pkt %p len %zu mss %u", pkt, pkt_len - hdr_len, mss);
+
+	for (offset = hdr_len; offset < pkt_len; offset += mss) {
+		size_t len = MIN(mss, pkt_len - offset);
+		bool last = (offset + len) == pkt_len;
+		struct net_pkt *seg;
+
+		/* PSH and FIN only belong to the last segment */
+		seg = gso_segment(pkt, hdr_len, offset - hdr_len, len, seq,
+				  last ? flags : (flags & ~(PSH | FIN)), index);
+		if (!seg) {
+			NET_DBG("Cannot allocate segment at offset %zu",
+				offset - hdr_len);
+			ret = -ENOMEM;
+			goto out;
+		}
+
+		ret = l2->send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			goto out;
+		}
+
+		sent += ret;
+		seq += len;
+		index++;
+	}
+
+	ret = 0;
+
+out:
+	/* If nothing could be sent, let the caller drop the packet. Otherwise
+	 * simulate the sending of the original packet, TCP retransmits any
+	 * missing segments.
+	 */
+	if (sent == 0 && ret < 0) {
+		return ret;
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+}
+
+int net_gso_finalize_local(struct net_pkt *pkt)
+{
+	int ret;
+
+	if (net_pkt_gso_size(pkt) == 0U) {
+		return 0;
+	}
+
+	net_pkt_set_gso_size(pkt, 0U);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt))) {
+		return -ENOBUFS;
+	}
+
+	/* The checksum was left to the segmentation, which is not done */
+	ret = net_tcp_finalize(pkt, true);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, false);
+
+	return ret;
+}
@@ -35,6 +35,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv4.h"
 #include "ipv6.h"
+#include "route.h"
 
 #include "net_stats.h"
 
@@ -259,7 +260,14 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		}
 
 		net_if_tx_lock(iface);
-		status = net_if_l2(iface)->send(iface, pkt);
+
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) > 0U &&
+		    !net_if_eth_hw_caps_supported(iface, ETHERNET_HW_TSO)) {
+			status = net_gso_send(iface, pkt);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
+
 		net_if_tx_unlock(iface);
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS) ||
@@ -751,6 +759,8 @@ static void iface_router_notify_deletion(struct net_if_router *router,
 			net_sprint_ipv6_addr(net_if_router_ipv6(router)),
 			delete_reason);
 
+		net_route_cache_flush();
+
 		net_mgmt_event_notify_with_info(NET_EVENT_IPV6_ROUTER_DEL,
 						router->iface,
 						&router->address.in6_addr,
@@ -878,6 +888,8 @@ static struct net_if_router *iface_router_add(struct net_if *iface,
 		if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
 			memcpy(net_if_router_ipv6(&routers[i]), addr,
 			       sizeof(struct in6_addr));
+			net_route_cache_flush();
+
 			net_mgmt_event_notify_with_info(
 					NET_EVENT_IPV6_ROUTER_ADD, iface,
 					&routers[i].address.in6_addr,
@@ -944,6 +956,7 @@ void net_if_router_rm(struct net_if_router *router)
 	k_mutex_lock(&lock, K_FOREVER);
 
 	router->is_used = false;
+	net_route_cache_flush();
 
 	/* FIXME - remove timer */
 
@@ -5564,6 +5577,29 @@ static bool need_calc_checksum(struct net_if *iface, enum ethernet_hw_caps caps,
 #endif
 }
 
+bool net_if_eth_hw_caps_supported(struct net_if *iface, uint32_t caps)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		if (!(IS_ENABLED(CONFIG_NET_VLAN) && net_eth_is_vlan_interface(iface))) {
+			return false;
+		}
+
+		iface = net_eth_get_vlan_main(iface);
+		if (iface == NULL) {
+			return false;
+		}
+	}
+
+	return (net_eth_get_hw_capabilities(iface) & caps) == caps;
+#else
+	ARG_UNUSED(iface);
+	ARG_UNUSED(caps);
+
+	return false;
+#endif
+}
+
 bool net_if_need_calc_tx_checksum(struct net_if *iface, enum net_if_checksum_type chksum_type)
 {
 	return need_calc_checksum(iface, ETHERNET_HW_TX_CHKSUM_OFFLOAD, chksum_type);
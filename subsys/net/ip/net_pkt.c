@@ -1954,12 +1954,12 @@ int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length)
 	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true);
 }
 
-int net_pkt_copy(struct net_pkt *pkt_dst,
-		 struct net_pkt *pkt_src,
-		 size_t length)
+static int pkt_copy(struct net_pkt *pkt_dst, struct net_pkt *pkt_src,
+		    size_t length, uint16_t *sum)
 {
 	struct net_pkt_cursor *c_dst = &pkt_dst->cursor;
 	struct net_pkt_cursor *c_src = &pkt_src->cursor;
+	bool odd = false;
 
 	while (c_dst->buf && c_src->buf && length) {
 		size_t s_len, d_len, len;
@@ -1987,7 +1987,20 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 			break;
 		}
 
-		memcpy(c_dst->pos, c_src->pos, len);
+		if (!IS_ENABLED(CONFIG_NET_RAW_MODE) && sum != NULL) {
+			uint32_t part = calc_chksum_copy(0, c_dst->pos, c_src->pos, len);
+
+			/* A chunk starting on an odd offset is summed byte swapped */
+			if (odd) {
+				part = BSWAP_16((uint16_t)part);
+			}
+
+			part += *sum;
+			*sum = (part & 0xffff) + (part >> 16);
+			odd ^= (len & 0x01);
+		} else {
+			memcpy(c_dst->pos, c_src->pos, len);
+		}
 
 		if (!net_pkt_is_being_overwritten(pkt_dst)) {
 			net_buf_add(c_dst->buf, len);
@@ -2007,6 +2020,19 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 	return 0;
 }
 
+int net_pkt_copy(struct net_pkt *pkt_dst,
+		 struct net_pkt *pkt_src,
+		 size_t length)
+{
+	return pkt_copy(pkt_dst, pkt_src, length, NULL);
+}
+
+int net_pkt_copy_chksum(struct net_pkt *pkt_dst, struct net_pkt *pkt_src,
+			size_t length, uint16_t *sum)
+{
+	return pkt_copy(pkt_dst, pkt_src, length, sum);
+}
+
 #if defined(NET_PKT_HAS_CONTROL_BLOCK)
 static inline void clone_pkt_cb(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 {
@@ -2042,8 +2068,10 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_forwarding(clone_pkt, net_pkt_forwarding(pkt));
 	net_pkt_set_chksum_done(clone_pkt, net_pkt_is_chksum_done(pkt));
 	net_pkt_set_ip_reassembled(pkt, net_pkt_is_ip_reassembled(pkt));
+	net_pkt_set_gro(clone_pkt, net_pkt_is_gro(pkt));
 	net_pkt_set_cooked_mode(clone_pkt, net_pkt_is_cooked_mode(pkt));
 	net_pkt_set_ipv4_pmtu(clone_pkt, net_pkt_ipv4_pmtu(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
 	net_pkt_set_l2_processed(clone_pkt, net_pkt_is_l2_processed(pkt));
 	net_pkt_set_ll_proto_type(clone_pkt, net_pkt_ll_proto_type(pkt));
@@ -2227,6 +2255,18 @@ int net_pkt_pull(struct net_pkt *pkt, size_t length)
 			rem = length;
 		}
 
+		if (left > rem && c_op->pos == c_op->buf->data &&
+		    (c_op->buf->flags & NET_BUF_EXTERNAL_DATA)) {
+			/* External data (e.g. zero-copy application buffers)
+			 * must not be written to, so move the start of the
+			 * fragment instead.
+			 */
+			net_buf_pull(c_op->buf, rem);
+			c_op->pos = c_op->buf->data;
+			length -= rem;
+			continue;
+		}
+
 		c_op->buf->len -= rem;
 		left -= rem;
 		if (left) {
@@ -2348,6 +2388,181 @@ int net_pkt_set_data(struct net_pkt *pkt,
 	return net_pkt_write(pkt, access->data, access->size);
 }
 
+/* Make len bytes from the cursor contiguous. Only the data at and after the
+ * cursor is moved, either to the tailroom of the current buffer or into a
+ * new buffer inserted at the cursor.
+ */
+/* Buffers are shared if they are referenced elsewhere, e.g. by a shallow clone
+ * which only holds a reference on the first one.
+ */
+static bool pkt_buffer_is_shared(struct net_pkt *pkt)
+{
+	for (struct net_buf *buf = pkt->buffer; buf; buf = buf->frags) {
+		if (buf->ref > 1U) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Give the packet its own copy of the data, the shared buffers are untouched */
+static int pkt_buffer_unshare(struct net_pkt *pkt)
+{
+	size_t offset = net_pkt_get_current_offset(pkt);
+	struct net_buf *shared = pkt->buffer;
+	struct net_buf *dst;
+
+	pkt->buffer = NULL;
+
+	if (net_pkt_alloc_buffer_raw(pkt, net_buf_frags_len(shared),
+				     K_NO_WAIT) < 0) {
+		pkt->buffer = shared;
+		return -ENOBUFS;
+	}
+
+	dst = pkt->buffer;
+
+	for (struct net_buf *src = shared; src; src = src->frags) {
+		const uint8_t *data = src->data;
+		size_t left = src->len;
+
+		while (left > 0U) {
+			size_t n = MIN(left, net_buf_tailroom(dst));
+
+			if (n == 0U) {
+				dst = dst->frags;
+				continue;
+			}
+
+			net_buf_add_mem(dst, data, n);
+			data += n;
+			left -= n;
+		}
+	}
+
+	net_pkt_frag_unref(shared);
+
+	net_pkt_cursor_init(pkt);
+
+	return net_pkt_skip(pkt, offset);
+}
+
+static int pkt_hdr_linearize(struct net_pkt *pkt, size_t len)
+{
+	struct net_buf *cur;
+	size_t offset;
+	size_t copied;
+	struct net_buf *buf, *frag;
+
+	if (net_pkt_remaining_data(pkt) < len) {
+		return -ENODATA;
+	}
+
+	if (pkt_buffer_is_shared(pkt)) {
+		int ret = pkt_buffer_unshare(pkt);
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (net_pkt_is_contiguous(pkt, len)) {
+			return 0;
+		}
+	}
+
+	cur = pkt->cursor.buf;
+	offset = pkt->cursor.pos - cur->data;
+	copied = cur->len - offset;
+
+	if (net_buf_tailroom(cur) >= len - copied) {
+		buf = cur;
+	} else {
+		size_t max;
+
+		buf = net_pkt_get_frag(pkt, len, K_NO_WAIT);
+		if (!buf) {
+			return -ENOBUFS;
+		}
+
+		max = net_buf_max_len(buf);
+		if (max < len) {
+			net_buf_unref(buf);
+			return -ENOBUFS;
+		}
+
+		net_buf_add_mem(buf, pkt->cursor.pos, copied);
+		cur->len = offset;
+
+		if (offset == 0U) {
+			/* Nothing left in the current buffer, replace it */
+			if (pkt->buffer == cur) {
+				pkt->buffer = buf;
+			} else {
+				for (frag = pkt->buffer; frag->frags != cur;
+				     frag = frag->frags) {
+				}
+
+				frag->frags = buf;
+			}
+
+			buf->frags = cur->frags;
+			cur->frags = NULL;
+			net_buf_unref(cur);
+		} else {
+			buf->frags = cur->frags;
+			cur->frags = buf;
+		}
+
+		pkt->cursor.buf = buf;
+		pkt->cursor.pos = buf->data;
+
+		/* Fill the new buffer so the following headers are likely
+		 * to be contiguous as well.
+		 */
+		len = MIN(max, net_pkt_remaining_data(pkt));
+	}
+
+	frag = buf->frags;
+
+	while (copied < len) {
+		size_t n = MIN(frag->len, len - copied);
+
+		net_buf_add_mem(buf, frag->data, n);
+		net_buf_pull(frag, n);
+		copied += n;
+
+		if (frag->len == 0U) {
+			frag = net_buf_frag_del(buf, frag);
+		}
+	}
+
+	return 0;
+}
+
+void *net_pkt_hdr_pull(struct net_pkt *pkt, size_t len)
+{
+	void *hdr;
+
+	NET_ASSERT(net_pkt_is_being_overwritten(pkt));
+
+	if (!net_pkt_is_contiguous(pkt, len)) {
+		if (IS_ENABLED(CONFIG_NET_HEADERS_ALWAYS_CONTIGUOUS) ||
+		    !pkt->cursor.buf || pkt_hdr_linearize(pkt, len) < 0) {
+			NET_DBG("Cannot pull %zu bytes header", len);
+			return NULL;
+		}
+	}
+
+	hdr = pkt->cursor.pos;
+
+	if (net_pkt_skip(pkt, len)) {
+		return NULL;
+	}
+
+	return hdr;
+}
+
 void net_pkt_init(void)
 {
 #if CONFIG_NET_PKT_LOG_LEVEL >= LOG_LEVEL_DBG
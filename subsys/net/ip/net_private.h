@@ -60,8 +60,11 @@ extern void net_if_post_init(void);
 extern void net_if_stats_reset(struct net_if *iface);
 extern void net_if_stats_reset_all(void);
 extern const char *net_if_oper_state2str(enum net_if_oper_state state);
-extern void net_process_rx_packet(struct net_pkt *pkt);
+struct net_gro;
+
+extern void net_process_rx_packet(struct net_pkt *pkt, struct net_gro *gro);
 extern void net_process_tx_packet(struct net_pkt *pkt);
+extern bool net_if_eth_hw_caps_supported(struct net_if *iface, uint32_t caps);
 
 extern struct net_if_addr *net_if_ipv4_addr_get_first_by_index(int ifindex);
 
@@ -142,6 +145,118 @@ static inline int net_context_get_local_addr(struct net_context *context,
 }
 #endif
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/* Wrap an application buffer into a net_buf fragment that references
+ * the data directly. The zero-copy completion callback of the context
+ * is called when the fragment is freed.
+ */
+struct net_buf *net_context_zerocopy_frag(struct net_context *context,
+					  const void *data, size_t len,
+					  k_timeout_t timeout);
+
+/* Check if a fragment was created by net_context_zerocopy_frag() */
+bool net_context_zerocopy_is_frag(const struct net_buf *buf);
+
+/* Reference len bytes at offset of a zero-copy fragment from a new
+ * fragment, without copying them. The zero-copy fragment is released
+ * when the new fragment is freed.
+ */
+struct net_buf *net_context_zerocopy_ref(struct net_buf *frag, size_t offset,
+					 size_t len, k_timeout_t timeout);
+#else
+static inline struct net_buf *net_context_zerocopy_frag(struct net_context *context,
+							const void *data, size_t len,
+							k_timeout_t timeout)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+	ARG_UNUSED(timeout);
+
+	return NULL;
+}
+
+static inline bool net_context_zerocopy_is_frag(const struct net_buf *buf)
+{
+	ARG_UNUSED(buf);
+
+	return false;
+}
+
+static inline struct net_buf *net_context_zerocopy_ref(struct net_buf *frag,
+						       size_t offset, size_t len,
+						       k_timeout_t timeout)
+{
+	ARG_UNUSED(frag);
+	ARG_UNUSED(offset);
+	ARG_UNUSED(len);
+	ARG_UNUSED(timeout);
+
+	return NULL;
+}
+#endif
+
+#if defined(CONFIG_NET_TCP_GSO)
+/* Split a TCP super-packet into MSS sized segments and pass them to the L2
+ * of the interface. Returns the number of bytes sent, in which case the
+ * packet has been consumed, or <0 on error.
+ */
+extern int net_gso_send(struct net_if *iface, struct net_pkt *pkt);
+
+/* Turn a TCP super-packet that is routed back to us into a regular packet
+ * with a full TCP checksum, as it is not split on the way.
+ */
+extern int net_gso_finalize_local(struct net_pkt *pkt);
+#else
+static inline int net_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return -ENOTSUP;
+}
+
+static inline int net_gso_finalize_local(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_NET_TCP_GRO)
+/* Receive offload state of one RX queue. At most one packet is held while
+ * more segments of the same flow are expected.
+ */
+struct net_gro {
+	struct net_pkt *pkt;
+	uint32_t next_seq;
+	uint16_t count;
+	bool is_loopback;
+};
+
+extern enum net_verdict net_gro_receive(struct net_gro *gro,
+					struct net_pkt *pkt,
+					bool is_loopback);
+extern void net_gro_flush(struct net_gro *gro);
+#else
+static inline enum net_verdict net_gro_receive(struct net_gro *gro,
+					       struct net_pkt *pkt,
+					       bool is_loopback)
+{
+	ARG_UNUSED(gro);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(is_loopback);
+
+	return NET_CONTINUE;
+}
+
+static inline void net_gro_flush(struct net_gro *gro)
+{
+	ARG_UNUSED(gro);
+}
+#endif
+
 #if defined(CONFIG_DNS_SOCKET_DISPATCHER)
 extern void dns_dispatcher_init(void);
 #else
@@ -206,6 +321,20 @@ static inline void net_tc_rx_init(void) { }
 enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
 					       k_timeout_t timeout);
 extern enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+/* Return the Rx traffic class of the flow the packet belongs to, or <0 if
+ * the packet is not part of an IP flow.
+ */
+extern int net_rx_flow2tc(struct net_pkt *pkt);
+#else
+static inline int net_rx_flow2tc(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return -1;
+}
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -279,8 +408,39 @@ extern char *net_byte_to_hex(char *ptr, uint8_t byte, char base, bool pad);
 extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
+extern uint16_t calc_chksum_copy(uint16_t sum_in, uint8_t *dst, const uint8_t *src,
+				 size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/* Copy length bytes like net_pkt_copy() and add them to the checksum *sum
+ * on the way. The copied data is summed as if it started on an even offset.
+ */
+extern int net_pkt_copy_chksum(struct net_pkt *pkt_dst, struct net_pkt *pkt_src,
+			       size_t length, uint16_t *sum);
+
+/* Incremental update of a checksum field, RFC 1624 eqn. 3:
+ * HC' = ~(~HC + ~m + m'). The values are taken as they are stored in the
+ * packet, so no byte order conversion is needed.
+ */
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + (uint32_t)new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum;
+}
+
+static inline uint16_t net_chksum_update32(uint16_t chksum, uint32_t old_val,
+					   uint32_t new_val)
+{
+	chksum = net_chksum_update16(chksum, old_val >> 16, new_val >> 16);
+
+	return net_chksum_update16(chksum, old_val & 0xffff, new_val & 0xffff);
+}
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
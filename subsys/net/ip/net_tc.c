@@ -13,10 +13,12 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "ipv4.h"
 
 #define TC_RX_PSEUDO_QUEUE (COND_CODE_1(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO, (1), (0)))
 #define NET_TC_RX_EFFECTIVE_COUNT (NET_TC_RX_COUNT + TC_RX_PSEUDO_QUEUE)
@@ -65,6 +67,10 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
 #endif
 
+#if defined(CONFIG_NET_TCP_GRO)
+static struct net_gro rx_gro[NET_TC_RX_COUNT];
+#endif
+
 enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
 					       k_timeout_t timeout)
 {
@@ -149,6 +155,112 @@ int net_rx_priority2tc(enum net_priority prio)
 #endif
 }
 
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+static uint32_t flow_hash_add(uint32_t hash, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+		hash ^= UNALIGNED_GET((const uint32_t *)(data + i));
+		hash = (hash << 13) | (hash >> 19);
+		hash = hash * 5U + 0xe6546b64U;
+	}
+
+	return hash;
+}
+
+static uint32_t flow_hash_final(uint32_t hash)
+{
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bU;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35U;
+	hash ^= hash >> 16;
+
+	return hash;
+}
+
+/* Calculate a hash over the addresses and ports of the packet. Only the
+ * first fragment is looked at, which must contain the headers. Returns 0
+ * if the packet is not an IP packet.
+ */
+static uint32_t flow_hash(struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+	const uint8_t *data = buf->data;
+	size_t len = buf->len;
+	uint32_t hash = 0U;
+	size_t hdr_len;
+	uint8_t proto;
+
+	if (IS_ENABLED(CONFIG_NET_L2_ETHERNET) &&
+	    net_if_l2(net_pkt_iface(pkt)) == &NET_L2_GET_NAME(ETHERNET)) {
+		size_t eth_len = sizeof(struct net_eth_hdr);
+
+		if (len < eth_len + sizeof(uint32_t)) {
+			return 0U;
+		}
+
+		if (((struct net_eth_hdr *)data)->type == htons(NET_ETH_PTYPE_VLAN)) {
+			eth_len += sizeof(uint32_t);
+		}
+
+		data += eth_len;
+		len -= eth_len;
+	}
+
+	if (len >= sizeof(struct net_ipv4_hdr) && (data[0] & 0xf0) == 0x40) {
+		const struct net_ipv4_hdr *hdr = (const struct net_ipv4_hdr *)data;
+
+		hash = flow_hash_add(hash, hdr->src, 2 * NET_IPV4_ADDR_SIZE);
+		hdr_len = (hdr->vhl & NET_IPV4_IHL_MASK) * 4U;
+		proto = hdr->proto;
+
+		/* Only the first fragment has the ports */
+		if ((sys_get_be16(hdr->offset) &
+		     (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) != 0U) {
+			proto = 0U;
+		}
+	} else if (len >= sizeof(struct net_ipv6_hdr) && (data[0] & 0xf0) == 0x60) {
+		const struct net_ipv6_hdr *hdr = (const struct net_ipv6_hdr *)data;
+
+		hash = flow_hash_add(hash, hdr->src, 2 * NET_IPV6_ADDR_SIZE);
+		hdr_len = sizeof(*hdr);
+		proto = hdr->nexthdr;
+	} else {
+		return 0U;
+	}
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    len >= hdr_len + sizeof(uint32_t)) {
+		/* Source and destination ports */
+		hash = flow_hash_add(hash, data + hdr_len, sizeof(uint32_t));
+	}
+
+	hash = flow_hash_final(hash ^ proto);
+
+	return hash != 0U ? hash : 1U;
+}
+
+int net_rx_flow2tc(struct net_pkt *pkt)
+{
+	uint32_t hash = net_pkt_rx_hash(pkt);
+
+	if (hash == 0U) {
+		if (pkt->buffer == NULL) {
+			return -1;
+		}
+
+		hash = flow_hash(pkt);
+		if (hash == 0U) {
+			return -1;
+		}
+
+		net_pkt_set_rx_hash(pkt, hash);
+	}
+
+	return hash % NET_TC_RX_COUNT;
+}
+#endif /* CONFIG_NET_TC_RX_FLOW_STEERING */
+
 #if defined(CONFIG_NET_TC_THREAD_PRIO_CUSTOM)
 #define BASE_PRIO_TX CONFIG_NET_TC_TX_THREAD_BASE_PRIO
 #elif defined(CONFIG_NET_TC_THREAD_COOPERATIVE)
@@ -287,14 +399,13 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #if NET_TC_RX_COUNT > 0
 static void tc_rx_handler(void *p1, void *p2, void *p3)
 {
-	ARG_UNUSED(p3);
-
 	struct k_fifo *fifo = p1;
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
 	struct k_sem *fifo_slot = p2;
 #else
 	ARG_UNUSED(p2);
 #endif
+	struct net_gro *gro = p3;
 	struct net_pkt *pkt;
 
 	while (1) {
@@ -307,7 +418,14 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 		k_sem_give(fifo_slot);
 #endif
 
-		net_process_rx_packet(pkt);
+		net_process_rx_packet(pkt, gro);
+
+		/* Do not keep a coalesced packet around if there is nothing
+		 * more to merge it with.
+		 */
+		if (gro != NULL && k_fifo_is_empty(fifo)) {
+			net_gro_flush(gro);
+		}
 	}
 }
 #endif
@@ -406,6 +524,12 @@ void net_tc_tx_init(void)
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_TC_THREAD_CPU_PIN)
+		if (k_thread_cpu_pin(tid, i % arch_num_cpus()) < 0) {
+			NET_WARN("Cannot pin %s thread %d to CPU", "TX", i);
+		}
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
@@ -430,7 +554,11 @@ void net_tc_rx_init(void)
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		/* Flows are spread over the queues regardless of their
+		 * priority, so no queue may starve the others.
+		 */
+		thread_priority = IS_ENABLED(CONFIG_NET_TC_RX_FLOW_STEERING) ?
+			rx_tc2thread(0) : rx_tc2thread(i);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -460,7 +588,11 @@ void net_tc_rx_init(void)
 #else
 				      NULL,
 #endif
+#if defined(CONFIG_NET_TCP_GRO)
+				      &rx_gro[i],
+#else
 				      NULL,
+#endif
 				      priority, 0, K_FOREVER);
 		if (!tid) {
 			NET_ERR("Cannot create TC handler thread %d", i);
@@ -474,6 +606,12 @@ void net_tc_rx_init(void)
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_TC_THREAD_CPU_PIN)
+		if (k_thread_cpu_pin(tid, i % arch_num_cpus()) < 0) {
+			NET_WARN("Cannot pin %s thread %d to CPU", "RX", i);
+		}
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
@@ -24,6 +24,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include <zephyr/net/net_ip.h>
 
 #include "net_private.h"
+#include "net_stats.h"
 #include "ipv6.h"
 #include "icmpv6.h"
 #include "nbr.h"
@@ -40,6 +41,41 @@ static sys_slist_t active_route_lifetime_timers;
 /* Timer that manages expired route entries. */
 static struct k_work_delayable route_lifetime_timer;
 
+#if defined(CONFIG_NET_ROUTE_CACHE)
+/* Result of net_route_get_info() for a recently used destination. The
+ * entry is valid only while its generation matches the current one, so
+ * bumping the generation invalidates the whole cache at once.
+ */
+struct route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+	struct in6_addr *nexthop;
+	uint32_t gen;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+static atomic_t route_cache_gen = ATOMIC_INIT(1);
+
+void net_route_cache_flush(void)
+{
+	atomic_inc(&route_cache_gen);
+}
+
+static inline struct route_cache_entry *route_cache_get(struct in6_addr *dst)
+{
+	uint32_t hash = UNALIGNED_GET(&dst->s6_addr32[0]) ^
+			UNALIGNED_GET(&dst->s6_addr32[1]) ^
+			UNALIGNED_GET(&dst->s6_addr32[2]) ^
+			UNALIGNED_GET(&dst->s6_addr32[3]);
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+#endif /* CONFIG_NET_ROUTE_CACHE */
+
 static void net_route_nexthop_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Nexthop %p removed", nbr);
@@ -470,6 +506,8 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 #endif
 
 exit:
+	net_route_cache_flush();
+
 	net_ipv6_nbr_unlock();
 	return route;
 }
@@ -588,6 +626,8 @@ int net_route_del(struct net_route_entry *route)
 
 	sys_slist_find_and_remove(&routes, &route->node);
 
+	net_route_cache_flush();
+
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
 		net_ipv6_nbr_unlock();
@@ -966,9 +1006,29 @@ bool net_route_get_info(struct net_if *iface,
 {
 	struct net_if_router *router;
 	bool ret = false;
+#if defined(CONFIG_NET_ROUTE_CACHE)
+	struct route_cache_entry *entry = route_cache_get(dst);
+	uint32_t gen = (uint32_t)atomic_get(&route_cache_gen);
+#endif
 
 	net_ipv6_nbr_lock();
 
+#if defined(CONFIG_NET_ROUTE_CACHE)
+	if (entry->gen == gen && entry->iface == iface &&
+	    net_ipv6_addr_cmp(&entry->dst, dst)) {
+		*route = entry->route;
+		/* A neighbor is its own next hop */
+		*nexthop = entry->nexthop ? entry->nexthop : dst;
+
+		if (*route) {
+			update_route_access(*route);
+		}
+
+		net_ipv6_nbr_unlock();
+		return true;
+	}
+#endif
+
 	/* Search in neighbor table first, if not search in routing table. */
 	if (net_ipv6_nbr_lookup(iface, dst)) {
 		/* Found nexthop, no need to look into routing table. */
@@ -1004,6 +1064,16 @@ bool net_route_get_info(struct net_if *iface,
 	}
 
 exit:
+#if defined(CONFIG_NET_ROUTE_CACHE)
+	if (ret) {
+		net_ipaddr_copy(&entry->dst, dst);
+		entry->iface = iface;
+		entry->route = *route;
+		entry->nexthop = *nexthop != dst ? *nexthop : NULL;
+		entry->gen = gen;
+	}
+#endif
+
 	net_ipv6_nbr_unlock();
 	return ret;
 }
@@ -1029,6 +1099,29 @@ static bool is_ll_addr_supported(struct net_if *iface)
 	return true;
 }
 
+/* Queue a forwarded packet with a resolved next hop directly to the
+ * outgoing interface. The checks of net_send_data() are meant for locally
+ * generated packets and the link layer destination is already known, so
+ * only the packet size needs to be verified.
+ */
+static int route_forward_fast(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+
+	if (net_pkt_get_len(pkt) > MAX(NET_IPV6_MTU, net_if_get_mtu(iface)) ||
+	    !net_if_flag_is_set(iface, NET_IF_LOWER_UP) ||
+	    net_if_flag_is_set(iface, NET_IF_SUSPENDED)) {
+		return net_send_data(pkt);
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_if_queue_tx(iface, pkt);
+
+	net_stats_update_ipv6_sent(iface);
+
+	return 0;
+}
+
 int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 {
 	struct net_linkaddr *lladdr = NULL;
@@ -1091,6 +1184,11 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 
 	net_ipv6_nbr_unlock();
 
+	if (IS_ENABLED(CONFIG_NET_ROUTE_FORWARD_FAST_PATH) &&
+	    (lladdr != NULL || !is_ll_addr_supported(net_pkt_iface(pkt)))) {
+		return route_forward_fast(pkt);
+	}
+
 	return net_send_data(pkt);
 
 error:
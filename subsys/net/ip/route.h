@@ -328,6 +328,20 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
  */
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface);
 
+/**
+ * @brief Invalidate all cached route lookups.
+ *
+ * Must be called whenever a route, a neighbor or a router is added or
+ * removed.
+ */
+#if defined(CONFIG_NET_ROUTE_CACHE) && defined(CONFIG_NET_NATIVE)
+void net_route_cache_flush(void);
+#else
+static inline void net_route_cache_flush(void)
+{
+}
+#endif
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
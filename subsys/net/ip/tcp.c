@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #endif
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_context.h>
+#include <zephyr/net/socket.h>
 #include <zephyr/net/udp.h>
 #include "ipv4.h"
 #include "ipv6.h"
@@ -39,25 +40,49 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
 static int tcp_max_timeout_ms;
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+#define TCP_RX_POOL_SIZE (CONFIG_NET_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE)
+#define TCP_TX_POOL_SIZE (CONFIG_NET_BUF_TX_COUNT * CONFIG_NET_BUF_DATA_SIZE)
+#else
+#define TCP_RX_POOL_SIZE CONFIG_NET_PKT_BUF_RX_DATA_POOL_SIZE
+#define TCP_TX_POOL_SIZE CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE
+#endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
+
+/* With window scaling or autotuning, the default windows stay within 64 kB
+ * and only grow beyond it when configured or tuned to.
+ */
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) || defined(CONFIG_NET_TCP_AUTOTUNE)
+#define TCP_DEFAULT_WINDOW(pool_size) MIN((pool_size) / 3, UINT16_MAX)
+#else
+#define TCP_DEFAULT_WINDOW(pool_size) ((pool_size) / 3)
+#endif
+
 static int tcp_rx_window =
 #if (CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE != 0)
 	CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE;
 #else
-#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
-	(CONFIG_NET_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE) / 3;
-#else
-	CONFIG_NET_PKT_BUF_RX_DATA_POOL_SIZE / 3;
-#endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
+	TCP_DEFAULT_WINDOW(TCP_RX_POOL_SIZE);
 #endif
 static int tcp_tx_window =
 #if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE != 0)
 	CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE;
 #else
-#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
-	(CONFIG_NET_BUF_TX_COUNT * CONFIG_NET_BUF_DATA_SIZE) / 3;
-#else
-	CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE / 3;
-#endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
+	TCP_DEFAULT_WINDOW(TCP_TX_POOL_SIZE);
+#endif
+
+/* Largest window that can be advertised */
+#define TCP_WIN_MAX (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ?			\
+		     ((uint32_t)UINT16_MAX << NET_TCP_MAX_WINDOW_SCALE) :	\
+		     (uint32_t)UINT16_MAX)
+
+/* Window shift we offer to the peer, chosen at init so that the largest
+ * receive window can be advertised.
+ */
+static uint8_t tcp_rcv_wscale;
+
+#if defined(CONFIG_NET_TCP_AUTOTUNE)
+static atomic_t tcp_autotune_mem;
+static uint32_t tcp_autotune_budget;
 #endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 #define TCP_RTO_MS (conn->rto)
@@ -97,79 +122,18 @@ static void tcp_set_seq(struct net_buf *buf, uint32_t seq)
 	*(uint32_t *)net_buf_user_data(buf) = seq;
 }
 
-static int tcp_pkt_linearize(struct net_pkt *pkt, size_t pos, size_t len)
-{
-	struct net_buf *buf, *first = pkt->cursor.buf, *second = first->frags;
-	int ret = 0;
-	size_t len1, len2;
-
-	if (net_pkt_get_len(pkt) < (pos + len)) {
-		NET_ERR("Insufficient packet len=%zd (pos+len=%zu)",
-			net_pkt_get_len(pkt), pos + len);
-		ret = -EINVAL;
-		goto out;
-	}
-
-	buf = net_pkt_get_frag(pkt, len, TCP_PKT_ALLOC_TIMEOUT);
-
-	if (!buf || net_buf_max_len(buf) < len) {
-		if (buf) {
-			net_buf_unref(buf);
-		}
-		ret = -ENOBUFS;
-		goto out;
-	}
-
-	net_buf_linearize(buf->data, net_buf_max_len(buf), pkt->frags, pos, len);
-	net_buf_add(buf, len);
-
-	len1 = first->len - (pkt->cursor.pos - pkt->cursor.buf->data);
-	len2 = len - len1;
-
-	first->len -= len1;
-
-	while (len2) {
-		size_t pull_len = MIN(second->len, len2);
-		struct net_buf *next;
-
-		len2 -= pull_len;
-		net_buf_pull(second, pull_len);
-		next = second->frags;
-		if (second->len == 0) {
-			net_buf_unref(second);
-		}
-		second = next;
-	}
-
-	buf->frags = second;
-	first->frags = buf;
- out:
-	return ret;
-}
-
 static struct tcphdr *th_get(struct net_pkt *pkt)
 {
 	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
-	struct tcphdr *th = NULL;
- again:
+
 	net_pkt_cursor_init(pkt);
 	net_pkt_set_overwrite(pkt, true);
 
 	if (net_pkt_skip(pkt, ip_len) != 0) {
-		goto out;
+		return NULL;
 	}
 
-	if (!net_pkt_is_contiguous(pkt, sizeof(*th))) {
-		if (tcp_pkt_linearize(pkt, ip_len, sizeof(*th)) < 0) {
-			goto out;
-		}
-
-		goto again;
-	}
-
-	th = net_pkt_cursor_get_pos(pkt);
- out:
-	return th;
+	return net_pkt_hdr_pull(pkt, sizeof(struct tcphdr));
 }
 
 static size_t tcp_endpoint_len(sa_family_t af)
@@ -484,7 +448,7 @@ static void tcp_new_reno_dup_ack(struct tcp *conn)
 	int32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	conn->ca.cwnd = MIN(new_win, TCP_WIN_MAX);
 	tcp_new_reno_log(conn, "dup_ack");
 }
 
@@ -500,7 +464,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			/* Implement a div_ceil	to avoid rounding to 0 */
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.cwnd = MIN(new_win, TCP_WIN_MAX);
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -791,6 +755,11 @@ static void tcp_conn_release(struct k_work *work)
 	conn->context->tcp = NULL;
 	conn->state = TCP_UNUSED;
 
+#if defined(CONFIG_NET_TCP_AUTOTUNE)
+	/* Give the window growth back to the autotuning budget */
+	atomic_sub(&tcp_autotune_mem, conn->tune.charged);
+#endif
+
 	tcp_send_queue_flush(conn);
 
 	(void)k_work_cancel_delayable(&conn->send_data_timer);
@@ -1145,8 +1114,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = MIN(options[2],
+						   NET_TCP_MAX_WINDOW_SCALE);
 			recv_options->wnd_found = true;
+			NET_DBG("WS=%hu", (uint16_t)recv_options->window);
 			break;
 		default:
 			continue;
@@ -1160,6 +1131,176 @@ end:
 	return result;
 }
 
+#if defined(CONFIG_NET_TCP_AUTOTUNE)
+/* Grow a window towards target, taking the memory from the global budget */
+static uint32_t tcp_autotune_grow(struct tcp *conn, uint32_t cur,
+				  uint32_t target, uint32_t limit)
+{
+	atomic_val_t used;
+	uint32_t delta;
+
+	target = MIN(target, MIN(limit, CONFIG_NET_TCP_AUTOTUNE_MAX_WINDOW_SIZE));
+	if (target <= cur) {
+		return cur;
+	}
+
+	do {
+		used = atomic_get(&tcp_autotune_mem);
+		if ((uint32_t)used >= tcp_autotune_budget) {
+			NET_DBG("conn: %p autotune budget exhausted", conn);
+			return cur;
+		}
+
+		delta = MIN(target - cur, tcp_autotune_budget - (uint32_t)used);
+	} while (!atomic_cas(&tcp_autotune_mem, used, used + delta));
+
+	conn->tune.charged += delta;
+
+	return cur + delta;
+}
+
+/* Called for in-order data of len bytes that starts at conn->ack */
+static void tcp_autotune_rcv(struct tcp *conn, size_t len)
+{
+	struct tcp_autotune *tune = &conn->tune;
+	uint32_t now = k_uptime_get_32();
+	uint32_t end = conn->ack + len;
+	uint32_t received;
+	uint32_t win;
+
+	if (!tune->rcv_started) {
+		tune->rcv_started = true;
+		tune->rcv_space_seq = conn->ack;
+		tune->rcv_space_time = now;
+	}
+
+	/* Without timestamps the round trip time is estimated as the time it
+	 * takes for the data to reach the window edge we last advertised.
+	 */
+	if (tune->rcv_rtt_active &&
+	    net_tcp_seq_cmp(end, tune->rcv_rtt_seq) >= 0) {
+		uint32_t sample = MAX(now - tune->rcv_rtt_time, 1U);
+
+		tune->rcv_rtt = tune->rcv_rtt == 0U ? sample :
+				(7U * tune->rcv_rtt + sample) / 8U;
+		tune->rcv_rtt_active = false;
+	}
+
+	if (!tune->rcv_rtt_active) {
+		tune->rcv_rtt_seq = end + conn->recv_win;
+		tune->rcv_rtt_time = now;
+		tune->rcv_rtt_active = true;
+	}
+
+	if (tune->rcv_rtt == 0U || now - tune->rcv_space_time < tune->rcv_rtt) {
+		return;
+	}
+
+	received = end - tune->rcv_space_seq;
+	tune->rcv_space_seq = end;
+	tune->rcv_space_time = now;
+
+	if (received <= tune->rcv_space) {
+		return;
+	}
+
+	tune->rcv_space = received;
+
+	if (tune->rcvbuf_locked) {
+		return;
+	}
+
+	/* Twice the data of one round trip lets the sender keep going while
+	 * the application is reading.
+	 */
+	win = tcp_autotune_grow(conn, conn->recv_win_max, 2U * received,
+				(uint32_t)UINT16_MAX << conn->rcv_wscale);
+	if (win > conn->recv_win_max) {
+		NET_DBG("conn: %p recv window %u -> %u (rtt %u ms)", conn,
+			conn->recv_win_max, win, tune->rcv_rtt);
+
+		conn->recv_win += win - conn->recv_win_max;
+		conn->recv_win_max = win;
+	}
+}
+
+/* Called when a segment of len bytes starting at seq has been sent */
+static void tcp_autotune_sent(struct tcp *conn, uint32_t seq, int len)
+{
+	struct tcp_autotune *tune = &conn->tune;
+	uint32_t end = seq + len;
+
+	if (!tune->snd_started) {
+		tune->snd_started = true;
+		tune->snd_max = seq;
+		tune->snd_space_seq = seq;
+	}
+
+	if (net_tcp_seq_cmp(end, tune->snd_max) <= 0) {
+		/* Karn's algorithm, retransmitted data is not timed */
+		if (tune->snd_rtt_active &&
+		    net_tcp_seq_cmp(seq, tune->snd_rtt_seq) < 0) {
+			tune->snd_rtt_active = false;
+		}
+
+		return;
+	}
+
+	tune->snd_max = end;
+
+	if (!tune->snd_rtt_active) {
+		tune->snd_rtt_seq = end;
+		tune->snd_rtt_time = k_uptime_get_32();
+		tune->snd_rtt_active = true;
+	}
+}
+
+/* Called when new data has been acknowledged and conn->seq advanced */
+static void tcp_autotune_acked(struct tcp *conn)
+{
+	struct tcp_autotune *tune = &conn->tune;
+	uint32_t delivered;
+	uint32_t win;
+
+	if (!tune->snd_rtt_active ||
+	    net_tcp_seq_cmp(conn->seq, tune->snd_rtt_seq) < 0) {
+		return;
+	}
+
+	tune->snd_rtt_active = false;
+
+	delivered = conn->seq - tune->snd_space_seq;
+	tune->snd_space_seq = conn->seq;
+
+	/* Only grow if our own buffer, not the peer, limited the sending */
+	if (tune->sndbuf_locked || tune->peer_win <= conn->send_win_max ||
+	    delivered <= conn->send_win_max / 2U) {
+		return;
+	}
+
+	win = tcp_autotune_grow(conn, conn->send_win_max, 2U * delivered,
+				(uint32_t)UINT16_MAX << conn->snd_wscale);
+	if (win > conn->send_win_max) {
+		NET_DBG("conn: %p send window %u -> %u (rtt %u ms)", conn,
+			conn->send_win_max, win,
+			k_uptime_get_32() - tune->snd_rtt_time);
+
+		conn->send_win_max = win;
+		conn->send_win = MIN(tune->peer_win, win);
+	}
+}
+
+static void tcp_autotune_peer_win(struct tcp *conn, uint32_t win)
+{
+	conn->tune.peer_win = win;
+}
+#else
+static void tcp_autotune_rcv(struct tcp *conn, size_t len) { }
+static void tcp_autotune_sent(struct tcp *conn, uint32_t seq, int len) { }
+static void tcp_autotune_acked(struct tcp *conn) { }
+static void tcp_autotune_peer_win(struct tcp *conn, uint32_t win) { }
+#endif /* CONFIG_NET_TCP_AUTOTUNE */
+
 static bool tcp_short_window(struct tcp *conn)
 {
 	int32_t threshold = MIN(conn_mss(conn), conn->recv_win_max / 2);
@@ -1297,6 +1438,8 @@ static enum net_verdict tcp_data_get(struct tcp *conn, struct net_pkt *pkt, size
 		 */
 		*len += tcp_check_pending_data(conn, pkt, *len);
 
+		tcp_autotune_rcv(conn, *len);
+
 		net_pkt_cursor_init(pkt);
 		net_pkt_set_overwrite(pkt, true);
 
@@ -1338,6 +1481,17 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Window field value for a segment sent to the peer */
+static uint16_t tcp_adv_win(struct tcp *conn, uint8_t flags)
+{
+	/* The window of a SYN segment is never scaled (RFC 7323) */
+	if (flags & SYN) {
+		return MIN(conn->recv_win, UINT16_MAX);
+	}
+
+	return MIN(conn->recv_win >> conn->rcv_wscale, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 			  uint32_t seq)
 {
@@ -1359,8 +1513,12 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 		th->th_off++;
 	}
 
+	if (conn->send_options.wnd_found) {
+		th->th_off++;
+	}
+
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_adv_win(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -1437,6 +1595,51 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &mss_opt_access);
 }
 
+static int net_tcp_set_wnd_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(wnd_opt_access, uint32_t);
+	uint32_t *wnd;
+	uint32_t opt;
+
+	wnd = net_pkt_get_data(pkt, &wnd_opt_access);
+	if (!wnd) {
+		return -ENOBUFS;
+	}
+
+	/* Padded to 32 bits with a leading NOP */
+	opt = (NET_TCP_NOP_OPT << 24) | (NET_TCP_WINDOW_SCALE_OPT << 16) |
+	      (NET_TCP_WINDOW_SCALE_SIZE << 8) | tcp_rcv_wscale;
+
+	UNALIGNED_PUT(htonl(opt), wnd);
+
+	return net_pkt_set_data(pkt, &wnd_opt_access);
+}
+
+/* Called when the handshake is done. The window scale is only used if both
+ * ends sent the option in their SYN segments.
+ */
+static void tcp_wscale_negotiated(struct tcp *conn)
+{
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    conn->recv_options.wnd_found) {
+		conn->rcv_wscale = tcp_rcv_wscale;
+		conn->snd_wscale = conn->recv_options.window;
+
+		NET_DBG("conn: %p window scale %u/%u", conn, conn->rcv_wscale,
+			conn->snd_wscale);
+		return;
+	}
+
+	conn->rcv_wscale = 0U;
+	conn->snd_wscale = 0U;
+
+	/* Nothing larger than 64 kB can be advertised */
+	conn->recv_win_max = MIN(conn->recv_win_max, UINT16_MAX);
+	conn->recv_win = MIN(conn->recv_win, conn->recv_win_max);
+	conn->send_win_max = MIN(conn->send_win_max, UINT16_MAX);
+	conn->send_win = MIN(conn->send_win, conn->send_win_max);
+}
+
 static bool is_destination_local(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -1549,6 +1752,10 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		alloc_len += sizeof(uint32_t);
 	}
 
+	if (conn->send_options.wnd_found) {
+		alloc_len += sizeof(uint32_t);
+	}
+
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1556,6 +1763,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
+		/* Larger than MSS data is sent as a super-packet that is split
+		 * into segments at the L2 boundary.
+		 */
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) &&
+		    net_pkt_get_len(data) > conn_mss(conn)) {
+			net_pkt_set_gso_size(pkt, conn_mss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -1581,6 +1796,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	if (conn->send_options.wnd_found) {
+		ret = net_tcp_set_wnd_opt(conn, pkt);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1649,6 +1872,68 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+/* Check if the send_data packet holds zero-copy application buffers */
+static bool tcp_send_data_is_zerocopy(struct tcp *conn)
+{
+	if (!IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+		return false;
+	}
+
+	for (struct net_buf *buf = conn->send_data->buffer; buf; buf = buf->frags) {
+		if (net_context_zerocopy_is_frag(buf)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Same as tcp_pkt_peek() but the zero-copy application buffers are
+ * referenced by the segment instead of being copied into it.
+ */
+static int tcp_pkt_peek_zerocopy(struct net_pkt *to, struct net_pkt *from,
+				 size_t pos, size_t len)
+{
+	struct net_buf *buf = from->buffer;
+	struct net_buf *frag;
+	size_t chunk;
+
+	while (buf != NULL && pos >= buf->len) {
+		pos -= buf->len;
+		buf = buf->frags;
+	}
+
+	while (len > 0 && buf != NULL) {
+		chunk = MIN(len, buf->len - pos);
+
+		if (net_context_zerocopy_is_frag(buf)) {
+			frag = net_context_zerocopy_ref(buf, pos, chunk,
+							TCP_PKT_ALLOC_TIMEOUT);
+		} else {
+			frag = net_pkt_get_frag(to, chunk, TCP_PKT_ALLOC_TIMEOUT);
+			if (frag != NULL) {
+				chunk = MIN(chunk, net_buf_tailroom(frag));
+				net_buf_add_mem(frag, buf->data + pos, chunk);
+			}
+		}
+
+		if (frag == NULL) {
+			return -ENOBUFS;
+		}
+
+		net_pkt_append_buffer(to, frag);
+
+		len -= chunk;
+		pos += chunk;
+		if (pos == buf->len) {
+			buf = buf->frags;
+			pos = 0;
+		}
+	}
+
+	return (len > 0) ? -ENOBUFS : 0;
+}
+
 static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 {
 	size_t alloc_len = len;
@@ -1692,6 +1977,82 @@ static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 	return ret;
 }
 
+/* Produce up to len bytes with the fill callback into new buffers allocated
+ * for the packet, which are returned in data. Returns the number of bytes
+ * produced, which is less than len if the callback runs out of data.
+ */
+static int tcp_buf_fill(struct net_pkt *pkt, size_t len,
+			net_tcp_fill_cb_t fill, void *user_data,
+			struct net_buf **data)
+{
+	struct net_buf *head = NULL;
+	size_t filled = 0;
+	int ret = 0;
+
+	while (filled < len) {
+		struct net_buf *buf;
+		size_t fill_len;
+
+		buf = net_pkt_get_frag(pkt, len - filled, TCP_PKT_ALLOC_TIMEOUT);
+		if (buf == NULL) {
+			ret = -ENOBUFS;
+			break;
+		}
+
+		fill_len = MIN(len - filled, net_buf_tailroom(buf));
+
+		ret = fill(net_buf_tail(buf), fill_len, user_data);
+		if (ret <= 0) {
+			net_buf_unref(buf);
+			break;
+		}
+
+		net_buf_add(buf, ret);
+		head = net_buf_frag_add(head, buf);
+		filled += ret;
+
+		if (ret < fill_len) {
+			break;
+		}
+	}
+
+	*data = head;
+
+	if (filled == 0 && ret < 0) {
+		return ret;
+	}
+
+	return filled;
+}
+
+/* Queue application data to the send_data packet. With zero-copy the
+ * application buffer is referenced until the data has been acknowledged.
+ */
+static int tcp_queue_append(struct tcp *conn, const uint8_t *data, size_t len,
+			    int flags)
+{
+	struct net_buf *frag;
+
+	if (!IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY) ||
+	    !(flags & ZSOCK_MSG_ZEROCOPY)) {
+		return tcp_pkt_append(conn->send_data, data, len);
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+	frag = net_context_zerocopy_frag(conn->context, data, len,
+					 TCP_PKT_ALLOC_TIMEOUT);
+	if (frag == NULL) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_append_buffer(conn->send_data, frag);
+
+	return 0;
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
 	bool window_full = (conn->send_data_total >= conn->send_win);
@@ -1736,13 +2097,52 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* Allocate a data packet for a super-packet. This is opportunistic, if there
+ * are not enough free buffers, the data is sent in MSS sized segments.
+ */
+static struct net_pkt *tcp_gso_pkt_alloc(struct tcp *conn, int len)
+{
+	struct net_pkt *pkt;
+
+	if (len <= conn_mss(conn)) {
+		return NULL;
+	}
+
+	pkt = net_pkt_alloc(K_NO_WAIT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_pkt_alloc_buffer_raw(pkt, len, K_NO_WAIT) < 0) {
+		tcp_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+#else
+#define tcp_gso_pkt_alloc(_conn, _len) NULL
+#endif /* CONFIG_NET_TCP_GSO */
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
+	int max_len = conn_mss(conn);
+	bool zerocopy = tcp_send_data_is_zerocopy(conn);
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Retransmissions are always done one segment at a time, and
+	 * zero-copy segments reference the application buffers directly.
+	 */
+	if (conn->data_mode != TCP_DATA_MODE_RESEND && !zerocopy) {
+		max_len = MAX(max_len, CONFIG_NET_TCP_GSO_MAX_SIZE);
+	}
+#endif
+
+	len = MIN(tcp_unsent_len(conn), max_len);
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1753,14 +2153,28 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
+	if (zerocopy) {
+		/* The payload fragments are added by tcp_pkt_peek_zerocopy() */
+		pkt = tcp_pkt_alloc(conn, 0);
+	} else {
+		pkt = tcp_gso_pkt_alloc(conn, len);
+		if (!pkt) {
+			len = MIN(len, conn_mss(conn));
+			pkt = tcp_pkt_alloc(conn, len);
+		}
+	}
+
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
 		goto out;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
+	if (zerocopy) {
+		ret = tcp_pkt_peek_zerocopy(pkt, conn->send_data, conn->unacked_len, len);
+	} else {
+		ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
+	}
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		ret = -ENOBUFS;
@@ -1769,6 +2183,8 @@ static int tcp_send_data(struct tcp *conn)
 
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
+		tcp_autotune_sent(conn, conn->seq + conn->unacked_len, len);
+
 		conn->unacked_len += len;
 
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
@@ -1776,7 +2192,10 @@ static int tcp_send_data(struct tcp *conn)
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
+
+			for (int seg = 0; seg < len; seg += conn_mss(conn)) {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
 		}
 	}
 
@@ -2130,6 +2549,12 @@ static struct tcp *tcp_conn_alloc(void)
 	conn->recv_win_sent = conn->recv_win_max;
 	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
 	conn->send_win = conn->send_win_max;
+#if defined(CONFIG_NET_TCP_AUTOTUNE)
+	/* Grow the receive window once more than half of it is filled in
+	 * one round trip.
+	 */
+	conn->tune.rcv_space = conn->recv_win_max / 2U;
+#endif
 	conn->tcp_nodelay = false;
 	conn->addr_ref_done = false;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -2139,7 +2564,7 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = TCP_WIN_MAX;
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2774,9 +3199,12 @@ static void tcp_check_sock_options(struct tcp *conn)
 					     &rcvbuf_opt, NULL);
 	}
 
-	if (sndbuf_opt > 0 && sndbuf_opt != conn->send_win_max) {
+	if (sndbuf_opt > 0 && (uint32_t)sndbuf_opt != conn->send_win_max) {
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
+#if defined(CONFIG_NET_TCP_AUTOTUNE)
+		conn->tune.sndbuf_locked = true;
+#endif
 		conn->send_win_max = sndbuf_opt;
 		if (conn->send_win > conn->send_win_max) {
 			conn->send_win = conn->send_win_max;
@@ -2785,11 +3213,14 @@ static void tcp_check_sock_options(struct tcp *conn)
 		k_mutex_unlock(&conn->lock);
 	}
 
-	if (rcvbuf_opt > 0 && rcvbuf_opt != conn->recv_win_max) {
+	if (rcvbuf_opt > 0 && (uint32_t)rcvbuf_opt != conn->recv_win_max) {
 		int diff;
 
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
+#if defined(CONFIG_NET_TCP_AUTOTUNE)
+		conn->tune.rcvbuf_locked = true;
+#endif
 		diff = rcvbuf_opt - conn->recv_win_max;
 		conn->recv_win_max = rcvbuf_opt;
 		tcp_update_recv_wnd(conn, diff);
@@ -2895,7 +3326,16 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (th) {
-		conn->send_win = ntohs(th_win(th));
+		uint32_t peer_win = ntohs(th_win(th));
+
+		/* The window of a SYN segment is never scaled */
+		if (!(th_flags(th) & SYN)) {
+			peer_win <<= conn->snd_wscale;
+		}
+
+		tcp_autotune_peer_win(conn, peer_win);
+
+		conn->send_win = peer_win;
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2929,9 +3369,15 @@ next_state:
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			/* Window scale is only replied if the peer offered it */
+			conn->send_options.wnd_found =
+				IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+				conn->recv_options.wnd_found;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
+			conn->send_options.wnd_found = false;
+			tcp_wscale_negotiated(conn);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -2943,12 +3389,15 @@ next_state:
 			verdict = NET_OK;
 		} else {
 			conn->send_options.mss_found = true;
+			conn->send_options.wnd_found =
+				IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE);
 			ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 			if (ret < 0) {
 				do_close = true;
 				close_status = ret;
 			} else {
 				conn->send_options.mss_found = false;
+				conn->send_options.wnd_found = false;
 				conn_seq(conn, + 1);
 				next = TCP_SYN_SENT;
 				tcp_conn_ref(conn);
@@ -3054,6 +3503,7 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_wscale_negotiated(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3217,6 +3667,8 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+			tcp_autotune_acked(conn);
+
 			/* Receipt of an acknowledgment that covers a sequence number
 			 * not previously acknowledged indicates that the connection
 			 * makes a "forward progress".
@@ -3712,8 +4164,34 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	return ret;
 }
 
+/* Account the data appended to send_data and try to send it. Called with
+ * the connection lock held.
+ */
+static int tcp_queue_commit(struct tcp *conn, size_t queued_len)
+{
+	int ret;
+
+	conn->send_data_total += queued_len;
+
+	/* Successfully queued data for transmission. Even if there's a transmit
+	 * failure now (out-of-buf case), it can be ignored for now, retransmit
+	 * timer will take care of queued data retransmission.
+	 */
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		tcp_conn_close(conn, ret);
+		return ret;
+	}
+
+	if (tcp_window_full(conn)) {
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	}
+
+	return queued_len;
+}
+
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct msghdr *msg)
+		  const struct msghdr *msg, int flags)
 {
 	struct tcp *conn = context->tcp;
 	size_t queued_len = 0;
@@ -3753,9 +4231,9 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		for (int i = 0; i < msg->msg_iovlen; i++) {
 			int iovlen = MIN(msg->msg_iov[i].iov_len, len);
 
-			ret = tcp_pkt_append(conn->send_data,
-					     msg->msg_iov[i].iov_base,
-					     iovlen);
+			ret = tcp_queue_append(conn,
+					       msg->msg_iov[i].iov_base,
+					       iovlen, flags);
 			if (ret < 0) {
 				if (queued_len == 0) {
 					goto out;
@@ -3772,7 +4250,7 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 			}
 		}
 	} else {
-		ret = tcp_pkt_append(conn->send_data, data, len);
+		ret = tcp_queue_append(conn, data, len, flags);
 		if (ret < 0) {
 			goto out;
 		}
@@ -3780,23 +4258,54 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		queued_len = len;
 	}
 
-	conn->send_data_total += queued_len;
+	ret = tcp_queue_commit(conn, queued_len);
+out:
+	k_mutex_unlock(&conn->lock);
 
-	/* Successfully queued data for transmission. Even if there's a transmit
-	 * failure now (out-of-buf case), it can be ignored for now, retransmit
-	 * timer will take care of queued data retransmission.
-	 */
-	ret = tcp_send_queued_data(conn);
-	if (ret < 0 && ret != -ENOBUFS) {
-		tcp_conn_close(conn, ret);
-		goto out;
+	return ret;
+}
+
+int net_tcp_queue_fill(struct net_context *context, size_t len,
+		       net_tcp_fill_cb_t fill, void *user_data)
+{
+	struct tcp *conn = context->tcp;
+	struct net_buf *data;
+	int ret;
+
+	if (!conn || conn->state != TCP_ESTABLISHED) {
+		return -ENOTCONN;
 	}
 
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
 	if (tcp_window_full(conn)) {
-		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+		k_mutex_unlock(&conn->lock);
+		return -EAGAIN;
+	}
+
+	len = MIN(conn->send_win - conn->send_data_total, len);
+
+	k_mutex_unlock(&conn->lock);
+
+	/* The callback may block, e.g. reading a file, so it runs without the
+	 * connection lock which the RX path and the TCP timers need.
+	 */
+	ret = tcp_buf_fill(conn->send_data, len, fill, user_data, &data);
+	if (ret <= 0) {
+		return ret;
 	}
 
-	ret = queued_len;
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state != TCP_ESTABLISHED) {
+		net_buf_unref(data);
+		ret = -ENOTCONN;
+		goto out;
+	}
+
+	net_pkt_append_buffer(conn->send_data, data);
+
+	ret = tcp_queue_commit(conn, ret);
 out:
 	k_mutex_unlock(&conn->lock);
 
@@ -4104,6 +4613,13 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
+	/* The checksum of a super-packet is calculated for each segment
+	 * separately when it is split.
+	 */
+	if (net_pkt_gso_size(pkt) > 0U && !force_chksum) {
+		return net_pkt_set_data(pkt, &tcp_access);
+	}
+
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
@@ -4112,14 +4628,14 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
-struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
-				  struct net_pkt_data_access *tcp_access)
+struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt)
 {
 	struct net_tcp_hdr *tcp_hdr;
 	enum net_if_checksum_type type = net_pkt_family(pkt) == AF_INET6 ?
 		NET_IF_CHECKSUM_IPV6_TCP : NET_IF_CHECKSUM_IPV4_TCP;
 
-	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
+	/* Segments coalesced by GRO have been verified one by one already */
+	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) && !net_pkt_is_gro(pkt) &&
 	    (net_if_need_calc_rx_checksum(net_pkt_iface(pkt), type) ||
 	     net_pkt_is_ip_reassembled(pkt)) &&
 	    net_calc_chksum_tcp(pkt) != 0U) {
@@ -4127,8 +4643,8 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 		goto drop;
 	}
 
-	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, tcp_access);
-	if (tcp_hdr && !net_pkt_set_data(pkt, tcp_access)) {
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_hdr_pull(pkt, sizeof(*tcp_hdr));
+	if (tcp_hdr) {
 		return tcp_hdr;
 	}
 
@@ -4632,6 +5148,7 @@ struct k_sem *net_tcp_conn_sem_get(struct net_context *context)
 
 void net_tcp_init(void)
 {
+	uint32_t max_win;
 	int i;
 	int rto;
 #if defined(CONFIG_NET_TEST_PROTOCOL)
@@ -4671,6 +5188,23 @@ void net_tcp_init(void)
 		tcp_max_timeout_ms += tcp_max_timeout_ms >> 1;
 	}
 
+	/* Smallest window shift that covers the largest receive window */
+	max_win = tcp_rx_window;
+#if defined(CONFIG_NET_TCP_AUTOTUNE)
+	max_win = MAX(max_win, CONFIG_NET_TCP_AUTOTUNE_MAX_WINDOW_SIZE);
+
+	tcp_autotune_budget = CONFIG_NET_TCP_AUTOTUNE_MEMORY > 0 ?
+		CONFIG_NET_TCP_AUTOTUNE_MEMORY :
+		(TCP_RX_POOL_SIZE + TCP_TX_POOL_SIZE) / 2;
+#endif
+
+	tcp_rcv_wscale = 0U;
+	while (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	       tcp_rcv_wscale < NET_TCP_MAX_WINDOW_SCALE &&
+	       (max_win >> tcp_rcv_wscale) > UINT16_MAX) {
+		tcp_rcv_wscale++;
+	}
+
 	k_thread_name_set(&tcp_work_q.thread, "tcp_work");
 	NET_DBG("Workq started. Thread ID: %p", &tcp_work_q.thread);
 }
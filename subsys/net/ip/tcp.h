@@ -84,12 +84,10 @@ int net_tcp_accept(struct net_context *context, net_tcp_accept_cb_t cb,
  * @brief Return struct net_tcp_hdr pointer
  *
  * @param pkt Network packet
- * @param tcp_access Helper variable for accessing TCP header
  *
  * @return Pointer to the TCP header on success, NULL on error
  */
-struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
-					struct net_pkt_data_access *tcp_access);
+struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt);
 /* TODO: net_tcp_input() isn't used by TCP and might be dropped with little
  *       re-factoring
  */
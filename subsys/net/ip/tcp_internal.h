@@ -266,21 +266,19 @@ static inline int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 /**
  * @brief Get pointer to TCP header in net_pkt
  *
+ * The header is accessed in place, the packet cursor is moved past it.
+ *
  * @param pkt Network packet
- * @param tcp_access Helper variable for accessing TCP header
  *
  * @return TCP header on success, NULL on error
  */
 #if defined(CONFIG_NET_NATIVE_TCP)
-struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
-				  struct net_pkt_data_access *tcp_access);
+struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt);
 #else
 static inline
-struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
-				  struct net_pkt_data_access *tcp_access)
+struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt)
 {
 	ARG_UNUSED(pkt);
-	ARG_UNUSED(tcp_access);
 
 	return NULL;
 }
@@ -293,20 +291,61 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
  * @param data		Pointer to the data
  * @param len		Number of bytes
  * @param msg		Data for a vector array operation
+ * @param flags		ZSOCK_MSG_ZEROCOPY to queue the data without copying
  *
  * @return 0 if ok, < 0 if error
  */
 #if defined(CONFIG_NET_NATIVE_TCP)
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct msghdr *msg);
+		  const struct msghdr *msg, int flags);
 #else
 static inline int net_tcp_queue(struct net_context *context, const void *data,
-				size_t len, const struct msghdr *msg)
+				size_t len, const struct msghdr *msg, int flags)
 {
 	ARG_UNUSED(context);
 	ARG_UNUSED(data);
 	ARG_UNUSED(len);
 	ARG_UNUSED(msg);
+	ARG_UNUSED(flags);
+
+	return -EPROTONOSUPPORT;
+}
+#endif
+
+/**
+ * @brief Callback producing data for net_tcp_queue_fill()
+ *
+ * @param buf		Buffer to fill
+ * @param len		Size of the buffer
+ * @param user_data	User data given to net_tcp_queue_fill()
+ *
+ * @return Number of bytes written (less than len at end of data), < 0 on error
+ */
+typedef int (*net_tcp_fill_cb_t)(uint8_t *buf, size_t len, void *user_data);
+
+/**
+ * @brief Enqueue data for transmission, letting the caller write it directly
+ * into the TCP send buffers
+ *
+ * @param context	Network context
+ * @param len		Maximum number of bytes to queue
+ * @param fill		Callback writing the data
+ * @param user_data	User data passed to the callback
+ *
+ * @return Number of bytes queued, -EAGAIN if the send window is full,
+ *         < 0 on other errors
+ */
+#if defined(CONFIG_NET_NATIVE_TCP)
+int net_tcp_queue_fill(struct net_context *context, size_t len,
+		       net_tcp_fill_cb_t fill, void *user_data);
+#else
+static inline int net_tcp_queue_fill(struct net_context *context, size_t len,
+				     net_tcp_fill_cb_t fill, void *user_data)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(len);
+	ARG_UNUSED(fill);
+	ARG_UNUSED(user_data);
 
 	return -EPROTONOSUPPORT;
 }
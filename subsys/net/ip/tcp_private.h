@@ -146,7 +146,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -234,9 +234,12 @@ union tcp_endpoint {
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
 
+/* Largest window shift allowed by RFC 7323 */
+#define NET_TCP_MAX_WINDOW_SCALE 14
+
 struct tcp_options {
 	uint16_t mss;
-	uint16_t window;
+	uint8_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
 };
@@ -244,9 +247,35 @@ struct tcp_options {
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
 struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+};
+#endif
+
+#if defined(CONFIG_NET_TCP_AUTOTUNE)
+/* Buffer autotuning state. Once per round trip the amount of data that
+ * was received or acknowledged is compared with the buffer size.
+ */
+struct tcp_autotune {
+	uint32_t rcv_rtt_seq;    /* window edge used for the receiver RTT */
+	uint32_t rcv_rtt_time;
+	uint32_t rcv_rtt;        /* smoothed receiver side RTT in ms */
+	uint32_t rcv_space_seq;  /* start of the current measurement round */
+	uint32_t rcv_space_time;
+	uint32_t rcv_space;      /* most data received in one round */
+	uint32_t snd_rtt_seq;    /* end of the segment being timed */
+	uint32_t snd_rtt_time;
+	uint32_t snd_space_seq;
+	uint32_t snd_max;        /* highest sequence number sent */
+	uint32_t peer_win;       /* unclamped window of the peer */
+	uint32_t charged;        /* memory taken from the global budget */
+	bool rcv_rtt_active : 1;
+	bool rcv_started : 1;
+	bool snd_rtt_active : 1;
+	bool snd_started : 1;
+	bool rcvbuf_locked : 1;
+	bool sndbuf_locked : 1;
 };
 #endif
 
@@ -314,18 +343,23 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_sent;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
+	uint32_t recv_win_sent;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 	struct tcp_collision_avoidance_reno ca;
+#endif
+#if defined(CONFIG_NET_TCP_AUTOTUNE)
+	struct tcp_autotune tune;
 #endif
 	uint8_t send_data_retries;
+	uint8_t rcv_wscale; /* shift of the windows we advertise */
+	uint8_t snd_wscale; /* shift of the windows the peer advertises */
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
 #endif
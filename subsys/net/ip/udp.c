@@ -147,15 +147,14 @@ int net_udp_unregister(struct net_conn_handle *handle)
 	return net_conn_unregister(handle);
 }
 
-struct net_udp_hdr *net_udp_input(struct net_pkt *pkt,
-				  struct net_pkt_data_access *udp_access)
+struct net_udp_hdr *net_udp_input(struct net_pkt *pkt)
 {
 	struct net_udp_hdr *udp_hdr;
 	enum net_if_checksum_type type = net_pkt_family(pkt) == AF_INET6 ?
 		NET_IF_CHECKSUM_IPV6_UDP : NET_IF_CHECKSUM_IPV4_UDP;
 
-	udp_hdr = (struct net_udp_hdr *)net_pkt_get_data(pkt, udp_access);
-	if (!udp_hdr || net_pkt_set_data(pkt, udp_access)) {
+	udp_hdr = (struct net_udp_hdr *)net_pkt_hdr_pull(pkt, sizeof(*udp_hdr));
+	if (!udp_hdr) {
 		NET_DBG("DROP: corrupted header");
 		goto drop;
 	}
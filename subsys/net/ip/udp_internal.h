@@ -77,21 +77,19 @@ static inline int net_udp_finalize(struct net_pkt *pkt, bool force_chksum)
 /**
  * @brief Get pointer to UDP header in net_pkt
  *
+ * The header is accessed in place, the packet cursor is moved past it.
+ *
  * @param pkt Network packet
- * @param udp_access Helper variable for accessing UDP header
  *
  * @return UDP header on success, NULL on error
  */
 #if defined(CONFIG_NET_NATIVE_UDP)
-struct net_udp_hdr *net_udp_input(struct net_pkt *pkt,
-				  struct net_pkt_data_access *udp_access);
+struct net_udp_hdr *net_udp_input(struct net_pkt *pkt);
 #else
 static inline
-struct net_udp_hdr *net_udp_input(struct net_pkt *pkt,
-				  struct net_pkt_data_access *udp_access)
+struct net_udp_hdr *net_udp_input(struct net_pkt *pkt)
 {
 	ARG_UNUSED(pkt);
-	ARG_UNUSED(udp_access);
 
 	return NULL;
 }
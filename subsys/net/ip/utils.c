@@ -559,6 +559,109 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+/* The block kernels below add the data to the sum in native byte order and
+ * return the number of bytes they consumed. The data is 4 byte aligned when
+ * they are called, the tail is left to the generic word loop.
+ */
+#if defined(CONFIG_NET_CHKSUM_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+
+/* Each round adds at most 2 * 0xffff to a 32-bit lane */
+#define CHKSUM_SIMD_MAX_ROUNDS 0x8000
+
+static size_t chksum_block(uint64_t *sum, const uint8_t *data, size_t len)
+{
+	const __m128i zero = _mm_setzero_si128();
+	size_t done = 0;
+
+	while (len - done >= 16) {
+		size_t rounds = MIN((len - done) / 16, CHKSUM_SIMD_MAX_ROUNDS);
+		__m128i acc = zero;
+		uint32_t lanes[4];
+
+		while (rounds--) {
+			__m128i v = _mm_loadu_si128((const __m128i *)(data + done));
+
+			acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(v, zero));
+			acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(v, zero));
+			done += 16;
+		}
+
+		_mm_storeu_si128((__m128i *)lanes, acc);
+		*sum += (uint64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	}
+
+	return done;
+}
+#elif defined(CONFIG_NET_CHKSUM_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
+
+#define CHKSUM_SIMD_MAX_ROUNDS 0x8000
+
+static size_t chksum_block(uint64_t *sum, const uint8_t *data, size_t len)
+{
+	size_t done = 0;
+
+	while (len - done >= 16) {
+		size_t rounds = MIN((len - done) / 16, CHKSUM_SIMD_MAX_ROUNDS);
+		uint32x4_t acc = vdupq_n_u32(0);
+		uint64x2_t wide;
+
+		while (rounds--) {
+			acc = vpadalq_u16(acc, vld1q_u16((const uint16_t *)(data + done)));
+			done += 16;
+		}
+
+		wide = vpaddlq_u32(acc);
+		*sum += vgetq_lane_u64(wide, 0) + vgetq_lane_u64(wide, 1);
+	}
+
+	return done;
+}
+#elif defined(CONFIG_64BIT)
+static inline uint64_t chksum_add64(uint64_t sum, uint64_t word)
+{
+	sum += word;
+
+	/* End-around carry */
+	return sum + (sum < word);
+}
+
+static size_t chksum_block(uint64_t *sum, const uint8_t *data, size_t len)
+{
+	const uint64_t *p;
+	uint64_t acc = 0;
+	size_t done = 0;
+
+	if (((uintptr_t)data & 0x04) != 0 && len >= sizeof(uint32_t)) {
+		*sum += *(const uint32_t *)data;
+		done += sizeof(uint32_t);
+	}
+
+	p = (const uint64_t *)(data + done);
+
+	while (len - done >= sizeof(uint64_t) * 4) {
+		acc = chksum_add64(acc, p[0]);
+		acc = chksum_add64(acc, p[1]);
+		acc = chksum_add64(acc, p[2]);
+		acc = chksum_add64(acc, p[3]);
+		p += 4;
+		done += sizeof(uint64_t) * 4;
+	}
+
+	while (len - done >= sizeof(uint64_t)) {
+		acc = chksum_add64(acc, *p++);
+		done += sizeof(uint64_t);
+	}
+
+	*sum += (acc & 0xffffffff) + (acc >> 32);
+
+	return done;
+}
+#else
+#define chksum_block(sum, data, len) 0U
+#endif
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
@@ -572,6 +675,7 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	uint32_t *p;
 	size_t i = 0;
 	size_t pending = len;
+	size_t done;
 	int odd_start = ((uintptr_t)data & 0x01);
 
 	/* Sum in is in host endianness, working order endianness is both dependent on endianness
@@ -594,6 +698,12 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
+
+	/* Let the widest available kernel handle the bulk of the data */
+	done = chksum_block(&sum, data, pending);
+	data += done;
+	pending -= done;
+
 	p = (uint32_t *)data;
 
 	/* Do loop unrolling for the very large data sets */
@@ -636,6 +746,49 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 }
 
+/* Same as calc_chksum() but the data is copied to dst while it is summed, so
+ * the caller does not have to walk the data a second time.
+ */
+uint16_t calc_chksum_copy(uint16_t sum_in, uint8_t *dst, const uint8_t *src, size_t len)
+{
+	uint64_t sum = 0;
+	size_t i = 0;
+
+	while (len - i >= sizeof(uint32_t)) {
+		uint32_t word = UNALIGNED_GET((const uint32_t *)(src + i));
+
+		UNALIGNED_PUT(word, (uint32_t *)(dst + i));
+		sum += word;
+		i += sizeof(uint32_t);
+	}
+
+	if (len - i >= sizeof(uint16_t)) {
+		uint16_t word = UNALIGNED_GET((const uint16_t *)(src + i));
+
+		UNALIGNED_PUT(word, (uint16_t *)(dst + i));
+		sum += word;
+		i += sizeof(uint16_t);
+	}
+
+	if (i < len) {
+		/* The last byte is the high order byte of a 16-bit word */
+		dst[i] = src[i];
+		sum += CHECKSUM_BIG_ENDIAN ? (src[i] << 8) : src[i];
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	if (!CHECKSUM_BIG_ENDIAN) {
+		sum = BSWAP_16((uint16_t)sum);
+	}
+
+	sum += sum_in;
+
+	return (uint16_t)((sum & 0xffff) + (sum >> 16));
+}
+
 #if defined(CONFIG_NET_NATIVE_IP)
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
@@ -166,6 +166,63 @@ static inline bool insert(struct coap_packet *cpkt, const uint8_t *data, uint16_
 	return true;
 }
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+/* Add an option to the end of the index. If the index is full, the packet is
+ * not indexed anymore and the options are parsed again by the getters.
+ */
+static void option_index_append(struct coap_packet *cpkt, uint16_t code, uint16_t offset)
+{
+	if (cpkt->opt_index == NULL) {
+		return;
+	}
+
+	if (cpkt->opt_index_len >= cpkt->opt_index_size) {
+		NET_DBG("Option index full, options not indexed");
+		cpkt->opt_index = NULL;
+		return;
+	}
+
+	cpkt->opt_index[cpkt->opt_index_len].code = code;
+	cpkt->opt_index[cpkt->opt_index_len].offset = offset;
+	cpkt->opt_index_len++;
+}
+
+/* Get the position of the first indexed option with a number equal or higher
+ * than `code`.
+ */
+static uint8_t option_index_find(const struct coap_packet *cpkt, uint16_t code)
+{
+	uint8_t low = 0U;
+	uint8_t high = cpkt->opt_index_len;
+
+	while (low < high) {
+		uint8_t mid = low + (high - low) / 2U;
+
+		if (cpkt->opt_index[mid].code < code) {
+			low = mid + 1U;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+/* Option number preceding the indexed option at `pos`, needed to decode its delta */
+static inline uint16_t option_index_prev_code(const struct coap_packet *cpkt, uint8_t pos)
+{
+	return pos > 0U ? cpkt->opt_index[pos - 1U].code : 0U;
+}
+
+/* Add `diff` to the offset of the indexed options from `pos` onwards */
+static void option_index_shift(struct coap_packet *cpkt, uint8_t pos, int diff)
+{
+	for (; pos < cpkt->opt_index_len; pos++) {
+		cpkt->opt_index[pos].offset += diff;
+	}
+}
+#endif /* CONFIG_COAP_OPTION_INDEX */
+
 int coap_packet_init(struct coap_packet *cpkt, uint8_t *data, uint16_t max_len,
 		     uint8_t ver, uint8_t type, uint8_t token_len,
 		     const uint8_t *token, uint8_t code, uint16_t id)
@@ -369,6 +426,10 @@ int coap_packet_append_option(struct coap_packet *cpkt, uint16_t code,
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	option_index_append(cpkt, cpkt->delta + code, cpkt->hdr_len + cpkt->opt_len);
+#endif
+
 	cpkt->opt_len += r;
 	cpkt->delta += code;
 
@@ -682,6 +743,51 @@ static int remove_middle_option(struct coap_packet *cpkt,
 
 	return 0;
 }
+
+#if defined(CONFIG_COAP_OPTION_INDEX)
+static int remove_indexed_option(struct coap_packet *cpkt, uint16_t code)
+{
+	uint8_t pos = option_index_find(cpkt, code);
+	uint16_t previous_offset;
+	uint16_t previous_code;
+	uint16_t old_opt_len;
+	int r;
+
+	if (pos == cpkt->opt_index_len || cpkt->opt_index[pos].code != code) {
+		return 0;
+	}
+
+	previous_offset = cpkt->opt_index[pos].offset;
+	previous_code = option_index_prev_code(cpkt, pos);
+
+	if (pos == cpkt->opt_index_len - 1U) {
+		/* last option */
+		remove_option_data(cpkt, previous_offset, cpkt->hdr_len + cpkt->opt_len);
+		cpkt->delta = previous_code;
+		cpkt->opt_index_len--;
+
+		return 0;
+	}
+
+	old_opt_len = cpkt->opt_len;
+
+	r = remove_middle_option(cpkt, cpkt->opt_index[pos + 1U].offset, code,
+				 previous_offset, previous_code);
+	if (r < 0) {
+		return r;
+	}
+
+	/* The next option takes the place of the removed one, the others are moved */
+	memmove(&cpkt->opt_index[pos], &cpkt->opt_index[pos + 1U],
+		(cpkt->opt_index_len - pos - 1U) * sizeof(cpkt->opt_index[0]));
+	cpkt->opt_index_len--;
+	cpkt->opt_index[pos].offset = previous_offset;
+	option_index_shift(cpkt, pos + 1U, (int)cpkt->opt_len - (int)old_opt_len);
+
+	return 0;
+}
+#endif /* CONFIG_COAP_OPTION_INDEX */
+
 int coap_packet_remove_option(struct coap_packet *cpkt, uint16_t code)
 {
 	uint16_t offset = 0;
@@ -704,6 +810,12 @@ int coap_packet_remove_option(struct coap_packet *cpkt, uint16_t code)
 		return 0;
 	}
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	if (cpkt->opt_index != NULL) {
+		return remove_indexed_option(cpkt, code);
+	}
+#endif
+
 	offset = cpkt->hdr_len;
 	previous_offset = cpkt->hdr_len;
 
@@ -743,8 +855,9 @@ int coap_packet_remove_option(struct coap_packet *cpkt, uint16_t code)
 	return 0;
 }
 
-int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
-		      struct coap_option *options, uint8_t opt_num)
+static int packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
+			struct coap_option *options, uint8_t opt_num,
+			struct coap_option_index *index, uint8_t index_len)
 {
 	uint16_t opt_len;
 	uint16_t offset;
@@ -772,6 +885,15 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	cpkt->hdr_len = 0U;
 	cpkt->delta = 0U;
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	cpkt->opt_index = index;
+	cpkt->opt_index_len = 0U;
+	cpkt->opt_index_size = index_len;
+#else
+	ARG_UNUSED(index);
+	ARG_UNUSED(index_len);
+#endif
+
 	/* Token lengths 9-15 are reserved. */
 	tkl = cpkt->data[0] & 0x0f;
 	if (tkl > 8) {
@@ -794,13 +916,27 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 
 	while (1) {
 		struct coap_option *option;
+		uint16_t opt_offset = offset;
+		uint16_t prev_opt_len = opt_len;
 
 		option = num < opt_num ? &options[num++] : NULL;
 		ret = parse_option(cpkt->data, offset, &offset, cpkt->max_len,
 				   &delta, &opt_len, option);
 		if (ret < 0) {
 			return -EILSEQ;
-		} else if (ret == 0) {
+		}
+
+#if defined(CONFIG_COAP_OPTION_INDEX)
+		/* The payload marker does not add to the options length */
+		if (opt_len != prev_opt_len) {
+			option_index_append(cpkt, delta, opt_offset);
+		}
+#else
+		ARG_UNUSED(opt_offset);
+		ARG_UNUSED(prev_opt_len);
+#endif
+
+		if (ret == 0) {
 			break;
 		}
 	}
@@ -811,6 +947,65 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	return 0;
 }
 
+int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
+		      struct coap_option *options, uint8_t opt_num)
+{
+	return packet_parse(cpkt, data, len, options, opt_num, NULL, 0U);
+}
+
+int coap_packet_parse_indexed(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
+			      struct coap_option *options, uint8_t opt_num,
+			      struct coap_option_index *index, uint8_t index_len)
+{
+	return packet_parse(cpkt, data, len, options, opt_num, index, index_len);
+}
+
+int coap_packet_set_option_index(struct coap_packet *cpkt,
+				 struct coap_option_index *index, uint8_t index_len)
+{
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	uint16_t end;
+	uint16_t offset;
+	uint16_t opt_len = 0U;
+	uint16_t delta = 0U;
+	int r;
+
+	if (!cpkt || !index) {
+		return -EINVAL;
+	}
+
+	cpkt->opt_index = index;
+	cpkt->opt_index_len = 0U;
+	cpkt->opt_index_size = index_len;
+
+	end = cpkt->hdr_len + cpkt->opt_len;
+	offset = cpkt->hdr_len;
+
+	while (offset < end) {
+		uint16_t opt_offset = offset;
+
+		r = parse_option(cpkt->data, offset, &offset, end, &delta, &opt_len, NULL);
+		if (r < 0) {
+			cpkt->opt_index = NULL;
+			return -EILSEQ;
+		}
+
+		option_index_append(cpkt, delta, opt_offset);
+		if (cpkt->opt_index == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+#else
+	ARG_UNUSED(cpkt);
+	ARG_UNUSED(index);
+	ARG_UNUSED(index_len);
+
+	return -ENOTSUP;
+#endif
+}
+
 int coap_packet_set_path(struct coap_packet *cpkt, const char *path)
 {
 	int ret = 0;
@@ -913,6 +1108,35 @@ out:
 	return ret;
 }
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+static int find_indexed_options(const struct coap_packet *cpkt, uint16_t code,
+				struct coap_option *options, uint16_t veclen)
+{
+	uint16_t end = cpkt->hdr_len + cpkt->opt_len;
+	uint8_t pos = option_index_find(cpkt, code);
+	uint16_t num = 0U;
+	int r;
+
+	while (pos < cpkt->opt_index_len && cpkt->opt_index[pos].code == code &&
+	       num < veclen) {
+		uint16_t offset = cpkt->opt_index[pos].offset;
+		uint16_t delta = option_index_prev_code(cpkt, pos);
+		uint16_t opt_len = 0U;
+
+		r = parse_option(cpkt->data, offset, &offset, end, &delta, &opt_len,
+				 &options[num]);
+		if (r < 0) {
+			return -EINVAL;
+		}
+
+		num++;
+		pos++;
+	}
+
+	return num;
+}
+#endif /* CONFIG_COAP_OPTION_INDEX */
+
 int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 		      struct coap_option *options, uint16_t veclen)
 {
@@ -927,12 +1151,20 @@ int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 		return 0;
 	}
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	if (cpkt->opt_index != NULL) {
+		return find_indexed_options(cpkt, code, options, veclen);
+	}
+#endif
+
 	offset = cpkt->hdr_len;
 	opt_len = 0U;
 	delta = 0U;
 	num = 0U;
 
 	while (delta <= code && num < veclen) {
+		uint16_t prev_opt_len = opt_len;
+
 		r = parse_option(cpkt->data, offset, &offset,
 				 cpkt->max_len, &delta, &opt_len,
 				 &options[num]);
@@ -940,6 +1172,11 @@ int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 			return -EINVAL;
 		}
 
+		/* The payload marker leaves options[num] untouched */
+		if (opt_len == prev_opt_len) {
+			break;
+		}
+
 		if (code == options[num].delta) {
 			num++;
 		}
@@ -1397,20 +1634,41 @@ int insert_option(struct coap_packet *cpkt, uint16_t code, const uint8_t *value,
 	uint16_t last_offset = cpkt->hdr_len;
 	struct coap_option option = {0};
 	int r;
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	uint8_t pos = 0U;
+	uint16_t old_opt_len = cpkt->opt_len;
+
+	if (cpkt->opt_index != NULL) {
+		/* Only the option following the new one has to be parsed */
+		pos = option_index_find(cpkt, code + 1U);
+		last_opt = option_index_prev_code(cpkt, pos);
+		last_offset = cpkt->opt_index[pos].offset;
+		opt_delta = last_opt;
+		offset = last_offset;
 
-	while (offset < cpkt->hdr_len + cpkt->opt_len) {
 		r = parse_option(cpkt->data, offset, &offset, cpkt->hdr_len + cpkt->opt_len,
 				 &opt_delta, &opt_len, &option);
 		if (r < 0) {
 			return -EILSEQ;
 		}
+	} else
+#endif
+	{
+		while (offset < cpkt->hdr_len + cpkt->opt_len) {
+			r = parse_option(cpkt->data, offset, &offset,
+					 cpkt->hdr_len + cpkt->opt_len,
+					 &opt_delta, &opt_len, &option);
+			if (r < 0) {
+				return -EILSEQ;
+			}
 
-		if (opt_delta > code) {
-			break;
-		}
+			if (opt_delta > code) {
+				break;
+			}
 
-		last_opt = opt_delta;
-		last_offset = offset;
+			last_opt = opt_delta;
+			last_offset = offset;
+		}
 	}
 
 	const uint16_t option_size = offset - last_offset;
@@ -1428,13 +1686,35 @@ int insert_option(struct coap_packet *cpkt, uint16_t code, const uint8_t *value,
 	}
 	cpkt->opt_len += r;
 
+	const uint16_t next_offset = last_offset + r;
+
 	/* reinsert option that comes after the new option (with adjusted delta) */
-	r = encode_option(cpkt, option.delta - code, option.value, option.len, last_offset + r);
+	r = encode_option(cpkt, option.delta - code, option.value, option.len, next_offset);
 	if (r < 0) {
 		return -EINVAL;
 	}
 	cpkt->opt_len += r;
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	if (cpkt->opt_index == NULL) {
+		return 0;
+	}
+
+	if (cpkt->opt_index_len >= cpkt->opt_index_size) {
+		NET_DBG("Option index full, options not indexed");
+		cpkt->opt_index = NULL;
+		return 0;
+	}
+
+	/* The new option takes the place of the next one, which is moved with the others */
+	memmove(&cpkt->opt_index[pos + 1U], &cpkt->opt_index[pos],
+		(cpkt->opt_index_len - pos) * sizeof(cpkt->opt_index[0]));
+	cpkt->opt_index_len++;
+	cpkt->opt_index[pos].code = code;
+	cpkt->opt_index[pos + 1U].offset = next_offset;
+	option_index_shift(cpkt, pos + 2U, (int)cpkt->opt_len - (int)old_opt_len);
+#endif
+
 	return 0;
 }
 
@@ -1939,6 +2219,47 @@ int coap_resource_notify(struct coap_resource *resource)
 	return 0;
 }
 
+int coap_notification_init(struct coap_packet *cpkt, struct coap_resource *resource,
+			   uint8_t *data, uint16_t max_len, uint8_t type, uint8_t code)
+{
+	int ret;
+
+	if (!resource) {
+		return -EINVAL;
+	}
+
+	/* The token is only added per observer, see coap_notification_header() */
+	ret = coap_packet_init(cpkt, data, max_len, COAP_VERSION_1, type, 0, NULL, code, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	coap_observer_increment_age(resource);
+
+	return coap_append_option_int(cpkt, COAP_OPTION_OBSERVE, resource->age);
+}
+
+int coap_notification_header(const struct coap_packet *cpkt,
+			     const struct coap_observer *observer, uint16_t id,
+			     uint8_t *buf, size_t len)
+{
+	struct coap_packet hdr;
+	int ret;
+
+	if (!cpkt || !observer || observer->tkl > COAP_TOKEN_MAX_LEN ||
+	    cpkt->hdr_len != BASIC_HEADER_SIZE) {
+		return -EINVAL;
+	}
+
+	ret = coap_packet_init(&hdr, buf, len, COAP_VERSION_1, coap_header_get_type(cpkt),
+			       observer->tkl, observer->token, __coap_header_get_code(cpkt), id);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return hdr.offset;
+}
+
 bool coap_request_is_observe(const struct coap_packet *request)
 {
 	return coap_get_option_int(request, COAP_OPTION_OBSERVE) == 0;
@@ -133,6 +133,9 @@ static int coap_server_process(int sock_fd)
 	struct coap_pending *pending;
 	struct coap_option options[MAX_OPTIONS] = { 0 };
 	uint8_t opt_num = MAX_OPTIONS;
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	struct coap_option_index opt_index[MAX_OPTIONS];
+#endif
 	uint8_t type;
 	ssize_t received;
 	int ret;
@@ -153,7 +156,12 @@ static int coap_server_process(int sock_fd)
 		return -errno;
 	}
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	ret = coap_packet_parse_indexed(&request, buf, MIN(received, sizeof(buf)), options, opt_num,
+					opt_index, ARRAY_SIZE(opt_index));
+#else
 	ret = coap_packet_parse(&request, buf, MIN(received, sizeof(buf)), options, opt_num);
+#endif
 	if (ret < 0) {
 		LOG_ERR("Failed To parse coap message (%d)", ret);
 		return ret;
@@ -559,6 +567,54 @@ int coap_service_is_running(const struct coap_service *service)
 	return ret;
 }
 
+/* Track a confirmable message for retransmission, the message is given in two parts so a
+ * notification header can be combined with the shared options and payload. Must be called
+ * with the lock held.
+ */
+static int coap_service_add_pending(const struct coap_service *service,
+				    const uint8_t *hdr, size_t hdr_len,
+				    const uint8_t *body, size_t body_len,
+				    const struct sockaddr *addr,
+				    const struct coap_transmission_parameters *params)
+{
+	struct coap_pending *pending;
+	struct coap_packet cpkt = { 0 };
+	int ret;
+
+	pending = coap_pending_next_unused(service->data->pending, MAX_PENDINGS);
+	if (pending == NULL) {
+		LOG_WRN("No pending message available for %s", service->name);
+		return -ENOMEM;
+	}
+
+	cpkt.data = coap_server_alloc(hdr_len + body_len);
+	if (cpkt.data == NULL) {
+		LOG_WRN("Failed to allocate pending message data for %s", service->name);
+		return -ENOMEM;
+	}
+
+	memcpy(cpkt.data, hdr, hdr_len);
+	if (body_len > 0) {
+		memcpy(cpkt.data + hdr_len, body, body_len);
+	}
+
+	cpkt.offset = hdr_len + body_len;
+	cpkt.max_len = cpkt.offset;
+
+	/* The pending message takes over the allocated copy */
+	ret = coap_pending_init(pending, &cpkt, addr, params);
+	if (ret < 0) {
+		LOG_WRN("Failed to init pending message for %s (%d)", service->name, ret);
+		coap_server_free(cpkt.data);
+		coap_pending_clear(pending);
+		return ret;
+	}
+
+	coap_pending_cycle(pending);
+
+	return 0;
+}
+
 int coap_service_send(const struct coap_service *service, const struct coap_packet *cpkt,
 		      const struct sockaddr *addr, socklen_t addr_len,
 		      const struct coap_transmission_parameters *params)
@@ -581,37 +637,13 @@ int coap_service_send(const struct coap_service *service, const struct coap_pack
 	 * Check if we should start with retransmits, if creating a pending message fails we still
 	 * try to send.
 	 */
-	if (coap_header_get_type(cpkt) == COAP_TYPE_CON) {
-		struct coap_pending *pending = coap_pending_next_unused(service->data->pending,
-									MAX_PENDINGS);
-
-		if (pending == NULL) {
-			LOG_WRN("No pending message available for %s", service->name);
-			goto send;
-		}
-
-		ret = coap_pending_init(pending, cpkt, addr, params);
-		if (ret < 0) {
-			LOG_WRN("Failed to init pending message for %s (%d)", service->name, ret);
-			goto send;
-		}
-
-		/* Replace tracked data with our allocated copy */
-		pending->data = coap_server_alloc(pending->len);
-		if (pending->data == NULL) {
-			LOG_WRN("Failed to allocate pending message data for %s", service->name);
-			coap_pending_clear(pending);
-			goto send;
-		}
-		memcpy(pending->data, cpkt->data, pending->len);
-
-		coap_pending_cycle(pending);
-
+	if (coap_header_get_type(cpkt) == COAP_TYPE_CON &&
+	    coap_service_add_pending(service, cpkt->data, cpkt->offset, NULL, 0,
+				     addr, params) == 0) {
 		/* Trigger event in receive loop to schedule retransmit */
 		coap_server_update_services();
 	}
 
-send:
 	(void)k_mutex_unlock(&lock);
 
 	ret = zsock_sendto(service->data->sock_fd, cpkt->data, cpkt->offset, 0, addr, addr_len);
@@ -638,6 +670,97 @@ int coap_resource_send(const struct coap_resource *resource, const struct coap_p
 	return -ENOENT;
 }
 
+int coap_resource_send_notification(struct coap_resource *resource,
+				    const struct coap_packet *cpkt,
+				    const struct coap_transmission_parameters *params)
+{
+	const struct coap_service *service = NULL;
+	/* Minimal sized header buffer */
+	uint8_t hdr[COAP_TOKEN_MAX_LEN + 4U];
+	struct iovec iov[2];
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	struct coap_observer *observer;
+	bool confirmable;
+	bool pending = false;
+	int sent = 0;
+	int ret = 0;
+
+	/* Only notifications created by coap_notification_init() can be shared */
+	if (cpkt == NULL || cpkt->hdr_len != 4U) {
+		return -EINVAL;
+	}
+
+	/* Find owning service */
+	COAP_SERVICE_FOREACH(svc) {
+		if (COAP_SERVICE_HAS_RESOURCE(svc, resource)) {
+			service = svc;
+			break;
+		}
+	}
+
+	if (service == NULL) {
+		return -ENOENT;
+	}
+
+	confirmable = coap_header_get_type(cpkt) == COAP_TYPE_CON;
+
+	/* Options and payload are shared by all observers */
+	iov[0].iov_base = hdr;
+	iov[1].iov_base = cpkt->data + cpkt->hdr_len;
+	iov[1].iov_len = cpkt->offset - cpkt->hdr_len;
+
+	/* Send all notifications in one go, the observers cannot change meanwhile */
+	(void)k_mutex_lock(&lock, K_FOREVER);
+
+	if (service->data->sock_fd < 0) {
+		ret = -EBADF;
+		goto unlock;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&resource->observers, observer, list) {
+		ret = coap_notification_header(cpkt, observer, coap_next_id(), hdr, sizeof(hdr));
+		if (ret < 0) {
+			LOG_ERR("Failed to create notification header (%d)", ret);
+			goto unlock;
+		}
+
+		iov[0].iov_len = ret;
+
+		if (confirmable &&
+		    coap_service_add_pending(service, iov[0].iov_base, iov[0].iov_len,
+					     iov[1].iov_base, iov[1].iov_len,
+					     &observer->addr, params) == 0) {
+			pending = true;
+		}
+
+		msg.msg_name = &observer->addr;
+		msg.msg_namelen = ADDRLEN(&observer->addr);
+
+		ret = zsock_sendmsg(service->data->sock_fd, &msg, 0);
+		if (ret < 0) {
+			LOG_ERR("Failed to send CoAP notification (%d)", -errno);
+			continue;
+		}
+
+		sent++;
+	}
+
+	ret = 0;
+
+unlock:
+	if (pending) {
+		/* Trigger event in receive loop to schedule retransmits */
+		coap_server_update_services();
+	}
+
+	(void)k_mutex_unlock(&lock);
+
+	return ret < 0 ? ret : sent;
+}
+
 int coap_resource_parse_observe(struct coap_resource *resource, const struct coap_packet *request,
 				const struct sockaddr *addr)
 {
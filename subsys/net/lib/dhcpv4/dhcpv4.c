@@ -1993,8 +1993,12 @@ bool net_dhcpv4_accept_unicast(struct net_pkt *pkt)
 		return false;
 	}
 
+	/* The IPv4 input path may already have pulled the IP header, so
+	 * locate the UDP header from the start of the packet.
+	 */
 	net_pkt_cursor_backup(pkt, &backup);
-	net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt));
+	net_pkt_cursor_init(pkt);
+	net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ipv4_opts_len(pkt));
 
 	/* Verify destination UDP port. */
 	udp_hdr = (struct net_udp_hdr *)net_pkt_get_data(pkt, &udp_access);
@@ -23,13 +23,75 @@ int dns_cache_flush(struct dns_cache *cache)
 	return 0;
 }
 
-int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
-		  uint32_t ttl)
+static int query_family(enum dns_query_type type, sa_family_t *family)
+{
+	if (type == DNS_QUERY_TYPE_A) {
+		*family = AF_INET;
+	} else if (type == DNS_QUERY_TYPE_AAAA) {
+		*family = AF_INET6;
+	} else {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_insert(struct dns_cache *cache, char const *query,
+			     struct dns_addrinfo const *addrinfo, uint32_t ttl, bool negative)
 {
 	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
 	size_t index_to_replace = 0;
 	bool found_empty = false;
+	struct dns_cache_entry *entry;
+
+	dns_cache_clean(cache);
+
+	/* A fresh answer replaces the entries it was requested to refresh */
+	for (size_t i = 0; i < cache->size; i++) {
+		entry = &cache->entries[i];
+
+		if (entry->in_use && entry->refreshing &&
+		    entry->data.ai_family == addrinfo->ai_family &&
+		    strcmp(entry->query, query) == 0) {
+			entry->in_use = false;
+		}
+	}
+
+	for (size_t i = 0; i < cache->size; i++) {
+		if (!cache->entries[i].in_use) {
+			index_to_replace = i;
+			found_empty = true;
+			break;
+		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
+			index_to_replace = i;
+			closest_to_expiry = cache->entries[i].expiry;
+		}
+	}
+
+	if (!found_empty) {
+		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+		cache->stats.evictions++;
+	}
 
+	entry = &cache->entries[index_to_replace];
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->data = *addrinfo;
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+	entry->refresh = sys_timepoint_calc(
+		K_MSEC((uint64_t)ttl * 10U * (100U - CONFIG_DNS_RESOLVER_CACHE_PREFETCH_THRESHOLD)));
+#endif
+	entry->hits = 0U;
+	entry->in_use = true;
+	entry->negative = negative;
+	entry->refreshing = false;
+}
+
+int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
+		  uint32_t ttl)
+{
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
@@ -45,28 +107,37 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
-	dns_cache_clean(cache);
+	dns_cache_insert(cache, query, addrinfo, ttl, false);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl)
+{
+	struct dns_addrinfo addrinfo = { 0 };
+	sa_family_t family;
+
+	if (cache == NULL || query == NULL || ttl == 0 || query_family(type, &family) < 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	addrinfo.ai_family = family;
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" with TTL %" PRIu32, query, ttl);
+
+	dns_cache_insert(cache, query, &addrinfo, ttl, true);
 
 	k_mutex_unlock(cache->lock);
 
@@ -98,7 +169,7 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
 {
 	size_t found = 0;
@@ -108,11 +179,7 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
 		return -EINVAL;
 	}
-	if (type == DNS_QUERY_TYPE_A) {
-		family = AF_INET;
-	} else if (type == DNS_QUERY_TYPE_AAAA) {
-		family = AF_INET6;
-	} else {
+	if (query_family(type, &family) < 0) {
 		return -EINVAL;
 	}
 	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
@@ -136,6 +203,12 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 		if (cache->entries[i].data.ai_family != family) {
 			continue;
 		}
+		if (cache->entries[i].negative) {
+			continue;
+		}
+		if (cache->entries[i].hits < UINT16_MAX) {
+			cache->entries[i].hits++;
+		}
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
@@ -146,6 +219,12 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 		}
 	}
 
+	if (found > 0) {
+		cache->stats.hits++;
+	} else {
+		cache->stats.misses++;
+	}
+
 	k_mutex_unlock(cache->lock);
 
 	if (found > addrinfo_array_len) {
@@ -158,6 +237,97 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 	return found;
 }
 
+int dns_cache_find_negative(struct dns_cache *cache, const char *query,
+			    enum dns_query_type type)
+{
+	sa_family_t family;
+	int ret = 0;
+
+	if (cache == NULL || query == NULL || query_family(type, &family) < 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	dns_cache_clean(cache);
+
+	for (size_t i = 0; i < cache->size; i++) {
+		if (cache->entries[i].in_use && cache->entries[i].negative &&
+		    cache->entries[i].data.ai_family == family &&
+		    strcmp(cache->entries[i].query, query) == 0) {
+			NET_DBG("Found negative \"%s\"", query);
+			cache->stats.negative_hits++;
+			ret = 1;
+			break;
+		}
+	}
+
+	k_mutex_unlock(cache->lock);
+
+	return ret;
+}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+bool dns_cache_refresh_due(struct dns_cache *cache, const char *query, enum dns_query_type type)
+{
+	struct dns_cache_entry *entry;
+	sa_family_t family;
+	bool due = false;
+
+	if (cache == NULL || query == NULL || query_family(type, &family) < 0) {
+		return false;
+	}
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	for (size_t i = 0; i < cache->size; i++) {
+		entry = &cache->entries[i];
+
+		if (!entry->in_use || entry->negative || entry->data.ai_family != family ||
+		    strcmp(entry->query, query) != 0) {
+			continue;
+		}
+
+		/* A single refresh per query */
+		if (entry->refreshing) {
+			due = false;
+			break;
+		}
+
+		if (entry->hits >= CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS &&
+		    sys_timepoint_expired(entry->refresh)) {
+			due = true;
+		}
+	}
+
+	if (due) {
+		NET_DBG("Refresh \"%s\"", query);
+
+		for (size_t i = 0; i < cache->size; i++) {
+			entry = &cache->entries[i];
+
+			if (entry->in_use && !entry->negative && entry->data.ai_family == family &&
+			    strcmp(entry->query, query) == 0) {
+				entry->refreshing = true;
+			}
+		}
+
+		cache->stats.prefetches++;
+	}
+
+	k_mutex_unlock(cache->lock);
+
+	return due;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
+void dns_cache_stats_get(struct dns_cache *cache, struct dns_resolve_cache_stats *stats)
+{
+	k_mutex_lock(cache->lock, K_FOREVER);
+	*stats = cache->stats;
+	k_mutex_unlock(cache->lock);
+}
+
 /* Needs to be called when lock is already acquired */
 static void dns_cache_clean(struct dns_cache const *cache)
 {
@@ -22,13 +22,21 @@ struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Hits past this point make the entry due for a refresh */
+	k_timepoint_t refresh;
+	uint16_t hits;
 	bool in_use;
+	/* The name has no address of this family, see RFC 2308 */
+	bool negative;
+	/* A query refreshing the entry is pending, its answer replaces it */
+	bool refreshing;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
 	struct k_mutex *lock;
+	struct dns_resolve_cache_stats stats;
 };
 
 /**
@@ -71,6 +79,21 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Adds a negative entry to the dns cache, recording that the query
+ * has no address of the given type.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param type Query type which got the negative answer.
+ * @param ttl Time to live for the entry in seconds, as found by
+ * dns_unpack_negative_ttl().
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -95,7 +118,46 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len);
 
+/**
+ * @brief Checks whether a negative answer to the query is cached.
+ *
+ * @param cache Cache where the entry should be searched.
+ * @param query Query which should be searched for.
+ * @param type Query type.
+ * @retval 1 if the query is known to have no address of the given type.
+ * @retval 0 if no negative answer is cached.
+ * @retval On error a negative value is returned.
+ */
+int dns_cache_find_negative(struct dns_cache *cache, const char *query,
+			    enum dns_query_type type);
+
+/**
+ * @brief Checks whether the entries of a query should be refreshed ahead of
+ * their expiry.
+ *
+ * Entries are due once they were found at least
+ * CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS times and less than
+ * CONFIG_DNS_RESOLVER_CACHE_PREFETCH_THRESHOLD percent of their TTL remains.
+ * The entries are then marked as being refreshed, so that a single refresh is
+ * requested, and are replaced by the first answer added for the query.
+ *
+ * @param cache Cache where the entries should be searched.
+ * @param query Query which should be searched for.
+ * @param type Query type.
+ * @retval true if a query should be sent to refresh the entries.
+ * @retval false otherwise.
+ */
+bool dns_cache_refresh_due(struct dns_cache *cache, const char *query, enum dns_query_type type);
+
+/**
+ * @brief Gets the cache statistics.
+ *
+ * @param cache Cache whose statistics are requested.
+ * @param stats Statistics of the cache.
+ */
+void dns_cache_stats_get(struct dns_cache *cache, struct dns_resolve_cache_stats *stats);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
@@ -179,18 +179,61 @@ int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
 	return 0;
 }
 
-int dns_unpack_response_header(struct dns_msg_t *msg, int src_id)
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl)
 {
-	uint8_t *dns_header;
-	uint16_t size;
-	int qdcount;
-	int ancount;
-	int rc;
+	uint16_t offset = dns_msg->answer_offset;
+	uint16_t len;
+	uint8_t *rr;
+	int dname_len;
 
-	dns_header = msg->msg;
-	size = msg->msg_size;
+	for (int i = 0; i < dns_header_nscount(dns_msg->msg); i++) {
+		rr = dns_msg->msg + offset;
 
-	if (size < DNS_MSG_HEADER_SIZE) {
+		dname_len = skip_fqdn(rr, dns_msg->msg_size - offset);
+		if (dname_len < 0) {
+			return dname_len;
+		}
+
+		/* type + class + ttl + rdlength, see RFC-1035 4.1.3. */
+		if (dns_msg->msg_size - offset - dname_len <
+		    DNS_COMMON_UINT_SIZE + DNS_COMMON_UINT_SIZE + DNS_TTL_LEN +
+		    DNS_RDLENGTH_LEN) {
+			return -EINVAL;
+		}
+
+		len = dns_answer_rdlength(dname_len, rr);
+		offset += dname_len + DNS_COMMON_UINT_SIZE + DNS_COMMON_UINT_SIZE +
+			  DNS_TTL_LEN + DNS_RDLENGTH_LEN;
+
+		if (len > dns_msg->msg_size - offset) {
+			return -EINVAL;
+		}
+
+		offset += len;
+
+		if (dns_answer_type(dname_len, rr) != DNS_RR_TYPE_SOA) {
+			continue;
+		}
+
+		/* MINIMUM is the last field of the SOA RDATA, see RFC-1035 3.3.13. */
+		if (len < DNS_TTL_LEN) {
+			return -EINVAL;
+		}
+
+		*ttl = MIN((uint32_t)dns_answer_ttl(dname_len, rr),
+			   sys_get_be32(dns_msg->msg + offset - DNS_TTL_LEN));
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+static int unpack_response_header_common(struct dns_msg_t *msg, int src_id)
+{
+	uint8_t *dns_header = msg->msg;
+
+	if (msg->msg_size < DNS_MSG_HEADER_SIZE) {
 		return -ENOMEM;
 	}
 
@@ -210,6 +253,23 @@ int dns_unpack_response_header(struct dns_msg_t *msg, int src_id)
 		return -EINVAL;
 	}
 
+	return 0;
+}
+
+int dns_unpack_response_header(struct dns_msg_t *msg, int src_id)
+{
+	uint8_t *dns_header;
+	int qdcount;
+	int ancount;
+	int rc;
+
+	dns_header = msg->msg;
+
+	rc = unpack_response_header_common(msg, src_id);
+	if (rc < 0) {
+		return rc;
+	}
+
 	rc = dns_header_rcode(dns_header);
 	switch (rc) {
 	case DNS_HEADER_NOERROR:
@@ -232,6 +292,31 @@ int dns_unpack_response_header(struct dns_msg_t *msg, int src_id)
 	return 0;
 }
 
+int dns_unpack_negative_response_header(struct dns_msg_t *msg, int src_id)
+{
+	uint8_t *dns_header;
+	int rc;
+
+	dns_header = msg->msg;
+
+	rc = unpack_response_header_common(msg, src_id);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = dns_header_rcode(dns_header);
+	if (rc != DNS_HEADER_NOERROR && rc != DNS_HEADER_NAMEERROR) {
+		return rc;
+	}
+
+	if (dns_unpack_header_qdcount(dns_header) != 1 ||
+	    dns_unpack_header_ancount(dns_header) != 0) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
 static int dns_msg_pack_query_header(uint8_t *buf, uint16_t size, uint16_t id)
 {
 	uint16_t offset;
@@ -89,6 +89,7 @@ enum dns_rr_type {
 	DNS_RR_TYPE_INVALID = 0,
 	DNS_RR_TYPE_A	= 1,		/* IPv4  */
 	DNS_RR_TYPE_CNAME = 5,		/* CNAME */
+	DNS_RR_TYPE_SOA = 6,		/* SOA   */
 	DNS_RR_TYPE_PTR = 12,		/* PTR   */
 	DNS_RR_TYPE_TXT = 16,		/* TXT   */
 	DNS_RR_TYPE_AAAA = 28,		/* IPv6  */
@@ -367,6 +368,24 @@ int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
  */
 int dns_unpack_response_header(struct dns_msg_t *msg, int src_id);
 
+/**
+ * @brief Reads the header of a negative response
+ *
+ * @details Same checks as dns_unpack_response_header(), but accepts a
+ *          NXDOMAIN (Name Error) response, and requires one question and
+ *          no answer, see RFC 2308.
+ *
+ * @param msg Structure containing the response.
+ * @param src_id Transaction id, it must match the id used in the query
+ *        datagram sent to the DNS server.
+ * @retval 0 if the message is a negative response.
+ * @retval -ENOMEM if the message is shorter than the header.
+ * @retval -EINVAL if the header is not the one of a response to the query,
+ *         or if the counters do not match a negative response.
+ * @retval RFC 1035 RCODEs (> 0) other than Name Error.
+ */
+int dns_unpack_negative_response_header(struct dns_msg_t *msg, int src_id);
+
 /**
  * @brief Packs the query message
  *
@@ -402,6 +421,23 @@ int dns_msg_pack_query(uint8_t *buf, uint16_t *len, uint16_t size,
  */
 int dns_unpack_response_query(struct dns_msg_t *dns_msg);
 
+/**
+ * @brief Finds the TTL of a negative response
+ *
+ * @details RFC 2308 ch. 5 defines the TTL of a negative response as the
+ *          minimum of the SOA record TTL and of its MINIMUM field. The SOA
+ *          record is searched for in the authority section, which starts
+ *          at the answer_offset as the response holds no answer.
+ *
+ * @param dns_msg Structure containing the message.
+ * @param ttl TTL of the negative response.
+ * @retval 0 on success
+ * @retval -ENOENT if the authority section holds no SOA record, the
+ *         response shall not be cached then.
+ * @retval -EINVAL if the authority section is malformed.
+ */
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl);
+
 /**
  * @brief Copies the qname from dns_msg to buf
  *
@@ -81,6 +81,17 @@ NET_BUF_POOL_DEFINE(dns_qname_pool, DNS_RESOLVER_BUF_CTR,
 DNS_CACHE_DEFINE(dns_cache, CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
+#ifdef CONFIG_DNS_RESOLVER_COALESCE_QUERIES
+static atomic_t dns_coalesced;
+#endif /* CONFIG_DNS_RESOLVER_COALESCE_QUERIES */
+
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+/* A single refresh query at a time, its name outlives the lookup starting it */
+#define DNS_PREFETCH_TIMEOUT_MS (2 * MSEC_PER_SEC)
+static char dns_prefetch_query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
+static atomic_t dns_prefetch_busy;
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
 static int init_called;
 static struct dns_resolve_context dns_default_ctx;
 
@@ -103,6 +114,11 @@ static inline void invoke_query_callback(int status,
 					 struct dns_addrinfo *info,
 					 struct dns_pending_query *pending_query);
 static void release_query(struct dns_pending_query *pending_query);
+static int dns_resolve_cancel_name(struct dns_resolve_context *ctx,
+				   uint16_t dns_id,
+				   const char *query_name,
+				   enum dns_query_type query_type,
+				   bool whole_lookup);
 
 static bool server_is_mdns(sa_family_t family, struct sockaddr *addr)
 {
@@ -779,6 +795,18 @@ static inline void invoke_query_callback(int status,
 	if (pending_query->query != NULL && pending_query->cb != NULL)  {
 		pending_query->cb(status, info, pending_query->user_data);
 	}
+
+#if defined(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)
+	/* Also notify the queries that joined this one */
+	for (int i = 0; pending_query->ctx != NULL && i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		struct dns_pending_query *query = &pending_query->ctx->queries[i];
+
+		if (query->coalesced_with == pending_query &&
+		    query->query != NULL && query->cb != NULL) {
+			query->cb(status, info, query->user_data);
+		}
+	}
+#endif /* CONFIG_DNS_RESOLVER_COALESCE_QUERIES */
 }
 
 /* Release a query slot reserved by get_cb_slot().
@@ -791,6 +819,18 @@ static void release_query(struct dns_pending_query *pending_query)
 {
 	int busy = k_work_cancel_delayable(&pending_query->timer);
 
+#if defined(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)
+	/* The queries that joined this one end with it */
+	for (int i = 0; pending_query->ctx != NULL && i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		struct dns_pending_query *query = &pending_query->ctx->queries[i];
+
+		if (query->coalesced_with == pending_query) {
+			query->coalesced_with = NULL;
+			release_query(query);
+		}
+	}
+#endif /* CONFIG_DNS_RESOLVER_COALESCE_QUERIES */
+
 	/* If the work item is no longer pending we're done. */
 	if (busy == 0) {
 		/* All done. */
@@ -823,6 +863,77 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)
+/* Must be invoked with context lock held */
+static int get_slot_by_query(struct dns_resolve_context *ctx,
+			     const char *query,
+			     enum dns_query_type query_type)
+{
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (check_query_active(&ctx->queries[i], false) &&
+		    ctx->queries[i].query != NULL &&
+		    ctx->queries[i].coalesced_with == NULL &&
+		    ctx->queries[i].query_type == query_type &&
+		    strcmp(ctx->queries[i].query, query) == 0) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+#endif /* CONFIG_DNS_RESOLVER_COALESCE_QUERIES */
+
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+/* Negative answers, see RFC 2308: the name does not exist (NXDOMAIN), or
+ * has no address of the requested type (NOERROR without answer). The
+ * answer is cached with the TTL of the SOA record in the authority section.
+ *
+ * Must be invoked with context lock held
+ */
+static int dns_validate_negative(struct dns_resolve_context *ctx,
+				 struct dns_msg_t *dns_msg,
+				 uint16_t dns_id,
+				 int *query_idx,
+				 uint16_t *query_hash)
+{
+	char *query_name;
+	int query_name_len;
+	uint32_t ttl;
+	int ret;
+
+	ret = dns_unpack_response_query(dns_msg);
+	if (ret < 0) {
+		errno = -ret;
+		return DNS_EAI_SYSTEM;
+	}
+
+	query_name = dns_msg->msg + dns_msg->query_offset;
+	query_name_len = strlen(query_name);
+
+	for (size_t i = 0, n = query_name_len; i < n; i++) {
+		query_name[i] = tolower(query_name[i]);
+	}
+
+	/* Add \0 and query type (A or AAAA) to the hash */
+	*query_hash = crc16_ansi(query_name, query_name_len + 1 + 2);
+
+	*query_idx = get_slot_by_id(ctx, dns_id, *query_hash);
+	if (*query_idx < 0) {
+		errno = ENOENT;
+		return DNS_EAI_SYSTEM;
+	}
+
+	if (CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL_MAX > 0 &&
+	    dns_unpack_negative_ttl(dns_msg, &ttl) == 0 && ttl > 0) {
+		dns_cache_add_negative(&dns_cache, ctx->queries[*query_idx].query,
+				       ctx->queries[*query_idx].query_type,
+				       MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL_MAX));
+	}
+
+	return DNS_EAI_NODATA;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /* Unit test needs to be able to call this function */
 #if !defined(CONFIG_NET_TEST)
 static
@@ -872,6 +983,18 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+	/* The whole header is checked before looking at the counters, other
+	 * responses are rejected by dns_unpack_response_header() below.
+	 */
+	if (*dns_id > 0 &&
+	    dns_unpack_negative_response_header(dns_msg, *dns_id) == 0) {
+		ret = dns_validate_negative(ctx, dns_msg, *dns_id, query_idx,
+					    query_hash);
+		goto quit;
+	}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 	ret = dns_unpack_response_header(dns_msg, *dns_id);
 	if (ret < 0) {
 		errno = -ret;
@@ -1181,9 +1304,9 @@ static int dns_read(struct dns_resolve_context *ctx,
 	return 0;
 
 finished:
-	dns_resolve_cancel_with_name(ctx, *dns_id,
-				     ctx->queries[query_idx].query,
-				     ctx->queries[query_idx].query_type);
+	dns_resolve_cancel_name(ctx, *dns_id,
+				ctx->queries[query_idx].query,
+				ctx->queries[query_idx].query_type, true);
 quit:
 	return ret;
 }
@@ -1330,6 +1453,74 @@ static void dns_resolve_cancel_slot(struct dns_resolve_context *ctx, int slot)
 	release_query(&ctx->queries[slot]);
 }
 
+#if defined(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)
+/* Callback of a cancelled query that is still pending for the queries that
+ * joined it.
+ */
+static void coalesced_carrier_cb(enum dns_resolve_status status,
+				 struct dns_addrinfo *info,
+				 void *user_data)
+{
+	ARG_UNUSED(status);
+	ARG_UNUSED(info);
+	ARG_UNUSED(user_data);
+}
+
+/* Must be invoked with context lock held */
+static bool has_joined_queries(struct dns_resolve_context *ctx,
+			       struct dns_pending_query *pending_query)
+{
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (ctx->queries[i].coalesced_with == pending_query &&
+		    ctx->queries[i].query != NULL &&
+		    ctx->queries[i].cb != NULL) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif /* CONFIG_DNS_RESOLVER_COALESCE_QUERIES */
+
+/* Cancel the lookup of one caller only, the lookups coalesced with it go on.
+ *
+ * Must be invoked with context lock held.
+ */
+static void dns_resolve_cancel_query(struct dns_resolve_context *ctx, int slot)
+{
+#if defined(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)
+	struct dns_pending_query *query = &ctx->queries[slot];
+	struct dns_pending_query *primary = query->coalesced_with;
+
+	if (primary == NULL && has_joined_queries(ctx, query)) {
+		/* The sent query keeps its id, timer and pending state for
+		 * the joined queries, only the canceller is notified.
+		 */
+		query->cb(DNS_EAI_CANCELED, NULL, query->user_data);
+		query->cb = coalesced_carrier_cb;
+		query->user_data = NULL;
+		return;
+	}
+
+	if (primary != NULL) {
+		invoke_query_callback(DNS_EAI_CANCELED, NULL, query);
+
+		query->coalesced_with = NULL;
+		release_query(query);
+
+		/* Nobody is waiting for the carried query anymore */
+		if (primary->cb == coalesced_carrier_cb &&
+		    !has_joined_queries(ctx, primary)) {
+			release_query(primary);
+		}
+
+		return;
+	}
+#endif /* CONFIG_DNS_RESOLVER_COALESCE_QUERIES */
+
+	dns_resolve_cancel_slot(ctx, slot);
+}
+
 /* Must be invoked with context lock held */
 static void dns_resolve_cancel_all(struct dns_resolve_context *ctx)
 {
@@ -1342,10 +1533,14 @@ static void dns_resolve_cancel_all(struct dns_resolve_context *ctx)
 	}
 }
 
+/* If whole_lookup is set, the queries coalesced with the cancelled one end
+ * with it, otherwise only the lookup of the caller is cancelled.
+ */
 static int dns_resolve_cancel_with_hash(struct dns_resolve_context *ctx,
 					uint16_t dns_id,
 					uint16_t query_hash,
-					const char *query_name)
+					const char *query_name,
+					bool whole_lookup)
 {
 	int ret = 0;
 	int i;
@@ -1370,7 +1565,20 @@ static int dns_resolve_cancel_with_hash(struct dns_resolve_context *ctx,
 		query_name == NULL ? "<unknown>" : query_name,
 		ctx->queries[i].query_type, query_hash);
 
-	dns_resolve_cancel_slot(ctx, i);
+	if (whole_lookup) {
+		dns_resolve_cancel_slot(ctx, i);
+		goto unlock;
+	}
+
+#if defined(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)
+	if (ctx->queries[i].cb == coalesced_carrier_cb) {
+		/* Already cancelled by its caller */
+		ret = -ENOENT;
+		goto unlock;
+	}
+#endif /* CONFIG_DNS_RESOLVER_COALESCE_QUERIES */
+
+	dns_resolve_cancel_query(ctx, i);
 
 unlock:
 	k_mutex_unlock(&ctx->lock);
@@ -1378,10 +1586,11 @@ unlock:
 	return ret;
 }
 
-int dns_resolve_cancel_with_name(struct dns_resolve_context *ctx,
-				 uint16_t dns_id,
-				 const char *query_name,
-				 enum dns_query_type query_type)
+static int dns_resolve_cancel_name(struct dns_resolve_context *ctx,
+				   uint16_t dns_id,
+				   const char *query_name,
+				   enum dns_query_type query_type,
+				   bool whole_lookup)
 {
 	uint16_t query_hash = 0;
 
@@ -1424,7 +1633,16 @@ int dns_resolve_cancel_with_name(struct dns_resolve_context *ctx,
 	}
 
 	return dns_resolve_cancel_with_hash(ctx, dns_id, query_hash,
-					    query_name);
+					    query_name, whole_lookup);
+}
+
+int dns_resolve_cancel_with_name(struct dns_resolve_context *ctx,
+				 uint16_t dns_id,
+				 const char *query_name,
+				 enum dns_query_type query_type)
+{
+	return dns_resolve_cancel_name(ctx, dns_id, query_name, query_type,
+				       false);
 }
 
 int dns_resolve_cancel(struct dns_resolve_context *ctx, uint16_t dns_id)
@@ -1475,11 +1693,48 @@ static void query_timeout(struct k_work *work)
 	(void)dns_resolve_cancel_with_hash(pending_query->ctx,
 					   pending_query->id,
 					   pending_query->query_hash,
-					   pending_query->query);
+					   pending_query->query, true);
 
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+static void dns_prefetch_cb(enum dns_resolve_status status,
+			    struct dns_addrinfo *info,
+			    void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	/* The answers were added to the cache, only the end matters here */
+	if (info == NULL) {
+		NET_DBG("Refresh of \"%s\" done (%d)", dns_prefetch_query, status);
+		atomic_clear(&dns_prefetch_busy);
+	}
+}
+
+static void dns_prefetch(struct dns_resolve_context *ctx,
+			 const char *query,
+			 enum dns_query_type type)
+{
+	int ret;
+
+	if (!atomic_cas(&dns_prefetch_busy, 0, 1)) {
+		return;
+	}
+
+	strncpy(dns_prefetch_query, query, sizeof(dns_prefetch_query) - 1);
+	dns_prefetch_query[sizeof(dns_prefetch_query) - 1] = '\0';
+
+	ret = dns_resolve_name_internal(ctx, dns_prefetch_query, type, NULL,
+					dns_prefetch_cb, NULL,
+					DNS_PREFETCH_TIMEOUT_MS, false);
+	if (ret < 0) {
+		NET_DBG("Cannot refresh \"%s\" (%d)", query, ret);
+		atomic_clear(&dns_prefetch_busy);
+	}
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
 int dns_resolve_name_internal(struct dns_resolve_context *ctx,
 			      const char *query,
 			      enum dns_query_type type,
@@ -1575,6 +1830,18 @@ try_resolve:
 
 			cb(DNS_EAI_ALLDONE, NULL, user_data);
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+			if (dns_cache_refresh_due(&dns_cache, query, type)) {
+				dns_prefetch(ctx, query, type);
+			}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
+			return 0;
+		}
+
+		if (dns_cache_find_negative(&dns_cache, query, type) > 0) {
+			cb(DNS_EAI_NODATA, NULL, user_data);
+
 			return 0;
 		}
 	}
@@ -1589,6 +1856,10 @@ try_resolve:
 		goto fail;
 	}
 
+#if defined(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)
+	j = get_slot_by_query(ctx, query, type);
+#endif
+
 	i = get_cb_slot(ctx);
 	if (i < 0) {
 		ret = -EAGAIN;
@@ -1605,6 +1876,33 @@ try_resolve:
 
 	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
 
+#if defined(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)
+	ctx->queries[i].coalesced_with = NULL;
+
+	if (j >= 0) {
+		/* Join the identical pending query instead of sending another
+		 * one. The id is only used to cancel this query.
+		 */
+		do {
+			ctx->queries[i].id = sys_rand16_get();
+		} while (ctx->queries[i].id == ctx->queries[j].id);
+
+		ctx->queries[i].query_hash = ctx->queries[j].query_hash;
+		ctx->queries[i].coalesced_with = &ctx->queries[j];
+
+		if (dns_id) {
+			*dns_id = ctx->queries[i].id;
+		}
+
+		NET_DBG("[%u] joined pending query [%u] for id %u", i, j,
+			ctx->queries[j].id);
+
+		atomic_inc(&dns_coalesced);
+		ret = 0;
+		goto quit;
+	}
+#endif /* CONFIG_DNS_RESOLVER_COALESCE_QUERIES */
+
 	dns_data = net_buf_alloc(&dns_msg_pool, ctx->buf_timeout);
 	if (!dns_data) {
 		ret = -ENOMEM;
@@ -1739,6 +2037,25 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 					 user_data, timeout, true);
 }
 
+int dns_resolve_cache_stats_get(struct dns_resolve_cache_stats *stats)
+{
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+	dns_cache_stats_get(&dns_cache, stats);
+
+#ifdef CONFIG_DNS_RESOLVER_COALESCE_QUERIES
+	stats->coalesced = atomic_get(&dns_coalesced);
+#endif
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+}
+
 /* Must be invoked with context lock held */
 static int dns_resolve_close_locked(struct dns_resolve_context *ctx)
 {
@@ -10,6 +10,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/net_core.h>
+#include <zephyr/sys/byteorder.h>
 
 LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
@@ -96,6 +97,193 @@ const struct hpack_table_entry *http_hpack_table_get(uint32_t key)
 	return &http_hpack_table_static[key];
 }
 
+/* Size accounted for each dynamic table entry on top of the name and value
+ * lengths, RFC7541 ch 4.1.
+ */
+#define HPACK_ENTRY_OVERHEAD 32
+/* Name and value lengths stored in front of each entry. */
+#define HPACK_ENTRY_HDR_LEN (2 * sizeof(uint16_t))
+
+#define HPACK_DYNAMIC_INDEX_FIRST (HTTP_SERVER_HPACK_WWW_AUTHENTICATE + 1)
+
+static uint8_t *hpack_table_entry(struct http_hpack_table *table, uint32_t n)
+{
+	uint8_t *entry = table->data;
+
+	if (n >= table->count) {
+		return NULL;
+	}
+
+	while (n-- > 0) {
+		entry += HPACK_ENTRY_HDR_LEN + sys_get_be16(entry) +
+			 sys_get_be16(entry + sizeof(uint16_t));
+	}
+
+	return entry;
+}
+
+static void hpack_table_evict(struct http_hpack_table *table, size_t max_size)
+{
+	while (table->size > max_size) {
+		uint8_t *entry = hpack_table_entry(table, table->count - 1);
+		size_t name_len = sys_get_be16(entry);
+		size_t value_len = sys_get_be16(entry + sizeof(uint16_t));
+
+		table->used = entry - table->data;
+		table->size -= name_len + value_len + HPACK_ENTRY_OVERHEAD;
+		table->count--;
+	}
+}
+
+static void hpack_table_insert(struct http_hpack_table *table,
+			       const char *name, size_t name_len,
+			       const char *value, size_t value_len)
+{
+	size_t entry_size = name_len + value_len + HPACK_ENTRY_OVERHEAD;
+	size_t entry_len = HPACK_ENTRY_HDR_LEN + name_len + value_len;
+	uint8_t *entry = table->data;
+
+	if (entry_size > table->max_size) {
+		/* Not an error, the table just ends up empty. */
+		hpack_table_evict(table, 0);
+		return;
+	}
+
+	hpack_table_evict(table, table->max_size - entry_size);
+
+	/* The entry overhead is larger than the stored lengths, so the
+	 * entries always fit if the size limit is respected.
+	 */
+	NET_ASSERT(table->used + entry_len <= table->data_size);
+
+	/* Newest entry goes first. */
+	memmove(entry + entry_len, entry, table->used);
+
+	sys_put_be16(name_len, entry);
+	sys_put_be16(value_len, entry + sizeof(uint16_t));
+	memcpy(entry + HPACK_ENTRY_HDR_LEN, name, name_len);
+	memcpy(entry + HPACK_ENTRY_HDR_LEN + name_len, value, value_len);
+
+	table->used += entry_len;
+	table->size += entry_size;
+	table->count++;
+}
+
+void http_hpack_table_init(struct http_hpack_table *table, uint8_t *data,
+			   size_t data_size, size_t max_size)
+{
+	table->data = data;
+	table->data_size = MIN(data_size, UINT16_MAX);
+	table->used = 0;
+	table->size = 0;
+	table->count = 0;
+	table->max_size = MIN(max_size, table->data_size);
+	table->limit = table->max_size;
+
+	/* The peer starts with the default size, so tell it if a different
+	 * one is used (only relevant when encoding).
+	 */
+	table->size_update = (table->max_size != HTTP_HPACK_DEFAULT_TABLE_SIZE);
+}
+
+void http_hpack_table_resize(struct http_hpack_table *table, size_t max_size)
+{
+	max_size = MIN(max_size, table->data_size);
+	if (max_size == table->max_size) {
+		return;
+	}
+
+	hpack_table_evict(table, max_size);
+	table->max_size = max_size;
+	table->size_update = true;
+}
+
+void http_hpack_table_set_limit(struct http_hpack_table *table, size_t limit)
+{
+	/* The entries are kept until the peer sends the table size update,
+	 * which it must do before any other field if the limit is lowered
+	 * below the current size, RFC 7541 ch 4.2.
+	 */
+	table->limit = MIN(limit, table->data_size);
+}
+
+/* Get the name and value of a static or dynamic table entry. Value is NULL
+ * for static entries without one.
+ */
+static int hpack_table_lookup(struct http_hpack_table *table, uint32_t index,
+			      const char **name, size_t *name_len,
+			      const char **value, size_t *value_len)
+{
+	const struct hpack_table_entry *static_entry;
+	uint8_t *entry;
+
+	static_entry = http_hpack_table_get(index);
+	if (static_entry != NULL) {
+		if (static_entry->name == NULL) {
+			return -EBADMSG;
+		}
+
+		*name = static_entry->name;
+		*name_len = strlen(static_entry->name);
+		*value = static_entry->value;
+		*value_len = static_entry->value != NULL ? strlen(static_entry->value) : 0;
+
+		return 0;
+	}
+
+	if (table == NULL || index < HPACK_DYNAMIC_INDEX_FIRST) {
+		return -EBADMSG;
+	}
+
+	entry = hpack_table_entry(table, index - HPACK_DYNAMIC_INDEX_FIRST);
+	if (entry == NULL) {
+		return -EBADMSG;
+	}
+
+	*name_len = sys_get_be16(entry);
+	*value_len = sys_get_be16(entry + sizeof(uint16_t));
+	*name = (const char *)entry + HPACK_ENTRY_HDR_LEN;
+	*value = *name + *name_len;
+
+	return 0;
+}
+
+static int hpack_table_find_index(struct http_hpack_table *table,
+				  struct http_hpack_header_buf *header,
+				  bool *name_only)
+{
+	uint8_t *entry = table->data;
+	int candidate = -1;
+
+	for (int i = 0; i < table->count; i++) {
+		size_t name_len = sys_get_be16(entry);
+		size_t value_len = sys_get_be16(entry + sizeof(uint16_t));
+		const uint8_t *name = entry + HPACK_ENTRY_HDR_LEN;
+
+		if (name_len == header->name_len &&
+		    memcmp(name, header->name, name_len) == 0) {
+			if (value_len == header->value_len &&
+			    memcmp(name + name_len, header->value, value_len) == 0) {
+				*name_only = false;
+				return HPACK_DYNAMIC_INDEX_FIRST + i;
+			}
+
+			if (candidate < 0) {
+				candidate = HPACK_DYNAMIC_INDEX_FIRST + i;
+			}
+		}
+
+		entry += HPACK_ENTRY_HDR_LEN + name_len + value_len;
+	}
+
+	if (candidate > 0) {
+		*name_only = true;
+		return candidate;
+	}
+
+	return -ENOENT;
+}
+
 static int http_hpack_find_index(struct http_hpack_header_buf *header,
 				 bool *name_only)
 {
@@ -282,9 +470,9 @@ static int hpack_string_decode(const uint8_t *buf, size_t datalen,
 }
 
 static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
-				struct http_hpack_header_buf *header)
+				struct http_hpack_header_buf *header,
+				struct http_hpack_table *table)
 {
-	const struct hpack_table_entry *entry;
 	uint32_t index;
 	int ret;
 
@@ -298,26 +486,19 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 		return -EBADMSG;
 	}
 
-	entry = http_hpack_table_get(index);
-	if (entry == NULL) {
+	if (hpack_table_lookup(table, index, &header->name, &header->name_len,
+			       &header->value, &header->value_len) < 0 ||
+	    header->value == NULL) {
 		return -EBADMSG;
 	}
 
-	if (entry->name == NULL || entry->value == NULL) {
-		return -EBADMSG;
-	}
-
-	header->name = entry->name;
-	header->name_len = strlen(entry->name);
-	header->value = entry->value;
-	header->value_len = strlen(entry->value);
-
 	return ret;
 }
 
 static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 				struct http_hpack_header_buf *header,
-				uint8_t prefix_len)
+				struct http_hpack_table *table,
+				uint8_t prefix_len, bool indexing)
 {
 	uint32_t index;
 	int ret, len;
@@ -346,19 +527,26 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 		datalen -= ret;
 	} else {
 		/* Indexed name. */
-		const struct hpack_table_entry *entry;
+		const char *value;
+		size_t value_len;
 
-		entry = http_hpack_table_get(index);
-		if (entry == NULL) {
+		if (hpack_table_lookup(table, index, &header->name,
+				       &header->name_len, &value, &value_len) < 0) {
 			return -EBADMSG;
 		}
 
-		if (entry->name == NULL) {
-			return -EBADMSG;
-		}
+		if (indexing && index >= HPACK_DYNAMIC_INDEX_FIRST) {
+			/* The entry might get evicted when the new one is
+			 * inserted, keep a copy of the name.
+			 */
+			if (header->name_len > sizeof(header->buf)) {
+				return -ENOBUFS;
+			}
 
-		header->name = entry->name;
-		header->name_len = strlen(entry->name);
+			memcpy(header->buf, header->name, header->name_len);
+			header->name = header->buf;
+			header->datalen = header->name_len;
+		}
 	}
 
 	ret = hpack_string_decode(buf, datalen, HPACK_HEADER_VALUE, header);
@@ -368,26 +556,33 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 
 	len += ret;
 
+	if (indexing && table != NULL) {
+		hpack_table_insert(table, header->name, header->name_len,
+				   header->value, header->value_len);
+	}
+
 	return len;
 }
 
 static int hpack_handle_literal_index(const uint8_t *buf, size_t datalen,
-			       struct http_hpack_header_buf *header)
+				      struct http_hpack_header_buf *header,
+				      struct http_hpack_table *table)
 {
-	/* TODO Add dynamic table support, if needed. */
-
-	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	return hpack_handle_literal(buf, datalen, header, table,
+				    HPACK_PREFIX_LEN_LITERAL_INDEXING, true);
 }
 
 static int hpack_handle_literal_no_index(const uint8_t *buf, size_t datalen,
-				  struct http_hpack_header_buf *header)
+					 struct http_hpack_header_buf *header,
+					 struct http_hpack_table *table)
 {
-	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING);
+	return hpack_handle_literal(buf, datalen, header, table,
+				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING, false);
 }
 
-static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
+static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen,
+					    struct http_hpack_header_buf *header,
+					    struct http_hpack_table *table)
 {
 	uint32_t max_size;
 	int ret;
@@ -398,13 +593,28 @@ static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
 		return ret;
 	}
 
-	/* TODO Add dynamic table support, if needed. */
+	if (table != NULL) {
+		/* Cannot exceed the size announced in the settings. */
+		if (max_size > table->limit) {
+			return -EBADMSG;
+		}
+
+		hpack_table_evict(table, max_size);
+		table->max_size = max_size;
+	}
+
+	/* No header field is produced. */
+	header->name = NULL;
+	header->name_len = 0;
+	header->value = NULL;
+	header->value_len = 0;
 
 	return ret;
 }
 
 int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
-			     struct http_hpack_header_buf *header)
+			     struct http_hpack_header_buf *header,
+			     struct http_hpack_table *table)
 {
 	uint8_t prefix;
 	int ret;
@@ -419,19 +629,26 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 
 	prefix = *buf;
 
+	/* A lowered limit must be acknowledged with a table size update. */
+	if (table != NULL && table->max_size > table->limit &&
+	    (prefix & HPACK_PREFIX_DYNAMIC_TABLE_SIZE_MASK) !=
+	    HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE) {
+		return -EBADMSG;
+	}
+
 	if ((prefix & HPACK_PREFIX_INDEXED_MASK) == HPACK_PREFIX_INDEXED) {
-		ret = hpack_handle_indexed(buf, datalen, header);
+		ret = hpack_handle_indexed(buf, datalen, header, table);
 	} else if ((prefix & HPACK_PREFIX_LITERAL_INDEXING_MASK) ==
 		   HPACK_PREFIX_LITERAL_INDEXING) {
-		ret = hpack_handle_literal_index(buf, datalen, header);
+		ret = hpack_handle_literal_index(buf, datalen, header, table);
 	} else if (((prefix & HPACK_PREFIX_LITERAL_NO_INDEXING_MASK) ==
 		    HPACK_PREFIX_LITERAL_NO_INDEXING) ||
 		   ((prefix & HPACK_PREFIX_LITERAL_NEVER_INDEXED_MASK) ==
 		    HPACK_PREFIX_LITERAL_NEVER_INDEXED)) {
-		ret = hpack_handle_literal_no_index(buf, datalen, header);
+		ret = hpack_handle_literal_no_index(buf, datalen, header, table);
 	} else if ((prefix & HPACK_PREFIX_DYNAMIC_TABLE_SIZE_MASK) ==
 		   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE) {
-		ret = hpack_handle_dynamic_size_update(buf, datalen);
+		ret = hpack_handle_dynamic_size_update(buf, datalen, header, table);
 	} else {
 		ret = -EINVAL;
 	}
@@ -465,7 +682,7 @@ static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
 			return -ENOBUFS;
 		}
 
-		*buf = (uint8_t)((value % 128) + 128);
+		*buf++ = (uint8_t)((value % 128) + 128);
 		len++;
 		value /= 128;
 	}
@@ -530,13 +747,12 @@ static int hpack_string_encode(uint8_t *buf, size_t buflen,
 }
 
 static int hpack_encode_literal(uint8_t *buf, size_t buflen,
-				struct http_hpack_header_buf *header)
+				struct http_hpack_header_buf *header,
+				uint8_t prefix, uint8_t prefix_len)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, 0,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
+	ret = hpack_integer_encode(buf, buflen, 0, prefix, prefix_len);
 	if (ret < 0) {
 		return ret;
 	}
@@ -565,13 +781,12 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 }
 
 static int hpack_encode_literal_value(uint8_t *buf, size_t buflen, int index,
-				      struct http_hpack_header_buf *header)
+				      struct http_hpack_header_buf *header,
+				      uint8_t prefix, uint8_t prefix_len)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, index,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
+	ret = hpack_integer_encode(buf, buflen, index, prefix, prefix_len);
 	if (ret < 0) {
 		return ret;
 	}
@@ -596,9 +811,38 @@ static int hpack_encode_indexed(uint8_t *buf, size_t buflen, int index)
 				    HPACK_PREFIX_LEN_INDEXED);
 }
 
+static int hpack_encode_size_update(uint8_t *buf, size_t buflen,
+				    struct http_hpack_table *table)
+{
+	return hpack_integer_encode(buf, buflen, table->max_size,
+				    HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+				    HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+}
+
+/* Headers which values should not end up in the compression context. */
+static bool hpack_header_is_sensitive(struct http_hpack_header_buf *header)
+{
+	static const char *const sensitive[] = {
+		"authorization", "cookie", "proxy-authorization", "set-cookie",
+	};
+
+	ARRAY_FOR_EACH(sensitive, i) {
+		if (strlen(sensitive[i]) == header->name_len &&
+		    memcmp(sensitive[i], header->name, header->name_len) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
-			     struct http_hpack_header_buf *header)
+			     struct http_hpack_header_buf *header,
+			     struct http_hpack_table *table)
 {
+	uint8_t prefix = HPACK_PREFIX_LITERAL_NEVER_INDEXED;
+	uint8_t prefix_len = HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED;
+	bool indexing = false;
 	int ret, len = 0;
 	bool name_only;
 
@@ -612,17 +856,64 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 		return -ENOBUFS;
 	}
 
+	if (table != NULL && table->size_update) {
+		/* Table size change has to be signalled in front of the next
+		 * header field.
+		 */
+		len = hpack_encode_size_update(buf, buflen, table);
+		if (len < 0) {
+			return len;
+		}
+
+		buf += len;
+		buflen -= len;
+	}
+
 	ret = http_hpack_find_index(header, &name_only);
+	if (table != NULL && (ret < 0 || name_only)) {
+		bool dyn_name_only;
+		int dyn;
+
+		dyn = hpack_table_find_index(table, header, &dyn_name_only);
+		if (dyn > 0 && (!dyn_name_only || ret < 0)) {
+			ret = dyn;
+			name_only = dyn_name_only;
+		}
+	}
+
+	if (table != NULL && (ret < 0 || name_only) &&
+	    header->name_len + header->value_len + HPACK_ENTRY_OVERHEAD <= table->max_size &&
+	    !hpack_header_is_sensitive(header)) {
+		indexing = true;
+		prefix = HPACK_PREFIX_LITERAL_INDEXING;
+		prefix_len = HPACK_PREFIX_LEN_LITERAL_INDEXING;
+	}
+
 	if (ret < 0) {
 		/* All literal */
-		len = hpack_encode_literal(buf, buflen, header);
+		ret = hpack_encode_literal(buf, buflen, header, prefix, prefix_len);
 	} else if (name_only) {
 		/* Literal value */
-		len = hpack_encode_literal_value(buf, buflen, ret, header);
+		ret = hpack_encode_literal_value(buf, buflen, ret, header,
+						 prefix, prefix_len);
 	} else {
 		/* Indexed */
-		len = hpack_encode_indexed(buf, buflen, ret);
+		ret = hpack_encode_indexed(buf, buflen, ret);
 	}
 
-	return len;
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* Update the compression context only once the header is encoded. */
+	if (table != NULL) {
+		table->size_update = false;
+	}
+
+	if (indexing) {
+		hpack_table_insert(table, header->name, header->name_len,
+				   header->value, header->value_len);
+	}
+
+	return len + ret;
 }
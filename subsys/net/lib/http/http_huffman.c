@@ -277,128 +277,181 @@ static const struct decode_elem decode_table[] = {
 	{ 30,  22, { 0b11111111, 0b11111111, 0b11111111, 0b11111000 } },
 };
 
-static const struct decode_elem eos = {
-	30,   0, { 0b11111111, 0b11111111, 0b11111111, 0b11111100 }
+/* Decoding is table driven. The first byte of a code is resolved with a single
+ * lookup in lookup_table, which covers all the codes of up to 8 bits (the
+ * vast majority of the characters seen in headers). The remaining codes all
+ * start with 0xfe or 0xff, and as the HPACK code is canonical, codes of the
+ * same length are consecutive. Their length is found by comparing the input
+ * with the upper limit of each code length in long_codes, and the symbol is
+ * then at a fixed offset in decode_table.
+ */
+struct huffman_lookup {
+	uint8_t symbol;
+	uint8_t bitlen; /* 0 if the code is longer than 8 bits */
 };
 
-#define UINT32_BITLEN 32
+struct huffman_long_code {
+	uint32_t limit; /* First left-aligned code not of this length */
+	uint8_t bitlen;
+	uint8_t index; /* Index of the first code of this length in decode_table */
+};
 
-#define MSB_MASK(len) (UINT32_MAX << (UINT32_BITLEN - len))
-#define LSB_MASK(len) ((1UL << len) - 1UL)
+static const struct huffman_lookup lookup_table[256] = {
+	{  48, 5 }, {  48, 5 }, {  48, 5 }, {  48, 5 }, {  48, 5 }, {  48, 5 }, {  48, 5 }, {  48, 5 },
+	{  49, 5 }, {  49, 5 }, {  49, 5 }, {  49, 5 }, {  49, 5 }, {  49, 5 }, {  49, 5 }, {  49, 5 },
+	{  50, 5 }, {  50, 5 }, {  50, 5 }, {  50, 5 }, {  50, 5 }, {  50, 5 }, {  50, 5 }, {  50, 5 },
+	{  97, 5 }, {  97, 5 }, {  97, 5 }, {  97, 5 }, {  97, 5 }, {  97, 5 }, {  97, 5 }, {  97, 5 },
+	{  99, 5 }, {  99, 5 }, {  99, 5 }, {  99, 5 }, {  99, 5 }, {  99, 5 }, {  99, 5 }, {  99, 5 },
+	{ 101, 5 }, { 101, 5 }, { 101, 5 }, { 101, 5 }, { 101, 5 }, { 101, 5 }, { 101, 5 }, { 101, 5 },
+	{ 105, 5 }, { 105, 5 }, { 105, 5 }, { 105, 5 }, { 105, 5 }, { 105, 5 }, { 105, 5 }, { 105, 5 },
+	{ 111, 5 }, { 111, 5 }, { 111, 5 }, { 111, 5 }, { 111, 5 }, { 111, 5 }, { 111, 5 }, { 111, 5 },
+	{ 115, 5 }, { 115, 5 }, { 115, 5 }, { 115, 5 }, { 115, 5 }, { 115, 5 }, { 115, 5 }, { 115, 5 },
+	{ 116, 5 }, { 116, 5 }, { 116, 5 }, { 116, 5 }, { 116, 5 }, { 116, 5 }, { 116, 5 }, { 116, 5 },
+	{  32, 6 }, {  32, 6 }, {  32, 6 }, {  32, 6 }, {  37, 6 }, {  37, 6 }, {  37, 6 }, {  37, 6 },
+	{  45, 6 }, {  45, 6 }, {  45, 6 }, {  45, 6 }, {  46, 6 }, {  46, 6 }, {  46, 6 }, {  46, 6 },
+	{  47, 6 }, {  47, 6 }, {  47, 6 }, {  47, 6 }, {  51, 6 }, {  51, 6 }, {  51, 6 }, {  51, 6 },
+	{  52, 6 }, {  52, 6 }, {  52, 6 }, {  52, 6 }, {  53, 6 }, {  53, 6 }, {  53, 6 }, {  53, 6 },
+	{  54, 6 }, {  54, 6 }, {  54, 6 }, {  54, 6 }, {  55, 6 }, {  55, 6 }, {  55, 6 }, {  55, 6 },
+	{  56, 6 }, {  56, 6 }, {  56, 6 }, {  56, 6 }, {  57, 6 }, {  57, 6 }, {  57, 6 }, {  57, 6 },
+	{  61, 6 }, {  61, 6 }, {  61, 6 }, {  61, 6 }, {  65, 6 }, {  65, 6 }, {  65, 6 }, {  65, 6 },
+	{  95, 6 }, {  95, 6 }, {  95, 6 }, {  95, 6 }, {  98, 6 }, {  98, 6 }, {  98, 6 }, {  98, 6 },
+	{ 100, 6 }, { 100, 6 }, { 100, 6 }, { 100, 6 }, { 102, 6 }, { 102, 6 }, { 102, 6 }, { 102, 6 },
+	{ 103, 6 }, { 103, 6 }, { 103, 6 }, { 103, 6 }, { 104, 6 }, { 104, 6 }, { 104, 6 }, { 104, 6 },
+	{ 108, 6 }, { 108, 6 }, { 108, 6 }, { 108, 6 }, { 109, 6 }, { 109, 6 }, { 109, 6 }, { 109, 6 },
+	{ 110, 6 }, { 110, 6 }, { 110, 6 }, { 110, 6 }, { 112, 6 }, { 112, 6 }, { 112, 6 }, { 112, 6 },
+	{ 114, 6 }, { 114, 6 }, { 114, 6 }, { 114, 6 }, { 117, 6 }, { 117, 6 }, { 117, 6 }, { 117, 6 },
+	{  58, 7 }, {  58, 7 }, {  66, 7 }, {  66, 7 }, {  67, 7 }, {  67, 7 }, {  68, 7 }, {  68, 7 },
+	{  69, 7 }, {  69, 7 }, {  70, 7 }, {  70, 7 }, {  71, 7 }, {  71, 7 }, {  72, 7 }, {  72, 7 },
+	{  73, 7 }, {  73, 7 }, {  74, 7 }, {  74, 7 }, {  75, 7 }, {  75, 7 }, {  76, 7 }, {  76, 7 },
+	{  77, 7 }, {  77, 7 }, {  78, 7 }, {  78, 7 }, {  79, 7 }, {  79, 7 }, {  80, 7 }, {  80, 7 },
+	{  81, 7 }, {  81, 7 }, {  82, 7 }, {  82, 7 }, {  83, 7 }, {  83, 7 }, {  84, 7 }, {  84, 7 },
+	{  85, 7 }, {  85, 7 }, {  86, 7 }, {  86, 7 }, {  87, 7 }, {  87, 7 }, {  89, 7 }, {  89, 7 },
+	{ 106, 7 }, { 106, 7 }, { 107, 7 }, { 107, 7 }, { 113, 7 }, { 113, 7 }, { 118, 7 }, { 118, 7 },
+	{ 119, 7 }, { 119, 7 }, { 120, 7 }, { 120, 7 }, { 121, 7 }, { 121, 7 }, { 122, 7 }, { 122, 7 },
+	{  38, 8 }, {  42, 8 }, {  44, 8 }, {  59, 8 }, {  88, 8 }, {  90, 8 }, {   0, 0 }, {   0, 0 },
+};
 
-static bool huffman_bits_compare(uint32_t bits, const struct decode_elem *entry)
-{
-	uint32_t mask = MSB_MASK(entry->bitlen);
-	uint32_t code = sys_get_be32(entry->code);
+static const struct huffman_long_code long_codes[] = {
+	{ 0xff400000, 10,  74 },
+	{ 0xffa00000, 11,  79 },
+	{ 0xffc00000, 12,  82 },
+	{ 0xfff00000, 13,  84 },
+	{ 0xfff80000, 14,  90 },
+	{ 0xfffe0000, 15,  92 },
+	{ 0xfffe6000, 19,  95 },
+	{ 0xfffee000, 20,  98 },
+	{ 0xffff4800, 21, 106 },
+	{ 0xffffb000, 22, 119 },
+	{ 0xffffea00, 23, 145 },
+	{ 0xfffff600, 24, 174 },
+	{ 0xfffff800, 25, 186 },
+	{ 0xfffffbc0, 26, 190 },
+	{ 0xfffffe20, 27, 205 },
+	{ 0xfffffff0, 28, 224 },
+	{ 0xfffffffc, 30, 253 },
+};
 
-	if (code == (bits & mask)) {
-		return true;
-	}
+static const uint8_t encode_index[256] = {
+	 84, 145, 224, 225, 226, 227, 228, 229, 230, 174, 253, 231, 232, 254, 233, 234,
+	235, 236, 237, 238, 239, 240, 255, 241, 242, 243, 244, 245, 246, 247, 248, 249,
+	 10,  74,  75,  82,  85,  11,  68,  79,  76,  77,  69,  80,  70,  12,  13,  14,
+	  0,   1,   2,  15,  16,  17,  18,  19,  20,  21,  36,  71,  92,  22,  83,  78,
+	 86,  23,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,
+	 51,  52,  53,  54,  55,  56,  57,  58,  72,  59,  73,  87,  95,  88,  90,  24,
+	 93,   3,  25,   4,  26,   5,  27,  28,  29,   6,  60,  61,  30,  31,  32,   7,
+	 33,  62,  34,   8,   9,  35,  63,  64,  65,  66,  67,  94,  81,  91,  89, 250,
+	 98, 119,  99, 100, 120, 121, 122, 146, 123, 147, 148, 149, 150, 151, 175, 152,
+	176, 177, 124, 153, 178, 154, 155, 156, 157, 106, 125, 158, 126, 159, 160, 179,
+	127, 107, 101, 128, 129, 161, 162, 108, 163, 130, 131, 180, 109, 132, 164, 165,
+	110, 111, 133, 112, 166, 134, 167, 168, 102, 135, 136, 137, 169, 138, 139, 170,
+	190, 191, 103,  96, 140, 171, 141, 186, 192, 193, 194, 205, 206, 195, 181, 187,
+	 97, 113, 196, 207, 208, 197, 209, 182, 114, 115, 198, 199, 251, 210, 211, 212,
+	104, 183, 105, 116, 142, 117, 118, 172, 143, 144, 188, 189, 184, 185, 200, 173,
+	201, 213, 202, 203, 214, 215, 216, 217, 218, 252, 219, 220, 221, 222, 223, 204,
+};
 
-	return false;
-}
+#define LOOKUP_BITS 8
+#define LONG_CODES_BASE 0xfe000000
+#define MAX_PADDING_LEN 7
+
+#define UINT32_BITLEN 32
+#define UINT64_BITLEN 64
 
 static const struct decode_elem *huffman_decode_bits(uint32_t bits)
 {
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (huffman_bits_compare(bits, &decode_table[i])) {
-			return &decode_table[i];
-		}
-	}
+	const struct huffman_lookup *entry = &lookup_table[bits >> (UINT32_BITLEN - LOOKUP_BITS)];
+	uint32_t base = LONG_CODES_BASE;
 
-	if (huffman_bits_compare(bits, &eos)) {
-		return &eos;
+	if (entry->bitlen != 0) {
+		return &decode_table[encode_index[entry->symbol]];
 	}
 
-	return NULL;
-}
-
-static const struct decode_elem *huffman_find_entry(uint8_t symbol)
-{
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (decode_table[i].symbol == symbol) {
-			return &decode_table[i];
+	for (int i = 0; i < ARRAY_SIZE(long_codes); i++) {
+		if (bits < long_codes[i].limit) {
+			return &decode_table[long_codes[i].index +
+					     ((bits - base) >> (UINT32_BITLEN - long_codes[i].bitlen))];
 		}
+
+		base = long_codes[i].limit;
 	}
 
+	/* EOS */
 	return NULL;
 }
 
-#define MAX_PADDING_LEN 7
-
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen)
 {
-	size_t encoded_bits_len = encoded_len * 8;
-	uint8_t bits_needed = UINT32_BITLEN;
 	const struct decode_elem *decoded;
-	uint8_t bits_in_byte_left = 8;
 	size_t decoded_len = 0;
-	uint32_t bits = 0;
+	uint64_t acc = 0;
+	uint8_t nbits = 0;
+	uint32_t bits;
 
 	if (encoded_buf == NULL || buf == NULL || encoded_len == 0) {
 		return -EINVAL;
 	}
 
-	while (encoded_bits_len > 0) {
-		/* Refill the bits variable */
-		while (bits_needed > 0) {
-			if (encoded_len > 0) {
-				if (bits_in_byte_left <= bits_needed) {
-					/* Consume rest of the byte */
-					bits <<= bits_in_byte_left;
-					bits |= *encoded_buf &
-						    LSB_MASK(bits_in_byte_left);
-					bits_needed -= bits_in_byte_left;
-					bits_in_byte_left = 0;
-				} else {
-					/* Consume part of the byte */
-					bits <<= bits_needed;
-					bits |= (*encoded_buf >>
-						 (bits_in_byte_left - bits_needed)) &
-						LSB_MASK(bits_needed);
-					bits_in_byte_left -= bits_needed;
-					bits_needed = 0;
-				}
-			} else {
-				/* Pad with ones */
-				bits <<= bits_needed;
-				bits |= LSB_MASK(bits_needed);
-				bits_needed = 0;
-			}
-
-			/* Move to next encoded byte */
-			if (bits_in_byte_left == 0) {
-				encoded_buf++;
-				encoded_len--;
-				bits_in_byte_left = 8;
-			}
+	while (true) {
+		/* Refill the bit accumulator a byte at a time */
+		while (encoded_len > 0 && nbits <= UINT64_BITLEN - 8) {
+			acc |= (uint64_t)*encoded_buf << (UINT64_BITLEN - 8 - nbits);
+			nbits += 8;
+			encoded_buf++;
+			encoded_len--;
 		}
 
-		/* Pass to decoder */
-		decoded = huffman_decode_bits(bits);
-		if (decoded == NULL) {
-			LOG_ERR("No symbol found");
-			return -EBADMSG;
+		if (nbits == 0) {
+			break;
 		}
 
-		if (decoded == &eos) {
-			if (encoded_bits_len > MAX_PADDING_LEN) {
-				LOG_ERR("eos reached prematurely");
-				return -EBADMSG;
-			}
+		/* Past the end of the input, the bits read as ones, which is
+		 * how valid padding looks like.
+		 */
+		bits = (uint32_t)(acc >> UINT32_BITLEN);
+		if (nbits < UINT32_BITLEN) {
+			bits |= UINT32_MAX >> nbits;
+		}
 
+		if (encoded_len == 0 && nbits <= MAX_PADDING_LEN && bits == UINT32_MAX) {
+			/* No code of up to 7 bits is all ones, this is padding. */
 			break;
 		}
 
-		if (encoded_bits_len < decoded->bitlen) {
+		decoded = huffman_decode_bits(bits);
+		if (decoded == NULL) {
+			LOG_ERR("eos reached prematurely");
+			return -EBADMSG;
+		}
+
+		if (decoded->bitlen > nbits) {
 			LOG_ERR("Invalid symbol used for padding");
 			return -EBADMSG;
 		}
 
-		/* Remove consumed bits from bits variable. */
-		bits_needed += decoded->bitlen;
-		encoded_bits_len -= decoded->bitlen;
+		/* Remove consumed bits from the accumulator. */
+		acc <<= decoded->bitlen;
+		nbits -= decoded->bitlen;
 
 		/* Store decoded symbol */
 		if (buflen == 0) {
@@ -419,8 +472,8 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 			      uint8_t *buf, size_t buflen)
 {
 	const struct decode_elem *entry;
-	size_t buflen_bits = buflen * 8;
-	uint8_t bit_offset = 0;
+	uint64_t acc = 0;
+	uint8_t nbits = 0;
 	int len = 0;
 
 	if (str == NULL || buf == NULL || str_len == 0) {
@@ -428,51 +481,36 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 	}
 
 	while (str_len > 0) {
-		uint32_t code;
-		uint8_t bitlen;
-
-		entry = huffman_find_entry(*str);
-		if (entry == NULL) {
-			return -EINVAL;
-		}
-
-		if (entry->bitlen > buflen_bits) {
-			return -ENOBUFS;
-		}
-
-		bitlen = entry->bitlen;
-		code = sys_get_be32(entry->code);
-
-		while (bitlen > 0) {
-			uint8_t to_copy = MIN(8 - bit_offset, bitlen);
-			uint8_t byte = (uint8_t)((code & MSB_MASK(to_copy)) >>
-						 (24 + bit_offset));
-
-			/* This is way suboptimal */
-			if (bit_offset == 0) {
-				*buf = byte;
-			} else {
-				*buf |= byte;
+		entry = &decode_table[encode_index[*str]];
+
+		/* Codes are at most 30 bits long, and at most 7 bits are left
+		 * in the accumulator below.
+		 */
+		acc = (acc << entry->bitlen) |
+		      (sys_get_be32(entry->code) >> (UINT32_BITLEN - entry->bitlen));
+		nbits += entry->bitlen;
+
+		while (nbits >= 8) {
+			if (len >= buflen) {
+				return -ENOBUFS;
 			}
 
-			code <<= to_copy;
-			bitlen -= to_copy;
-			bit_offset  = (bit_offset + to_copy) % 8;
-
-			if (bit_offset == 0) {
-				buf++;
-				len++;
-			}
+			nbits -= 8;
+			*buf++ = (uint8_t)(acc >> nbits);
+			len++;
 		}
 
-		buflen_bits -= entry->bitlen;
 		str_len--;
 		str++;
 	}
 
 	/* Pad with ones. */
-	if (bit_offset > 0) {
-		*buf |= LSB_MASK((8 - bit_offset));
+	if (nbits > 0) {
+		if (len >= buflen) {
+			return -ENOBUFS;
+		}
+
+		*buf = (uint8_t)((acc << (8 - nbits)) | (0xff >> nbits));
 		len++;
 	}
 
@@ -43,6 +43,8 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
 
+#define HTTP_SERVER_USE_WORKERS (CONFIG_HTTP_SERVER_WORKERS > 0)
+
 struct http_server_ctx {
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
 
@@ -52,12 +54,56 @@ struct http_server_ctx {
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
 	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
+
+#if HTTP_SERVER_USE_WORKERS
+	/* Clients being processed by a worker. Their sockets are not polled
+	 * until the worker is done, so a client is never handled by two
+	 * threads at once.
+	 */
+	bool busy[HTTP_SERVER_MAX_CLIENTS];
+	int busy_count;
+
+	/* Copy of fds given to zsock_poll(), see server_poll() */
+	struct zsock_pollfd poll_fds[HTTP_SERVER_SOCK_COUNT];
+#endif
 };
 
 static struct http_server_ctx server_ctx;
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
 
+#if HTTP_SERVER_USE_WORKERS
+/* Protects the poll array and the client slots, which are modified both by
+ * the server thread and by the workers.
+ */
+static K_MUTEX_DEFINE(server_lock);
+static K_CONDVAR_DEFINE(server_idle);
+static K_MSGQ_DEFINE(http_server_work_q, sizeof(struct http_client_ctx *),
+	      HTTP_SERVER_MAX_CLIENTS, sizeof(void *));
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_HTTP_SERVER_WORKERS,
+				   CONFIG_HTTP_SERVER_WORKER_STACK_SIZE);
+static struct k_thread workers[CONFIG_HTTP_SERVER_WORKERS];
+
+static inline void server_lock_take(void)
+{
+	(void)k_mutex_lock(&server_lock, K_FOREVER);
+}
+
+static inline void server_lock_give(void)
+{
+	(void)k_mutex_unlock(&server_lock);
+}
+#else
+static inline void server_lock_take(void)
+{
+}
+
+static inline void server_lock_give(void)
+{
+}
+#endif /* HTTP_SERVER_USE_WORKERS */
+
 #if defined(CONFIG_HTTP_SERVER_TLS_USE_ALPN)
 static const char *const alpn_list[] = {"h2", "http/1.1"};
 #endif
@@ -352,6 +398,8 @@ void http_server_release_client(struct http_client_ctx *client)
 
 	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
 
+	server_lock_take();
+
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
 
@@ -372,6 +420,25 @@ void http_server_release_client(struct http_client_ctx *client)
 
 	memset(client, 0, sizeof(struct http_client_ctx));
 	client->fd = INVALID_SOCK;
+
+	server_lock_give();
+}
+
+bool http_server_dynamic_claim(struct http_resource_detail_dynamic *dynamic_detail,
+			       struct http_client_ctx *client)
+{
+	bool claimed = false;
+
+	server_lock_take();
+
+	if (dynamic_detail->holder == NULL || dynamic_detail->holder == client) {
+		dynamic_detail->holder = client;
+		claimed = true;
+	}
+
+	server_lock_give();
+
+	return claimed;
 }
 
 static void close_client_connection(struct http_client_ctx *client)
@@ -426,6 +493,18 @@ static void init_client_ctx(struct http_client_ctx *client, const struct http_se
 	client->preface_sent = false;
 	client->window_size = HTTP_SERVER_INITIAL_WINDOW_SIZE;
 
+#if CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE > 0
+	/* The client may use the default decoding table size until it
+	 * acknowledges the size in our settings.
+	 */
+	http_hpack_table_init(&client->hpack_decoder, client->hpack_decoder_data,
+			      sizeof(client->hpack_decoder_data),
+			      HTTP_HPACK_DEFAULT_TABLE_SIZE);
+	http_hpack_table_init(&client->hpack_encoder, client->hpack_encoder_data,
+			      sizeof(client->hpack_encoder_data),
+			      CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE);
+#endif
+
 	memset(client->buffer, 0, sizeof(client->buffer));
 	memset(client->url_buffer, 0, sizeof(client->url_buffer));
 	k_work_init_delayable(&client->inactivity_timer, client_timeout);
@@ -544,6 +623,85 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
+static void handle_client_data(struct http_client_ctx *client)
+{
+	int ret;
+
+	ret = zsock_recv(client->fd, client->buffer + client->data_len,
+			 sizeof(client->buffer) - client->data_len, 0);
+	if (ret <= 0) {
+		if (ret == 0) {
+			LOG_DBG("Connection closed by peer for client #%d",
+				(int)ARRAY_INDEX(server_ctx.clients, client));
+		} else {
+			ret = -errno;
+			LOG_DBG("ERROR reading from socket (%d)", ret);
+		}
+
+		close_client_connection(client);
+		return;
+	}
+
+	client->data_len += ret;
+
+	http_client_timer_restart(client);
+
+	ret = handle_http_request(client);
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
+		}
+		close_client_connection(client);
+	} else if (client->data_len == sizeof(client->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		close_client_connection(client);
+	}
+}
+
+/* Wait for socket events, returns with the server lock taken. */
+static int server_poll(struct http_server_ctx *ctx)
+{
+#if HTTP_SERVER_USE_WORKERS
+	int ret;
+
+	/* The workers and the inactivity timers update the poll array under
+	 * the server lock, which is not held while polling. Poll a copy of it
+	 * instead, and report the events of the sockets which were not
+	 * replaced meanwhile.
+	 */
+	server_lock_take();
+
+	memcpy(ctx->poll_fds, ctx->fds, sizeof(ctx->poll_fds));
+
+	for (int i = 0; i < ARRAY_SIZE(ctx->busy); i++) {
+		if (ctx->busy[i]) {
+			ctx->poll_fds[ctx->listen_fds + i].fd = INVALID_SOCK;
+		}
+	}
+
+	server_lock_give();
+
+	ret = zsock_poll(ctx->poll_fds, HTTP_SERVER_SOCK_COUNT, -1);
+
+	server_lock_take();
+
+	for (int i = 0; i < ARRAY_SIZE(ctx->fds); i++) {
+		ctx->fds[i].revents = (ctx->fds[i].fd == ctx->poll_fds[i].fd) ?
+				      ctx->poll_fds[i].revents : 0;
+	}
+
+	return ret;
+#else
+	return zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
+#endif
+}
+
 static int http_server_run(struct http_server_ctx *ctx)
 {
 	struct http_client_ctx *client;
@@ -558,7 +716,7 @@ static int http_server_run(struct http_server_ctx *ctx)
 	value = 0;
 
 	while (1) {
-		ret = zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
+		ret = server_poll(ctx);
 		if (ret < 0) {
 			ret = -errno;
 			LOG_DBG("poll failed (%d)", ret);
@@ -567,21 +725,43 @@ static int http_server_run(struct http_server_ctx *ctx)
 
 		if (ret == 0) {
 			/* should not happen because timeout is -1 */
+			server_lock_give();
 			break;
 		}
 
+#if HTTP_SERVER_USE_WORKERS
+		/* The workers use the eventfd to have the sockets they are
+		 * done with polled again.
+		 */
+		if (ctx->fds[0].revents) {
+			eventfd_read(ctx->fds[0].fd, &value);
+
+			if (!server_running) {
+				LOG_DBG("Received stop event. exiting ..");
+				ret = 0;
+				goto closing;
+			}
+		}
+#else
 		if (ret == 1 && ctx->fds[0].revents) {
 			eventfd_read(ctx->fds[0].fd, &value);
 			LOG_DBG("Received stop event. exiting ..");
 			ret = 0;
 			goto closing;
 		}
+#endif
 
 		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
 			if (ctx->fds[i].fd < 0) {
 				continue;
 			}
 
+#if HTTP_SERVER_USE_WORKERS
+			if (i >= ctx->listen_fds && ctx->busy[i - ctx->listen_fds]) {
+				continue;
+			}
+#endif
+
 			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
 				if (i >= ctx->listen_fds) {
 					LOG_DBG("Client #%d has disconnected",
@@ -665,52 +845,100 @@ static int http_server_run(struct http_server_ctx *ctx)
 			/* Client sock */
 			client = &ctx->clients[i - ctx->listen_fds];
 
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
+#if HTTP_SERVER_USE_WORKERS
+			/* Stop polling the socket while a worker owns it */
+			ctx->fds[i].events = 0;
+			ctx->busy[i - ctx->listen_fds] = true;
+			ctx->busy_count++;
 
-				close_client_connection(client);
-				continue;
-			}
+			(void)k_msgq_put(&http_server_work_q, &client, K_NO_WAIT);
+#else
+			handle_client_data(client);
+#endif
+		}
 
-			client->data_len += ret;
+		server_lock_give();
+	}
 
-			http_client_timer_restart(client);
+	return 0;
 
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
-				close_client_connection(client);
-			}
+closing:
+#if HTTP_SERVER_USE_WORKERS
+	/* Unblock the workers still sending to their clients and wait for
+	 * them to finish before the sockets are closed.
+	 */
+	for (i = 0; i < ARRAY_SIZE(ctx->busy); i++) {
+		if (ctx->busy[i]) {
+			(void)zsock_shutdown(ctx->clients[i].fd, ZSOCK_SHUT_RDWR);
 		}
 	}
 
-	return 0;
+	while (ctx->busy_count > 0) {
+		(void)k_condvar_wait(&server_idle, &server_lock, K_FOREVER);
+	}
+#endif
 
-closing:
 	/* Close all client connections and the server socket */
 	close_all_sockets(ctx);
+
+	server_lock_give();
+
 	return ret;
 }
 
+#if HTTP_SERVER_USE_WORKERS
+static void http_server_worker(void *p1, void *p2, void *p3)
+{
+	struct http_client_ctx *client;
+	int idx;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&http_server_work_q, &client, K_FOREVER);
+
+		idx = ARRAY_INDEX(server_ctx.clients, client);
+
+		/* Sending a response blocks only this worker while the peer
+		 * is not reading, the other clients are served meanwhile.
+		 */
+		handle_client_data(client);
+
+		server_lock_take();
+
+		/* Poll the socket again, unless the connection was closed */
+		if (client->fd != INVALID_SOCK) {
+			server_ctx.fds[server_ctx.listen_fds + idx].events = ZSOCK_POLLIN;
+		}
+
+		server_ctx.busy[idx] = false;
+		server_ctx.busy_count--;
+
+		/* Make the server thread poll with the updated socket list */
+		eventfd_write(server_ctx.fds[0].fd, 1);
+
+		if (server_ctx.busy_count == 0) {
+			k_condvar_broadcast(&server_idle);
+		}
+
+		server_lock_give();
+	}
+}
+
+static void http_server_workers_start(void)
+{
+	for (int i = 0; i < CONFIG_HTTP_SERVER_WORKERS; i++) {
+		k_thread_create(&workers[i], worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				http_server_worker, NULL, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&workers[i], "http_server_worker");
+	}
+}
+#endif /* HTTP_SERVER_USE_WORKERS */
+
 /* Compare a path and a resource string. The path string comes from the HTTP request and may be
  * terminated by either '?' or '\0'. The resource string is registered along with the resource and
  * may only be terminated by `\0`.
@@ -760,9 +988,292 @@ static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
 	return false;
 }
 
+#if defined(CONFIG_HTTP_SERVER_ROUTE_TRIE)
+#define ROUTE_NONE 0U
+
+enum route_state {
+	ROUTE_NOT_BUILT = 0,
+	ROUTE_READY = 1,
+	ROUTE_FAILED = -1,
+};
+
+/* Node of the routing radix trie. The label points to the resource string,
+ * so no strings are copied. Node and resource numbers are 1-based, leaving
+ * 0 (ROUTE_NONE) for "none" in the zero initialized service runtime data.
+ */
+struct route_node {
+	const char *label;
+	uint16_t label_len;
+	uint16_t child;
+	uint16_t next;
+	/* First resource ending at this node, for regular (0) and
+	 * Websocket (1) resources.
+	 */
+	uint16_t res[2];
+};
+
+static struct route_node route_nodes[CONFIG_HTTP_SERVER_ROUTE_TRIE_NODES];
+static uint16_t route_nodes_used;
+static K_MUTEX_DEFINE(route_lock);
+
+static inline struct route_node *route_node_get(uint16_t idx)
+{
+	return &route_nodes[idx - 1];
+}
+
+static uint16_t route_node_alloc(const char *label, size_t len)
+{
+	struct route_node *node;
+
+	if (route_nodes_used >= ARRAY_SIZE(route_nodes)) {
+		return ROUTE_NONE;
+	}
+
+	node = &route_nodes[route_nodes_used++];
+	memset(node, 0, sizeof(*node));
+	node->label = label;
+	node->label_len = len;
+
+	return route_nodes_used;
+}
+
+static inline int route_kind(const struct http_resource_desc *resource)
+{
+	const struct http_resource_detail *detail = resource->detail;
+
+	return detail->type == HTTP_RESOURCE_TYPE_WEBSOCKET ? 1 : 0;
+}
+
+static int route_insert(uint16_t root, const char *str, int kind, uint16_t res)
+{
+	uint16_t node = root;
+
+	while (*str != '\0') {
+		uint16_t *link = &route_node_get(node)->child;
+		struct route_node *child;
+		size_t len = 0;
+
+		while (*link != ROUTE_NONE && route_node_get(*link)->label[0] != *str) {
+			link = &route_node_get(*link)->next;
+		}
+
+		if (*link == ROUTE_NONE) {
+			*link = route_node_alloc(str, strlen(str));
+			if (*link == ROUTE_NONE) {
+				return -ENOMEM;
+			}
+
+			node = *link;
+			break;
+		}
+
+		child = route_node_get(*link);
+
+		while (len < child->label_len && child->label[len] == str[len]) {
+			len++;
+		}
+
+		if (len < child->label_len) {
+			/* Split the edge where the strings differ */
+			uint16_t mid = route_node_alloc(child->label, len);
+
+			if (mid == ROUTE_NONE) {
+				return -ENOMEM;
+			}
+
+			route_node_get(mid)->child = *link;
+			route_node_get(mid)->next = child->next;
+			child->next = ROUTE_NONE;
+			child->label += len;
+			child->label_len -= len;
+			*link = mid;
+		}
+
+		node = *link;
+		str += len;
+	}
+
+	if (route_node_get(node)->res[kind] == ROUTE_NONE) {
+		route_node_get(node)->res[kind] = res;
+	}
+
+	return 0;
+}
+
+/* Exact resource strings go to the trie, wildcard resources to a list kept
+ * in definition order.
+ */
+static int route_build(const struct http_service_desc *service)
+{
+	struct http_service_runtime_data *data = service->data;
+	uint16_t *wildcard = &data->route_wildcards;
+	uint16_t root;
+	int ret;
+
+	if (service->res_end - service->res_begin >= UINT16_MAX) {
+		return -E2BIG;
+	}
+
+	root = route_node_alloc("", 0);
+	if (root == ROUTE_NONE) {
+		return -ENOMEM;
+	}
+
+	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+		uint16_t res = resource - service->res_begin + 1;
+		size_t len = strlen(resource->resource);
+
+		if (len > UINT16_MAX) {
+			return -E2BIG;
+		}
+
+		if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) &&
+		    strpbrk(resource->resource, "*?[\\") != NULL) {
+			*wildcard = route_node_alloc(resource->resource, len);
+			if (*wildcard == ROUTE_NONE) {
+				return -ENOMEM;
+			}
+
+			route_node_get(*wildcard)->res[route_kind(resource)] = res;
+			wildcard = &route_node_get(*wildcard)->next;
+			continue;
+		}
+
+		ret = route_insert(root, resource->resource, route_kind(resource), res);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	data->route_root = root;
+
+	return 0;
+}
+
+static bool route_ready(const struct http_service_desc *service)
+{
+	struct http_service_runtime_data *data = service->data;
+
+	if (data->route_state == ROUTE_NOT_BUILT) {
+		k_mutex_lock(&route_lock, K_FOREVER);
+
+		if (data->route_state == ROUTE_NOT_BUILT) {
+			uint16_t used = route_nodes_used;
+			int ret;
+
+			ret = route_build(service);
+			if (ret < 0) {
+				NET_WARN("Cannot build routing trie (%d), using linear lookup", ret);
+
+				route_nodes_used = used;
+				data->route_root = ROUTE_NONE;
+				data->route_wildcards = ROUTE_NONE;
+				data->route_state = ROUTE_FAILED;
+			} else {
+				data->route_state = ROUTE_READY;
+			}
+		}
+
+		k_mutex_unlock(&route_lock);
+	}
+
+	return data->route_state == ROUTE_READY;
+}
+
+/* Return the first resource, in definition order, that the linear lookup
+ * would match. Exact resources also match a path continuing with '/' when
+ * wildcards are enabled, as fnmatch() with FNM_LEADING_DIR does.
+ */
+static struct http_resource_desc *route_lookup(const struct http_service_desc *service,
+					       const char *path, bool is_websocket)
+{
+	struct http_service_runtime_data *data = service->data;
+	int kind = is_websocket ? 1 : 0;
+	uint16_t best = UINT16_MAX;
+	const char *pos = path;
+	struct route_node *node;
+	uint16_t idx;
+
+	node = route_node_get(data->route_root);
+
+	while (true) {
+		if (node->res[kind] != ROUTE_NONE && node->res[kind] < best &&
+		    (*pos == '\0' || *pos == '?' ||
+		     (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) && *pos == '/'))) {
+			best = node->res[kind];
+		}
+
+		if (*pos == '\0' || *pos == '?') {
+			break;
+		}
+
+		for (idx = node->child; idx != ROUTE_NONE; idx = route_node_get(idx)->next) {
+			if (route_node_get(idx)->label[0] == *pos) {
+				break;
+			}
+		}
+
+		if (idx == ROUTE_NONE) {
+			break;
+		}
+
+		node = route_node_get(idx);
+
+		for (size_t i = 0; i < node->label_len; i++, pos++) {
+			if (*pos != node->label[i] || *pos == '?') {
+				goto wildcards;
+			}
+		}
+	}
+
+wildcards:
+	for (idx = data->route_wildcards;
+	     IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) && idx != ROUTE_NONE;
+	     idx = node->next) {
+		node = route_node_get(idx);
+
+		if (node->res[kind] == ROUTE_NONE) {
+			continue;
+		}
+
+		if (node->res[kind] > best) {
+			break;
+		}
+
+		if (fnmatch(node->label, path, (FNM_PATHNAME | FNM_LEADING_DIR)) == 0 ||
+		    compare_strings(path, node->label) == 0) {
+			best = node->res[kind];
+			break;
+		}
+	}
+
+	if (best == UINT16_MAX) {
+		return NULL;
+	}
+
+	return &service->res_begin[best - 1];
+}
+#endif /* CONFIG_HTTP_SERVER_ROUTE_TRIE */
+
 struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
 						 const char *path, int *path_len, bool is_websocket)
 {
+#if defined(CONFIG_HTTP_SERVER_ROUTE_TRIE)
+	if (route_ready(service)) {
+		struct http_resource_desc *resource;
+
+		resource = route_lookup(service, path, is_websocket);
+		if (resource != NULL) {
+			NET_DBG("Got match for %s", resource->resource);
+
+			*path_len = path_len_without_query(path);
+			return resource->detail;
+		}
+
+		goto fallback;
+	}
+#endif
+
 	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
 		if (skip_this(resource, is_websocket)) {
 			continue;
@@ -786,6 +1297,9 @@ struct http_resource_detail *get_resource_detail(const struct http_service_desc
 		}
 	}
 
+#if defined(CONFIG_HTTP_SERVER_ROUTE_TRIE)
+fallback:
+#endif
 	if (service->res_fallback != NULL) {
 		*path_len = path_len_without_query(path);
 		return service->res_fallback;
@@ -896,6 +1410,36 @@ int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t
 	return 0;
 }
 
+#if defined(CONFIG_FILE_SYSTEM)
+/* Send the file in slices so that the inactivity timer can be restarted
+ * while a large file is being transferred.
+ */
+#define SENDFILE_SLICE_SIZE 2048
+
+int http_server_sendfile(struct http_client_ctx *client, struct fs_file_t *file, size_t len)
+{
+	while (len) {
+		ssize_t out_len = zsock_sendfile(client->fd, file, NULL,
+						 MIN(len, SENDFILE_SLICE_SIZE));
+
+		if (out_len < 0) {
+			return -errno;
+		}
+
+		if (out_len == 0) {
+			/* File is shorter than announced */
+			return -EIO;
+		}
+
+		len -= out_len;
+
+		http_client_timer_restart(client);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_FILE_SYSTEM */
+
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status)
 {
 	if (status != HTTP_SERVER_DATA_FINAL) {
@@ -975,6 +1519,10 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+#if HTTP_SERVER_USE_WORKERS
+	http_server_workers_start();
+#endif
+
 	while (true) {
 		k_sem_take(&server_start, K_FOREVER);
 
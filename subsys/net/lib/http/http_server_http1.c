@@ -490,7 +490,6 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 
 	enum http_compression chosen_compression = 0;
 	int len;
-	int remaining;
 	int ret;
 	size_t file_size;
 	struct fs_file_t file;
@@ -553,21 +552,13 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 
 	client->http1_headers_sent = true;
 
-	/* read and send file */
-	remaining = file_size;
-	while (remaining > 0) {
-		len = fs_read(&file, http_response, sizeof(http_response));
-		if (len < 0) {
-			LOG_ERR("Filesystem read error (%d)", len);
-			goto close;
-		}
-
-		ret = http_server_sendall(client, http_response, len);
-		if (ret < 0) {
-			goto close;
-		}
-		remaining -= len;
+	/* send file, the data is read directly into the socket send buffers */
+	ret = http_server_sendfile(client, &file, file_size);
+	if (ret < 0) {
+		LOG_ERR("Cannot send file %s (%d)", fname, ret);
+		goto close;
 	}
+
 	ret = http_server_sendall(client, "\r\n\r\n", 4);
 
 close:
@@ -595,7 +586,7 @@ static int handle_http1_dynamic_resource(
 		return send_http1_405(client);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_dynamic_claim(dynamic_detail, client)) {
 		ret = send_http1_409(client);
 		if (ret < 0) {
 			return ret;
@@ -604,8 +595,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
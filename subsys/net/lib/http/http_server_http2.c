@@ -107,6 +107,14 @@ static void release_http_stream_context(struct http_client_ctx *client,
 	}
 }
 
+#if CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE > 0
+#define HPACK_DECODER(client) (&(client)->hpack_decoder)
+#define HPACK_ENCODER(client) (&(client)->hpack_encoder)
+#else
+#define HPACK_DECODER(client) NULL
+#define HPACK_ENCODER(client) NULL
+#endif
+
 static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 			    size_t *buflen, const char *name, const char *value)
 {
@@ -117,7 +125,8 @@ static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 	client->header_field.value = value;
 	client->header_field.value_len = strlen(value);
 
-	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field);
+	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field,
+				       HPACK_ENCODER(client));
 	if (ret < 0) {
 		LOG_DBG("Failed to encode header, err %d", ret);
 		return ret;
@@ -262,7 +271,8 @@ int send_settings_frame(struct http_client_ctx *client, bool ack)
 			(settings_frame + HTTP2_FRAME_HEADER_SIZE);
 		UNALIGNED_PUT(htons(HTTP2_SETTINGS_HEADER_TABLE_SIZE),
 			      &setting->id);
-		UNALIGNED_PUT(0, &setting->value);
+		UNALIGNED_PUT(htonl(CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE),
+			      &setting->value);
 
 		setting++;
 		UNALIGNED_PUT(htons(HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS),
@@ -451,6 +461,11 @@ out:
 }
 
 #if defined(CONFIG_FILE_SYSTEM)
+/* Payload size of the DATA frames used for static filesystem resources,
+ * smaller than the minimum SETTINGS_MAX_FRAME_SIZE a peer can announce.
+ */
+#define STATIC_FS_DATA_FRAME_SIZE 2048
+
 static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs *static_fs_detail,
 					   struct http2_frame *frame,
 					   struct http_client_ctx *client)
@@ -467,9 +482,8 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		.type = static_fs_detail->common.type,
 	};
 	enum http_compression chosen_compression = 0;
-	int len;
-	int remaining;
-	char tmp[64];
+	size_t remaining;
+	size_t len;
 
 	if (client->method != HTTP_GET) {
 		return send_http2_405(client, frame);
@@ -528,23 +542,26 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		goto out;
 	}
 
-	/* read and send file */
+	/* send file, the frame payload is read directly into the socket
+	 * send buffers
+	 */
 	remaining = client->data_len;
-	while (remaining > 0) {
-		len = fs_read(&file, tmp, sizeof(tmp));
-		if (len < 0) {
-			LOG_ERR("Filesystem read error (%d)", len);
+	do {
+		len = MIN(remaining, STATIC_FS_DATA_FRAME_SIZE);
+		remaining -= len;
+
+		ret = send_data_frame(client, NULL, len, frame->stream_identifier,
+				      (remaining > 0) ? 0 : HTTP2_FLAG_END_STREAM);
+		if (ret < 0) {
 			goto out;
 		}
 
-		remaining -= len;
-		ret = send_data_frame(client, tmp, len, frame->stream_identifier,
-				      (remaining > 0) ? 0 : HTTP2_FLAG_END_STREAM);
+		ret = http_server_sendfile(client, &file, len);
 		if (ret < 0) {
-			LOG_DBG("Cannot write to socket (%d)", ret);
+			LOG_ERR("Cannot send file %s (%d)", fname, ret);
 			goto out;
 		}
-	}
+	} while (remaining > 0);
 
 	client->current_stream->end_stream_sent = true;
 
@@ -782,7 +799,7 @@ static int handle_http2_dynamic_resource(
 		return send_http2_405(client, frame);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_dynamic_claim(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -791,8 +808,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 	case HTTP_DELETE:
@@ -1561,7 +1576,8 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		struct http_hpack_header_buf *header = &client->header_field;
 		size_t datalen = MIN(client->data_len, frame->length);
 
-		ret = http_hpack_decode_header(client->cursor, datalen, header);
+		ret = http_hpack_decode_header(client->cursor, datalen, header,
+					       HPACK_DECODER(client));
 		if (ret <= 0) {
 			if (ret == -EAGAIN) {
 				ret = handle_incomplete_http_header(client);
@@ -1586,6 +1602,11 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		client->cursor += ret;
 		client->data_len -= ret;
 
+		if (header->name_len == 0) {
+			/* Dynamic table size update */
+			continue;
+		}
+
 		LOG_DBG("Parsed header: %.*s %.*s", (int)header->name_len,
 			header->name, (int)header->value_len, header->value);
 
@@ -1736,6 +1757,26 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+#if CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE > 0
+	if (!is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
+		struct http2_settings_field *setting =
+			(struct http2_settings_field *)client->cursor;
+
+		for (int i = 0; i < frame->length / sizeof(*setting); i++, setting++) {
+			if (ntohs(UNALIGNED_GET(&setting->id)) ==
+			    HTTP2_SETTINGS_HEADER_TABLE_SIZE) {
+				/* Limit of the table used to encode responses */
+				http_hpack_table_resize(HPACK_ENCODER(client),
+							ntohl(UNALIGNED_GET(&setting->value)));
+			}
+		}
+	} else {
+		/* The client now uses the table size from our settings */
+		http_hpack_table_set_limit(HPACK_DECODER(client),
+					   CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE);
+	}
+#endif
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
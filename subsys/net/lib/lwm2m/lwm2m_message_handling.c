@@ -1707,7 +1707,7 @@ static int do_composite_read_op(struct lwm2m_message *msg, uint16_t content_form
 
 static int lwm2m_perform_read_object_instance(struct lwm2m_message *msg,
 					      struct lwm2m_engine_obj_inst *obj_inst,
-					      uint8_t *num_read)
+					      uint16_t *num_read)
 {
 	struct lwm2m_engine_res *res = NULL;
 	struct lwm2m_engine_obj_field *obj_field;
@@ -1798,7 +1798,7 @@ int lwm2m_perform_read_op(struct lwm2m_message *msg, uint16_t content_format)
 	struct lwm2m_engine_obj_inst *obj_inst = NULL;
 	struct lwm2m_obj_path temp_path;
 	int ret = 0;
-	uint8_t num_read = 0U;
+	uint16_t num_read = 0U;
 
 	if (msg->path.level >= LWM2M_PATH_LEVEL_OBJECT_INST) {
 		obj_inst = get_engine_obj_inst(msg->path.obj_id, msg->path.obj_inst_id);
@@ -3215,7 +3215,7 @@ cleanup:
 	return ret;
 }
 
-static int lwm2m_perform_composite_read_root(struct lwm2m_message *msg, uint8_t *num_read)
+static int lwm2m_perform_composite_read_root(struct lwm2m_message *msg, uint16_t *num_read)
 {
 	int ret;
 	struct lwm2m_engine_obj *obj;
@@ -3251,7 +3251,7 @@ int lwm2m_perform_composite_read_op(struct lwm2m_message *msg, uint16_t content_
 	struct lwm2m_engine_obj_inst *obj_inst = NULL;
 	struct lwm2m_obj_path_list *entry;
 	int ret = 0;
-	uint8_t num_read = 0U;
+	uint16_t num_read = 0U;
 
 	/* set output content-format */
 	ret = coap_append_option_int(msg->out.out_cpkt, COAP_OPTION_CONTENT_FORMAT, content_format);
@@ -3267,7 +3267,9 @@ int lwm2m_perform_composite_read_op(struct lwm2m_message *msg, uint16_t content_
 	}
 
 	/* Add object start mark */
-	engine_put_begin(&msg->out, &msg->path);
+	if (engine_put_begin(&msg->out, &msg->path) < 0) {
+		return -ENOMEM;
+	}
 
 	/* Read resource from path */
 	SYS_SLIST_FOR_EACH_CONTAINER(lwm2m_path_list, entry, node) {
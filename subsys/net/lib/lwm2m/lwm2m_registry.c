@@ -94,6 +94,116 @@ sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
 
 sys_slist_t *lwm2m_engine_obj_inst_list(void) { return &engine_obj_inst_list; }
 
+#if defined(CONFIG_LWM2M_REGISTRY_INDEX)
+/* Registry index, entries sorted by key. The lists above remain the
+ * reference, the index is dropped if it runs out of entries.
+ */
+struct registry_index_entry {
+	uint32_t key;
+	void *ptr;
+};
+
+struct registry_index {
+	struct registry_index_entry *entries;
+	uint16_t count;
+	uint16_t size;
+	bool valid;
+};
+
+static struct registry_index_entry obj_index_entries[CONFIG_LWM2M_REGISTRY_INDEX_OBJECTS];
+static struct registry_index_entry
+	obj_inst_index_entries[CONFIG_LWM2M_REGISTRY_INDEX_OBJECT_INSTANCES];
+
+static struct registry_index obj_index = {
+	.entries = obj_index_entries,
+	.size = ARRAY_SIZE(obj_index_entries),
+	.valid = true,
+};
+
+static struct registry_index obj_inst_index = {
+	.entries = obj_inst_index_entries,
+	.size = ARRAY_SIZE(obj_inst_index_entries),
+	.valid = true,
+};
+
+#define REGISTRY_INDEX_KEY(obj_id, obj_inst_id) (((uint32_t)(obj_id) << 16) | (obj_inst_id))
+
+/* Position of the first entry with a key equal or higher than key */
+static uint16_t registry_index_find(const struct registry_index *index, uint32_t key)
+{
+	uint16_t low = 0U;
+	uint16_t high = index->count;
+
+	while (low < high) {
+		uint16_t mid = low + (high - low) / 2U;
+
+		if (index->entries[mid].key < key) {
+			low = mid + 1U;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+static void *registry_index_get(const struct registry_index *index, uint32_t key)
+{
+	uint16_t pos = registry_index_find(index, key);
+
+	if (pos < index->count && index->entries[pos].key == key) {
+		return index->entries[pos].ptr;
+	}
+
+	return NULL;
+}
+
+static void registry_index_add(struct registry_index *index, uint32_t key, void *ptr)
+{
+	uint16_t pos;
+
+	if (!index->valid) {
+		return;
+	}
+
+	if (index->count >= index->size) {
+		LOG_WRN("Registry index full, falling back to list lookups");
+		index->valid = false;
+		return;
+	}
+
+	/* Keep registration order for equal keys, like the lists */
+	for (pos = registry_index_find(index, key);
+	     pos < index->count && index->entries[pos].key == key; pos++) {
+	}
+
+	memmove(&index->entries[pos + 1U], &index->entries[pos],
+		(index->count - pos) * sizeof(index->entries[0]));
+	index->entries[pos].key = key;
+	index->entries[pos].ptr = ptr;
+	index->count++;
+}
+
+static void registry_index_remove(struct registry_index *index, uint32_t key, void *ptr)
+{
+	uint16_t pos;
+
+	if (!index->valid) {
+		return;
+	}
+
+	for (pos = registry_index_find(index, key);
+	     pos < index->count && index->entries[pos].key == key; pos++) {
+		if (index->entries[pos].ptr == ptr) {
+			memmove(&index->entries[pos], &index->entries[pos + 1U],
+				(index->count - pos - 1U) * sizeof(index->entries[0]));
+			index->count--;
+			return;
+		}
+	}
+}
+#endif /* CONFIG_LWM2M_REGISTRY_INDEX */
+
 #if defined(CONFIG_LWM2M_RESOURCE_DATA_CACHE_SUPPORT)
 static void lwm2m_engine_cache_write(const struct lwm2m_engine_obj_field *obj_field,
 				     const struct lwm2m_obj_path *path, const void *value,
@@ -113,6 +223,9 @@ void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_list, &obj->node);
+#if defined(CONFIG_LWM2M_REGISTRY_INDEX)
+	registry_index_add(&obj_index, REGISTRY_INDEX_KEY(obj->obj_id, 0), obj);
+#endif
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -124,6 +237,9 @@ void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj)
 #endif
 	engine_remove_observer_by_id(obj->obj_id, -1);
 	sys_slist_find_and_remove(&engine_obj_list, &obj->node);
+#if defined(CONFIG_LWM2M_REGISTRY_INDEX)
+	registry_index_remove(&obj_index, REGISTRY_INDEX_KEY(obj->obj_id, 0), obj);
+#endif
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -131,6 +247,16 @@ struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 {
 	struct lwm2m_engine_obj *obj;
 
+#if defined(CONFIG_LWM2M_REGISTRY_INDEX)
+	if (obj_index.valid) {
+		if (obj_id < 0 || obj_id > UINT16_MAX) {
+			return NULL;
+		}
+
+		return registry_index_get(&obj_index, REGISTRY_INDEX_KEY(obj_id, 0));
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_list, obj, node) {
 		if (obj->obj_id == obj_id) {
 			return obj;
@@ -176,6 +302,11 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_REGISTRY_INDEX)
+	registry_index_add(&obj_inst_index,
+			   REGISTRY_INDEX_KEY(obj_inst->obj->obj_id, obj_inst->obj_inst_id),
+			   obj_inst);
+#endif
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -185,12 +316,29 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_REGISTRY_INDEX)
+	registry_index_remove(&obj_inst_index,
+			      REGISTRY_INDEX_KEY(obj_inst->obj->obj_id, obj_inst->obj_inst_id),
+			      obj_inst);
+#endif
 }
 
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
+#if defined(CONFIG_LWM2M_REGISTRY_INDEX)
+	if (obj_inst_index.valid) {
+		if (obj_id < 0 || obj_id > UINT16_MAX || obj_inst_id < 0 ||
+		    obj_inst_id > UINT16_MAX) {
+			return NULL;
+		}
+
+		return registry_index_get(&obj_inst_index,
+					  REGISTRY_INDEX_KEY(obj_id, obj_inst_id));
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
@@ -204,6 +352,26 @@ struct lwm2m_engine_obj_inst *next_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst, *next = NULL;
 
+#if defined(CONFIG_LWM2M_REGISTRY_INDEX)
+	if (obj_inst_index.valid) {
+		uint16_t pos;
+
+		if (obj_id < 0 || obj_id > UINT16_MAX || obj_inst_id >= UINT16_MAX) {
+			return NULL;
+		}
+
+		/* Instances of an object are sorted by instance ID */
+		pos = registry_index_find(&obj_inst_index,
+					  REGISTRY_INDEX_KEY(obj_id, MAX(obj_inst_id + 1, 0)));
+		if (pos < obj_inst_index.count &&
+		    (obj_inst_index.entries[pos].key >> 16) == obj_id) {
+			return obj_inst_index.entries[pos].ptr;
+		}
+
+		return NULL;
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id > obj_inst_id &&
 		    (!next || next->obj_inst_id > obj_inst->obj_inst_id)) {
@@ -395,10 +563,15 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
+	/* Resources are usually initialized in the order of the object fields */
+	i = of - oi->obj->fields;
+	if (i < oi->resource_count && oi->resources[i].res_id == path->res_id) {
+		r = &oi->resources[i];
+	}
+
+	for (i = 0; !r && i < oi->resource_count; i++) {
 		if (oi->resources[i].res_id == path->res_id) {
 			r = &oi->resources[i];
-			break;
 		}
 	}
 
@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <inttypes.h>
 #include <ctype.h>
 #include <time.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/kernel.h>
 
@@ -35,6 +36,9 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #define SENML_MAX_NAME_SIZE sizeof("/65535/65535/")
 
+/* Largest definite length array header the records may need, 99 xx xx # array(65535) */
+#define SENML_ARRAY_HDR_MAX_SIZE 3
+
 struct cbor_out_fmt_data {
 	/* Data */
 	struct lwm2m_senml input;
@@ -55,6 +59,12 @@ struct cbor_out_fmt_data {
 		size_t objlnk_sz; /* Object link buff size */
 		uint8_t objlnk_cnt;
 	};
+
+	/* Records are encoded as soon as they are complete */
+	struct {
+		uint16_t array_offset; /* Payload offset of the array header */
+		uint16_t array_cnt; /* Records encoded so far */
+	};
 };
 
 struct cbor_in_fmt_data {
@@ -175,39 +185,86 @@ static int put_basename(struct lwm2m_output_context *out, struct lwm2m_obj_path
 	return 0;
 }
 
-static int put_empty_array(struct lwm2m_output_context *out)
+static int put_begin(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
-	int len = 1;
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
 
-	memset(CPKT_BUF_W_PTR(out->out_cpkt), 0x80, len); /* 80 # array(0) */
-	out->out_cpkt->offset += len;
+	/* The record count is known only at the end, reserve space for the array header */
+	if (CPKT_BUF_W_SIZE(out->out_cpkt) < SENML_ARRAY_HDR_MAX_SIZE) {
+		return -ENOMEM;
+	}
 
-	return len;
+	fd->array_offset = out->out_cpkt->offset;
+	fd->array_cnt = 0;
+	out->out_cpkt->offset += SENML_ARRAY_HDR_MAX_SIZE;
+
+	return 0;
 }
 
 static int put_end(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
-	size_t len;
-	struct lwm2m_senml *input = &(LWM2M_OFD_CBOR(out)->input);
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	uint8_t *hdr = out->out_cpkt->data + fd->array_offset;
+	size_t len = out->out_cpkt->offset - fd->array_offset - SENML_ARRAY_HDR_MAX_SIZE;
+	size_t hdr_len;
+
+	/* Canonical CBOR requires the shortest header for the record count */
+	if (fd->array_cnt < 24) {
+		hdr[0] = 0x80 | fd->array_cnt; /* 8x # array(x) */
+		hdr_len = 1;
+	} else if (fd->array_cnt <= UINT8_MAX) {
+		hdr[0] = 0x98; /* 98 xx # array(xx) */
+		hdr[1] = fd->array_cnt;
+		hdr_len = 2;
+	} else {
+		hdr[0] = 0x99; /* 99 xx xx # array(xxxx) */
+		sys_put_be16(fd->array_cnt, &hdr[1]);
+		hdr_len = 3;
+	}
 
-	if (!input->lwm2m_senml_record_m_count) {
-		len = put_empty_array(out);
+	memmove(hdr + hdr_len, hdr + SENML_ARRAY_HDR_MAX_SIZE, len);
+	out->out_cpkt->offset -= SENML_ARRAY_HDR_MAX_SIZE - hdr_len;
 
-		return len;
+	return hdr_len + len;
+}
+
+/* Encode the record just consumed right into the payload, so that the number of records a
+ * payload can hold is only bounded by the buffer size.
+ */
+static int put_record(struct lwm2m_output_context *out)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	uint8_t *pos = CPKT_BUF_W_PTR(out->out_cpkt) - 1;
+	uint8_t prev = *pos;
+	uint_fast8_t ret;
+	size_t len;
+
+	if (fd->array_cnt == UINT16_MAX) {
+		return -ENOMEM;
 	}
 
-	uint_fast8_t ret =
-		cbor_encode_lwm2m_senml(CPKT_BUF_W_REGION(out->out_cpkt), input, &len);
+	/* The record is encoded as an array of one, which header lands on the last byte
+	 * written so far and is restored right after. There is always such a byte as the
+	 * space for the final array header is reserved by put_begin().
+	 */
+	ret = cbor_encode_lwm2m_senml(pos, CPKT_BUF_W_SIZE(out->out_cpkt) + 1, &fd->input, &len);
+	*pos = prev;
 
 	if (ret != ZCBOR_SUCCESS) {
-		LOG_ERR("unable to encode senml cbor msg");
-
-		return -E2BIG;
+		LOG_ERR("unable to encode senml cbor record");
+		return -ENOMEM;
 	}
 
-	out->out_cpkt->offset += len;
+	out->out_cpkt->offset += len - 1;
+	fd->array_cnt++;
+
+	/* Names and object links referenced by the record can be reused */
+	memset(&fd->input.lwm2m_senml_record_m[0], 0, sizeof(struct record));
+	fd->input.lwm2m_senml_record_m_count = 0;
+	fd->name_cnt = 0;
+	fd->objlnk_cnt = 0;
 
-	return len;
+	return 0;
 }
 
 static int put_begin_oi(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
@@ -376,7 +433,7 @@ static int put_value(struct lwm2m_output_context *out, struct lwm2m_obj_path *pa
 	record->record_union.union_vi = value;
 	record->record_union_present = 1;
 
-	return 0;
+	return put_record(out);
 }
 
 static int put_s8(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, int8_t value)
@@ -414,7 +471,7 @@ static int put_time(struct lwm2m_output_context *out, struct lwm2m_obj_path *pat
 	record->record_union.union_vi = (int64_t)value;
 	record->record_union_present = 1;
 
-	return 0;
+	return put_record(out);
 }
 
 static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, double *value)
@@ -432,7 +489,7 @@ static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *pa
 	record->record_union.union_vf = *value;
 	record->record_union_present = 1;
 
-	return 0;
+	return put_record(out);
 }
 
 static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
@@ -452,7 +509,7 @@ static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 	record->record_union.union_vs.len = buflen;
 	record->record_union_present = 1;
 
-	return 0;
+	return put_record(out);
 }
 
 static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, bool value)
@@ -470,7 +527,7 @@ static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *pat
 	record->record_union.union_vb = value;
 	record->record_union_present = 1;
 
-	return 0;
+	return put_record(out);
 }
 
 static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
@@ -490,7 +547,7 @@ static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 	record->record_union.union_vd.len = buflen;
 	record->record_union_present = 1;
 
-	return 0;
+	return put_record(out);
 }
 
 static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *path,
@@ -529,7 +586,7 @@ static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 
 	fd->objlnk_cnt++;
 
-	return 0;
+	return put_record(out);
 }
 
 static int get_opaque(struct lwm2m_input_context *in,
@@ -790,6 +847,7 @@ static int do_write_op_item(struct lwm2m_message *msg, struct record *rec)
 }
 
 const struct lwm2m_writer senml_cbor_writer = {
+	.put_begin = put_begin,
 	.put_end = put_end,
 	.put_begin_oi = put_begin_oi,
 	.put_begin_r = put_begin_r,
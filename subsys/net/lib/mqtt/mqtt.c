@@ -25,6 +25,10 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+	mqtt_publish_queue_reset(client);
+#endif
 }
 
 /** @brief Initialize tx buffer. */
@@ -711,6 +715,18 @@ int mqtt_live(struct mqtt_client *client)
 
 	mqtt_mutex_lock(client);
 
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+	if (MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+		err_code = mqtt_publish_queue_flush(client);
+		if (err_code < 0) {
+			mqtt_mutex_unlock(client);
+			return err_code;
+		}
+
+		err_code = 0;
+	}
+#endif
+
 	elapsed_time = mqtt_elapsed_time_in_ms_get(
 				client->internal.last_activity);
 	if ((client->keepalive > 0) &&
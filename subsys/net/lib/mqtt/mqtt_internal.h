@@ -198,6 +198,40 @@ void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
  */
 int mqtt_handle_rx(struct mqtt_client *client);
 
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+/**@brief Sends the queued PUBLISH messages allowed by the inflight window and
+ *        retransmits the unacknowledged ones. Called with the client locked.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ *
+ * @return Number of packets sent or an error code.
+ */
+int mqtt_publish_queue_flush(struct mqtt_client *client);
+
+/**@brief Handles an acknowledgment of a queued PUBLISH message. Replies with
+ *        PUBREL on PUBREC.
+ *
+ * @param[in] client Identifies the client for which the packet was received.
+ * @param[in] type Type of the received packet.
+ * @param[in] message_id Message identifier of the received packet.
+ * @param[in] reason_code MQTT 5.0 reason code of the received packet, zero
+ *                        otherwise.
+ *
+ * @return 1 if PUBREL was sent for the message, so that the PUBREC is not
+ *         reported to the application, 0 if the procedure is successful,
+ *         an error code otherwise.
+ */
+int mqtt_publish_queue_ack(struct mqtt_client *client, uint8_t type,
+			   uint16_t message_id, uint8_t reason_code);
+
+/**@brief Prepares the unacknowledged queued messages for retransmission once
+ *        the connection is lost.
+ *
+ * @param[in] client Identifies the client which lost the connection.
+ */
+void mqtt_publish_queue_reset(struct mqtt_client *client);
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+
 /**@brief Disconnect MQTT client.
  *
  * @param[in] client Identifies the client which disconnects.
@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file mqtt_publish_queue.c
+ *
+ * @brief Outbound PUBLISH queue with an inflight window.
+ *
+ * Queued packets are kept encoded and back to back in the application
+ * provided buffer, in transmission order, so that a flush sends all the
+ * packets allowed by the inflight window with a single transport write.
+ * Once a QoS 2 message is received by the broker, its PUBLISH packet is
+ * replaced by the PUBREL packet, which is retransmitted until PUBCOMP.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_mqtt_queue, CONFIG_MQTT_LOG_LEVEL);
+
+#include <zephyr/net/mqtt.h>
+
+#include "mqtt_transport.h"
+#include "mqtt_internal.h"
+#include "mqtt_os.h"
+
+enum pub_queue_state {
+	/** Not sent yet, or to be sent again after a connection loss. */
+	PUB_QUEUE_QUEUED,
+	/** PUBLISH sent, awaiting PUBACK or PUBREC. */
+	PUB_QUEUE_SENT,
+	/** PUBREL sent, awaiting PUBCOMP. */
+	PUB_QUEUE_RELEASED,
+	/** PUBREL to be sent again after a connection loss. */
+	PUB_QUEUE_RELEASE_QUEUED,
+	/** To be removed from the queue. */
+	PUB_QUEUE_DONE,
+};
+
+static bool retransmit_due(const struct mqtt_client *client,
+			   const struct mqtt_publish_queue_entry *entry)
+{
+	/* MQTT 5.0 forbids resending PUBLISH and PUBREL on a live
+	 * connection [MQTT-4.4.0-1].
+	 */
+	if ((CONFIG_MQTT_PUBLISH_RETRANSMIT_TIMEOUT == 0) ||
+	    mqtt_is_version_5_0(client)) {
+		return false;
+	}
+
+	return mqtt_elapsed_time_in_ms_get(entry->sent_time) >=
+	       CONFIG_MQTT_PUBLISH_RETRANSMIT_TIMEOUT;
+}
+
+static struct mqtt_publish_queue_entry *entry_find(struct mqtt_publish_queue *queue,
+						   uint16_t message_id)
+{
+	for (int i = 0; i < queue->count; i++) {
+		if (queue->entries[i].message_id == message_id) {
+			return &queue->entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static uint16_t message_id_next(struct mqtt_publish_queue *queue)
+{
+	do {
+		queue->last_message_id++;
+		if (queue->last_message_id == 0U) {
+			queue->last_message_id = 1U;
+		}
+	} while (entry_find(queue, queue->last_message_id) != NULL);
+
+	return queue->last_message_id;
+}
+
+/** @brief Remove the completed packets and pack the remaining ones. */
+static void queue_compact(struct mqtt_client *client)
+{
+	struct mqtt_publish_queue *queue = &client->internal.pub_queue;
+	uint32_t offset = 0U;
+	uint8_t count = 0U;
+
+	for (int i = 0; i < queue->count; i++) {
+		struct mqtt_publish_queue_entry *entry = &queue->entries[i];
+
+		if (entry->state == PUB_QUEUE_DONE) {
+			continue;
+		}
+
+		if (entry->offset != offset) {
+			memmove(client->pub_queue_buf + offset,
+				client->pub_queue_buf + entry->offset, entry->len);
+			entry->offset = offset;
+		}
+
+		offset += entry->len;
+		queue->entries[count++] = *entry;
+	}
+
+	queue->count = count;
+	queue->used = offset;
+}
+
+int mqtt_publish_queue_flush(struct mqtt_client *client)
+{
+	struct mqtt_publish_queue *queue = &client->internal.pub_queue;
+	struct iovec io_vector[CONFIG_MQTT_PUBLISH_QUEUE_SIZE];
+	bool selected[CONFIG_MQTT_PUBLISH_QUEUE_SIZE] = { 0 };
+	uint8_t inflight = queue->inflight;
+	struct msghdr msg;
+	int iov_count = 0;
+	int sent = 0;
+	int err_code;
+
+	for (int i = 0; i < queue->count; i++) {
+		struct mqtt_publish_queue_entry *entry = &queue->entries[i];
+		uint8_t *packet = client->pub_queue_buf + entry->offset;
+
+		if (entry->state == PUB_QUEUE_QUEUED) {
+			if (entry->message_id != 0U) {
+				/* Keep the order, later messages wait as well. */
+				if (inflight >= CONFIG_MQTT_PUBLISH_INFLIGHT_MAX) {
+					break;
+				}
+
+				inflight++;
+			}
+		} else if (entry->state == PUB_QUEUE_RELEASE_QUEUED) {
+			/* Already accounted for in the inflight window. */
+		} else if (retransmit_due(client, entry)) {
+			if (entry->state == PUB_QUEUE_SENT) {
+				packet[0] |= MQTT_HEADER_DUP_MASK;
+			}
+		} else {
+			continue;
+		}
+
+		selected[i] = true;
+		sent++;
+
+		/* Packets adjacent in the buffer share an I/O vector. */
+		if ((iov_count > 0) &&
+		    ((uint8_t *)io_vector[iov_count - 1].iov_base +
+		     io_vector[iov_count - 1].iov_len == packet)) {
+			io_vector[iov_count - 1].iov_len += entry->len;
+		} else {
+			io_vector[iov_count].iov_base = packet;
+			io_vector[iov_count].iov_len = entry->len;
+			iov_count++;
+		}
+	}
+
+	if (sent == 0) {
+		return 0;
+	}
+
+	memset(&msg, 0, sizeof(msg));
+
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = iov_count;
+
+	NET_DBG("[%p]: Sending %d queued packets in %d vectors.", client, sent,
+		iov_count);
+
+	err_code = mqtt_transport_write_msg(client, &msg);
+	if (err_code < 0) {
+		NET_ERR("Transport write failed, err_code = %d, "
+			"closing connection", err_code);
+		mqtt_client_disconnect(client, err_code, true);
+		return err_code;
+	}
+
+	client->internal.last_activity = mqtt_sys_tick_in_ms_get();
+
+	for (int i = 0; i < queue->count; i++) {
+		struct mqtt_publish_queue_entry *entry = &queue->entries[i];
+
+		if (!selected[i]) {
+			continue;
+		}
+
+		if (entry->message_id == 0U) {
+			entry->state = PUB_QUEUE_DONE;
+			continue;
+		}
+
+		if (entry->state == PUB_QUEUE_QUEUED) {
+			entry->state = PUB_QUEUE_SENT;
+		} else if (entry->state == PUB_QUEUE_RELEASE_QUEUED) {
+			entry->state = PUB_QUEUE_RELEASED;
+		}
+
+		entry->sent_time = client->internal.last_activity;
+	}
+
+	queue->inflight = inflight;
+	queue_compact(client);
+
+	return sent;
+}
+
+static int pubrel_send(struct mqtt_client *client,
+		       struct mqtt_publish_queue_entry *entry)
+{
+	const struct mqtt_pubrel_param param = {
+		.message_id = entry->message_id,
+	};
+	struct buf_ctx packet;
+	int err_code;
+
+	memset(client->tx_buf, 0, client->tx_buf_size);
+	packet.cur = client->tx_buf;
+	packet.end = client->tx_buf + client->tx_buf_size;
+
+	err_code = publish_release_encode(client, &param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	err_code = mqtt_transport_write(client, packet.cur,
+					packet.end - packet.cur);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	client->internal.last_activity = mqtt_sys_tick_in_ms_get();
+
+	/* PUBREL is never longer than the PUBLISH packet it replaces. */
+	__ASSERT_NO_MSG(packet.end - packet.cur <= entry->len);
+
+	memcpy(client->pub_queue_buf + entry->offset, packet.cur,
+	       packet.end - packet.cur);
+	entry->len = packet.end - packet.cur;
+	entry->state = PUB_QUEUE_RELEASED;
+	entry->sent_time = client->internal.last_activity;
+
+	return 0;
+}
+
+int mqtt_publish_queue_ack(struct mqtt_client *client, uint8_t type,
+			   uint16_t message_id, uint8_t reason_code)
+{
+	struct mqtt_publish_queue *queue = &client->internal.pub_queue;
+	struct mqtt_publish_queue_entry *entry;
+	int err_code = 0;
+
+	entry = entry_find(queue, message_id);
+	if (entry == NULL) {
+		/* Not a queued message. */
+		return 0;
+	}
+
+	switch (type) {
+	case MQTT_PKT_TYPE_PUBACK:
+		if (entry->state != PUB_QUEUE_SENT) {
+			return 0;
+		}
+
+		entry->state = PUB_QUEUE_DONE;
+		break;
+
+	case MQTT_PKT_TYPE_PUBREC:
+		if ((entry->state != PUB_QUEUE_SENT) &&
+		    (entry->state != PUB_QUEUE_RELEASED)) {
+			return 0;
+		}
+
+		/* MQTT 5.0 PUBREC with an error reason code ends the flow. */
+		if (reason_code >= 0x80) {
+			entry->state = PUB_QUEUE_DONE;
+			break;
+		}
+
+		err_code = pubrel_send(client, entry);
+		if (err_code == 0) {
+			/* Released, the application must not release it. */
+			return 1;
+		}
+
+		break;
+
+	case MQTT_PKT_TYPE_PUBCOMP:
+		if (entry->state != PUB_QUEUE_RELEASED) {
+			return 0;
+		}
+
+		entry->state = PUB_QUEUE_DONE;
+		break;
+
+	default:
+		return 0;
+	}
+
+	if (entry->state == PUB_QUEUE_DONE) {
+		queue->inflight--;
+		queue_compact(client);
+	}
+
+	return err_code;
+}
+
+void mqtt_publish_queue_reset(struct mqtt_client *client)
+{
+	struct mqtt_publish_queue *queue = &client->internal.pub_queue;
+	uint8_t inflight = 0U;
+
+	for (int i = 0; i < queue->count; i++) {
+		struct mqtt_publish_queue_entry *entry = &queue->entries[i];
+
+		switch (entry->state) {
+		case PUB_QUEUE_SENT:
+			/* Publish again on the next connection. */
+			client->pub_queue_buf[entry->offset] |= MQTT_HEADER_DUP_MASK;
+			entry->state = PUB_QUEUE_QUEUED;
+			break;
+
+		case PUB_QUEUE_RELEASED:
+		case PUB_QUEUE_RELEASE_QUEUED:
+			/* Release again on the next connection. */
+			entry->state = PUB_QUEUE_RELEASE_QUEUED;
+			inflight++;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	queue->inflight = inflight;
+}
+
+int mqtt_publish_enqueue(struct mqtt_client *client,
+			 const struct mqtt_publish_param *param)
+{
+	struct mqtt_publish_queue *queue;
+	struct mqtt_publish_param publish;
+	struct buf_ctx packet;
+	uint8_t *start;
+	uint32_t len;
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(param);
+
+	NET_DBG("[CID %p]:[State 0x%02x]: >> Topic size 0x%08x, "
+		 "Data size 0x%08x", client, client->internal.state,
+		 param->message.topic.topic.size,
+		 param->message.payload.len);
+
+	mqtt_mutex_lock(client);
+
+	queue = &client->internal.pub_queue;
+
+	if ((client->pub_queue_buf == NULL) ||
+	    (queue->count >= CONFIG_MQTT_PUBLISH_QUEUE_SIZE)) {
+		err_code = -ENOMEM;
+		goto error;
+	}
+
+	/* Acknowledgments are matched by message identifier. */
+	if ((param->message.topic.qos != MQTT_QOS_0_AT_MOST_ONCE) &&
+	    (param->message_id != 0U) &&
+	    (entry_find(queue, param->message_id) != NULL)) {
+		err_code = -EEXIST;
+		goto error;
+	}
+
+	publish = *param;
+	if ((publish.message.topic.qos != MQTT_QOS_0_AT_MOST_ONCE) &&
+	    (publish.message_id == 0U)) {
+		publish.message_id = message_id_next(queue);
+	} else if (publish.message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		publish.message_id = 0U;
+	}
+
+	start = client->pub_queue_buf + queue->used;
+	packet.cur = start;
+	packet.end = client->pub_queue_buf + client->pub_queue_buf_size;
+
+	err_code = publish_encode(client, &publish, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	/* The encoder only reserves room for the payload, check it fits. */
+	len = packet.end - packet.cur;
+	if (publish.message.payload.len >
+	    client->pub_queue_buf_size - queue->used - len) {
+		err_code = -ENOMEM;
+		goto error;
+	}
+
+	memmove(start, packet.cur, len);
+	if (publish.message.payload.len > 0U) {
+		memcpy(start + len, publish.message.payload.data,
+		       publish.message.payload.len);
+	}
+
+	queue->entries[queue->count++] = (struct mqtt_publish_queue_entry) {
+		.offset = queue->used,
+		.len = len + publish.message.payload.len,
+		.message_id = publish.message_id,
+		.state = PUB_QUEUE_QUEUED,
+	};
+	queue->used += len + publish.message.payload.len;
+
+	err_code = publish.message_id;
+
+error:
+	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
+		 client, client->internal.state, err_code);
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
+int mqtt_publish_flush(struct mqtt_client *client)
+{
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+	if (!MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+		err_code = -ENOTCONN;
+	} else {
+		err_code = mqtt_publish_queue_flush(client);
+	}
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
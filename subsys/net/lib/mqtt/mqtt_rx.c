@@ -80,6 +80,13 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(client, buf, &evt.param.puback);
 		evt.result = err_code;
+
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+		if (err_code == 0) {
+			err_code = mqtt_publish_queue_ack(client, MQTT_PKT_TYPE_PUBACK,
+							  evt.param.puback.message_id, 0U);
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -89,6 +96,26 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		err_code = publish_receive_decode(client, buf,
 						  &evt.param.pubrec);
 		evt.result = err_code;
+
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+		if (err_code == 0) {
+			uint8_t reason_code = 0U;
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+			reason_code = evt.param.pubrec.reason_code;
+#endif
+			err_code = mqtt_publish_queue_ack(client, MQTT_PKT_TYPE_PUBREC,
+							  evt.param.pubrec.message_id,
+							  reason_code);
+			if (err_code > 0) {
+				/* Released by the queue, an application
+				 * releasing it as well would send PUBREL twice.
+				 */
+				notify_event = false;
+				err_code = 0;
+			}
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_PUBREL:
@@ -107,6 +134,13 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		err_code = publish_complete_decode(client, buf,
 						   &evt.param.pubcomp);
 		evt.result = err_code;
+
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+		if (err_code == 0) {
+			err_code = mqtt_publish_queue_ack(client, MQTT_PKT_TYPE_PUBCOMP,
+							  evt.param.pubcomp.message_id, 0U);
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
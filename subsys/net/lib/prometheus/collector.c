@@ -20,6 +20,8 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/iterable_sections.h>
 
+#include "prometheus_internal.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_collector, CONFIG_PROMETHEUS_LOG_LEVEL);
 
@@ -162,46 +164,39 @@ out:
 int prometheus_collector_walk_metrics(struct prometheus_collector_walk_context *ctx,
 				      uint8_t *buffer, size_t buffer_size)
 {
+	size_t len = 0;
 	int ret = 0;
 
-	if (ctx->collector == NULL) {
+	if (ctx->collector == NULL || buffer == NULL || buffer_size == 0) {
 		LOG_ERR("Invalid arguments");
 		return -EINVAL;
 	}
 
+	if (ctx->state == PROMETHEUS_WALK_STOP) {
+		/* Already done, the walk context needs to be initialized again */
+		buffer[0] = '\0';
+		return 0;
+	}
+
 	if (ctx->state == PROMETHEUS_WALK_START) {
 		k_mutex_lock(&ctx->collector->lock, K_FOREVER);
 		ctx->state = PROMETHEUS_WALK_CONTINUE;
 
-		/* Start of the loop is taken from
-		 * SYS_SLIST_FOR_EACH_CONTAINER_SAFE macro to simulate
-		 * a loop.
-		 */
-
-		ctx->metric = Z_GENLIST_PEEK_HEAD_CONTAINER(slist,
-							    &ctx->collector->metrics,
-							    ctx->metric,
-							    node);
-		ctx->tmp = Z_GENLIST_PEEK_NEXT_CONTAINER(slist,
-							 ctx->metric,
-							 node);
+		ctx->metric = SYS_SLIST_PEEK_HEAD_CONTAINER(&ctx->collector->metrics,
+							    ctx->metric, node);
+		ctx->line = 0;
 	}
 
-	if (ctx->state == PROMETHEUS_WALK_CONTINUE) {
-		int len = 0;
-
-		ctx->metric = ctx->tmp;
-		ctx->tmp = Z_GENLIST_PEEK_NEXT_CONTAINER(slist,
-							 ctx->metric,
-							 node);
-
+	while (ctx->state == PROMETHEUS_WALK_CONTINUE) {
 		if (ctx->metric == NULL) {
 			ctx->state = PROMETHEUS_WALK_STOP;
-			goto out;
+			break;
 		}
 
-		/* If there is a user callback, use it to update the metric data. */
-		if (ctx->collector->user_cb) {
+		/* If there is a user callback, use it to update the metric data
+		 * before its first line.
+		 */
+		if (ctx->line == 0 && ctx->collector->user_cb) {
 			ret = ctx->collector->user_cb(ctx->collector, ctx->metric,
 						      ctx->collector->user_data);
 			if (ret < 0) {
@@ -211,23 +206,40 @@ int prometheus_collector_walk_metrics(struct prometheus_collector_walk_context *
 				}
 
 				/* Skip this metric for now */
-				goto out;
+				ctx->metric = SYS_SLIST_PEEK_NEXT_CONTAINER(ctx->metric, node);
+				continue;
 			}
 		}
 
-		ret = prometheus_format_one_metric(ctx->metric, buffer, buffer_size, &len);
+		ret = prometheus_format_line(ctx->metric, ctx->line, (char *)buffer + len,
+					     buffer_size - len);
+		if (ret == -ENOMEM && len > 0) {
+			/* Buffer is full, continue from this line next time */
+			break;
+		}
+
 		if (ret < 0) {
 			ctx->state = PROMETHEUS_WALK_STOP;
 			goto out;
 		}
 
-		ret = -EAGAIN;
+		if (ret == 0) {
+			ctx->metric = SYS_SLIST_PEEK_NEXT_CONTAINER(ctx->metric, node);
+			ctx->line = 0;
+			continue;
+		}
+
+		len += ret;
+		ctx->line++;
 	}
 
+	ret = (ctx->state == PROMETHEUS_WALK_STOP) ? 0 : -EAGAIN;
+
 out:
+	buffer[len] = '\0';
+
 	if (ctx->state == PROMETHEUS_WALK_STOP) {
 		k_mutex_unlock(&ctx->collector->lock);
-		ret = 0;
 	}
 
 	return ret;
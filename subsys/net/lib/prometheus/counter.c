@@ -11,6 +11,8 @@
 
 #include <zephyr/kernel.h>
 
+#include "prometheus_internal.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_counter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
@@ -20,7 +22,18 @@ int prometheus_counter_add(struct prometheus_counter *counter, uint64_t value)
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+	unsigned int key = arch_irq_lock();
+	unsigned int cpu = CPU_ID;
+
+	prometheus_cell_write_begin(&counter->cpu_seq[cpu]);
+	counter->cpu_value[cpu] += value;
+	prometheus_cell_write_end(&counter->cpu_seq[cpu]);
+
+	arch_irq_unlock(key);
+#else
 	counter->value += value;
+#endif
 
 	return 0;
 }
@@ -33,11 +46,11 @@ int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value)
 		return -EINVAL;
 	}
 
-	if (value == counter->value) {
+	old_value = prometheus_counter_get(counter);
+	if (value == old_value) {
 		return 0;
 	}
 
-	old_value = counter->value;
 	if (value < old_value) {
 		LOG_DBG("Cannot set counter to a lower value (%" PRIu64 " < %" PRIu64 ")",
 			value, old_value);
@@ -48,3 +61,24 @@ int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value)
 
 	return 0;
 }
+
+uint64_t prometheus_counter_get(const struct prometheus_counter *counter)
+{
+	uint64_t value = counter->value;
+
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		uint64_t cpu_value;
+		uint32_t seq;
+
+		do {
+			seq = prometheus_cell_read_begin(&counter->cpu_seq[i]);
+			cpu_value = counter->cpu_value[i];
+		} while (prometheus_cell_read_retry(&counter->cpu_seq[i], seq));
+
+		value += cpu_value;
+	}
+#endif
+
+	return value;
+}
@@ -21,117 +21,81 @@
 
 #include <zephyr/kernel.h>
 
+#include "prometheus_internal.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_formatter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
-static int write_metric_to_buffer(char *buffer, size_t buffer_size, const char *format, ...)
+static int write_line(char *buffer, size_t buffer_size, const char *format, ...)
 {
-	/* helper function to write formatted metric to buffer */
+	/* helper function to write one formatted line to buffer */
 	va_list args;
-	size_t len = strlen(buffer);
-
-	if (len >= buffer_size) {
-		return -ENOMEM;
-	}
-	buffer += len;
-	buffer_size -= len;
+	int len;
 
 	va_start(args, format);
 	len = vsnprintf(buffer, buffer_size, format, args);
 	va_end(args);
+	if (len < 0) {
+		return -EINVAL;
+	}
+
 	if (len >= buffer_size) {
 		return -ENOMEM;
 	}
 
-	return 0;
+	return len;
 }
 
-int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
-				 size_t buffer_size, int *written)
+static const char *metric_type_name(enum prometheus_metric_type type)
 {
-	int ret = 0;
-
-	/* write HELP line if available */
-	if (metric->description[0] != '\0') {
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# HELP %s %s\n", metric->name,
-					     metric->description);
-		if (ret < 0) {
-			LOG_ERR("Error writing to buffer");
-			goto out;
-		}
-	}
-
-	/* write TYPE line */
-	switch (metric->type) {
+	switch (type) {
 	case PROMETHEUS_COUNTER:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s counter\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing counter");
-			goto out;
-		}
-
-		break;
-
+		return "counter";
 	case PROMETHEUS_GAUGE:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s gauge\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing gauge");
-			goto out;
-		}
-
-		break;
-
+		return "gauge";
 	case PROMETHEUS_HISTOGRAM:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s histogram\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
-		}
-
-		break;
-
+		return "histogram";
 	case PROMETHEUS_SUMMARY:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s summary\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
-		}
-
-		break;
-
+		return "summary";
 	default:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s untyped\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing untyped");
-			goto out;
+		return "untyped";
+	}
+}
+
+int prometheus_format_line(const struct prometheus_metric *metric, int line,
+			   char *buffer, size_t buffer_size)
+{
+	/* write HELP line if available */
+	if (metric->description[0] != '\0') {
+		if (line == 0) {
+			return write_line(buffer, buffer_size, "# HELP %s %s\n", metric->name,
+					  metric->description);
 		}
 
-		break;
+		line--;
+	}
+
+	/* write TYPE line */
+	if (line == 0) {
+		return write_line(buffer, buffer_size, "# TYPE %s %s\n", metric->name,
+				  metric_type_name(metric->type));
 	}
 
-	/* write metric-specific fields */
+	line--;
+
+	/* write metric-specific fields, the values are read line by line so
+	 * that updates are never held back by the formatting.
+	 */
 	switch (metric->type) {
 	case PROMETHEUS_COUNTER: {
 		const struct prometheus_counter *counter =
 			CONTAINER_OF(metric, struct prometheus_counter, base);
 
-		LOG_DBG("counter->value: %llu", counter->value);
-
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %llu\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, counter->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing counter");
-				goto out;
-			}
+		if (line < metric->num_labels) {
+			return write_line(buffer, buffer_size, "%s{%s=\"%s\"} %llu\n",
+					  metric->name, metric->labels[line].key,
+					  metric->labels[line].value,
+					  prometheus_counter_get(counter));
 		}
 
 		break;
@@ -141,17 +105,10 @@ int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 		const struct prometheus_gauge *gauge =
 			CONTAINER_OF(metric, struct prometheus_gauge, base);
 
-		LOG_DBG("gauge->value: %f", gauge->value);
-
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %f\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, gauge->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing gauge");
-				goto out;
-			}
+		if (line < metric->num_labels) {
+			return write_line(buffer, buffer_size, "%s{%s=\"%s\"} %f\n",
+					  metric->name, metric->labels[line].key,
+					  metric->labels[line].value, gauge->value);
 		}
 
 		break;
@@ -161,33 +118,22 @@ int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 		const struct prometheus_histogram *histogram =
 			CONTAINER_OF(metric, struct prometheus_histogram, base);
 
-		LOG_DBG("histogram->count: %lu", histogram->count);
-
-		for (int i = 0; i < histogram->num_buckets; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s_bucket{le=\"%f\"} %lu\n", metric->name,
-				histogram->buckets[i].upper_bound,
-				histogram->buckets[i].count);
-			if (ret < 0) {
-				LOG_ERR("Error writing histogram");
-				goto out;
-			}
+		if (line < histogram->num_buckets) {
+			return write_line(buffer, buffer_size, "%s_bucket{le=\"%f\"} %lu\n",
+					  metric->name, histogram->buckets[line].upper_bound,
+					  prometheus_histogram_get_bucket_count(histogram, line));
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, histogram->sum);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
+		line -= histogram->num_buckets;
+
+		if (line == 0) {
+			return write_line(buffer, buffer_size, "%s_sum %f\n", metric->name,
+					  prometheus_histogram_get_sum(histogram));
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     histogram->count);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
+		if (line == 1) {
+			return write_line(buffer, buffer_size, "%s_count %lu\n", metric->name,
+					  prometheus_histogram_get_count(histogram));
 		}
 
 		break;
@@ -197,33 +143,23 @@ int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 		const struct prometheus_summary *summary =
 			CONTAINER_OF(metric, struct prometheus_summary, base);
 
-		LOG_DBG("summary->count: %lu", summary->count);
-
-		for (int i = 0; i < summary->num_quantiles; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%f\"} %f\n", metric->name, "quantile",
-				summary->quantiles[i].quantile,
-				summary->quantiles[i].value);
-			if (ret < 0) {
-				LOG_ERR("Error writing summary");
-				goto out;
-			}
+		if (line < summary->num_quantiles) {
+			return write_line(buffer, buffer_size, "%s{%s=\"%f\"} %f\n",
+					  metric->name, "quantile",
+					  summary->quantiles[line].quantile,
+					  summary->quantiles[line].value);
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, summary->sum);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+		line -= summary->num_quantiles;
+
+		if (line == 0) {
+			return write_line(buffer, buffer_size, "%s_sum %f\n", metric->name,
+					  prometheus_summary_get_sum(summary));
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     summary->count);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+		if (line == 1) {
+			return write_line(buffer, buffer_size, "%s_count %lu\n", metric->name,
+					  prometheus_summary_get_count(summary));
 		}
 
 		break;
@@ -232,12 +168,46 @@ int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 	default:
 		/* should not happen */
 		LOG_ERR("Unsupported metric type %d", metric->type);
-		ret = -EINVAL;
-		goto out;
+		return -EINVAL;
 	}
 
-out:
-	return ret;
+	return 0;
+}
+
+int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
+				 size_t buffer_size, int *written)
+{
+	size_t len = strlen(buffer);
+	int ret;
+
+	for (int line = 0; ; line++) {
+		if (len >= buffer_size) {
+			ret = -ENOMEM;
+			break;
+		}
+
+		ret = prometheus_format_line(metric, line, buffer + len, buffer_size - len);
+		if (ret <= 0) {
+			break;
+		}
+
+		len += ret;
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Error writing %s (%d)", metric->name, ret);
+
+		/* Drop the partially written line */
+		if (len < buffer_size) {
+			buffer[len] = '\0';
+		}
+
+		return ret;
+	}
+
+	*written = len;
+
+	return 0;
 }
 
 int prometheus_format_exposition(struct prometheus_collector *collector, char *buffer,
@@ -11,33 +11,117 @@
 
 #include <zephyr/kernel.h>
 
+#include "prometheus_internal.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_histogram, CONFIG_PROMETHEUS_LOG_LEVEL);
 
 int prometheus_histogram_observe(struct prometheus_histogram *histogram, double value)
 {
+	size_t bucket;
+
 	if (!histogram) {
 		return -EINVAL;
 	}
 
+	/* find appropriate bucket */
+	for (bucket = 0; bucket < histogram->num_buckets; ++bucket) {
+		if (value <= histogram->buckets[bucket].upper_bound) {
+			break;
+		}
+	}
+
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+	unsigned int key = arch_irq_lock();
+	unsigned int cpu = CPU_ID;
+
+	prometheus_cell_write_begin(&histogram->cpu_seq[cpu]);
+
+	histogram->cpu_count[cpu]++;
+	histogram->cpu_sum[cpu] += value;
+
+	if (bucket < histogram->num_buckets) {
+		histogram->buckets[bucket].cpu_count[cpu]++;
+	}
+
+	prometheus_cell_write_end(&histogram->cpu_seq[cpu]);
+
+	arch_irq_unlock(key);
+#else
 	/* increment count */
 	histogram->count++;
 
 	/* update sum */
 	histogram->sum += value;
 
-	/* find appropriate bucket */
-	for (size_t i = 0; i < histogram->num_buckets; ++i) {
-		if (value <= histogram->buckets[i].upper_bound) {
-			/* increment count for the bucket */
-			histogram->buckets[i].count++;
-
-			LOG_DBG("value: %f, bucket: %f, count: %lu", value,
-				histogram->buckets[i].upper_bound, histogram->buckets[i].count);
+	if (bucket < histogram->num_buckets) {
+		/* increment count for the bucket */
+		histogram->buckets[bucket].count++;
+	}
+#endif
 
-			break;
-		}
+	if (bucket < histogram->num_buckets) {
+		LOG_DBG("value: %f, bucket: %f, count: %lu", value,
+			histogram->buckets[bucket].upper_bound,
+			prometheus_histogram_get_bucket_count(histogram, bucket));
 	}
 
 	return 0;
 }
+
+double prometheus_histogram_get_sum(const struct prometheus_histogram *histogram)
+{
+	double sum = histogram->sum;
+
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		double cpu_sum;
+		uint32_t seq;
+
+		do {
+			seq = prometheus_cell_read_begin(&histogram->cpu_seq[i]);
+			cpu_sum = histogram->cpu_sum[i];
+		} while (prometheus_cell_read_retry(&histogram->cpu_seq[i], seq));
+
+		sum += cpu_sum;
+	}
+#endif
+
+	return sum;
+}
+
+unsigned long prometheus_histogram_get_count(const struct prometheus_histogram *histogram)
+{
+	unsigned long count = histogram->count;
+
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+	/* A count is a single word, it is never read half updated */
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		count += *(const volatile unsigned long *)&histogram->cpu_count[i];
+	}
+#endif
+
+	return count;
+}
+
+unsigned long prometheus_histogram_get_bucket_count(const struct prometheus_histogram *histogram,
+						    size_t bucket)
+{
+	const struct prometheus_histogram_bucket *entry;
+	unsigned long count;
+
+	if (bucket >= histogram->num_buckets) {
+		return 0;
+	}
+
+	entry = &histogram->buckets[bucket];
+	count = entry->count;
+
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		count += *(const volatile unsigned long *)&entry->cpu_count[i];
+	}
+#endif
+
+	return count;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/net/prometheus/collector.h>
+#include <zephyr/net/prometheus/counter.h>
+#include <zephyr/net/prometheus/gauge.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/mem_stats.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(pm_kernel_stats, CONFIG_PROMETHEUS_LOG_LEVEL);
+
+static int kernel_stats_scrape(struct prometheus_collector *collector,
+			       struct prometheus_metric *metric,
+			       void *user_data);
+
+PROMETHEUS_COLLECTOR_DEFINE(prometheus_kernel_stats, kernel_stats_scrape);
+
+#if defined(CONFIG_OBJ_CORE_STATS_SYSTEM)
+static PROMETHEUS_COUNTER_DEFINE(kernel_cpu_busy_cycles, "CPU cycles spent in threads",
+				 ({ .key = "cpu", .value = "all" }),
+				 &prometheus_kernel_stats);
+static PROMETHEUS_COUNTER_DEFINE(kernel_cpu_idle_cycles, "CPU cycles spent idle",
+				 ({ .key = "cpu", .value = "all" }),
+				 &prometheus_kernel_stats);
+#endif
+
+#if defined(CONFIG_OBJ_CORE_THREAD)
+static PROMETHEUS_GAUGE_DEFINE(kernel_threads, "Number of threads",
+			       ({ .key = "kernel", .value = "threads" }),
+			       &prometheus_kernel_stats);
+#endif
+
+#if defined(CONFIG_OBJ_CORE_STATS_MEM_SLAB)
+static PROMETHEUS_GAUGE_DEFINE(kernel_mem_slab_allocated_bytes,
+			       "Bytes allocated from memory slabs",
+			       ({ .key = "kernel", .value = "mem_slab" }),
+			       &prometheus_kernel_stats);
+static PROMETHEUS_GAUGE_DEFINE(kernel_mem_slab_free_bytes,
+			       "Bytes free in memory slabs",
+			       ({ .key = "kernel", .value = "mem_slab" }),
+			       &prometheus_kernel_stats);
+#endif
+
+#if defined(CONFIG_OBJ_CORE_THREAD)
+static int count_object(struct k_obj_core *obj_core, void *data)
+{
+	ARG_UNUSED(obj_core);
+
+	(*(int *)data)++;
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_OBJ_CORE_STATS_MEM_SLAB)
+static int add_mem_slab_stats(struct k_obj_core *obj_core, void *data)
+{
+	struct sys_memory_stats *total = data;
+	struct sys_memory_stats stats;
+
+	if (k_obj_core_stats_query(obj_core, &stats, sizeof(stats)) == 0) {
+		total->allocated_bytes += stats.allocated_bytes;
+		total->free_bytes += stats.free_bytes;
+	}
+
+	return 0;
+}
+#endif
+
+/* The kernel keeps the statistics, they are only read when scraped */
+static int kernel_stats_scrape(struct prometheus_collector *collector,
+			       struct prometheus_metric *metric,
+			       void *user_data)
+{
+	ARG_UNUSED(collector);
+	ARG_UNUSED(user_data);
+
+#if defined(CONFIG_OBJ_CORE_STATS_SYSTEM)
+	if (metric == &kernel_cpu_busy_cycles.base || metric == &kernel_cpu_idle_cycles.base) {
+		struct prometheus_counter *counter =
+			CONTAINER_OF(metric, struct prometheus_counter, base);
+		k_thread_runtime_stats_t stats;
+		int ret;
+
+		ret = k_obj_core_stats_query(K_OBJ_CORE(&_kernel), &stats, sizeof(stats));
+		if (ret < 0) {
+			return -EAGAIN;
+		}
+
+		return prometheus_counter_set(counter, counter == &kernel_cpu_busy_cycles ?
+						       stats.total_cycles : stats.idle_cycles);
+	}
+#endif
+
+#if defined(CONFIG_OBJ_CORE_THREAD)
+	if (metric == &kernel_threads.base) {
+		struct k_obj_type *type = k_obj_type_find(K_OBJ_TYPE_THREAD_ID);
+		int count = 0;
+
+		if (type == NULL) {
+			return -EAGAIN;
+		}
+
+		(void)k_obj_type_walk_locked(type, count_object, &count);
+
+		return prometheus_gauge_set(&kernel_threads, count);
+	}
+#endif
+
+#if defined(CONFIG_OBJ_CORE_STATS_MEM_SLAB)
+	if (metric == &kernel_mem_slab_allocated_bytes.base ||
+	    metric == &kernel_mem_slab_free_bytes.base) {
+		struct k_obj_type *type = k_obj_type_find(K_OBJ_TYPE_MEM_SLAB_ID);
+		struct sys_memory_stats total = { 0 };
+
+		if (type == NULL) {
+			return -EAGAIN;
+		}
+
+		/* The statistics query takes the lock of the object type */
+		(void)k_obj_type_walk_unlocked(type, add_mem_slab_stats, &total);
+
+		if (metric == &kernel_mem_slab_allocated_bytes.base) {
+			return prometheus_gauge_set(&kernel_mem_slab_allocated_bytes,
+						    total.allocated_bytes);
+		}
+
+		return prometheus_gauge_set(&kernel_mem_slab_free_bytes, total.free_bytes);
+	}
+#endif
+
+	return -EAGAIN;
+}
+
+static int kernel_stats_init(void)
+{
+	int count = 0;
+
+	STRUCT_SECTION_FOREACH(prometheus_counter, entry) {
+		if (entry->base.collector == &prometheus_kernel_stats) {
+			prometheus_collector_register_metric(&prometheus_kernel_stats,
+							     &entry->base);
+			count++;
+		}
+	}
+
+	STRUCT_SECTION_FOREACH(prometheus_gauge, entry) {
+		if (entry->base.collector == &prometheus_kernel_stats) {
+			prometheus_collector_register_metric(&prometheus_kernel_stats,
+							     &entry->base);
+			count++;
+		}
+	}
+
+	LOG_DBG("Registered %d kernel metrics", count);
+
+	return 0;
+}
+
+SYS_INIT(kernel_stats_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
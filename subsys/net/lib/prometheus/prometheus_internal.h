@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_NET_LIB_PROMETHEUS_INTERNAL_H_
+#define ZEPHYR_SUBSYS_NET_LIB_PROMETHEUS_INTERNAL_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/sys/barrier.h>
+
+#include <zephyr/net/prometheus/metric.h>
+
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+
+/* With per-CPU metrics, a CPU only updates its own cells, with interrupts
+ * locked on that CPU only, so that updates never wait for another CPU.
+ * The cells are summed when the metric is read. A 64-bit cell is not
+ * written atomically on a 32-bit CPU, so the cells of each CPU come with
+ * a sequence counter, odd while they are updated. A reader retries until
+ * the counter was even and did not change while the cells were read.
+ */
+static inline void prometheus_cell_write_begin(uint32_t *seq)
+{
+	*(volatile uint32_t *)seq += 1U;
+	barrier_dmem_fence_full();
+}
+
+static inline void prometheus_cell_write_end(uint32_t *seq)
+{
+	barrier_dmem_fence_full();
+	*(volatile uint32_t *)seq += 1U;
+}
+
+static inline uint32_t prometheus_cell_read_begin(const uint32_t *seq)
+{
+	uint32_t start;
+
+	/* The writer runs with interrupts locked, it is done in a moment */
+	do {
+		start = *(const volatile uint32_t *)seq;
+	} while ((start & 1U) != 0U);
+
+	barrier_dmem_fence_full();
+
+	return start;
+}
+
+static inline bool prometheus_cell_read_retry(const uint32_t *seq, uint32_t start)
+{
+	barrier_dmem_fence_full();
+
+	return *(const volatile uint32_t *)seq != start;
+}
+
+#endif /* CONFIG_PROMETHEUS_PER_CPU_METRICS */
+
+/* Format a line of the exposition of a metric, the HELP line first if the
+ * metric has a description, then the TYPE line and the samples.
+ *
+ * Returns the length of the line, 0 if the metric has less lines, or
+ * -ENOMEM if the line and its terminating NUL do not fit in the buffer.
+ */
+int prometheus_format_line(const struct prometheus_metric *metric, int line,
+			   char *buffer, size_t buffer_size);
+
+#endif /* ZEPHYR_SUBSYS_NET_LIB_PROMETHEUS_INTERNAL_H_ */
@@ -11,6 +11,8 @@
 
 #include <zephyr/kernel.h>
 
+#include "prometheus_internal.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_summary, CONFIG_PROMETHEUS_LOG_LEVEL);
 
@@ -20,11 +22,23 @@ int prometheus_summary_observe(struct prometheus_summary *summary, double value)
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+	unsigned int key = arch_irq_lock();
+	unsigned int cpu = CPU_ID;
+
+	prometheus_cell_write_begin(&summary->cpu_seq[cpu]);
+	summary->cpu_count[cpu]++;
+	summary->cpu_sum[cpu] += value;
+	prometheus_cell_write_end(&summary->cpu_seq[cpu]);
+
+	arch_irq_unlock(key);
+#else
 	/* increment count */
 	summary->count++;
 
 	/* update sum */
 	summary->sum += value;
+#endif
 
 	return 0;
 }
@@ -39,20 +53,55 @@ int prometheus_summary_observe_set(struct prometheus_summary *summary,
 		return -EINVAL;
 	}
 
-	if (value == summary->sum && count == summary->count) {
+	old_count = prometheus_summary_get_count(summary);
+	old_sum = prometheus_summary_get_sum(summary);
+
+	if (value == old_sum && count == old_count) {
 		return 0;
 	}
 
-	old_count = summary->count;
 	if (count < old_count) {
 		LOG_DBG("Cannot set summary count to a lower value");
 		return -EINVAL;
 	}
 
 	summary->count += (count - old_count);
-
-	old_sum = summary->sum;
 	summary->sum += (value - old_sum);
 
 	return 0;
 }
+
+double prometheus_summary_get_sum(const struct prometheus_summary *summary)
+{
+	double sum = summary->sum;
+
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		double cpu_sum;
+		uint32_t seq;
+
+		do {
+			seq = prometheus_cell_read_begin(&summary->cpu_seq[i]);
+			cpu_sum = summary->cpu_sum[i];
+		} while (prometheus_cell_read_retry(&summary->cpu_seq[i], seq));
+
+		sum += cpu_sum;
+	}
+#endif
+
+	return sum;
+}
+
+unsigned long prometheus_summary_get_count(const struct prometheus_summary *summary)
+{
+	unsigned long count = summary->count;
+
+#if defined(CONFIG_PROMETHEUS_PER_CPU_METRICS)
+	/* A count is a single word, it is never read half updated */
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		count += *(const volatile unsigned long *)&summary->cpu_count[i];
+	}
+#endif
+
+	return count;
+}
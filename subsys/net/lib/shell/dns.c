@@ -136,6 +136,18 @@ static void print_dns_info(const struct shell *sh,
 			   remaining);
 		}
 	}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct dns_resolve_cache_stats stats;
+
+	if (dns_resolve_cache_stats_get(&stats) == 0) {
+		PR("Cache:\n");
+		PR("\thits %u misses %u negative hits %u\n",
+		   stats.hits, stats.misses, stats.negative_hits);
+		PR("\tevictions %u prefetches %u coalesced %u\n",
+		   stats.evictions, stats.prefetches, stats.coalesced);
+	}
+#endif
 }
 #endif
 
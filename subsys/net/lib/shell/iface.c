@@ -63,6 +63,8 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_TXINJECTION_MODE,     "TX-Injection supported"),
 	EC(ETHERNET_LINK_2500BASE_T,      "2.5 Gbits"),
 	EC(ETHERNET_LINK_5000BASE_T,      "5 Gbits"),
+	EC(ETHERNET_HW_TSO,               "TCP segmentation offload"),
+	EC(ETHERNET_HW_LRO,               "Large receive offload"),
 };
 
 static void print_supported_ethernet_capabilities(
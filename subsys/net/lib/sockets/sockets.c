@@ -362,6 +362,11 @@ ssize_t z_vrfy_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 					addrlen));
 	}
 
+	/* Zero-copy completion callbacks are only available to supervisor
+	 * threads, so always copy the user data.
+	 */
+	flags &= ~ZSOCK_MSG_ZEROCOPY;
+
 	return z_impl_zsock_sendto(sock, (const void *)buf, len, flags,
 			dest_addr ? (struct sockaddr *)&dest_addr_copy : NULL,
 			addrlen);
@@ -436,6 +441,11 @@ static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
 		}
 	}
 
+	/* The iovec data is a temporary copy, so it cannot be sent
+	 * without copying.
+	 */
+	flags &= ~ZSOCK_MSG_ZEROCOPY;
+
 	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
 				   flags);
 
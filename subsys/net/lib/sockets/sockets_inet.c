@@ -12,6 +12,7 @@
 LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
+#include <zephyr/internal/syscall_handler.h>
 #include <zephyr/net/mld.h>
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/net_pkt.h>
@@ -23,6 +24,10 @@ LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/iterable_sections.h>
 
+#if defined(CONFIG_FILE_SYSTEM)
+#include <zephyr/fs/fs.h>
+#endif
+
 #if defined(CONFIG_SOCKS)
 #include "socks.h"
 #endif
@@ -619,6 +624,9 @@ out:
 	return -1;
 }
 
+ssize_t zsock_sendmsg_ctx(struct net_context *ctx, const struct msghdr *msg,
+			  int flags);
+
 ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 			 int flags,
 			 const struct sockaddr *dest_addr, socklen_t addrlen)
@@ -628,6 +636,32 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	k_timepoint_t buf_timeout, end;
 	int status;
 
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY) &&
+	    (flags & ZSOCK_MSG_ZEROCOPY)) {
+		/* Zero-copy data is passed down via the sendmsg() path which
+		 * carries the send flags to the net_context.
+		 */
+		struct iovec iov = {
+			.iov_base = (void *)buf,
+			.iov_len = len,
+		};
+		struct msghdr msg = {
+			.msg_name = (void *)dest_addr,
+			.msg_namelen = dest_addr != NULL ? addrlen : 0,
+			.msg_iov = &iov,
+			.msg_iovlen = 1,
+		};
+
+		status = net_context_recv(ctx, zsock_received_cb,
+					  K_NO_WAIT, ctx->user_data);
+		if (status < 0) {
+			errno = -status;
+			return -1;
+		}
+
+		return zsock_sendmsg_ctx(ctx, &msg, flags);
+	}
+
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
 		timeout = K_NO_WAIT;
 		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
@@ -1338,6 +1372,299 @@ static size_t zsock_recv_stream_immediate(struct net_context *ctx, uint8_t **buf
 	return recv_len;
 }
 
+static ssize_t zsock_recv_pkt_ctx(struct net_context *ctx,
+				  struct net_pkt **pkt, int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	size_t len = 0;
+	int ret;
+
+	*pkt = NULL;
+
+	if (sock_type != SOCK_DGRAM && sock_type != SOCK_STREAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (flags & ~ZSOCK_MSG_DONTWAIT) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM &&
+	    net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	do {
+		if (sock_type == SOCK_STREAM) {
+			if (sock_is_error(ctx)) {
+				errno = POINTER_TO_INT(ctx->user_data);
+				return -1;
+			}
+
+			if (sock_is_eof(ctx)) {
+				return 0;
+			}
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = zsock_wait_data(ctx, &timeout);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+		}
+
+		*pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (*pkt == NULL) {
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				errno = EAGAIN;
+				return -1;
+			}
+
+			/* Woken up without data, e.g. by EOF */
+			continue;
+		}
+
+		len = net_pkt_remaining_data(*pkt);
+
+		if (sock_type == SOCK_STREAM) {
+			if (net_pkt_eof(*pkt)) {
+				sock_set_eof(ctx);
+			}
+
+			if (len == 0) {
+				/* Pure FIN marker, nothing to hand over */
+				net_pkt_unref(*pkt);
+				*pkt = NULL;
+				continue;
+			}
+
+			net_context_update_recv_wnd(ctx, len);
+		}
+	} while (*pkt == NULL);
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+	    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+		net_socket_update_tc_rx_time(*pkt, k_cycle_get_32());
+	}
+
+	return len;
+}
+
+ssize_t zsock_recv_pkt(int sock, struct net_pkt **pkt, int flags)
+{
+	const struct fd_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (pkt == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zvfs_get_fd_obj_and_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	/* Only native sockets queue net_pkt's that can be handed over */
+	if (vtable != &sock_fd_op_vtable.fd_vtable ||
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zsock_recv_pkt_ctx(ctx, pkt, flags);
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+#if defined(CONFIG_FILE_SYSTEM)
+/* Size of the bounce buffer used when the data cannot be read directly into
+ * the TCP send buffers.
+ */
+#define SENDFILE_CHUNK_SIZE 128
+
+static int sendfile_fill_cb(uint8_t *buf, size_t len, void *user_data)
+{
+	ssize_t ret = fs_read(user_data, buf, len);
+
+	return ret < 0 ? (int)ret : (int)MIN(ret, INT_MAX);
+}
+
+static ssize_t zsock_sendfile_tcp(struct net_context *ctx,
+				  struct fs_file_t *file, size_t count)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	size_t sent = 0;
+	int status;
+
+	if (sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	while (sent < count) {
+		status = net_tcp_queue_fill(ctx, count - sent,
+					    sendfile_fill_cb, file);
+		if (status == 0) {
+			/* End of file */
+			break;
+		}
+
+		if (status < 0) {
+			if (sent > 0 && (status == -EAGAIN || status == -ENOBUFS) &&
+			    K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				break;
+			}
+
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				return sent > 0 ? sent : status;
+			}
+
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		sent += status;
+	}
+
+	return sent;
+}
+
+static ssize_t zsock_sendfile_copy(int sock, struct fs_file_t *file,
+				   size_t count)
+{
+	uint8_t chunk[SENDFILE_CHUNK_SIZE];
+	size_t sent = 0;
+
+	while (sent < count) {
+		ssize_t len, out = 0;
+
+		len = fs_read(file, chunk, MIN(sizeof(chunk), count - sent));
+		if (len < 0) {
+			if (sent > 0) {
+				break;
+			}
+
+			errno = -len;
+			return -1;
+		}
+
+		if (len == 0) {
+			break;
+		}
+
+		while (out < len) {
+			ssize_t ret = zsock_send(sock, chunk + out, len - out, 0);
+
+			if (ret < 0) {
+				/* Do not leave the file position past the
+				 * data that was not sent.
+				 */
+				(void)fs_seek(file, out - len, FS_SEEK_CUR);
+
+				return sent > 0 ? sent : ret;
+			}
+
+			out += ret;
+			sent += ret;
+		}
+	}
+
+	return sent;
+}
+
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count)
+{
+	const struct fd_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	off_t pos = 0;
+	ssize_t ret;
+	int err;
+
+	if (file == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zvfs_get_fd_obj_and_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (offset != NULL) {
+		pos = fs_tell(file);
+		if (pos < 0) {
+			errno = -pos;
+			return -1;
+		}
+
+		err = fs_seek(file, *offset, FS_SEEK_SET);
+		if (err < 0) {
+			errno = -err;
+			return -1;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+	    vtable == &sock_fd_op_vtable.fd_vtable &&
+	    net_context_get_type(ctx) == SOCK_STREAM &&
+	    !net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		(void)k_mutex_lock(lock, K_FOREVER);
+		ret = zsock_sendfile_tcp(ctx, file, count);
+		k_mutex_unlock(lock);
+	} else {
+		ret = zsock_sendfile_copy(sock, file, count);
+	}
+
+	if (offset != NULL) {
+		if (ret > 0) {
+			*offset += ret;
+		}
+
+		err = fs_seek(file, pos, FS_SEEK_SET);
+		if (err < 0 && ret >= 0) {
+			errno = -err;
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
+#endif /* CONFIG_FILE_SYSTEM */
+
 static int zsock_fionread_ctx(struct net_context *ctx)
 {
 	size_t ret = zsock_recv_stream_immediate(ctx, NULL, NULL, 0);
@@ -1774,6 +2101,31 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			}
 			break;
 
+		case SO_ZEROCOPY:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+				struct zsock_zerocopy *zc = optval;
+				struct net_context_zerocopy zerocopy;
+
+				if (zc == NULL || *optlen != sizeof(*zc)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				ret = net_context_get_option(ctx,
+							     NET_OPT_ZEROCOPY,
+							     &zerocopy, NULL);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				zc->cb = zerocopy.cb;
+				zc->user_data = zerocopy.user_data;
+
+				return 0;
+			}
+			break;
+
 		case SO_PROTOCOL: {
 			int proto = (int)net_context_get_proto(ctx);
 
@@ -2406,6 +2758,41 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			break;
 
+		case SO_ZEROCOPY:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+				const struct zsock_zerocopy *zc = optval;
+				struct net_context_zerocopy zerocopy;
+
+#if defined(CONFIG_USERSPACE)
+				/* The callback is run in kernel context */
+				if (k_is_in_user_syscall()) {
+					errno = EPERM;
+					return -1;
+				}
+#endif
+
+				if (zc == NULL || optlen != sizeof(*zc)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				zerocopy.cb = zc->cb;
+				zerocopy.user_data = zc->user_data;
+
+				ret = net_context_set_option(ctx,
+							     NET_OPT_ZEROCOPY,
+							     &zerocopy,
+							     sizeof(zerocopy));
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_SOCKS5:
 			if (IS_ENABLED(CONFIG_SOCKS)) {
 				ret = net_context_set_option(ctx,
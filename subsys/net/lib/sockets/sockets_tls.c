@@ -46,7 +46,9 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/ssl_cookie.h>
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
+#include <mbedtls/platform_util.h>
 #include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -68,6 +70,12 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #define DTLS_SENDMSG_BUF_SIZE 0
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE)
+#define TLS_SENDMSG_BUF_SIZE (CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE)
+#else
+#define TLS_SENDMSG_BUF_SIZE 0
+#endif /* CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE */
+
 static const struct socket_op_vtable tls_sock_fd_op_vtable;
 
 #ifndef MBEDTLS_ERR_SSL_PEER_VERIFY_FAILED
@@ -242,6 +250,11 @@ __net_socket struct tls_context {
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 
 #endif /* CONFIG_MBEDTLS */
+
+#if TLS_SENDMSG_BUF_SIZE > 0
+	/** Buffer coalescing the small buffers given to sendmsg(). */
+	uint8_t sendmsg_buf[TLS_SENDMSG_BUF_SIZE];
+#endif
 };
 
 
@@ -254,6 +267,30 @@ static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_S
 static mbedtls_ssl_cache_context server_cache;
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Keys protecting the session tickets issued by servers, set up on first use.
+ * The context is referenced by the configuration of every server context, so
+ * it is never freed. Purging the sessions rotates the keys instead.
+ */
+static mbedtls_ssl_ticket_context server_tickets;
+static bool server_tickets_ready;
+
+/* Serializes the use of server_tickets, mbedTLS is built without
+ * MBEDTLS_THREADING_C so the ticket context has no lock of its own.
+ */
+static struct k_mutex ticket_lock;
+
+/* Sizes of the key name and the key expected by mbedtls_ssl_ticket_rotate() */
+#define TLS_TICKET_NAME_LEN 4
+#define TLS_TICKET_KEY_LEN 32
+
+#if defined(MBEDTLS_GCM_C)
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_256_GCM
+#else
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_256_CCM
+#endif
+#endif /* MBEDTLS_SSL_TICKET_C */
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
@@ -373,6 +410,10 @@ static int tls_init(void)
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	k_mutex_init(&ticket_lock);
+#endif
+
 	return 0;
 }
 
@@ -722,6 +763,31 @@ exit:
 	mbedtls_ssl_session_free(&session);
 }
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Must be called with ticket_lock held */
+static int tls_session_tickets_rotate(void)
+{
+	uint8_t key[TLS_TICKET_NAME_LEN + TLS_TICKET_KEY_LEN];
+	int ret;
+
+	ret = tls_ctr_drbg_random(NULL, key, sizeof(key));
+	if (ret == 0) {
+		ret = mbedtls_ssl_ticket_rotate(&server_tickets, key, TLS_TICKET_NAME_LEN,
+						key + TLS_TICKET_NAME_LEN, TLS_TICKET_KEY_LEN,
+						CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+	}
+
+	mbedtls_platform_zeroize(key, sizeof(key));
+
+	if (ret != 0) {
+		NET_ERR("Failed to rotate session ticket keys, err: -0x%x", -ret);
+		return -EIO;
+	}
+
+	return 0;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
 static void tls_session_purge(void)
 {
 	tls_session_cache_reset();
@@ -730,7 +796,77 @@ static void tls_session_purge(void)
 	mbedtls_ssl_cache_free(&server_cache);
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	/* The ticket context keeps the current and the previous key. Replace
+	 * both of them, so that all the issued tickets become invalid.
+	 */
+	k_mutex_lock(&ticket_lock, K_FOREVER);
+
+	if (server_tickets_ready) {
+		for (int i = 0; i < 2; i++) {
+			if (tls_session_tickets_rotate() < 0) {
+				break;
+			}
+		}
+	}
+
+	k_mutex_unlock(&ticket_lock);
+#endif
+}
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+static int tls_session_tickets_setup(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&ticket_lock, K_FOREVER);
+
+	if (!server_tickets_ready) {
+		mbedtls_ssl_ticket_init(&server_tickets);
+
+		ret = mbedtls_ssl_ticket_setup(&server_tickets, tls_ctr_drbg_random, NULL,
+					       TLS_TICKET_CIPHER,
+					       CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+		if (ret != 0) {
+			NET_ERR("Failed to set up session tickets, err: -0x%x", -ret);
+			mbedtls_ssl_ticket_free(&server_tickets);
+			ret = -ENOMEM;
+		} else {
+			server_tickets_ready = true;
+		}
+	}
+
+	k_mutex_unlock(&ticket_lock);
+
+	return ret;
+}
+
+static int tls_session_ticket_write(void *p_ticket, const mbedtls_ssl_session *session,
+				    unsigned char *start, const unsigned char *end,
+				    size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	k_mutex_lock(&ticket_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_write(p_ticket, session, start, end, tlen, lifetime);
+	k_mutex_unlock(&ticket_lock);
+
+	return ret;
+}
+
+static int tls_session_ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+				    unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&ticket_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+	k_mutex_unlock(&ticket_lock);
+
+	return ret;
 }
+#endif /* MBEDTLS_SSL_TICKET_C */
 
 static inline int time_left(uint32_t start, uint32_t timeout)
 {
@@ -1421,6 +1557,17 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	/* Clients able to resume from a ticket do not need a cache entry */
+	if (is_server && context->options.cache_enabled &&
+	    tls_session_tickets_setup() == 0) {
+		mbedtls_ssl_conf_session_tickets_cb(&context->config,
+						    tls_session_ticket_write,
+						    tls_session_ticket_parse,
+						    &server_tickets);
+	}
+#endif
+
 #if defined(MBEDTLS_SSL_EARLY_DATA)
 	mbedtls_ssl_conf_early_data(&context->config, MBEDTLS_SSL_EARLY_DATA_ENABLED);
 #endif
@@ -2498,6 +2645,111 @@ static ssize_t dtls_sendmsg_merge_and_send(struct tls_context *ctx,
 	return len;
 }
 
+/* Returns the number of bytes written to the TLS stream, which is less than
+ * len if an error occurred after some data was written, like a short write.
+ * The error is only returned if nothing was written.
+ */
+static ssize_t tls_send_all(struct tls_context *ctx, const uint8_t *buf,
+			    size_t len, int flags, const struct msghdr *msg)
+{
+	size_t sent = 0;
+	ssize_t ret;
+
+	while (sent < len) {
+		ret = ztls_sendto_ctx(ctx, buf + sent, len - sent, flags,
+				      msg->msg_name, msg->msg_namelen);
+		if (ret < 0) {
+			return sent > 0 ? sent : ret;
+		}
+		sent += ret;
+	}
+
+	return sent;
+}
+
+#if TLS_SENDMSG_BUF_SIZE > 0
+/* Small buffers are gathered in a per-context buffer so that they are sent
+ * in as few TLS records as possible, each record costing a header, a MAC and
+ * an encryption pass. Buffers at least as large as the intermediate buffer
+ * are sent directly, once the gathered data was flushed.
+ */
+static ssize_t tls_sendmsg_coalesce_and_send(struct tls_context *ctx,
+					     const struct msghdr *msg,
+					     int flags)
+{
+	size_t buf_len = 0;
+	ssize_t len = 0;
+	ssize_t ret;
+
+	for (int i = 0; i < msg->msg_iovlen; i++) {
+		struct iovec *vec = msg->msg_iov + i;
+		const uint8_t *ptr = vec->iov_base;
+		size_t left = vec->iov_len;
+
+		if (left >= sizeof(ctx->sendmsg_buf)) {
+			if (buf_len > 0) {
+				ret = tls_send_all(ctx, ctx->sendmsg_buf,
+						   buf_len, flags, msg);
+				if (ret < 0) {
+					goto err;
+				}
+				len += ret;
+				if ((size_t)ret < buf_len) {
+					return len;
+				}
+				buf_len = 0;
+			}
+
+			ret = tls_send_all(ctx, ptr, left, flags, msg);
+			if (ret < 0) {
+				goto err;
+			}
+			len += ret;
+			if ((size_t)ret < left) {
+				return len;
+			}
+			continue;
+		}
+
+		while (left > 0) {
+			size_t chunk = MIN(left, sizeof(ctx->sendmsg_buf) - buf_len);
+
+			memcpy(ctx->sendmsg_buf + buf_len, ptr, chunk);
+			buf_len += chunk;
+			ptr += chunk;
+			left -= chunk;
+
+			if (buf_len == sizeof(ctx->sendmsg_buf)) {
+				ret = tls_send_all(ctx, ctx->sendmsg_buf,
+						   buf_len, flags, msg);
+				if (ret < 0) {
+					goto err;
+				}
+				len += ret;
+				if ((size_t)ret < buf_len) {
+					return len;
+				}
+				buf_len = 0;
+			}
+		}
+	}
+
+	if (buf_len > 0) {
+		ret = tls_send_all(ctx, ctx->sendmsg_buf, buf_len, flags, msg);
+		if (ret < 0) {
+			goto err;
+		}
+		len += ret;
+	}
+
+	return len;
+
+err:
+	/* Report the data already sent, like a short write */
+	return len > 0 ? len : ret;
+}
+#endif /* TLS_SENDMSG_BUF_SIZE > 0 */
+
 static ssize_t tls_sendmsg_loop_and_send(struct tls_context *ctx,
 					 const struct msghdr *msg,
 					 int flags)
@@ -2507,24 +2759,20 @@ static ssize_t tls_sendmsg_loop_and_send(struct tls_context *ctx,
 
 	for (int i = 0; i < msg->msg_iovlen; i++) {
 		struct iovec *vec = msg->msg_iov + i;
-		size_t sent = 0;
 
 		if (vec->iov_len == 0) {
 			continue;
 		}
 
-		while (sent < vec->iov_len) {
-			uint8_t *ptr = (uint8_t *)vec->iov_base + sent;
-
-			ret = ztls_sendto_ctx(ctx, ptr, vec->iov_len - sent,
-					      flags, msg->msg_name,
-					      msg->msg_namelen);
-			if (ret < 0) {
-				return ret;
-			}
-			sent += ret;
+		ret = tls_send_all(ctx, vec->iov_base, vec->iov_len, flags, msg);
+		if (ret < 0) {
+			/* Report the data already sent, like a short write */
+			return len > 0 ? len : ret;
+		}
+		len += ret;
+		if ((size_t)ret < vec->iov_len) {
+			break;
 		}
-		len += sent;
 	}
 
 	return len;
@@ -2562,6 +2810,12 @@ ssize_t ztls_sendmsg_ctx(struct tls_context *ctx, const struct msghdr *msg,
 		}
 	}
 
+#if TLS_SENDMSG_BUF_SIZE > 0
+	if (ctx->type == SOCK_STREAM && msghdr_non_empty_iov_count(msg) > 1) {
+		return tls_sendmsg_coalesce_and_send(ctx, msg, flags);
+	}
+#endif
+
 send_loop:
 	return tls_sendmsg_loop_and_send(ctx, msg, flags);
 }
@@ -2623,6 +2877,11 @@ static ssize_t recv_tls(struct tls_context *ctx, void *buf,
 			    ret == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET) {
 				int timeout_ms;
 
+				if (recv_len > 0 && !waitall) {
+					/* Pending data consumed, return what was read. */
+					break;
+				}
+
 				if (!is_block) {
 					ret = -EAGAIN;
 					goto err;
@@ -2661,7 +2920,13 @@ err:
 		}
 
 		recv_len += ret;
-	} while ((recv_len == 0) || (waitall && (recv_len < max_len)));
+
+		/* mbedtls_ssl_read() returns the data of one record at most,
+		 * keep on reading the records already received so that the
+		 * caller gets as much data as possible per call.
+		 */
+	} while ((recv_len == 0) || (waitall && (recv_len < max_len)) ||
+		 ((recv_len < max_len) && mbedtls_ssl_check_pending(&ctx->ssl)));
 
 	return recv_len;
 }
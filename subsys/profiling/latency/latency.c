@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/profiling/latency.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
+#include <inttypes.h>
+#include <string.h>
+
+#define __no_instrument __attribute__((__no_instrument_function__))
+
+__no_instrument void __cyg_profile_func_enter(void *func, void *call_site);
+__no_instrument void __cyg_profile_func_exit(void *func, void *call_site);
+
+/* Generated from CONFIG_PROFILING_LATENCY_INCLUDE_FUNCTIONS */
+extern void *const latency_include_functions[];
+extern const size_t latency_include_functions_count;
+
+struct latency_function {
+	void *func;
+	struct latency_stats stats;
+};
+
+static struct latency_function latency_functions[CONFIG_PROFILING_LATENCY_FUNCTIONS];
+static uint32_t latency_dropped;
+static bool latency_running;
+/* Set while the hooks run, so the functions they call are not measured */
+static bool latency_busy;
+/* Incremented on start, to discard the calls entered before */
+static uint32_t latency_generation;
+
+static __no_instrument struct latency_function *latency_function_new(size_t idx, void *func)
+{
+	struct latency_function *function = &latency_functions[idx];
+
+	if (function->func == NULL) {
+		function->func = func;
+		function->stats.min = UINT64_MAX;
+	}
+
+	return function;
+}
+
+static __no_instrument struct latency_function *latency_function_get(void *func)
+{
+	size_t idx;
+
+	/* The included functions have the entry of their index */
+	if (latency_include_functions_count != 0U) {
+		for (idx = 0; idx < latency_include_functions_count; idx++) {
+			if (latency_include_functions[idx] == func) {
+				return latency_function_new(idx, func);
+			}
+		}
+
+		return NULL;
+	}
+
+	/* Open addressing with linear probing */
+	idx = ((uintptr_t)func >> 1) % CONFIG_PROFILING_LATENCY_FUNCTIONS;
+	for (size_t i = 0; i < CONFIG_PROFILING_LATENCY_FUNCTIONS; i++) {
+		if ((latency_functions[idx].func == func) ||
+		    (latency_functions[idx].func == NULL)) {
+			return latency_function_new(idx, func);
+		}
+
+		idx = (idx + 1U) % CONFIG_PROFILING_LATENCY_FUNCTIONS;
+	}
+
+	return NULL;
+}
+
+static __no_instrument bool latency_is_included(void *func)
+{
+	if (latency_include_functions_count == 0U) {
+		return true;
+	}
+
+	for (size_t i = 0; i < latency_include_functions_count; i++) {
+		if (latency_include_functions[i] == func) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static __no_instrument void latency_stats_update(struct latency_stats *stats, uint64_t cycles)
+{
+	size_t bucket = (cycles == 0U) ? 0U : (64U - u64_count_leading_zeros(cycles));
+
+	stats->count++;
+	stats->total += cycles;
+	stats->min = MIN(stats->min, cycles);
+	stats->max = MAX(stats->max, cycles);
+	stats->histogram[MIN(bucket, CONFIG_PROFILING_LATENCY_BUCKETS - 1)]++;
+}
+
+static __no_instrument struct _thread_latency *latency_thread_get(void)
+{
+	struct _thread_latency *latency;
+
+	if (_current == NULL) {
+		return NULL;
+	}
+
+	latency = &_current->latency;
+	if (latency->generation != latency_generation) {
+		latency->generation = latency_generation;
+		latency->depth = 0U;
+	}
+
+	return latency;
+}
+
+void __cyg_profile_func_enter(void *func, void *call_site)
+{
+	struct _thread_latency *latency;
+	unsigned int key;
+
+	ARG_UNUSED(call_site);
+
+	if (!latency_running) {
+		return;
+	}
+
+	key = arch_irq_lock();
+
+	if (latency_busy || !latency_is_included(func)) {
+		goto out;
+	}
+
+	latency_busy = true;
+
+	latency = latency_thread_get();
+	if (latency != NULL) {
+		if (latency->depth < CONFIG_PROFILING_LATENCY_DEPTH) {
+			latency->calls[latency->depth].func = func;
+			latency->calls[latency->depth].entry = timing_counter_get();
+		} else {
+			latency_dropped++;
+		}
+
+		latency->depth++;
+	}
+
+	latency_busy = false;
+out:
+	arch_irq_unlock(key);
+}
+
+void __cyg_profile_func_exit(void *func, void *call_site)
+{
+	struct latency_function *function;
+	struct _thread_latency *latency;
+	timing_t exit;
+	unsigned int key;
+	uint32_t depth;
+
+	ARG_UNUSED(call_site);
+
+	if (!latency_running) {
+		return;
+	}
+
+	key = arch_irq_lock();
+
+	if (latency_busy || !latency_is_included(func)) {
+		goto out;
+	}
+
+	latency_busy = true;
+
+	exit = timing_counter_get();
+
+	latency = latency_thread_get();
+	if ((latency == NULL) || (latency->depth == 0U)) {
+		/* Entered before the measurement was started */
+		goto done;
+	}
+
+	if (latency->depth > CONFIG_PROFILING_LATENCY_DEPTH) {
+		latency->depth--;
+		goto done;
+	}
+
+	/* Calls which did not exit in this thread, because the current thread
+	 * changed while they ran, are discarded.
+	 */
+	depth = latency->depth;
+	while ((depth > 0U) && (latency->calls[depth - 1U].func != func)) {
+		depth--;
+	}
+
+	if (depth == 0U) {
+		goto done;
+	}
+
+	latency->depth = depth - 1U;
+
+	function = latency_function_get(func);
+	if (function == NULL) {
+		latency_dropped++;
+		goto done;
+	}
+
+	latency_stats_update(&function->stats,
+			     timing_cycles_get(&latency->calls[depth - 1U].entry, &exit));
+
+done:
+	latency_busy = false;
+out:
+	arch_irq_unlock(key);
+}
+
+int latency_start(void)
+{
+	unsigned int key;
+
+	if (latency_running) {
+		return -EALREADY;
+	}
+
+	key = arch_irq_lock();
+	/* 0 is the generation of the threads which never entered a call */
+	latency_generation = (latency_generation + 1U != 0U) ? latency_generation + 1U : 1U;
+	latency_running = true;
+	arch_irq_unlock(key);
+
+	return 0;
+}
+
+int latency_stop(void)
+{
+	if (!latency_running) {
+		return -EALREADY;
+	}
+
+	latency_running = false;
+
+	return 0;
+}
+
+bool latency_is_running(void)
+{
+	return latency_running;
+}
+
+void latency_clear(void)
+{
+	unsigned int key = arch_irq_lock();
+
+	memset(latency_functions, 0, sizeof(latency_functions));
+	latency_dropped = 0U;
+
+	arch_irq_unlock(key);
+}
+
+int latency_foreach(latency_cb_t cb, void *user_data)
+{
+	struct latency_function function;
+	unsigned int key;
+	int ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(latency_functions); i++) {
+		key = arch_irq_lock();
+		function = latency_functions[i];
+		arch_irq_unlock(key);
+
+		if ((function.func == NULL) || (function.stats.count == 0U)) {
+			continue;
+		}
+
+		ret = cb(function.func, &function.stats, user_data);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+uint32_t latency_dropped_get(void)
+{
+	return latency_dropped;
+}
+
+#ifdef CONFIG_SHELL
+static int cmd_latency_start(const struct shell *sh, size_t argc, char **argv)
+{
+	if (latency_start() != 0) {
+		shell_warn(sh, "Latency is running");
+		return -EALREADY;
+	}
+
+	shell_print(sh, "Enabled latency");
+
+	return 0;
+}
+
+static int cmd_latency_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	if (latency_stop() != 0) {
+		shell_warn(sh, "Latency is not running");
+		return -EALREADY;
+	}
+
+	shell_print(sh, "Latency done!");
+
+	return 0;
+}
+
+static int cmd_latency_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	latency_clear();
+
+	shell_print(sh, "Latency statistics cleared");
+
+	return 0;
+}
+
+static int latency_function_count(void *func, const struct latency_stats *stats, void *user_data)
+{
+	size_t *count = user_data;
+
+	(*count)++;
+
+	return 0;
+}
+
+static int cmd_latency_info(const struct shell *sh, size_t argc, char **argv)
+{
+	size_t count = 0;
+
+	if (latency_running) {
+		shell_print(sh, "Latency is running");
+	}
+
+	(void)latency_foreach(latency_function_count, &count);
+
+	shell_print(sh, "Latency functions: %zu/%d, dropped calls: %u", count,
+		    CONFIG_PROFILING_LATENCY_FUNCTIONS, latency_dropped);
+
+	return 0;
+}
+
+static int latency_function_print(void *func, const struct latency_stats *stats, void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	shell_print(sh, "%p: %u calls, min %" PRIu64 " ns, avg %" PRIu64 " ns, max %" PRIu64 " ns",
+		    func, stats->count, timing_cycles_to_ns(stats->min),
+		    timing_cycles_to_ns_avg(stats->total, stats->count),
+		    timing_cycles_to_ns(stats->max));
+
+	for (size_t i = 0; i < ARRAY_SIZE(stats->histogram); i++) {
+		if (stats->histogram[i] == 0U) {
+			continue;
+		}
+
+		if (i == ARRAY_SIZE(stats->histogram) - 1U) {
+			shell_print(sh, "  >= %" PRIu64 " ns: %u",
+				    timing_cycles_to_ns(BIT64(i - 1U)), stats->histogram[i]);
+		} else {
+			shell_print(sh, "  < %" PRIu64 " ns: %u",
+				    timing_cycles_to_ns(BIT64(i)), stats->histogram[i]);
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_latency_print(const struct shell *sh, size_t argc, char **argv)
+{
+	(void)latency_foreach(latency_function_print, (void *)sh);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_latency,
+	SHELL_CMD_ARG(start, NULL, "Start measuring latencies", cmd_latency_start, 0, 0),
+	SHELL_CMD_ARG(stop, NULL, "Stop measuring latencies", cmd_latency_stop, 0, 0),
+	SHELL_CMD_ARG(print, NULL, "Print the latency histograms", cmd_latency_print, 0, 0),
+	SHELL_CMD_ARG(clear, NULL, "Clear the latency histograms", cmd_latency_clear, 0, 0),
+	SHELL_CMD_ARG(info, NULL, "Print the latency info", cmd_latency_info, 0, 0),
+	SHELL_SUBCMD_SET_END
+);
+SHELL_CMD_ARG_REGISTER(latency, &m_sub_latency, "Function latency histograms", NULL, 0, 0);
+#endif /* CONFIG_SHELL */
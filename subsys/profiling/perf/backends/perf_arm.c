@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <cmsis_core.h>
+
+/*
+ * The process stack only holds the frame of the sampled context when the timer
+ * interrupt preempted a thread, i.e. when it is the only active exception.
+ * Samples of an interrupted exception handler are dropped.
+ */
+bool arch_perf_can_trace(void)
+{
+	return (__get_IPSR() != 0U) && ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) != 0U);
+}
+
+/*
+ * Code built for Thumb does not keep a chain of frame records which could be
+ * walked, so only the address where the interrupt occurred and the return
+ * address of the interrupted function are traced.
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	if (size < 2U) {
+		return 0;
+	}
+
+	/*
+	 * Threads run on the process stack, where the core pushes the basic
+	 * stack frame (struct __basic_sf) of the interrupted thread, see
+	 * arch_perf_can_trace().
+	 */
+	const struct __basic_sf * const bsf = (const struct __basic_sf *)__get_PSP();
+
+	buf[0] = (uintptr_t)bsf->pc;
+	buf[1] = (uintptr_t)bsf->lr;
+
+	return 2;
+}
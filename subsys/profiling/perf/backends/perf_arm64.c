@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+struct perf_trace {
+	uintptr_t *buf;
+	size_t size;
+	size_t idx;
+	bool overflow;
+};
+
+static bool perf_trace_add(void *cookie, unsigned long addr)
+{
+	struct perf_trace *trace = cookie;
+
+	if (trace->idx >= trace->size) {
+		trace->overflow = true;
+		return false;
+	}
+
+	trace->buf[trace->idx++] = addr;
+
+	return true;
+}
+
+/*
+ * This function uses the frame records of the interrupted code, walked by
+ * arch_stack_walk(), to get trace of return addresses.
+ * Return addresses are translated in corresponding function's names using .elf file.
+ * So we get function call trace
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	struct perf_trace trace = {
+		.buf = buf,
+		.size = size,
+	};
+
+	if (size < 2U) {
+		return 0;
+	}
+
+	/*
+	 * In arm64 (arch/arm64/core/vector_table.S), the registers of the
+	 * interrupted code, including elr, lr and fp (x29), are saved in
+	 * struct arch_esf on its stack. Then, if the interrupt is not nested,
+	 * _isr_wrapper (arch/arm64/core/isr_wrapper.S) switches sp to
+	 * _current_cpu->irq_stack and saves the previous sp, the address of the
+	 * esf, with offset -16 on irq stack.
+	 */
+	const struct arch_esf * const esf =
+		*((struct arch_esf **)(((uintptr_t)_current_cpu->irq_stack) - 16));
+
+	trace.buf[trace.idx++] = (uintptr_t)esf->elr;
+
+	/*
+	 * During function prologue and epilogue, fp still points to the frame
+	 * record of the caller. Saving lr helps in case when irq occurred there,
+	 * the duplicated function is merged by stackcollapse.py otherwise.
+	 */
+	trace.buf[trace.idx++] = (uintptr_t)esf->lr;
+
+	arch_stack_walk(perf_trace_add, &trace, _current, esf);
+
+	return trace.overflow ? 0 : trace.idx;
+}
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+/* Frame of the interrupt handler (boards/native/native_sim/irq_handler.c) */
+extern void *posix_irq_handler_frame;
+
+/* Maximum size of a stack frame, to detect a corrupted frame pointer */
+#define PERF_FRAME_MAX_SIZE 0x10000
+
+static inline bool in_text_region(uintptr_t addr)
+{
+	/* Defined by the default linker script of the host */
+	extern char __executable_start[], etext[];
+
+	return (addr >= (uintptr_t)__executable_start) && (addr < (uintptr_t)etext);
+}
+
+/*
+ * This function use frame pointers to unwind stack and get trace of return addresses.
+ * Return addresses are translated in corresponding function's names using .elf file.
+ * So we get function call trace
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	size_t idx = 0;
+
+	/*
+	 * Interrupts are handled in the host thread of the interrupted Zephyr
+	 * thread, by posix_irq_handler(). It saves its frame pointer when the
+	 * interrupt is not nested, its return address is the location where
+	 * the interrupt occurred.
+	 *
+	 * stack frame in memory:
+	 * (addresses growth up)
+	 *  ....
+	 *  ra
+	 *  fp (next) <- fp (curr)
+	 *  ....
+	 */
+	void **fp = posix_irq_handler_frame;
+
+	while (fp != NULL) {
+		if (idx >= size) {
+			return 0;
+		}
+
+		if (!in_text_region((uintptr_t)fp[1])) {
+			break;
+		}
+
+		buf[idx++] = (uintptr_t)fp[1];
+		void **new_fp = (void **)fp[0];
+
+		/*
+		 * anti-infinity-loop if
+		 * new_fp can't be smaller than fp, cause the stack is growing down
+		 * and trace moves deeper into the stack
+		 */
+		if ((new_fp <= fp) || ((uintptr_t)new_fp - (uintptr_t)fp > PERF_FRAME_MAX_SIZE)) {
+			break;
+		}
+		fp = new_fp;
+	}
+
+	return idx;
+}
@@ -8,23 +8,55 @@
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/arch/cpu.h>
+#include <zephyr/profiling/perf.h>
+#include <zephyr/sys/atomic.h>
+#ifdef CONFIG_SHELL
 #include <zephyr/shell/shell.h>
 #include <zephyr/shell/shell_uart.h>
+#else
+struct shell;
+#endif
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
 
+/* Backends which cannot trace every interrupted context override it */
+__weak bool arch_perf_can_trace(void)
+{
+	return true;
+}
+
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+/* Number of samples of a thread with a stack trace, hash 0 for a free entry */
+struct perf_stack {
+	uint32_t hash;
+	uint32_t count;
+	k_tid_t thread;
+	size_t length;
+	uintptr_t trace[CONFIG_PROFILING_PERF_AGGREGATE_DEPTH];
+};
+#endif
+
 struct perf_data_t {
 	struct k_timer timer;
 
+#ifdef CONFIG_SHELL
 	const struct shell *sh;
+#endif
 
 	struct k_work_delayable dwork;
 
+	atomic_t running;
+	uint32_t dropped;
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	struct perf_stack stacks[CONFIG_PROFILING_PERF_AGGREGATE_ENTRIES];
+#else
 	size_t idx;
 	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
 	bool buf_full;
+#endif
 };
 
 static void perf_tracer(struct k_timer *timer);
@@ -34,6 +66,76 @@ static struct perf_data_t perf_data = {
 	.dwork = Z_WORK_DELAYABLE_INITIALIZER(perf_dwork_handler),
 };
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+/* FNV-1a hash of the thread and stack trace */
+static uint32_t perf_stack_hash(k_tid_t thread, const uintptr_t *trace, size_t length)
+{
+	uint32_t hash = 2166136261U;
+	uintptr_t word = (uintptr_t)thread;
+
+	for (size_t i = 0; i <= length; i++) {
+		for (size_t j = 0; j < sizeof(word); j++) {
+			hash ^= (uint8_t)(word >> (j * 8U));
+			hash *= 16777619U;
+		}
+		word = (i < length) ? trace[i] : 0;
+	}
+
+	return (hash != 0U) ? hash : 1U;
+}
+
+static bool perf_stack_add(struct perf_data_t *perf_data_ptr, k_tid_t thread,
+			   const uintptr_t *trace, size_t length)
+{
+	const uint32_t hash = perf_stack_hash(thread, trace, length);
+	size_t idx = hash % CONFIG_PROFILING_PERF_AGGREGATE_ENTRIES;
+
+	/* Open addressing with linear probing */
+	for (size_t i = 0; i < CONFIG_PROFILING_PERF_AGGREGATE_ENTRIES; i++) {
+		struct perf_stack *stack = &perf_data_ptr->stacks[idx];
+
+		if (stack->hash == 0U) {
+			stack->hash = hash;
+			stack->count = 1U;
+			stack->thread = thread;
+			stack->length = length;
+			memcpy(stack->trace, trace, length * sizeof(trace[0]));
+			return true;
+		}
+
+		if ((stack->hash == hash) && (stack->thread == thread) &&
+		    (stack->length == length) &&
+		    (memcmp(stack->trace, trace, length * sizeof(trace[0])) == 0)) {
+			stack->count++;
+			return true;
+		}
+
+		idx = (idx + 1U) % CONFIG_PROFILING_PERF_AGGREGATE_ENTRIES;
+	}
+
+	return false;
+}
+
+static void perf_tracer(struct k_timer *timer)
+{
+	struct perf_data_t *perf_data_ptr =
+		(struct perf_data_t *)k_timer_user_data_get(timer);
+	uintptr_t trace[CONFIG_PROFILING_PERF_AGGREGATE_DEPTH];
+	size_t trace_length;
+
+	if (!arch_perf_can_trace()) {
+		perf_data_ptr->dropped++;
+		return;
+	}
+
+	trace_length = arch_perf_current_stack_trace(trace, ARRAY_SIZE(trace));
+
+	if ((trace_length == 0) ||
+	    !perf_stack_add(perf_data_ptr, _current, trace, trace_length)) {
+		perf_data_ptr->dropped++;
+	}
+}
+#else
 static void perf_tracer(struct k_timer *timer)
 {
 	struct perf_data_t *perf_data_ptr =
@@ -41,6 +143,11 @@ static void perf_tracer(struct k_timer *timer)
 
 	size_t trace_length = 0;
 
+	if (!arch_perf_can_trace()) {
+		perf_data_ptr->dropped++;
+		return;
+	}
+
 	if (++perf_data_ptr->idx < CONFIG_PROFILING_PERF_BUFFER_SIZE) {
 		trace_length = arch_perf_current_stack_trace(
 					perf_data_ptr->buf + perf_data_ptr->idx,
@@ -56,6 +163,16 @@ static void perf_tracer(struct k_timer *timer)
 		k_work_reschedule(&perf_data_ptr->dwork, K_NO_WAIT);
 	}
 }
+#endif
+
+static bool perf_buf_full(void)
+{
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	return false;
+#else
+	return perf_data.buf_full;
+#endif
+}
 
 static void perf_dwork_handler(struct k_work *work)
 {
@@ -63,81 +180,264 @@ static void perf_dwork_handler(struct k_work *work)
 	struct perf_data_t *perf_data_ptr = CONTAINER_OF(dwork, struct perf_data_t, dwork);
 
 	k_timer_stop(&perf_data_ptr->timer);
-	if (perf_data_ptr->buf_full) {
+	atomic_clear(&perf_data_ptr->running);
+
+#ifdef CONFIG_SHELL
+	if (perf_data_ptr->sh == NULL) {
+		return;
+	}
+
+	if (perf_buf_full()) {
 		shell_error(perf_data_ptr->sh, "Perf buf overflow!");
 	} else {
 		shell_print(perf_data_ptr->sh, "Perf done!");
 	}
+#endif
 }
 
-static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
+static int perf_start_internal(const struct shell *sh, uint32_t frequency,
+			       k_timeout_t duration)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
-		shell_warn(sh, "Perf is running");
-		return -EINPROGRESS;
+	if (frequency == 0U) {
+		return -EINVAL;
 	}
 
-	if (perf_data.buf_full) {
-		shell_warn(sh, "Perf buffer is full");
+	if (perf_buf_full()) {
 		return -ENOBUFS;
 	}
 
-	k_timeout_t duration = K_MSEC(strtoll(argv[1], NULL, 10));
-	k_timeout_t period = K_NSEC(1000000000 / strtoll(argv[2], NULL, 10));
+	/* Only one caller may start perf, the shell and the API can race */
+	if (!atomic_cas(&perf_data.running, 0, 1)) {
+		return -EINPROGRESS;
+	}
 
+#ifdef CONFIG_SHELL
 	perf_data.sh = sh;
+#else
+	ARG_UNUSED(sh);
+#endif
 
 	k_timer_user_data_set(&perf_data.timer, &perf_data);
-	k_timer_start(&perf_data.timer, K_NO_WAIT, period);
+	k_timer_start(&perf_data.timer, K_NO_WAIT, K_NSEC(NSEC_PER_SEC / frequency));
 
-	k_work_schedule(&perf_data.dwork, duration);
+	if (!K_TIMEOUT_EQ(duration, K_FOREVER)) {
+		k_work_schedule(&perf_data.dwork, duration);
+	}
 
-	shell_print(sh, "Enabled perf");
+	return 0;
+}
+
+int perf_start(uint32_t frequency, k_timeout_t duration)
+{
+	return perf_start_internal(NULL, frequency, duration);
+}
+
+int perf_stop(void)
+{
+	if (!atomic_get(&perf_data.running)) {
+		return -EALREADY;
+	}
+
+	(void)k_work_cancel_delayable(&perf_data.dwork);
+	k_timer_stop(&perf_data.timer);
+	atomic_clear(&perf_data.running);
 
 	return 0;
 }
 
-static int cmd_perf_clear(const struct shell *sh, size_t argc, char **argv)
+bool perf_is_running(void)
 {
-	if (sh != NULL) {
-		if (k_work_delayable_is_pending(&perf_data.dwork)) {
-			shell_warn(sh, "Perf is running");
-			return -EINPROGRESS;
-		}
-		shell_print(sh, "Perf buffer cleared");
+	return atomic_get(&perf_data.running) != 0;
+}
+
+int perf_clear(void)
+{
+	if (perf_is_running()) {
+		return -EINPROGRESS;
 	}
 
+	perf_data.dropped = 0;
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	memset(perf_data.stacks, 0, sizeof(perf_data.stacks));
+#else
 	perf_data.idx = 0;
 	perf_data.buf_full = false;
+#endif
+
+	return 0;
+}
+
+int perf_foreach_sample(perf_sample_cb_t cb, void *user_data)
+{
+	int ret;
+
+	if (perf_is_running()) {
+		return -EINPROGRESS;
+	}
+
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	for (size_t i = 0; i < ARRAY_SIZE(perf_data.stacks); i++) {
+		const struct perf_stack *stack = &perf_data.stacks[i];
+
+		if (stack->hash == 0U) {
+			continue;
+		}
+
+		ret = cb(stack->thread, stack->count, stack->trace, stack->length, user_data);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+#else
+	for (size_t i = 0; i < perf_data.idx; i += perf_data.buf[i] + 1) {
+		ret = cb(NULL, 1U, &perf_data.buf[i + 1], perf_data.buf[i], user_data);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+#endif
+
+	return 0;
+}
+
+uint32_t perf_dropped_get(void)
+{
+	return perf_data.dropped;
+}
+
+#ifdef CONFIG_SHELL
+static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
+{
+	int ret;
+
+	k_timeout_t duration = K_MSEC(strtoll(argv[1], NULL, 10));
+
+	ret = perf_start_internal(sh, strtoul(argv[2], NULL, 10), duration);
+	if (ret == -EINPROGRESS) {
+		shell_warn(sh, "Perf is running");
+		return ret;
+	} else if (ret == -ENOBUFS) {
+		shell_warn(sh, "Perf buffer is full");
+		return ret;
+	} else if (ret != 0) {
+		shell_error(sh, "Invalid frequency");
+		return ret;
+	}
+
+	shell_print(sh, "Enabled perf");
+
+	return 0;
+}
+
+static int cmd_perf_start(const struct shell *sh, size_t argc, char **argv)
+{
+	int ret;
+
+	ret = perf_start_internal(sh, strtoul(argv[1], NULL, 10), K_FOREVER);
+	if (ret == -EINPROGRESS) {
+		shell_warn(sh, "Perf is running");
+		return ret;
+	} else if (ret == -ENOBUFS) {
+		shell_warn(sh, "Perf buffer is full");
+		return ret;
+	} else if (ret != 0) {
+		shell_error(sh, "Invalid frequency");
+		return ret;
+	}
+
+	shell_print(sh, "Enabled perf");
+
+	return 0;
+}
+
+static int cmd_perf_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	if (perf_stop() != 0) {
+		shell_warn(sh, "Perf is not running");
+		return -EALREADY;
+	}
+
+	shell_print(sh, "Perf done!");
+
+	return 0;
+}
+
+static int cmd_perf_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	if (perf_clear() != 0) {
+		shell_warn(sh, "Perf is running");
+		return -EINPROGRESS;
+	}
+
+	shell_print(sh, "Perf buffer cleared");
 
 	return 0;
 }
 
 static int cmd_perf_info(const struct shell *sh, size_t argc, char **argv)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+	if (perf_is_running()) {
 		shell_print(sh, "Perf is running");
 	}
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	size_t used = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(perf_data.stacks); i++) {
+		used += (perf_data.stacks[i].hash != 0U) ? 1 : 0;
+	}
+
+	shell_print(sh, "Perf stacks: %zu/%d, dropped samples: %u", used,
+		    CONFIG_PROFILING_PERF_AGGREGATE_ENTRIES, perf_data.dropped);
+#else
 	shell_print(sh, "Perf buf: %zu/%d %s", perf_data.idx, CONFIG_PROFILING_PERF_BUFFER_SIZE,
 		    perf_data.buf_full ? "(full)" : "");
+#endif
 
 	return 0;
 }
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+static int perf_stack_print(k_tid_t thread, uint32_t count, const uintptr_t *trace,
+			    size_t length, void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	/* One line per stack trace: count, thread and return addresses */
+	shell_fprintf(sh, SHELL_NORMAL, "%08x %016lx", count, (uintptr_t)thread);
+	for (size_t i = 0; i < length; i++) {
+		shell_fprintf(sh, SHELL_NORMAL, " %016lx", trace[i]);
+	}
+	shell_fprintf(sh, SHELL_NORMAL, "\n");
+
+	return 0;
+}
+#endif
+
 static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+	if (perf_is_running()) {
 		shell_warn(sh, "Perf is running");
 		return -EINPROGRESS;
 	}
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	size_t used = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(perf_data.stacks); i++) {
+		used += (perf_data.stacks[i].hash != 0U) ? 1 : 0;
+	}
+
+	shell_print(sh, "Perf stacks %zu dropped %u", used, perf_data.dropped);
+	(void)perf_foreach_sample(perf_stack_print, (void *)sh);
+#else
 	shell_print(sh, "Perf buf length %zu", perf_data.idx);
 	for (size_t i = 0; i < perf_data.idx; i++) {
 		shell_print(sh, "%016lx", perf_data.buf[i]);
 	}
+#endif
 
-	cmd_perf_clear(NULL, 0, NULL);
+	(void)perf_clear();
 
 	return 0;
 }
@@ -146,11 +446,18 @@ static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 	"Start recording for <duration> ms on <frequency> Hz\n"                                    \
 	"Usage: record <duration> <frequency>"
 
+#define CMD_HELP_START                                                                             \
+	"Start recording on <frequency> Hz until stopped\n"                                        \
+	"Usage: start <frequency>"
+
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf,
 	SHELL_CMD_ARG(record, NULL, CMD_HELP_RECORD, cmd_perf_record, 3, 0),
+	SHELL_CMD_ARG(start, NULL, CMD_HELP_START, cmd_perf_start, 2, 0),
+	SHELL_CMD_ARG(stop, NULL, "Stop recording", cmd_perf_stop, 0, 0),
 	SHELL_CMD_ARG(printbuf, NULL, "Print the perf buffer", cmd_perf_print, 0, 0),
 	SHELL_CMD_ARG(clear, NULL, "Clear the perf buffer", cmd_perf_clear, 0, 0),
 	SHELL_CMD_ARG(info, NULL, "Print the perf info", cmd_perf_info, 0, 0),
 	SHELL_SUBCMD_SET_END
 );
 SHELL_CMD_ARG_REGISTER(perf, &m_sub_perf, "Lightweight profiler", NULL, 0, 0);
+#endif /* CONFIG_SHELL */
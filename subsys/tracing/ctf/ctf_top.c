@@ -14,6 +14,50 @@
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/debug/cpu_load.h>
+#include <tracing_core.h>
+
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Magic number starting each packet, see CTF 1.8 */
+#define CTF_PACKET_MAGIC 0xC1FC1FC1U
+
+/*
+ * Packet header and context of the per-CPU streams. They must be kept in sync
+ * with the declarations added to the metadata by scripts/tracing/parse_ctf.py.
+ */
+struct ctf_packet_header {
+	uint32_t magic;
+	uint8_t stream_instance_id;
+	uint32_t timestamp_begin;
+	uint32_t timestamp_end;
+	uint32_t content_size;
+	uint32_t packet_size;
+	uint8_t cpu_id;
+} __packed;
+
+static struct ctf_packet_header ctf_packet_header;
+
+uint32_t tracing_packet_header_get(unsigned int cpu, uint32_t content_size,
+				   uint32_t timestamp_begin, uint32_t timestamp_end,
+				   uint8_t **data)
+{
+	/* Sizes are given in bits and include the header. */
+	const uint32_t packet_size = (sizeof(ctf_packet_header) + content_size) * 8U;
+
+	ctf_packet_header = (struct ctf_packet_header) {
+		.magic = CTF_PACKET_MAGIC,
+		.stream_instance_id = (uint8_t)cpu,
+		.timestamp_begin = timestamp_begin,
+		.timestamp_end = timestamp_end,
+		.content_size = packet_size,
+		.packet_size = packet_size,
+		.cpu_id = (uint8_t)cpu,
+	};
+
+	*data = (uint8_t *)&ctf_packet_header;
+
+	return sizeof(ctf_packet_header);
+}
+#endif
 
 static void _get_thread_name(struct k_thread *thread,
 			     ctf_bounded_string_t *name)
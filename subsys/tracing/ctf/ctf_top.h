@@ -49,7 +49,20 @@
 		tracing_format_raw_data(epacket, sizeof(epacket));              \
 	}
 
-#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+/*
+ * Timestamp and emit with the local interrupts locked, so that the events of a
+ * CPU are put in its buffer in timestamp order.
+ */
+#define CTF_EVENT(...)                                                         \
+	{                                                                      \
+		const unsigned int ctf_key = arch_irq_lock();                  \
+		const uint32_t tstamp = k_cyc_to_ns_floor64(k_cycle_get_32()); \
+									       \
+		CTF_GATHER_FIELDS(tstamp, __VA_ARGS__)                         \
+		arch_irq_unlock(ctf_key);                                      \
+	}
+#elif defined(CONFIG_TRACING_CTF_TIMESTAMP)
 #define CTF_EVENT(...)                                                         \
 	{                                                                      \
 		const uint32_t tstamp = k_cyc_to_ns_floor64(k_cycle_get_32()); \
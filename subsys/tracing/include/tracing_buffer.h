@@ -15,7 +15,7 @@ extern "C" {
 #endif
 
 /**
- * @brief Initialize tracing buffer.
+ * @brief Initialize tracing buffer(s).
  */
 void tracing_buffer_init(void);
 
@@ -104,6 +104,51 @@ int tracing_buffer_get_finish(uint32_t size);
  */
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/*
+ * With CONFIG_TRACING_PER_CPU_BUFFERS, the functions above use the buffer of
+ * the current CPU and must be called with the interrupts locked. The tracing
+ * thread reads the buffers of all CPUs with the functions below.
+ */
+
+/**
+ * @brief Get number of bytes of valid data in the tracing buffer of a CPU.
+ *
+ * The data ends with the last put in the buffer, all data put later is
+ * timestamped after it.
+ *
+ * @param cpu CPU index.
+ * @param timestamp Pointer to the time of the last put.
+ *
+ * @return Valid data size (in bytes).
+ */
+uint32_t tracing_buffer_cpu_size_get(unsigned int cpu, uint32_t *timestamp);
+
+/**
+ * @brief Get address of the first valid data in the tracing buffer of a CPU.
+ *
+ * @param cpu CPU index.
+ * @param data Pointer to the address. It's set to a location pointing to
+ *             the first valid data within the tracing buffer.
+ * @param size Requested buffer size (in bytes).
+ *
+ * @return Size of valid buffer which can be smaller than requested
+ *         if there isn't enough valid data or buffer wraps.
+ */
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Indicate number of bytes read from claimed buffer of a CPU.
+ *
+ * @param cpu CPU index.
+ * @param size Number of bytes read from claimed buffer.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Given @a size exceeds available data of tracing buffer.
+ */
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size);
+#endif
+
 /**
  * @brief Get buffer from tracing command buffer.
  *
@@ -14,9 +14,16 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Each CPU has its own buffer, only the local interrupts need to be locked. */
+#define TRACING_LOCK()		{ unsigned int key; key = arch_irq_lock()
+
+#define TRACING_UNLOCK()	{ arch_irq_unlock(key); } }
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
@@ -53,6 +60,25 @@ void tracing_cmd_handle(uint8_t *buf, uint32_t length);
  */
 void tracing_trigger_output(bool before_put_is_empty);
 
+/**
+ * @brief Get header of the packet of a per-CPU stream.
+ *
+ * Provided by the tracing format when CONFIG_TRACING_PER_CPU_BUFFERS is
+ * enabled. The tracing thread outputs the header before the content of the
+ * buffer of the CPU.
+ *
+ * @param cpu CPU index.
+ * @param content_size Size of the content of the packet (in bytes).
+ * @param timestamp_begin Time of the beginning of the packet.
+ * @param timestamp_end Time of the end of the packet.
+ * @param data Pointer to the header address.
+ *
+ * @return Header size (in bytes).
+ */
+uint32_t tracing_packet_header_get(unsigned int cpu, uint32_t content_size,
+				   uint32_t timestamp_begin, uint32_t timestamp_end,
+				   uint8_t **data);
+
 /**
  * @brief Check if we are in tracing thread context.
  *
@@ -4,12 +4,75 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/ring_buffer.h>
+#include <tracing_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+#define TRACING_BUFFERS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define TRACING_BUFFERS 1
+#endif
+
+static struct ring_buf tracing_ring_buf[TRACING_BUFFERS];
+static uint8_t tracing_buffer[TRACING_BUFFERS][CONFIG_TRACING_BUFFER_SIZE + 1];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Total size of the data put in the buffer of a CPU and time of the last put,
+ * updated together under a sequence count. The tracing thread outputs the data
+ * up to the mark in a packet ending at its time, and the events put later are
+ * all timestamped after it.
+ */
+struct tracing_cpu_mark {
+	atomic_t seq;
+	uint32_t put_total;
+	uint32_t timestamp;
+};
+
+static struct tracing_cpu_mark tracing_cpu_marks[TRACING_BUFFERS];
+static uint32_t tracing_cpu_get_total[TRACING_BUFFERS];
+
+/* The buffers are only read from another CPU on SMP targets. */
+static inline void tracing_cpu_fence(void)
+{
+	if (IS_ENABLED(CONFIG_SMP)) {
+		barrier_dmem_fence_full();
+	} else {
+		compiler_barrier();
+	}
+}
+
+static void tracing_cpu_mark_update(uint32_t size)
+{
+	struct tracing_cpu_mark *mark = &tracing_cpu_marks[CPU_ID];
+
+	atomic_inc(&mark->seq);
+	tracing_cpu_fence();
+	mark->put_total += size;
+	/* Same clock as the CTF event timestamps. */
+	mark->timestamp = k_cyc_to_ns_floor64(k_cycle_get_32());
+	tracing_cpu_fence();
+	atomic_inc(&mark->seq);
+}
+#endif
+
+/* With per-CPU buffers, each buffer is only written by its CPU, with the
+ * interrupts locked, and only read by the tracing thread. Ring buffer indexes
+ * are then never updated concurrently and no lock is needed.
+ */
+static inline struct ring_buf *local_ring_buf(void)
+{
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	return &tracing_ring_buf[CPU_ID];
+#else
+	return &tracing_ring_buf[0];
+#endif
+}
+
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 {
 	*data = &tracing_cmd_buffer[0];
@@ -19,51 +82,126 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+	return ring_buf_put_claim(local_ring_buf(), data, size);
 }
 
 int tracing_buffer_put_finish(uint32_t size)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	int err;
+
+	/* Data must be visible to the tracing thread before the index. */
+	tracing_cpu_fence();
+
+	err = ring_buf_put_finish(local_ring_buf(), size);
+	if (err == 0 && size > 0) {
+		tracing_cpu_mark_update(size);
+	}
+
+	return err;
+#else
+	return ring_buf_put_finish(local_ring_buf(), size);
+#endif
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		uint32_t claimed_size, total_size = 0U;
+		uint8_t *buf;
+
+		do {
+			claimed_size = tracing_buffer_put_claim(&buf, size - total_size);
+			memcpy(buf, data + total_size, claimed_size);
+			total_size += claimed_size;
+		} while (total_size < size && claimed_size);
+
+		(void)tracing_buffer_put_finish(total_size);
+
+		return total_size;
+	}
+
+	return ring_buf_put(local_ring_buf(), data, size);
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+	return ring_buf_get_claim(local_ring_buf(), data, size);
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+	return ring_buf_get_finish(local_ring_buf(), size);
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	return ring_buf_get(local_ring_buf(), data, size);
 }
 
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	for (int i = 0; i < TRACING_BUFFERS; i++) {
+		ring_buf_init(&tracing_ring_buf[i],
+			      sizeof(tracing_buffer[i]), tracing_buffer[i]);
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+		tracing_cpu_marks[i].put_total = 0U;
+		tracing_cpu_get_total[i] = 0U;
+#endif
+	}
 }
 
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	return ring_buf_is_empty(local_ring_buf());
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return ring_buf_capacity_get(local_ring_buf());
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	return ring_buf_space_get(local_ring_buf());
+}
+
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+uint32_t tracing_buffer_cpu_size_get(unsigned int cpu, uint32_t *timestamp)
+{
+	struct tracing_cpu_mark *mark = &tracing_cpu_marks[cpu];
+	atomic_val_t seq;
+	uint32_t put_total;
+
+	do {
+		seq = atomic_get(&mark->seq);
+		tracing_cpu_fence();
+		put_total = mark->put_total;
+		*timestamp = mark->timestamp;
+		/* Data must not be read before the mark either. */
+		tracing_cpu_fence();
+	} while ((seq & 1) || (seq != atomic_get(&mark->seq)));
+
+	return put_total - tracing_cpu_get_total[cpu];
+}
+
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data, uint32_t size)
+{
+	return ring_buf_get_claim(&tracing_ring_buf[cpu], data, size);
+}
+
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size)
+{
+	int err;
+
+	/* Data must be read before the space is given back to the CPU. */
+	tracing_cpu_fence();
+
+	err = ring_buf_get_finish(&tracing_ring_buf[cpu], size);
+	if (err == 0) {
+		tracing_cpu_get_total[cpu] += size;
+	}
+
+	return err;
 }
+#endif
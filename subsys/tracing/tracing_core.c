@@ -54,6 +54,59 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+static uint32_t tracing_cpu_packet_end[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Output the content of the buffer of a CPU as a packet of its stream. */
+static bool tracing_cpu_buffer_flush(unsigned int cpu)
+{
+	uint8_t *transferring_buf;
+	uint32_t transferring_length, content_size, timestamp;
+
+	/* Only complete events are in the buffer, the packet does not split any. */
+	content_size = tracing_buffer_cpu_size_get(cpu, &timestamp);
+	if (content_size == 0) {
+		return false;
+	}
+
+	transferring_length =
+		tracing_packet_header_get(cpu, content_size,
+					  tracing_cpu_packet_end[cpu], timestamp,
+					  &transferring_buf);
+	tracing_cpu_packet_end[cpu] = timestamp;
+	tracing_buffer_handle(transferring_buf, transferring_length);
+
+	while (content_size > 0) {
+		transferring_length =
+			tracing_buffer_cpu_get_claim(cpu, &transferring_buf,
+						     content_size);
+		tracing_buffer_handle(transferring_buf, transferring_length);
+		tracing_buffer_cpu_get_finish(cpu, transferring_length);
+		content_size -= transferring_length;
+	}
+
+	return true;
+}
+
+static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
+{
+	bool flushed;
+
+	tracing_thread_tid = k_current_get();
+
+	while (true) {
+		flushed = false;
+
+		for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+			flushed |= tracing_cpu_buffer_flush(cpu);
+		}
+
+		if (!flushed) {
+			k_sem_take(&tracing_thread_sem, K_FOREVER);
+		}
+	}
+}
+#else
 static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
 	uint8_t *transferring_buf;
@@ -77,6 +130,7 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 		}
 	}
 }
+#endif
 
 static void tracing_thread_timer_expiry_fn(struct k_timer *timer)
 {
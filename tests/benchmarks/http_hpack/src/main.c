@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/http/hpack.h>
+
+/* HPACK benchmark. N_ROUNDS header blocks are encoded and decoded again, the
+ * time spent in the encoder and the decoder is reported separately, together
+ * with the size of the encoded data.
+ */
+
+#define N_ROUNDS 1000
+
+struct bench_header {
+	const char *name;
+	const char *value;
+};
+
+/* A typical request and response of a REST API */
+static const struct bench_header request[] = {
+	{ ":method", "GET" },
+	{ ":scheme", "https" },
+	{ ":authority", "device.example.com" },
+	{ ":path", "/api/v1/sensors/temperature" },
+	{ "user-agent", "Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101" },
+	{ "accept", "application/json" },
+	{ "accept-encoding", "gzip, deflate, br" },
+	{ "authorization", "Bearer 0123456789abcdef" },
+};
+
+static const struct bench_header response[] = {
+	{ ":status", "200" },
+	{ "content-type", "application/json" },
+	{ "content-length", "42" },
+	{ "cache-control", "no-cache" },
+	{ "server", "Zephyr" },
+	{ "access-control-allow-origin", "*" },
+};
+
+static uint8_t block[1024];
+
+static struct http_hpack_table encoder;
+static struct http_hpack_table decoder;
+static uint8_t encoder_data[CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE];
+static uint8_t decoder_data[CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE];
+
+struct bench_result {
+	uint64_t encode_cycles;
+	uint64_t decode_cycles;
+	size_t encoded_len;
+	size_t decoded_len;
+};
+
+static int encode_block(const struct bench_header *headers, size_t count,
+			struct http_hpack_table *table)
+{
+	size_t len = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		struct http_hpack_header_buf hdr = {
+			.name = headers[i].name,
+			.value = headers[i].value,
+			.name_len = strlen(headers[i].name),
+			.value_len = strlen(headers[i].value),
+		};
+		int ret;
+
+		ret = http_hpack_encode_header(block + len, sizeof(block) - len,
+					       &hdr, table);
+		if (ret < 0) {
+			return ret;
+		}
+
+		len += ret;
+	}
+
+	return len;
+}
+
+static int decode_block(size_t len, struct http_hpack_table *table)
+{
+	struct http_hpack_header_buf hdr;
+	size_t consumed = 0;
+	size_t decoded = 0;
+
+	while (consumed < len) {
+		int ret;
+
+		ret = http_hpack_decode_header(block + consumed, len - consumed,
+					       &hdr, table);
+		if (ret < 0) {
+			return ret;
+		}
+
+		consumed += ret;
+		decoded += hdr.name_len + hdr.value_len;
+	}
+
+	return decoded;
+}
+
+static int run(const struct bench_header *headers, size_t count,
+	       bool use_table, struct bench_result *result)
+{
+	struct http_hpack_table *enc_table = use_table ? &encoder : NULL;
+	struct http_hpack_table *dec_table = use_table ? &decoder : NULL;
+	timing_t start, end;
+	int len, ret;
+
+	memset(result, 0, sizeof(*result));
+
+	http_hpack_table_init(&encoder, encoder_data, sizeof(encoder_data),
+			      sizeof(encoder_data));
+	http_hpack_table_init(&decoder, decoder_data, sizeof(decoder_data),
+			      sizeof(decoder_data));
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		start = timing_counter_get();
+		len = encode_block(headers, count, enc_table);
+		end = timing_counter_get();
+
+		if (len < 0) {
+			printk("Cannot encode block %d (%d)\n", i, len);
+			return len;
+		}
+
+		result->encode_cycles += timing_cycles_get(&start, &end);
+		result->encoded_len += len;
+
+		start = timing_counter_get();
+		ret = decode_block(len, dec_table);
+		end = timing_counter_get();
+
+		if (ret < 0) {
+			printk("Cannot decode block %d (%d)\n", i, ret);
+			return ret;
+		}
+
+		result->decode_cycles += timing_cycles_get(&start, &end);
+		result->decoded_len += ret;
+	}
+
+	return 0;
+}
+
+static void report(const char *name, bool use_table, uint64_t cycles, size_t len)
+{
+	uint64_t us = timing_cycles_to_ns(cycles) / NSEC_PER_USEC;
+
+	printk("%s (%s table): %d blocks, %zu bytes in %llu us\n", name,
+	       use_table ? "dynamic" : "static", N_ROUNDS, len, us);
+}
+
+static void bench(const char *name, const struct bench_header *headers,
+		  size_t count)
+{
+	struct bench_result result;
+
+	printk("%s headers:\n", name);
+
+	for (int i = 0; i < 2; i++) {
+		bool use_table = (i == 1);
+
+		if (use_table && sizeof(encoder.data) == 0) {
+			break;
+		}
+
+		if (run(headers, count, use_table, &result) < 0) {
+			return;
+		}
+
+		report("encode", use_table, result.encode_cycles, result.encoded_len);
+		report("decode", use_table, result.decode_cycles, result.decoded_len);
+	}
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	bench("Request", request, ARRAY_SIZE(request));
+	bench("Response", response, ARRAY_SIZE(response));
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
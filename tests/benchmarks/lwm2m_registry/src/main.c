@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
+
+#include "lwm2m_engine.h"
+#include "lwm2m_object.h"
+#include "lwm2m_rw_senml_cbor.h"
+
+/* LwM2M registry benchmark. A test object with N_INSTANCES instances of
+ * N_RESOURCES resources each is registered, then the time spent resolving
+ * resource paths, iterating over the instances and reading the whole object
+ * tree in SenML CBOR format, an instance at a time and at once, is reported.
+ */
+
+#define BENCH_OBJ_ID 32769
+#define N_INSTANCES  256
+#define N_RESOURCES  8
+
+static struct lwm2m_engine_obj bench_obj;
+
+static struct lwm2m_engine_obj_field fields[N_RESOURCES] = {
+	OBJ_FIELD_DATA(0, RW, S32),
+	OBJ_FIELD_DATA(1, RW, S32),
+	OBJ_FIELD_DATA(2, RW, S32),
+	OBJ_FIELD_DATA(3, RW, S32),
+	OBJ_FIELD_DATA(4, RW, S32),
+	OBJ_FIELD_DATA(5, RW, S32),
+	OBJ_FIELD_DATA(6, RW, S32),
+	OBJ_FIELD_DATA(7, RW, S32),
+};
+
+static struct lwm2m_engine_obj_inst inst[N_INSTANCES];
+static struct lwm2m_engine_res res[N_INSTANCES][N_RESOURCES];
+static struct lwm2m_engine_res_inst res_inst[N_INSTANCES][N_RESOURCES];
+static int32_t values[N_INSTANCES][N_RESOURCES];
+
+static struct lwm2m_message msg;
+
+/* Large enough for the SenML CBOR encoding of the whole object */
+static uint8_t obj_buf[N_INSTANCES * N_RESOURCES * 12];
+
+static struct lwm2m_engine_obj_inst *bench_obj_create(uint16_t obj_inst_id)
+{
+	int i = 0, j = 0;
+
+	if (obj_inst_id >= N_INSTANCES) {
+		return NULL;
+	}
+
+	init_res_instance(res_inst[obj_inst_id], N_RESOURCES);
+
+	for (int r = 0; r < N_RESOURCES; r++) {
+		values[obj_inst_id][r] = obj_inst_id * N_RESOURCES + r;
+		INIT_OBJ_RES_DATA(r, res[obj_inst_id], i, res_inst[obj_inst_id], j,
+				  &values[obj_inst_id][r], sizeof(int32_t));
+	}
+
+	inst[obj_inst_id].resources = res[obj_inst_id];
+	inst[obj_inst_id].resource_count = i;
+
+	return &inst[obj_inst_id];
+}
+
+static int bench_obj_init(void)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+	int ret;
+
+	bench_obj.obj_id = BENCH_OBJ_ID;
+	bench_obj.version_major = 1;
+	bench_obj.version_minor = 0;
+	bench_obj.fields = fields;
+	bench_obj.field_count = ARRAY_SIZE(fields);
+	bench_obj.max_instance_count = N_INSTANCES;
+	bench_obj.create_cb = bench_obj_create;
+
+	lwm2m_register_obj(&bench_obj);
+
+	/* Create the instances in reverse order, as a worst case for lookups */
+	for (int i = N_INSTANCES - 1; i >= 0; i--) {
+		ret = lwm2m_create_obj_inst(BENCH_OBJ_ID, i, &obj_inst);
+		if (ret < 0) {
+			printk("Cannot create instance %d (%d)\n", i, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void report(const char *name, uint64_t cycles, int count, const char *unit)
+{
+	uint64_t us = timing_cycles_to_ns(cycles) / NSEC_PER_USEC;
+
+	printk("%s: %d %s in %llu us\n", name, count, unit, us);
+}
+
+static void bench_lookup(void)
+{
+	timing_t start, end;
+	int32_t value;
+	int ret;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_INSTANCES; i++) {
+		for (int r = 0; r < N_RESOURCES; r++) {
+			ret = lwm2m_get_s32(&LWM2M_OBJ(BENCH_OBJ_ID, i, r), &value);
+			if (ret < 0 || value != values[i][r]) {
+				printk("Cannot read %d/%d/%d (%d)\n", BENCH_OBJ_ID, i, r, ret);
+				return;
+			}
+		}
+	}
+
+	end = timing_counter_get();
+
+	report("lookup", timing_cycles_get(&start, &end), N_INSTANCES * N_RESOURCES,
+	       "resources");
+}
+
+static void bench_iterate(void)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+	timing_t start, end;
+	int count = 0;
+
+	start = timing_counter_get();
+
+	for (obj_inst = next_engine_obj_inst(BENCH_OBJ_ID, -1); obj_inst != NULL;
+	     obj_inst = next_engine_obj_inst(BENCH_OBJ_ID, obj_inst->obj_inst_id)) {
+		count++;
+	}
+
+	end = timing_counter_get();
+
+	report("iterate", timing_cycles_get(&start, &end), count, "instances");
+}
+
+static void bench_read(void)
+{
+	timing_t start, end;
+	uint64_t cycles = 0;
+	size_t len = 0;
+	int ret;
+
+	for (int i = 0; i < N_INSTANCES; i++) {
+		memset(&msg, 0, sizeof(msg));
+		msg.out.writer = &senml_cbor_writer;
+		msg.out.out_cpkt = &msg.cpkt;
+		msg.cpkt.data = msg.msg_data;
+		msg.cpkt.max_len = sizeof(msg.msg_data);
+		msg.path = LWM2M_OBJ(BENCH_OBJ_ID, i);
+
+		start = timing_counter_get();
+		ret = do_read_op_senml_cbor(&msg);
+		end = timing_counter_get();
+
+		if (ret < 0) {
+			printk("Cannot read instance %d (%d)\n", i, ret);
+			return;
+		}
+
+		cycles += timing_cycles_get(&start, &end);
+		len += msg.cpkt.offset;
+	}
+
+	printk("read: %d instances, %zu bytes in %llu us\n", N_INSTANCES, len,
+	       timing_cycles_to_ns(cycles) / NSEC_PER_USEC);
+}
+
+static void bench_read_object(void)
+{
+	timing_t start, end;
+	int ret;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.out.writer = &senml_cbor_writer;
+	msg.out.out_cpkt = &msg.cpkt;
+	msg.cpkt.data = obj_buf;
+	msg.cpkt.max_len = sizeof(obj_buf);
+	msg.path = LWM2M_OBJ(BENCH_OBJ_ID);
+
+	start = timing_counter_get();
+	ret = do_read_op_senml_cbor(&msg);
+	end = timing_counter_get();
+
+	if (ret < 0) {
+		printk("Cannot read object %d (%d)\n", BENCH_OBJ_ID, ret);
+		return;
+	}
+
+	printk("read object: %d records, %u bytes in %llu us\n", N_INSTANCES * N_RESOURCES,
+	       msg.cpkt.offset, timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC);
+}
+
+int main(void)
+{
+	if (bench_obj_init() < 0) {
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	bench_lookup();
+	bench_iterate();
+	bench_read();
+	bench_read_object();
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_chksum_bench, LOG_LEVEL_INF);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <string.h>
+
+#include "net_private.h"
+
+/* Internet checksum microbenchmark. Every routine is run N_RUNS times for
+ * each packet size and data alignment, and the average time is reported.
+ */
+
+#define N_RUNS 1000
+#define MAX_LEN 9000
+
+static const size_t lengths[] = { 20, 40, 64, 128, 576, 1280, 1500, 9000 };
+
+static uint8_t src_buf[MAX_LEN + 8] __aligned(8);
+static uint8_t dst_buf[MAX_LEN + 8] __aligned(8);
+
+/* Keep the compiler from optimizing the measured calls away */
+static volatile uint16_t result;
+
+static uint64_t avg_ns(timing_t start, timing_t end)
+{
+	uint64_t cycles = timing_cycles_get(&start, &end);
+
+	return timing_cycles_to_ns_avg(cycles, N_RUNS);
+}
+
+static void bench_chksum(size_t len, int align)
+{
+	timing_t start, end;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_RUNS; i++) {
+		result = calc_chksum(0, src_buf + align, len);
+	}
+
+	end = timing_counter_get();
+
+	printk("calc_chksum      len %4zu align %d: %6llu ns\n", len, align,
+	       avg_ns(start, end));
+}
+
+static void bench_chksum_copy(size_t len, int align)
+{
+	timing_t start, end;
+	uint64_t copy_ns;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_RUNS; i++) {
+		result = calc_chksum_copy(0, dst_buf + align, src_buf, len);
+	}
+
+	end = timing_counter_get();
+	copy_ns = avg_ns(start, end);
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_RUNS; i++) {
+		memcpy(dst_buf + align, src_buf, len);
+		result = calc_chksum(0, dst_buf + align, len);
+	}
+
+	end = timing_counter_get();
+
+	printk("calc_chksum_copy len %4zu align %d: %6llu ns (memcpy + sum %llu ns)\n",
+	       len, align, copy_ns, avg_ns(start, end));
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof(src_buf); i++) {
+		src_buf[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	timing_init();
+	timing_start();
+
+	for (size_t i = 0; i < ARRAY_SIZE(lengths); i++) {
+		for (int align = 0; align < 4; align++) {
+			bench_chksum(lengths[i], align);
+		}
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(lengths); i++) {
+		for (int align = 0; align < 4; align++) {
+			bench_chksum_copy(lengths[i], align);
+		}
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_forward_bench, LOG_LEVEL_INF);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+
+#include "net_private.h"
+#include "ipv6.h"
+#include "udp_internal.h"
+#include "route.h"
+
+/* IPv6 forwarding benchmark. N_PKTS UDP packets are received on the "in"
+ * interface and routed to the "out" interface, the time until the last one
+ * reaches the driver is reported.
+ */
+
+#define N_PKTS 10000
+#define PAYLOAD_LEN 64
+
+static struct in6_addr in_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 1, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr out_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 2, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 1, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+static struct in6_addr nexthop_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 2, 0, 0,
+					    0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+static struct in6_addr dst_prefix = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 3, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0 } } };
+
+static uint8_t nexthop_mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x02 };
+static uint8_t payload[PAYLOAD_LEN];
+
+static struct net_if *in_iface;
+static struct net_if *out_iface;
+
+static uint32_t forwarded;
+static K_SEM_DEFINE(done, 0, 1);
+
+static int fwd_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void fwd_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x00 };
+
+	mac[5]++;
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+	net_if_flag_set(iface, NET_IF_IPV6_NO_ND);
+}
+
+static int fwd_in_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static int fwd_out_send(const struct device *dev, struct net_pkt *pkt)
+{
+	if (++forwarded == N_PKTS) {
+		k_sem_give(&done);
+	}
+
+	return 0;
+}
+
+static struct dummy_api fwd_in_api = {
+	.iface_api.init = fwd_iface_init,
+	.send = fwd_in_send,
+};
+
+static struct dummy_api fwd_out_api = {
+	.iface_api.init = fwd_iface_init,
+	.send = fwd_out_send,
+};
+
+NET_DEVICE_INIT_INSTANCE(fwd_in, "fwd_in", 0, fwd_dev_init, NULL, NULL, NULL,
+			 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &fwd_in_api,
+			 DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV6_MTU);
+
+NET_DEVICE_INIT_INSTANCE(fwd_out, "fwd_out", 0, fwd_dev_init, NULL, NULL, NULL,
+			 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &fwd_out_api,
+			 DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV6_MTU);
+
+static int setup(void)
+{
+	struct net_linkaddr lladdr;
+	struct in6_addr dst = dst_prefix;
+
+	in_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	out_iface = in_iface + 1;
+
+	if (!net_if_ipv6_addr_add(in_iface, &in_addr, NET_ADDR_MANUAL, 0) ||
+	    !net_if_ipv6_addr_add(out_iface, &out_addr, NET_ADDR_MANUAL, 0)) {
+		printk("Cannot add addresses\n");
+		return -EINVAL;
+	}
+
+	(void)net_linkaddr_set(&lladdr, nexthop_mac, sizeof(nexthop_mac));
+
+	if (!net_ipv6_nbr_add(out_iface, &nexthop_addr, &lladdr, false,
+			      NET_IPV6_NBR_STATE_STATIC)) {
+		printk("Cannot add neighbor\n");
+		return -EINVAL;
+	}
+
+	if (!net_route_add(out_iface, &dst_prefix, 64, &nexthop_addr,
+			   NET_IPV6_ND_INFINITE_LIFETIME,
+			   NET_ROUTE_PREFERENCE_MEDIUM)) {
+		printk("Cannot add route\n");
+		return -EINVAL;
+	}
+
+	/* Warm up the route lookup */
+	dst.s6_addr[15] = 1;
+	(void)net_route_lookup(NULL, &dst);
+
+	return 0;
+}
+
+static int inject(int i)
+{
+	struct in6_addr dst = dst_prefix;
+	struct net_pkt *pkt;
+
+	/* Spread the packets over a few destinations */
+	dst.s6_addr[15] = 1 + (i & 0x7);
+
+	pkt = net_pkt_rx_alloc_with_buffer(in_iface, NET_IPV6UDPH_LEN + PAYLOAD_LEN,
+					   AF_INET6, IPPROTO_UDP, K_FOREVER);
+	if (!pkt) {
+		return -ENOMEM;
+	}
+
+	if (net_ipv6_create(pkt, &peer_addr, &dst) ||
+	    net_udp_create(pkt, htons(4242), htons(4242)) ||
+	    net_pkt_write(pkt, payload, sizeof(payload))) {
+		net_pkt_unref(pkt);
+		return -EINVAL;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_ipv6_finalize(pkt, IPPROTO_UDP)) {
+		net_pkt_unref(pkt);
+		return -EINVAL;
+	}
+
+	if (net_recv_data(in_iface, pkt) < 0) {
+		net_pkt_unref(pkt);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	timing_t start, end;
+	uint64_t us;
+
+	if (setup() < 0) {
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_PKTS; i++) {
+		if (inject(i) < 0) {
+			printk("Cannot inject packet %d\n", i);
+			return 0;
+		}
+	}
+
+	k_sem_take(&done, K_FOREVER);
+
+	end = timing_counter_get();
+	us = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC;
+
+	timing_stop();
+
+	printk("forwarded %d packets of %d bytes in %llu us: %llu pps\n",
+	       N_PKTS, NET_IPV6UDPH_LEN + PAYLOAD_LEN, us,
+	       us ? (uint64_t)N_PKTS * USEC_PER_SEC / us : 0);
+
+	printk("fin\n");
+
+	return 0;
+}
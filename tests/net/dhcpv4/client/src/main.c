@@ -211,7 +211,12 @@ static const unsigned char ack[420] = {
 };
 
 static const struct in_addr server_addr = { { { 192, 0, 2, 1 } } };
+#if defined(DHCPV4_TEST_UNICAST)
+/* Server replies unicast to the offered address (yiaddr) */
+static const struct in_addr client_addr = { { { 10, 237, 72, 158 } } };
+#else
 static const struct in_addr client_addr = { { { 255, 255, 255, 255 } } };
+#endif
 
 #define SERVER_PORT		67
 #define CLIENT_PORT		68
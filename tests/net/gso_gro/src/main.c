@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_gso_gro_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <net_private.h>
+#include <connection.h>
+#include <ipv4.h>
+#include <ipv6.h>
+#include <tcp_internal.h>
+
+#define ALLOC_TIMEOUT K_MSEC(100)
+
+#define TEST_MSS 536U
+#define TEST_IPV4_ID 0x1234U
+#define TEST_SEQ 1000U
+#define TEST_ACK 5000U
+#define MY_PORT 4242U
+#define PEER_PORT 5353U
+
+#define MAX_SEGMENTS 8
+
+/* 192.0.2.1 and 192.0.2.2 */
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+/* 2001:db8::1 and 2001:db8::2 */
+static struct in6_addr my_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct net_if *test_iface;
+
+static uint8_t test_data[4 * TEST_MSS];
+
+/* Segments captured by the driver or received by the connection handler */
+struct test_segment {
+	size_t payload_len;
+	uint32_t seq;
+	uint16_t ipv4_id;
+	uint8_t flags;
+	bool ip_chksum_ok;
+	bool tcp_chksum_ok;
+	bool gro;
+};
+
+static struct test_segment segments[MAX_SEGMENTS];
+static uint8_t payload[sizeof(test_data)];
+static size_t segment_count;
+
+static void test_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[6] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+/* Record a segment and copy its payload at its sequence number */
+static void segment_record(struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct test_segment *seg = &segments[segment_count];
+	struct net_tcp_hdr *tcp_hdr;
+	size_t ip_len, hdr_len;
+	uint32_t offset;
+
+	zassert_true(segment_count < MAX_SEGMENTS, "Too many segments");
+
+	if (net_pkt_family(pkt) == AF_INET) {
+		ip_len = ntohs(NET_IPV4_HDR(pkt)->len);
+		seg->ipv4_id = sys_get_be16(NET_IPV4_HDR(pkt)->id);
+		seg->ip_chksum_ok = net_calc_chksum_ipv4(pkt) == 0U;
+	} else {
+		ip_len = ntohs(NET_IPV6_HDR(pkt)->len) + sizeof(struct net_ipv6_hdr);
+		seg->ip_chksum_ok = true;
+	}
+
+	zassert_equal(ip_len, net_pkt_get_len(pkt), "IP length mismatch");
+
+	seg->tcp_chksum_ok = net_calc_chksum_tcp(pkt) == 0U;
+	seg->gro = net_pkt_is_gro(pkt);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	zassert_ok(net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+				net_pkt_ip_opts_len(pkt)), "Cannot skip IP header");
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	zassert_not_null(tcp_hdr, "No TCP header");
+
+	seg->seq = sys_get_be32(tcp_hdr->seq);
+	seg->flags = tcp_hdr->flags;
+	hdr_len = (tcp_hdr->offset >> 4) * 4U;
+	seg->payload_len = ip_len - net_pkt_ip_hdr_len(pkt) -
+			   net_pkt_ip_opts_len(pkt) - hdr_len;
+
+	offset = seg->seq - TEST_SEQ;
+	zassert_true(offset + seg->payload_len <= sizeof(payload),
+		     "Segment out of range");
+
+	zassert_ok(net_pkt_skip(pkt, hdr_len), "Cannot skip TCP header");
+	zassert_ok(net_pkt_read(pkt, &payload[offset], seg->payload_len),
+		   "Cannot read payload");
+
+	segment_count++;
+}
+
+static int test_iface_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+
+	segment_record(pkt);
+
+	return 0;
+}
+
+static struct dummy_api test_iface_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_iface_send,
+};
+
+NET_DEVICE_INIT(net_gso_gro_test, "net_gso_gro_test", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &test_iface_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV4_MTU);
+
+static enum net_verdict tcp_data_received(struct net_conn *conn,
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  union net_proto_header *proto_hdr,
+					  void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	segment_record(pkt);
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+/* Create a TCP packet from the peer, or to the peer if outgoing is set */
+static struct net_pkt *prepare_tcp_pkt(sa_family_t family, bool outgoing,
+				       uint32_t seq, uint8_t flags,
+				       const uint8_t *data, size_t len)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *pkt;
+	int ret;
+
+	/* The payload of a super-packet can be larger than the MTU */
+	pkt = net_pkt_alloc_with_buffer(test_iface, sizeof(struct net_tcp_hdr),
+					family, IPPROTO_TCP, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_alloc_buffer_raw(pkt, len, ALLOC_TIMEOUT),
+		   "Cannot allocate payload");
+
+	if (family == AF_INET) {
+		ret = net_ipv4_create(pkt, outgoing ? &my_addr : &peer_addr,
+				      outgoing ? &peer_addr : &my_addr);
+	} else {
+		ret = net_ipv6_create(pkt, outgoing ? &my_addr6 : &peer_addr6,
+				      outgoing ? &peer_addr6 : &my_addr6);
+	}
+
+	zassert_ok(ret, "Cannot create IP header");
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	zassert_not_null(tcp_hdr, "Cannot get TCP header");
+
+	memset(tcp_hdr, 0, sizeof(*tcp_hdr));
+	tcp_hdr->src_port = htons(outgoing ? MY_PORT : PEER_PORT);
+	tcp_hdr->dst_port = htons(outgoing ? PEER_PORT : MY_PORT);
+	sys_put_be32(seq, tcp_hdr->seq);
+	sys_put_be32(TEST_ACK, tcp_hdr->ack);
+	tcp_hdr->offset = (sizeof(*tcp_hdr) / 4U) << 4;
+	tcp_hdr->flags = flags;
+	sys_put_be16(8192U, tcp_hdr->wnd);
+
+	zassert_ok(net_pkt_set_data(pkt, &tcp_access), "Cannot set TCP header");
+	zassert_ok(net_pkt_write(pkt, data, len), "Cannot write payload");
+
+	net_pkt_cursor_init(pkt);
+
+	if (family == AF_INET) {
+		sys_put_be16(TEST_IPV4_ID, NET_IPV4_HDR(pkt)->id);
+		ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	} else {
+		ret = net_ipv6_finalize(pkt, IPPROTO_TCP);
+	}
+
+	zassert_ok(ret, "Cannot finalize packet");
+
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void check_gso(sa_family_t family, size_t len)
+{
+	size_t expected = DIV_ROUND_UP(len, TEST_MSS);
+	struct net_pkt *pkt;
+	size_t hdr_len;
+	int ret;
+
+	pkt = prepare_tcp_pkt(family, true, TEST_SEQ, PSH | ACK, test_data, len);
+	net_pkt_set_gso_size(pkt, TEST_MSS);
+	hdr_len = net_pkt_ip_hdr_len(pkt) + sizeof(struct net_tcp_hdr);
+
+	/* The super-packet is consumed when something was sent */
+	ret = net_gso_send(test_iface, pkt);
+	zassert_equal(ret, len + expected * hdr_len,
+		      "Unexpected number of bytes sent (%d)", ret);
+	zassert_equal(segment_count, expected, "Expected %zu segments, got %zu",
+		      expected, segment_count);
+
+	for (size_t i = 0; i < segment_count; i++) {
+		bool last = (i == segment_count - 1U);
+
+		zassert_equal(segments[i].payload_len,
+			      last ? len - i * TEST_MSS : TEST_MSS,
+			      "Wrong size of segment %zu", i);
+		zassert_equal(segments[i].seq, TEST_SEQ + i * TEST_MSS,
+			      "Wrong sequence number of segment %zu", i);
+		zassert_equal(segments[i].flags, last ? (PSH | ACK) : ACK,
+			      "Wrong flags of segment %zu", i);
+		zassert_true(segments[i].ip_chksum_ok,
+			     "Wrong IP checksum of segment %zu", i);
+		zassert_true(segments[i].tcp_chksum_ok,
+			     "Wrong TCP checksum of segment %zu", i);
+
+		if (family == AF_INET) {
+			zassert_equal(segments[i].ipv4_id, TEST_IPV4_ID + i,
+				      "Wrong IPv4 ID of segment %zu", i);
+		}
+	}
+
+	zassert_mem_equal(payload, test_data, len, "Payload mismatch");
+}
+
+ZTEST(net_gso_gro, test_gso_ipv4)
+{
+	check_gso(AF_INET, 3 * TEST_MSS + 100U);
+}
+
+ZTEST(net_gso_gro, test_gso_ipv6)
+{
+	check_gso(AF_INET6, 2 * TEST_MSS);
+}
+
+/* A super-packet to our own address is looped back without being split */
+static void check_gso_loopback(sa_family_t family, size_t len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	/* Loopback swaps the addresses, the ports are those of the peer */
+	pkt = prepare_tcp_pkt(family, false, TEST_SEQ, PSH | ACK, test_data, len);
+	net_pkt_set_gso_size(pkt, TEST_MSS);
+
+	/* Finalize again as done by TCP, which leaves the TCP checksum of the
+	 * super-packet to the segmentation.
+	 */
+	if (family == AF_INET) {
+		net_ipv4_addr_copy_raw(NET_IPV4_HDR(pkt)->src, (uint8_t *)&my_addr);
+		ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	} else {
+		net_ipv6_addr_copy_raw(NET_IPV6_HDR(pkt)->src, (uint8_t *)&my_addr6);
+		ret = net_ipv6_finalize(pkt, IPPROTO_TCP);
+	}
+
+	zassert_ok(ret, "Cannot finalize packet");
+	net_pkt_cursor_init(pkt);
+
+	zassert_ok(net_send_data(pkt), "Cannot send packet");
+
+	zassert_equal(segment_count, 1, "Expected one looped back packet");
+	zassert_equal(segments[0].payload_len, len, "Packet was split");
+	zassert_equal(segments[0].seq, TEST_SEQ, "Wrong sequence number");
+	zassert_true(segments[0].ip_chksum_ok, "Wrong IP checksum");
+	zassert_true(segments[0].tcp_chksum_ok, "Wrong TCP checksum");
+	zassert_mem_equal(payload, test_data, len, "Payload mismatch");
+}
+
+ZTEST(net_gso_gro, test_gso_loopback_ipv4)
+{
+	check_gso_loopback(AF_INET, 3 * TEST_MSS + 100U);
+}
+
+ZTEST(net_gso_gro, test_gso_loopback_ipv6)
+{
+	check_gso_loopback(AF_INET6, 2 * TEST_MSS);
+}
+
+/* Pass a data segment of the peer at offset of the test data to GRO */
+static enum net_verdict gro_receive(struct net_gro *gro, sa_family_t family,
+				    size_t offset, size_t len, uint8_t flags)
+{
+	struct net_pkt *pkt;
+	enum net_verdict verdict;
+
+	pkt = prepare_tcp_pkt(family, false, TEST_SEQ + offset, flags,
+			      &test_data[offset], len);
+
+	verdict = net_gro_receive(gro, pkt, false);
+	if (verdict == NET_CONTINUE) {
+		/* Not held, passed as is to the IP input by the caller */
+		net_pkt_unref(pkt);
+	}
+
+	return verdict;
+}
+
+static void check_gro_merge(sa_family_t family)
+{
+	struct net_gro gro = { 0 };
+
+	zassert_equal(gro_receive(&gro, family, 0, 100U, ACK), NET_OK,
+		      "First segment not held");
+	zassert_equal(gro_receive(&gro, family, 100U, 200U, ACK), NET_OK,
+		      "Second segment not merged");
+	zassert_equal(segment_count, 0, "Segments passed before the flush");
+
+	/* PSH ends the merge and flushes the coalesced packet */
+	zassert_equal(gro_receive(&gro, family, 300U, 50U, PSH | ACK), NET_OK,
+		      "Third segment not merged");
+	zassert_is_null(gro.pkt, "Packet still held after PSH");
+
+	zassert_equal(segment_count, 1, "Expected one coalesced packet");
+	zassert_equal(segments[0].payload_len, 350U, "Wrong coalesced size");
+	zassert_equal(segments[0].seq, TEST_SEQ, "Wrong sequence number");
+	zassert_equal(segments[0].flags, PSH | ACK, "Wrong flags");
+	zassert_true(segments[0].ip_chksum_ok, "Wrong IP checksum");
+	zassert_true(segments[0].gro, "Packet not marked as coalesced");
+	zassert_mem_equal(payload, test_data, 350U, "Payload mismatch");
+}
+
+ZTEST(net_gso_gro, test_gro_merge_ipv4)
+{
+	check_gro_merge(AF_INET);
+}
+
+ZTEST(net_gso_gro, test_gro_merge_ipv6)
+{
+	check_gro_merge(AF_INET6);
+}
+
+ZTEST(net_gso_gro, test_gro_flush)
+{
+	struct net_gro gro = { 0 };
+
+	zassert_equal(gro_receive(&gro, AF_INET, 0, 100U, ACK), NET_OK,
+		      "First segment not held");
+
+	/* A gap in the sequence numbers flushes the held packet */
+	zassert_equal(gro_receive(&gro, AF_INET, 200U, 100U, ACK), NET_OK,
+		      "Segment after the gap not held");
+	zassert_equal(segment_count, 1, "Held packet not flushed on a gap");
+	zassert_equal(segments[0].payload_len, 100U, "Wrong size");
+	zassert_false(segments[0].gro, "Single segment marked as coalesced");
+	zassert_true(segments[0].tcp_chksum_ok, "Wrong TCP checksum");
+
+	/* Segments which change the connection state are never held */
+	zassert_equal(gro_receive(&gro, AF_INET, 300U, 100U, FIN | ACK),
+		      NET_CONTINUE, "FIN segment held");
+	zassert_is_null(gro.pkt, "Packet still held after FIN");
+	zassert_equal(segment_count, 2, "Held packet not flushed on FIN");
+	zassert_equal(segments[1].seq, TEST_SEQ + 200U, "Wrong segment flushed");
+
+	/* Explicit flush, as done when the RX queue runs empty */
+	zassert_equal(gro_receive(&gro, AF_INET, 400U, 100U, ACK), NET_OK,
+		      "Segment not held");
+	net_gro_flush(&gro);
+	zassert_is_null(gro.pkt, "Packet still held after flush");
+	zassert_equal(segment_count, 3, "Held packet not flushed");
+	zassert_equal(segments[2].seq, TEST_SEQ + 400U, "Wrong segment flushed");
+}
+
+ZTEST(net_gso_gro, test_gro_max_segments)
+{
+	struct net_gro gro = { 0 };
+	size_t offset = 0;
+
+	for (int i = 0; i < CONFIG_NET_TCP_GRO_MAX_SEGMENTS; i++) {
+		zassert_equal(gro_receive(&gro, AF_INET, offset, 100U, ACK), NET_OK,
+			      "Segment %d not held", i);
+		offset += 100U;
+	}
+
+	zassert_is_null(gro.pkt, "Packet still held at the segment limit");
+	zassert_equal(segment_count, 1, "Expected one coalesced packet");
+	zassert_equal(segments[0].payload_len, offset, "Wrong coalesced size");
+	zassert_mem_equal(payload, test_data, offset, "Payload mismatch");
+}
+
+static void *test_setup(void)
+{
+	struct net_conn_handle *handle;
+	int ret;
+
+	test_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(test_iface, "Interface not available");
+
+	zassert_not_null(net_if_ipv4_addr_add(test_iface, &my_addr,
+					      NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv4 address");
+	zassert_not_null(net_if_ipv6_addr_add(test_iface, &my_addr6,
+					      NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv6 address");
+
+	ret = net_conn_register(IPPROTO_TCP, SOCK_STREAM, AF_INET, NULL, NULL,
+				PEER_PORT, MY_PORT, NULL,
+				tcp_data_received, NULL, &handle);
+	zassert_ok(ret, "Cannot register IPv4 TCP handler");
+
+	ret = net_conn_register(IPPROTO_TCP, SOCK_STREAM, AF_INET6, NULL, NULL,
+				PEER_PORT, MY_PORT, NULL,
+				tcp_data_received, NULL, &handle);
+	zassert_ok(ret, "Cannot register IPv6 TCP handler");
+
+	for (size_t i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = (uint8_t)(i * 7U);
+	}
+
+	return NULL;
+}
+
+static void test_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(segments, 0, sizeof(segments));
+	memset(payload, 0, sizeof(payload));
+	segment_count = 0;
+}
+
+ZTEST_SUITE(net_gso_gro, NULL, test_setup, test_before, NULL, NULL);
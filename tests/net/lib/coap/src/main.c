@@ -1282,6 +1282,33 @@ ZTEST(coap, test_build_options_out_of_order_1)
 	zassert_equal(cpkt.offset, 52, "Wrong data size");
 }
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+static struct coap_option_index test_opt_index[16];
+
+/* Verify the option index against the options parsed from the packet data */
+static void assert_option_index(const struct coap_packet *cpkt)
+{
+	struct coap_option_index expected[ARRAY_SIZE(test_opt_index)];
+	struct coap_packet parsed = *cpkt;
+	int r;
+
+	if (cpkt->opt_index == NULL) {
+		return;
+	}
+
+	r = coap_packet_set_option_index(&parsed, expected, ARRAY_SIZE(expected));
+	zassert_equal(r, 0, "Could not index options");
+	zassert_equal(parsed.opt_index_len, cpkt->opt_index_len, "Wrong index length");
+	zassert_mem_equal(expected, cpkt->opt_index, parsed.opt_index_len * sizeof(expected[0]),
+			  "Wrong index");
+}
+#else
+static void assert_option_index(const struct coap_packet *cpkt)
+{
+	ARG_UNUSED(cpkt);
+}
+#endif
+
 #define ASSERT_OPTIONS_AND_PAYLOAD(cpkt, expected_opt_len, expected_data, expected_offset,         \
 				   expected_delta)                                                 \
 	do {                                                                                       \
@@ -1293,6 +1320,7 @@ ZTEST(coap, test_build_options_out_of_order_1)
 		zassert_equal(expected_offset, cpkt.offset, "Wrong offset");                       \
 		zassert_mem_equal(expected_data, cpkt.data, expected_offset, "Wrong data");        \
 		zassert_equal(expected_delta, cpkt.delta, "Wrong delta");                          \
+		assert_option_index(&cpkt);                                                        \
 	} while (0)
 
 static void init_basic_test_msg(struct coap_packet *cpkt, uint8_t *data)
@@ -1311,6 +1339,11 @@ static void init_basic_test_msg(struct coap_packet *cpkt, uint8_t *data)
 			     strlen(token), token, COAP_METHOD_POST, 0x1234);
 	zassert_equal(r, 0, "Could not initialize packet");
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	r = coap_packet_set_option_index(cpkt, test_opt_index, ARRAY_SIZE(test_opt_index));
+	zassert_equal(r, 0, "Could not set option index");
+#endif
+
 	r = coap_append_option_int(cpkt, COAP_OPTION_SIZE2,
 				   coap_block_size_to_bytes(COAP_BLOCK_128));
 	zassert_equal(r, 0, "Could not append option");
@@ -1628,6 +1661,67 @@ ZTEST(coap, test_remove_non_existent_coap_option)
 	ASSERT_OPTIONS_AND_PAYLOAD(cpkt, 4, expected_original_msg, 18, 17);
 }
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+ZTEST(coap, test_option_index)
+{
+	static const uint16_t codes[] = {
+		COAP_OPTION_URI_HOST, COAP_OPTION_OBSERVE, COAP_OPTION_URI_PORT,
+		COAP_OPTION_URI_PATH, COAP_OPTION_CONTENT_FORMAT, COAP_OPTION_MAX_AGE,
+		COAP_OPTION_URI_QUERY, COAP_OPTION_ACCEPT, COAP_OPTION_SIZE2,
+		COAP_OPTION_SIZE1, COAP_OPTION_ETAG, COAP_OPTION_BLOCK2,
+	};
+	struct coap_option_index opt_index[16];
+	struct coap_option options[4];
+	struct coap_option expected[4];
+	struct coap_packet cpkt;
+	struct coap_packet plain;
+	uint8_t *data = data_buf[0];
+	int r;
+
+	init_basic_test_msg(&cpkt, data);
+
+	r = coap_packet_parse_indexed(&cpkt, data, cpkt.offset, NULL, 0,
+				      opt_index, ARRAY_SIZE(opt_index));
+	zassert_equal(r, 0, "Could not parse packet");
+	assert_option_index(&cpkt);
+
+	r = coap_packet_parse(&plain, data, cpkt.offset, NULL, 0);
+	zassert_equal(r, 0, "Could not parse packet");
+
+	/* Indexed lookups return the same options as parsing the whole packet */
+	ARRAY_FOR_EACH(codes, i) {
+		int num = coap_find_options(&plain, codes[i], expected, ARRAY_SIZE(expected));
+
+		r = coap_find_options(&cpkt, codes[i], options, ARRAY_SIZE(options));
+		zassert_equal(r, num, "Wrong number of options %u", codes[i]);
+
+		for (int j = 0; j < num; j++) {
+			zassert_equal(options[j].delta, expected[j].delta, "Wrong option number");
+			zassert_equal(options[j].len, expected[j].len, "Wrong option length");
+			zassert_mem_equal(options[j].value, expected[j].value, expected[j].len,
+					  "Wrong option value");
+		}
+	}
+
+	/* A single entry is enough for one option only */
+	r = coap_find_options(&cpkt, COAP_OPTION_URI_QUERY, options, 1);
+	zassert_equal(r, 1, "Wrong number of options");
+	zassert_mem_equal(options[0].value, "query0", options[0].len, "Wrong option value");
+
+	/* Packets with more options than index entries are parsed, but not indexed */
+	r = coap_packet_parse_indexed(&cpkt, data, plain.offset, NULL, 0, opt_index, 4);
+	zassert_equal(r, 0, "Could not parse packet");
+	zassert_is_null(cpkt.opt_index, "Options should not be indexed");
+
+	r = coap_find_options(&cpkt, COAP_OPTION_SIZE1, options, ARRAY_SIZE(options));
+	zassert_equal(r, 1, "Wrong number of options");
+	zassert_equal(coap_option_value_to_int(&options[0]), 64, "Wrong option value");
+
+	r = coap_packet_set_option_index(&cpkt, opt_index, 4);
+	zassert_equal(r, -ENOMEM, "Options should not fit in the index");
+}
+#endif /* CONFIG_COAP_OPTION_INDEX */
+
 static void assert_coap_packet_set_path_query_options(const char *path,
 						      const char * const *expected,
 						      size_t expected_len, uint16_t code)
@@ -1840,6 +1934,86 @@ ZTEST(coap, test_notify_age)
 	coap_remove_observer(resource, observer);
 }
 
+static int build_notification(struct coap_packet *cpkt, uint8_t *data, uint8_t tkl,
+			      const uint8_t *token, uint16_t id, int age)
+{
+	static const uint8_t payload[] = "22.5";
+	int r;
+
+	r = coap_packet_init(cpkt, data, COAP_BUF_SIZE, COAP_VERSION_1, COAP_TYPE_NON_CON,
+			     tkl, token, COAP_RESPONSE_CODE_CONTENT, id);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_append_option_int(cpkt, COAP_OPTION_OBSERVE, age);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_append_option_int(cpkt, COAP_OPTION_CONTENT_FORMAT,
+				   COAP_CONTENT_FORMAT_TEXT_PLAIN);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_append_payload_marker(cpkt);
+	if (r < 0) {
+		return r;
+	}
+
+	return coap_packet_append_payload(cpkt, payload, sizeof(payload) - 1);
+}
+
+ZTEST(coap, test_notification_shared)
+{
+	struct coap_resource *resource = &server_resources[0];
+	struct coap_observer observers[] = {
+		{ .token = { 't', 'o', 'k', 'e', 'n' }, .tkl = 5 },
+		{ .token = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 }, .tkl = 8 },
+		{ .tkl = 0 },
+	};
+	uint8_t hdr[COAP_TOKEN_MAX_LEN + 4];
+	uint8_t msg[COAP_BUF_SIZE];
+	struct coap_packet notification;
+	struct coap_packet expected;
+	int r;
+
+	resource->age = 10;
+
+	r = coap_notification_init(&notification, resource, data_buf[0], COAP_BUF_SIZE,
+				   COAP_TYPE_NON_CON, COAP_RESPONSE_CODE_CONTENT);
+	zassert_equal(r, 0, "Could not initialize notification");
+	zassert_equal(resource->age, 11, "Resource age not incremented");
+
+	r = coap_append_option_int(&notification, COAP_OPTION_CONTENT_FORMAT,
+				   COAP_CONTENT_FORMAT_TEXT_PLAIN);
+	zassert_equal(r, 0, "Could not append option");
+	r = coap_packet_append_payload_marker(&notification);
+	zassert_equal(r, 0, "Could not append payload marker");
+	r = coap_packet_append_payload(&notification, "22.5", 4);
+	zassert_equal(r, 0, "Could not append payload");
+
+	ARRAY_FOR_EACH_PTR(observers, observer) {
+		uint16_t id = 0x1234 + observer->tkl;
+		size_t body_len = notification.offset - notification.hdr_len;
+
+		r = build_notification(&expected, data_buf[1], observer->tkl, observer->token,
+				       id, resource->age);
+		zassert_equal(r, 0, "Could not build reference notification");
+
+		r = coap_notification_header(&notification, observer, id, hdr, sizeof(hdr));
+		zassert_equal(r, 4 + observer->tkl, "Wrong header length");
+
+		memcpy(msg, hdr, r);
+		memcpy(msg + r, notification.data + notification.hdr_len, body_len);
+
+		zassert_equal(r + body_len, expected.offset, "Wrong notification length");
+		zassert_mem_equal(msg, expected.data, expected.offset,
+				  "Notification differs from the reference");
+	}
+}
+
 ZTEST(coap, test_age_is_newer)
 {
 	for (int i = COAP_FIRST_AGE; i < COAP_MAX_AGE; ++i) {
@@ -8,6 +8,7 @@
 
 #include <zephyr/ztest.h>
 #include <zephyr/net/coap_service.h>
+#include <zephyr/net/socket.h>
 
 static int coap_method1(struct coap_resource *resource, struct coap_packet *request,
 			struct sockaddr *addr, socklen_t addr_len)
@@ -318,4 +319,88 @@ ZTEST(coap_service, test_COAP_RESOURCE_DEFINE)
 	}
 }
 
+#define OBSERVER_PORT 5684
+
+static void register_observer(struct coap_resource *resource, const uint8_t *token,
+			      uint8_t tkl, struct sockaddr *addr)
+{
+	uint8_t buf[32];
+	struct coap_packet request;
+
+	zassert_ok(coap_packet_init(&request, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_CON,
+				    tkl, token, COAP_METHOD_GET, coap_next_id()));
+	zassert_ok(coap_append_option_int(&request, COAP_OPTION_OBSERVE, 0));
+	zassert_ok(coap_resource_parse_observe(resource, &request, addr));
+}
+
+ZTEST(coap_service, test_coap_resource_send_notification)
+{
+	static const uint8_t tokens[][4] = {
+		{ 0x01, 0x02, 0x03, 0x04 },
+		{ 0xaa, 0xbb },
+	};
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(OBSERVER_PORT),
+		.sin6_addr = IN6ADDR_LOOPBACK_INIT,
+	};
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	struct coap_packet notification;
+	uint16_t ids[ARRAY_SIZE(tokens)];
+	const uint8_t *payload;
+	uint16_t payload_len;
+	uint8_t buf[64];
+	int sock;
+	int ret;
+
+	ret = coap_service_start(&service_A);
+	zassert_true(ret == 0 || ret == -EALREADY, "Failed to start service (%d) %d", ret, errno);
+
+	sock = zsock_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "Failed to create socket (%d)", errno);
+	zassert_ok(zsock_bind(sock, (struct sockaddr *)&addr, sizeof(addr)));
+
+	register_observer(&resource_0, tokens[0], 4, (struct sockaddr *)&addr);
+	register_observer(&resource_0, tokens[1], 2, (struct sockaddr *)&addr);
+
+	zassert_ok(coap_notification_init(&notification, &resource_0, buf, sizeof(buf),
+					  COAP_TYPE_NON_CON, COAP_RESPONSE_CODE_CONTENT));
+	zassert_ok(coap_packet_append_payload_marker(&notification));
+	zassert_ok(coap_packet_append_payload(&notification, "42", 2));
+
+	ret = coap_resource_send_notification(&resource_0, &notification, NULL);
+	zassert_equal(ret, ARRAY_SIZE(tokens), "Wrong number of observers notified (%d)", ret);
+
+	/* Observers are notified in registration order */
+	ARRAY_FOR_EACH(tokens, i) {
+		struct zsock_pollfd pfd = { .fd = sock, .events = ZSOCK_POLLIN };
+		struct coap_packet received;
+
+		zassert_equal(zsock_poll(&pfd, 1, 1000), 1, "Notification %zu not received", i);
+
+		ret = zsock_recv(sock, buf, sizeof(buf), 0);
+		zassert_true(ret > 0, "Notification %zu not received (%d)", i, errno);
+		zassert_ok(coap_packet_parse(&received, buf, ret, NULL, 0));
+
+		zassert_equal(coap_header_get_token(&received, token), i == 0 ? 4 : 2);
+		zassert_mem_equal(token, tokens[i], i == 0 ? 4 : 2);
+		zassert_equal(coap_header_get_type(&received), COAP_TYPE_NON_CON);
+		zassert_equal(coap_header_get_code(&received), COAP_RESPONSE_CODE_CONTENT);
+		zassert_equal(coap_get_option_int(&received, COAP_OPTION_OBSERVE), resource_0.age);
+
+		payload = coap_packet_get_payload(&received, &payload_len);
+		zassert_equal(payload_len, 2);
+		zassert_mem_equal(payload, "42", 2);
+
+		ids[i] = coap_header_get_id(&received);
+	}
+
+	zassert_not_equal(ids[0], ids[1], "Message IDs must differ");
+
+	zassert_ok(coap_resource_remove_observer_by_token(&resource_0, tokens[0], 4));
+	zassert_ok(coap_resource_remove_observer_by_token(&resource_0, tokens[1], 2));
+
+	zassert_ok(zsock_close(sock));
+}
+
 ZTEST_SUITE(coap_service, NULL, NULL, NULL, NULL, NULL);
@@ -174,3 +174,80 @@ ZTEST(net_dns_cache_test, test_only_expected_type_returned)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type_b, &info_read, 1));
 	zassert_equal(AF_INET6, info_read.ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find_negative(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA));
+	zassert_equal(0, dns_cache_find_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					&info_read, 1));
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find_negative(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA));
+}
+
+ZTEST(net_dns_cache_test, test_stats)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	struct dns_resolve_cache_stats before, after;
+	const char *query = "example.com";
+
+	dns_cache_stats_get(&test_dns_cache, &before);
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, "example.org", DNS_QUERY_TYPE_A,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					&info_read, 1));
+	zassert_equal(1, dns_cache_find_negative(&test_dns_cache, "example.org",
+						 DNS_QUERY_TYPE_A));
+
+	dns_cache_stats_get(&test_dns_cache, &after);
+
+	zassert_equal(before.hits + 1, after.hits);
+	zassert_equal(before.misses + 1, after.misses);
+	zassert_equal(before.negative_hits + 1, after.negative_hits);
+}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+ZTEST(net_dns_cache_test, test_refresh_due)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+
+	for (int i = 0; i < CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS; i++) {
+		zassert_equal(1, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+						&info_read, 1));
+	}
+
+	/* Not yet close enough to the expiry */
+	zassert_false(dns_cache_refresh_due(&test_dns_cache, query, DNS_QUERY_TYPE_A));
+
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 10 *
+		       (100 - CONFIG_DNS_RESOLVER_CACHE_PREFETCH_THRESHOLD) + 1));
+
+	zassert_true(dns_cache_refresh_due(&test_dns_cache, query, DNS_QUERY_TYPE_A));
+	/* A single refresh is requested */
+	zassert_false(dns_cache_refresh_due(&test_dns_cache, query, DNS_QUERY_TYPE_A));
+
+	/* The entry is still served until the answer replaces it */
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+	zassert_false(dns_cache_refresh_due(&test_dns_cache, query, DNS_QUERY_TYPE_A));
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
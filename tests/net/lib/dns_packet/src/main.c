@@ -1230,6 +1230,82 @@ ZTEST(dns_packet, test_dns_malformed_and_valid_responses)
 	test_dns_valid_responses();
 }
 
+static void run_dns_negative_response(const char *test_case, uint8_t *buf,
+				      size_t len, bool negative)
+{
+	static const uint8_t query[] = {
+		/* Labels */
+		0x03, 0x77, 0x77, 0x77, 0x0d, 0x7a, 0x65, 0x70,
+		0x68, 0x79, 0x72, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+		0x63, 0x74, 0x03, 0x6f, 0x72, 0x67, 0x00,
+		/* Query type */
+		0x00, 0x01
+	};
+	struct dns_msg_t dns_msg = { 0 };
+	uint16_t dns_id = 0x0102;
+	int query_idx = -1;
+	uint16_t query_hash = 0;
+	int ret;
+
+	dns_msg.msg = buf;
+	dns_msg.msg_size = len;
+
+	setup_dns_context(&dns_ctx, 0, dns_id, query, sizeof(query),
+			  DNS_QUERY_TYPE_A);
+
+	ret = dns_validate_msg(&dns_ctx, &dns_msg, &dns_id, &query_idx,
+			       NULL, &query_hash);
+	if (negative) {
+		zassert_equal(ret, DNS_EAI_NODATA,
+			      "[%s] Negative response not recognized (%d)",
+			      test_case, ret);
+	} else {
+		zassert_not_equal(ret, DNS_EAI_NODATA,
+				  "[%s] Malformed response taken as negative",
+				  test_case);
+	}
+}
+
+ZTEST(dns_packet, test_dns_negative_response)
+{
+	static const uint8_t nxdomain[] = {
+		/* DNS msg header (12 bytes), QR, RD, RA, NXDOMAIN */
+		0x01, 0x02, 0x81, 0x83, 0x00, 0x01, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00,
+		/* Query string (www.zephyrproject.org) */
+		0x03, 0x77, 0x77, 0x77, 0x0d, 0x7a, 0x65, 0x70,
+		0x68, 0x79, 0x72, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+		0x63, 0x74, 0x03, 0x6f, 0x72, 0x67, 0x00,
+		/* Type and class */
+		0x00, 0x01, 0x00, 0x01,
+	};
+	uint8_t buf[sizeof(nxdomain)];
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_DNS_RESOLVER_CACHE);
+
+	memcpy(buf, nxdomain, sizeof(buf));
+	run_dns_negative_response("nxdomain", buf, sizeof(buf), true);
+
+	/* Shorter than the header, the counters must not be read */
+	memcpy(buf, nxdomain, sizeof(buf));
+	run_dns_negative_response("short", buf, 8, false);
+
+	/* Z bit set */
+	memcpy(buf, nxdomain, sizeof(buf));
+	buf[3] |= 0x40;
+	run_dns_negative_response("z_bit", buf, sizeof(buf), false);
+
+	/* Not a standard query (opcode 2, status) */
+	memcpy(buf, nxdomain, sizeof(buf));
+	buf[2] |= 0x10;
+	run_dns_negative_response("opcode", buf, sizeof(buf), false);
+
+	/* No question */
+	memcpy(buf, nxdomain, sizeof(buf));
+	buf[5] = 0x00;
+	run_dns_negative_response("qdcount", buf, sizeof(buf), false);
+}
+
 ZTEST(dns_packet, test_dns_id_len)
 {
 	struct dns_msg_t dns_msg = { 0 };
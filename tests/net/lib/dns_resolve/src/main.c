@@ -442,6 +442,10 @@ ZTEST(dns_resolve, test_dns_query_too_many)
 	int expected_status = DNS_EAI_CANCELED;
 	int ret;
 
+	if (CONFIG_DNS_NUM_CONCUR_QUERIES > 1) {
+		ztest_test_skip();
+	}
+
 	timeout_query = true;
 
 	ret = dns_get_addr_info(NAME4,
@@ -582,6 +586,81 @@ ZTEST(dns_resolve, test_dns_query_ipv6_cancel)
 	verify_cancelled();
 }
 
+#if defined(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)
+static int coalesced_status[2];
+static int coalesced_calls[2];
+
+static void dns_result_cb_coalesced(enum dns_resolve_status status,
+				    struct dns_addrinfo *info,
+				    void *user_data)
+{
+	int idx = POINTER_TO_INT(user_data);
+
+	coalesced_status[idx] = status;
+	coalesced_calls[idx]++;
+}
+#endif
+
+ZTEST(dns_resolve, test_dns_query_coalesced_cancel)
+{
+#if defined(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)
+	struct dns_resolve_context *ctx = dns_resolve_get_default();
+	uint16_t dns_id1, dns_id2;
+	int ret, i, pending = 0;
+
+	if (CONFIG_DNS_NUM_CONCUR_QUERIES < 2) {
+		ztest_test_skip();
+	}
+
+	timeout_query = true;
+	memset(coalesced_status, 0, sizeof(coalesced_status));
+	memset(coalesced_calls, 0, sizeof(coalesced_calls));
+
+	ret = dns_get_addr_info(NAME4, DNS_QUERY_TYPE_A, &dns_id1,
+				dns_result_cb_coalesced, INT_TO_POINTER(0),
+				DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot create IPv4 query");
+
+	ret = dns_get_addr_info(NAME4, DNS_QUERY_TYPE_A, &dns_id2,
+				dns_result_cb_coalesced, INT_TO_POINTER(1),
+				DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot join IPv4 query");
+	zassert_not_equal(dns_id1, dns_id2, "Joined query has the same id");
+
+	/* Cancelling the sent query must not end the joined lookup */
+	ret = dns_cancel_addr_info(dns_id1);
+	zassert_equal(ret, 0, "Cannot cancel IPv4 query");
+
+	zassert_equal(coalesced_calls[0], 1, "Canceller not notified");
+	zassert_equal(coalesced_status[0], DNS_EAI_CANCELED, "Invalid status");
+	zassert_equal(coalesced_calls[1], 0, "Joined lookup was notified");
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (k_work_delayable_busy_get(&ctx->queries[i].timer) != 0) {
+			pending++;
+		}
+	}
+
+	zassert_equal(pending, 1, "Sent query is no longer pending");
+
+	ret = dns_cancel_addr_info(dns_id1);
+	zassert_equal(ret, -ENOENT, "Cancelled query cancelled twice");
+
+	ret = dns_cancel_addr_info(dns_id2);
+	zassert_equal(ret, 0, "Cannot cancel joined IPv4 query");
+
+	zassert_equal(coalesced_calls[0], 1, "Canceller notified twice");
+	zassert_equal(coalesced_calls[1], 1, "Joined lookup not notified");
+	zassert_equal(coalesced_status[1], DNS_EAI_CANCELED, "Invalid status");
+
+	verify_cancelled();
+
+	timeout_query = false;
+#else
+	ztest_test_skip();
+#endif
+}
+
 struct expected_status {
 	int status1;
 	int status2;
@@ -85,6 +85,36 @@ static uint16_t service_E_port = 8080;
 HTTP_SERVICE_DEFINE(service_E, "192.0.2.1", &service_E_port, 1, 1, NULL, DETAIL(0));
 HTTP_RESOURCE_DEFINE(resource_10, service_E, "/index.html", RES(4));
 
+/*
+ * Resources sharing path prefixes, mixed with wildcards, for the lookup
+ * order tests. Resources are sorted by name, so the numbering gives the
+ * definition order.
+ */
+static struct http_resource_detail route_detail[] = {
+	[0 ... 7] = {
+		.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+	},
+	[8] = {
+		.type = HTTP_RESOURCE_TYPE_WEBSOCKET,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+	},
+};
+
+#define ROUTE(n) &route_detail[n]
+
+static uint16_t service_F_port = 8081;
+HTTP_SERVICE_DEFINE(service_F, "198.51.100.1", &service_F_port, 1, 1, NULL, NULL);
+HTTP_RESOURCE_DEFINE(route_0, service_F, "/docs/*", ROUTE(0));
+HTTP_RESOURCE_DEFINE(route_1, service_F, "/api/v1/users", ROUTE(1));
+HTTP_RESOURCE_DEFINE(route_2, service_F, "/api/v1/users/me", ROUTE(2));
+HTTP_RESOURCE_DEFINE(route_3, service_F, "/api/v1/items", ROUTE(3));
+HTTP_RESOURCE_DEFINE(route_4, service_F, "/api/v2", ROUTE(4));
+HTTP_RESOURCE_DEFINE(route_5, service_F, "/api/*", ROUTE(5));
+HTTP_RESOURCE_DEFINE(route_6, service_F, "/api/v1/items", ROUTE(6));
+HTTP_RESOURCE_DEFINE(route_7, service_F, "/docs/index.html", ROUTE(7));
+HTTP_RESOURCE_DEFINE(route_8, service_F, "/api/v1/users", ROUTE(8));
+
 ZTEST(http_service, test_HTTP_SERVICE_DEFINE)
 {
 	zassert_ok(strcmp(service_A.host, "a.service.com"));
@@ -117,7 +147,7 @@ ZTEST(http_service, test_HTTP_SERVICE_COUNT)
 
 	n_svc = 4273;
 	HTTP_SERVICE_COUNT(&n_svc);
-	zassert_equal(n_svc, 5);
+	zassert_equal(n_svc, 6);
 }
 
 ZTEST(http_service, test_HTTP_SERVICE_RESOURCE_COUNT)
@@ -135,6 +165,7 @@ ZTEST(http_service, test_HTTP_SERVICE_FOREACH)
 	size_t have_service_C = 0;
 	size_t have_service_D = 0;
 	size_t have_service_E = 0;
+	size_t have_service_F = 0;
 
 	HTTP_SERVICE_FOREACH(svc) {
 		if (svc == &service_A) {
@@ -147,6 +178,8 @@ ZTEST(http_service, test_HTTP_SERVICE_FOREACH)
 			have_service_D = 1;
 		} else if (svc == &service_E) {
 			have_service_E = 1;
+		} else if (svc == &service_F) {
+			have_service_F = 1;
 		} else {
 			zassert_unreachable("svc (%p) not equal to any defined service", svc);
 		}
@@ -154,12 +187,13 @@ ZTEST(http_service, test_HTTP_SERVICE_FOREACH)
 		n_svc++;
 	}
 
-	zassert_equal(n_svc, 5);
+	zassert_equal(n_svc, 6);
 	zassert_equal(have_service_A, 1);
 	zassert_equal(have_service_B, 1);
 	zassert_equal(have_service_C, 1);
 	zassert_equal(have_service_D, 1);
 	zassert_equal(have_service_E, 1);
+	zassert_equal(have_service_F, 1);
 }
 
 ZTEST(http_service, test_HTTP_RESOURCE_FOREACH)
@@ -421,6 +455,73 @@ ZTEST(http_service, test_HTTP_RESOURCE_DEFAULT)
 	zassert_equal(res, RES(0), "Resource mismatch");
 }
 
+#define CHECK_WS_PATH(svc, path, len) ({ *len = 0; get_resource_detail(&svc, path, len, true); })
+
+ZTEST(http_service, test_HTTP_RESOURCE_LOOKUP_ORDER)
+{
+	struct http_resource_detail *res;
+	int len;
+
+	/* Exact match, also with a query string */
+	res = CHECK_PATH(service_F, "/api/v1/users", &len);
+	zassert_equal(res, ROUTE(1), "Resource mismatch");
+	zassert_equal(len, strlen("/api/v1/users"), "Length incorrect");
+
+	res = CHECK_PATH(service_F, "/api/v1/users?id=1", &len);
+	zassert_equal(res, ROUTE(1), "Resource mismatch");
+	zassert_equal(len, strlen("/api/v1/users"), "Length incorrect");
+
+	/* The shorter resource is defined first and matches as a leading directory */
+	res = CHECK_PATH(service_F, "/api/v1/users/me", &len);
+	zassert_equal(res, ROUTE(1), "Resource mismatch");
+	zassert_equal(len, strlen("/api/v1/users/me"), "Length incorrect");
+
+	res = CHECK_PATH(service_F, "/api/v2/status", &len);
+	zassert_equal(res, ROUTE(4), "Resource mismatch");
+
+	/* The first of two identical resources wins */
+	res = CHECK_PATH(service_F, "/api/v1/items", &len);
+	zassert_equal(res, ROUTE(3), "Resource mismatch");
+
+	/* Prefixes of exact resources fall back to the wildcard */
+	res = CHECK_PATH(service_F, "/api/v1/user", &len);
+	zassert_equal(res, ROUTE(5), "Resource mismatch");
+
+	res = CHECK_PATH(service_F, "/api/v1/itemsx", &len);
+	zassert_equal(res, ROUTE(5), "Resource mismatch");
+
+	res = CHECK_PATH(service_F, "/api/v3?v=2", &len);
+	zassert_equal(res, ROUTE(5), "Resource mismatch");
+	zassert_equal(len, strlen("/api/v3"), "Length incorrect");
+
+	/* A wildcard defined before an exact resource takes precedence */
+	res = CHECK_PATH(service_F, "/docs/index.html", &len);
+	zassert_equal(res, ROUTE(0), "Resource mismatch");
+
+	res = CHECK_PATH(service_F, "/docs", &len);
+	zassert_is_null(res, "Resource found");
+	zassert_equal(len, 0, "Length set");
+
+	res = CHECK_PATH(service_F, "/ap", &len);
+	zassert_is_null(res, "Resource found");
+
+	/* Websocket resources are looked up separately */
+	res = CHECK_WS_PATH(service_F, "/api/v1/users", &len);
+	zassert_equal(res, ROUTE(8), "Resource mismatch");
+
+	res = CHECK_WS_PATH(service_F, "/api/v1/items", &len);
+	zassert_is_null(res, "Resource found");
+
+#if defined(CONFIG_HTTP_SERVER_ROUTE_TRIE)
+	/* The trie of service_F does not fit in a pool of 4 nodes, check that
+	 * the trie was used when it fits and the linear lookup otherwise.
+	 */
+	zassert_equal(service_F.data->route_state,
+		      CONFIG_HTTP_SERVER_ROUTE_TRIE_NODES > 4 ? 1 : -1,
+		      "Unexpected trie state");
+#endif
+}
+
 extern void http_server_get_content_type_from_extension(char *url, char *content_type,
 							size_t content_type_size);
 
@@ -632,7 +632,7 @@ static void expect_contains_header(const uint8_t *buffer, size_t len,
 	size_t consumed = 0;
 
 	while (consumed < len) {
-		ret = http_hpack_decode_header(buffer + consumed, len, &header_buf);
+		ret = http_hpack_decode_header(buffer + consumed, len, &header_buf, NULL);
 		zassert_true(ret >= 0, "Failed to decode header");
 		zassert_true(consumed + ret <= len, "Frame length exceeded");
 
@@ -1242,6 +1242,103 @@ ZTEST(server_function_tests, test_http1_connection_close)
 	zassert_equal(ret, 0, "Connection should've been closed");
 }
 
+static int test_connect_client(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	struct timeval optval = {
+		.tv_sec = TIMEOUT_S,
+		.tv_usec = 0,
+	};
+	int fd;
+	int ret;
+
+	ret = zsock_inet_pton(AF_INET, SERVER_IPV4_ADDR, &sa.sin_addr.s_addr);
+	zassert_equal(ret, 1, "inet_pton() failed to convert %s", SERVER_IPV4_ADDR);
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(fd >= 0, "Failed to create client socket (%d)", errno);
+
+	ret = zsock_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &optval, sizeof(optval));
+	zassert_ok(ret, "Failed to set timeout (%d)", errno);
+
+	ret = zsock_connect(fd, (struct sockaddr *)&sa, sizeof(sa));
+	zassert_ok(ret, "Failed to connect (%d)", errno);
+
+	return fd;
+}
+
+static void test_recv_response(int fd, const char *expected, size_t len)
+{
+	uint8_t response[128];
+	size_t offset = 0;
+	int ret;
+
+	zassert_true(len <= sizeof(response), "Response buffer too small");
+
+	while (offset < len) {
+		ret = zsock_recv(fd, response + offset, len - offset, 0);
+		zassert_true(ret > 0, "recv() failed (%d)", errno);
+		offset += ret;
+	}
+
+	zassert_mem_equal(response, expected, len,
+			  "Received data doesn't match expected response");
+}
+
+/* While one client is in the middle of a request, the connections are handed
+ * over between the server thread and the workers. Check that the sockets are
+ * still polled correctly, so that no request is lost or handled twice.
+ */
+ZTEST(server_function_tests, test_http1_interleaved_clients)
+{
+	static const char http1_request[] =
+		"GET / HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"User-Agent: curl/7.68.0\r\n"
+		"Accept: */*\r\n"
+		"Accept-Encoding: deflate, gzip, br\r\n"
+		"\r\n";
+	static const char expected_response[] =
+		"HTTP/1.1 200 OK\r\n"
+		"Content-Type: text/html\r\n"
+		"Content-Length: 13\r\n"
+		"\r\n"
+		TEST_STATIC_PAYLOAD;
+	const size_t split = strlen(http1_request) / 2;
+	int other_fd;
+	int ret;
+
+	other_fd = test_connect_client();
+
+	for (int i = 0; i < 5; i++) {
+		/* Leave a partial request pending on the other client */
+		ret = zsock_send(other_fd, http1_request, split, 0);
+		zassert_equal(ret, split, "send() failed (%d)", errno);
+
+		ret = zsock_send(client_fd, http1_request, strlen(http1_request), 0);
+		zassert_equal(ret, strlen(http1_request), "send() failed (%d)", errno);
+
+		test_recv_response(client_fd, expected_response, sizeof(expected_response) - 1);
+
+		ret = zsock_send(other_fd, http1_request + split,
+				 strlen(http1_request) - split, 0);
+		zassert_equal(ret, strlen(http1_request) - split, "send() failed (%d)", errno);
+
+		/* Both clients request at the same time */
+		ret = zsock_send(client_fd, http1_request, strlen(http1_request), 0);
+		zassert_equal(ret, strlen(http1_request), "send() failed (%d)", errno);
+
+		test_recv_response(other_fd, expected_response, sizeof(expected_response) - 1);
+		test_recv_response(client_fd, expected_response, sizeof(expected_response) - 1);
+	}
+
+	ret = zsock_close(other_fd);
+	zassert_ok(ret, "close() failed (%d)", errno);
+}
+
 ZTEST(server_function_tests, test_http2_post_data_with_padding)
 {
 	static const uint8_t request_post_dynamic[] = {
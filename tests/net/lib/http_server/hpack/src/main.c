@@ -257,7 +257,7 @@ static void test_hpack_verify_encode(const struct example_headers *example,
 		};
 		int ret;
 
-		ret = http_hpack_encode_header(test_buf, sizeof(test_buf), &hdr);
+		ret = http_hpack_encode_header(test_buf, sizeof(test_buf), &hdr, NULL);
 		zassert_equal(ret, example[i].encoded_len, "Wrong encoding length");
 		zassert_mem_equal(test_buf, example[i].encoded, ret,
 				  "Header wrongly decoded");
@@ -271,7 +271,8 @@ static void test_hpack_verify_decode(const struct example_headers *example,
 		struct http_hpack_header_buf hdr;
 		int ret;
 
-		ret = http_hpack_decode_header(example[i].encoded, example[i].encoded_len, &hdr);
+		ret = http_hpack_decode_header(example[i].encoded, example[i].encoded_len, &hdr,
+					       NULL);
 		zassert_equal(ret, example[i].encoded_len, "Wrong decoding length");
 		zassert_equal(hdr.name_len, strlen(example[i].name),
 			      "Wrong decoded header name length");
@@ -494,4 +495,248 @@ ZTEST(http2_hpack, test_http2_hpack_literal_not_indexed_decode)
 				 ARRAY_SIZE(test_enc_literal_not_indexed_headers));
 }
 
+struct example_header_block {
+	uint8_t encoded[100];
+	uint8_t encoded_len;
+	const char *headers[6][2];
+	uint8_t num_headers;
+	uint16_t table_size;
+};
+
+/* Request examples from RFC7541, C.3 and C.4. */
+static const struct example_header_block test_requests[] = {
+	{ { 0x82, 0x86, 0x84, 0x41, 0x0f, 0x77, 0x77, 0x77,
+	    0x2e, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65,
+	    0x2e, 0x63, 0x6f, 0x6d },
+	  20,
+	  { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" },
+	    { ":authority", "www.example.com" } },
+	  4, 57 },
+	{ { 0x82, 0x86, 0x84, 0xbe, 0x58, 0x08, 0x6e, 0x6f,
+	    0x2d, 0x63, 0x61, 0x63, 0x68, 0x65 },
+	  14,
+	  { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" },
+	    { ":authority", "www.example.com" }, { "cache-control", "no-cache" } },
+	  5, 110 },
+	{ { 0x82, 0x87, 0x85, 0xbf, 0x40, 0x0a, 0x63, 0x75,
+	    0x73, 0x74, 0x6f, 0x6d, 0x2d, 0x6b, 0x65, 0x79,
+	    0x0c, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d, 0x2d,
+	    0x76, 0x61, 0x6c, 0x75, 0x65 },
+	  29,
+	  { { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" },
+	    { ":authority", "www.example.com" }, { "custom-key", "custom-value" } },
+	  5, 164 },
+};
+
+static const struct example_header_block test_requests_huffman[] = {
+	{ { 0x82, 0x86, 0x84, 0x41, 0x8c, 0xf1, 0xe3, 0xc2,
+	    0xe5, 0xf2, 0x3a, 0x6b, 0xa0, 0xab, 0x90, 0xf4,
+	    0xff },
+	  17,
+	  { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" },
+	    { ":authority", "www.example.com" } },
+	  4, 57 },
+	{ { 0x82, 0x86, 0x84, 0xbe, 0x58, 0x86, 0xa8, 0xeb,
+	    0x10, 0x64, 0x9c, 0xbf },
+	  12,
+	  { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" },
+	    { ":authority", "www.example.com" }, { "cache-control", "no-cache" } },
+	  5, 110 },
+	{ { 0x82, 0x87, 0x85, 0xbf, 0x40, 0x88, 0x25, 0xa8,
+	    0x49, 0xe9, 0x5b, 0xa9, 0x7d, 0x7f, 0x89, 0x25,
+	    0xa8, 0x49, 0xe9, 0x5b, 0xb8, 0xe8, 0xb4, 0xbf },
+	  24,
+	  { { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" },
+	    { ":authority", "www.example.com" }, { "custom-key", "custom-value" } },
+	  5, 164 },
+};
+
+/* Response examples from RFC7541, C.5. The table is limited to 256 bytes, so
+ * entries are evicted.
+ */
+static const struct example_header_block test_responses[] = {
+	{ { 0x48, 0x03, 0x33, 0x30, 0x32, 0x58, 0x07, 0x70,
+	    0x72, 0x69, 0x76, 0x61, 0x74, 0x65, 0x61, 0x1d,
+	    0x4d, 0x6f, 0x6e, 0x2c, 0x20, 0x32, 0x31, 0x20,
+	    0x4f, 0x63, 0x74, 0x20, 0x32, 0x30, 0x31, 0x33,
+	    0x20, 0x32, 0x30, 0x3a, 0x31, 0x33, 0x3a, 0x32,
+	    0x31, 0x20, 0x47, 0x4d, 0x54, 0x6e, 0x17, 0x68,
+	    0x74, 0x74, 0x70, 0x73, 0x3a, 0x2f, 0x2f, 0x77,
+	    0x77, 0x77, 0x2e, 0x65, 0x78, 0x61, 0x6d, 0x70,
+	    0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d },
+	  70,
+	  { { ":status", "302" }, { "cache-control", "private" },
+	    { "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+	    { "location", "https://www.example.com" } },
+	  4, 222 },
+	{ { 0x48, 0x03, 0x33, 0x30, 0x37, 0xc1, 0xc0, 0xbf },
+	  8,
+	  { { ":status", "307" }, { "cache-control", "private" },
+	    { "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+	    { "location", "https://www.example.com" } },
+	  4, 222 },
+	{ { 0x88, 0xc1, 0x61, 0x1d, 0x4d, 0x6f, 0x6e, 0x2c,
+	    0x20, 0x32, 0x31, 0x20, 0x4f, 0x63, 0x74, 0x20,
+	    0x32, 0x30, 0x31, 0x33, 0x20, 0x32, 0x30, 0x3a,
+	    0x31, 0x33, 0x3a, 0x32, 0x32, 0x20, 0x47, 0x4d,
+	    0x54, 0xc0, 0x5a, 0x04, 0x67, 0x7a, 0x69, 0x70,
+	    0x77, 0x38, 0x66, 0x6f, 0x6f, 0x3d, 0x41, 0x53,
+	    0x44, 0x4a, 0x4b, 0x48, 0x51, 0x4b, 0x42, 0x5a,
+	    0x58, 0x4f, 0x51, 0x57, 0x45, 0x4f, 0x50, 0x49,
+	    0x55, 0x41, 0x58, 0x51, 0x57, 0x45, 0x4f, 0x49,
+	    0x55, 0x3b, 0x20, 0x6d, 0x61, 0x78, 0x2d, 0x61,
+	    0x67, 0x65, 0x3d, 0x33, 0x36, 0x30, 0x30, 0x3b,
+	    0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e,
+	    0x3d, 0x31 },
+	  98,
+	  { { ":status", "200" }, { "cache-control", "private" },
+	    { "date", "Mon, 21 Oct 2013 20:13:22 GMT" },
+	    { "location", "https://www.example.com" },
+	    { "content-encoding", "gzip" },
+	    { "set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1" } },
+	  6, 215 },
+};
+
+static struct http_hpack_table test_table;
+static uint8_t test_table_data[HTTP_HPACK_DEFAULT_TABLE_SIZE];
+
+static void test_hpack_verify_decode_blocks(const struct example_header_block *example,
+					    size_t num_examples)
+{
+	for (int i = 0; i < num_examples; i++) {
+		const uint8_t *buf = example[i].encoded;
+		size_t len = example[i].encoded_len;
+
+		for (int j = 0; j < example[i].num_headers; j++) {
+			struct http_hpack_header_buf hdr;
+			int ret;
+
+			ret = http_hpack_decode_header(buf, len, &hdr, &test_table);
+			zassert_true(ret > 0, "Failed to decode header");
+			zassert_equal(hdr.name_len, strlen(example[i].headers[j][0]),
+				      "Wrong decoded header name length");
+			zassert_equal(hdr.value_len, strlen(example[i].headers[j][1]),
+				      "Wrong decoded header value length");
+			zassert_mem_equal(hdr.name, example[i].headers[j][0], hdr.name_len,
+					  "Header name wrongly decoded");
+			zassert_mem_equal(hdr.value, example[i].headers[j][1], hdr.value_len,
+					  "Header value wrongly decoded");
+
+			buf += ret;
+			len -= ret;
+		}
+
+		zassert_equal(len, 0, "Header block not fully decoded");
+		zassert_equal(test_table.size, example[i].table_size,
+			      "Wrong dynamic table size");
+	}
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_decode)
+{
+	http_hpack_table_init(&test_table, test_table_data, sizeof(test_table_data), 4096);
+	test_hpack_verify_decode_blocks(test_requests, ARRAY_SIZE(test_requests));
+
+	http_hpack_table_init(&test_table, test_table_data, sizeof(test_table_data), 4096);
+	test_hpack_verify_decode_blocks(test_requests_huffman,
+					ARRAY_SIZE(test_requests_huffman));
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_decode_eviction)
+{
+	http_hpack_table_init(&test_table, test_table_data, sizeof(test_table_data), 256);
+	test_hpack_verify_decode_blocks(test_responses, ARRAY_SIZE(test_responses));
+	zassert_equal(test_table.count, 3, "Wrong number of table entries");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_encode)
+{
+	struct http_hpack_header_buf hdr = {
+		.name = "custom-key",
+		.value = "custom-value",
+		.name_len = strlen("custom-key"),
+		.value_len = strlen("custom-value"),
+	};
+	static uint8_t decoder_data[HTTP_HPACK_DEFAULT_TABLE_SIZE];
+	struct http_hpack_table decoder;
+	struct http_hpack_header_buf dec;
+	int ret;
+
+	http_hpack_table_init(&test_table, test_table_data, 256, 256);
+	http_hpack_table_init(&decoder, decoder_data, sizeof(decoder_data), 4096);
+
+	/* Table size update followed by a literal with incremental indexing. */
+	ret = http_hpack_encode_header(test_buf, sizeof(test_buf), &hdr, &test_table);
+	zassert_true(ret > 0, "Failed to encode header");
+	zassert_equal(test_buf[0] & 0xe0, 0x20, "Expected table size update");
+	zassert_equal(test_table.size, 54, "Header not added to the table");
+
+	zassert_equal(http_hpack_decode_header(test_buf, ret, &dec, &decoder), 3,
+		      "Failed to decode table size update");
+	zassert_equal(dec.name_len, 0, "Unexpected header field");
+	zassert_equal(decoder.max_size, 256, "Table size not updated");
+	zassert_equal(http_hpack_decode_header(test_buf + 3, ret - 3, &dec, &decoder),
+		      ret - 3, "Failed to decode header");
+	zassert_mem_equal(dec.value, hdr.value, hdr.value_len, "Wrong header value");
+
+	/* Repeated header is sent as an index to the dynamic table. */
+	ret = http_hpack_encode_header(test_buf, sizeof(test_buf), &hdr, &test_table);
+	zassert_equal(ret, 1, "Header not indexed");
+	zassert_equal(test_buf[0], 0xbe, "Wrong index");
+
+	zassert_equal(http_hpack_decode_header(test_buf, ret, &dec, &decoder), 1,
+		      "Failed to decode indexed header");
+	zassert_mem_equal(dec.name, hdr.name, hdr.name_len, "Wrong header name");
+	zassert_mem_equal(dec.value, hdr.value, hdr.value_len, "Wrong header value");
+
+	/* Sensitive headers are never indexed. */
+	hdr.name = "set-cookie";
+	hdr.name_len = strlen("set-cookie");
+
+	ret = http_hpack_encode_header(test_buf, sizeof(test_buf), &hdr, &test_table);
+	zassert_true(ret > 1, "Failed to encode header");
+	zassert_equal(test_buf[0] & 0xf0, 0x10, "Expected never indexed literal");
+	zassert_equal(test_table.count, 1, "Sensitive header added to the table");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_decode_limit)
+{
+	/* Literal with incremental indexing, then its index */
+	static const uint8_t literal[] = {
+		0x40, 0x0a, 'c', 'u', 's', 't', 'o', 'm', '-', 'k', 'e', 'y',
+		0x0c, 'c', 'u', 's', 't', 'o', 'm', '-', 'v', 'a', 'l', 'u', 'e',
+	};
+	static const uint8_t indexed[] = { 0xbe };
+	/* Table size updates to 512 and to 256 */
+	static const uint8_t update_512[] = { 0x3f, 0xe1, 0x03 };
+	static const uint8_t update_256[] = { 0x3f, 0xe1, 0x01 };
+	struct http_hpack_header_buf hdr;
+
+	/* Before the settings are acknowledged the default size applies */
+	http_hpack_table_init(&test_table, test_table_data, sizeof(test_table_data),
+			      HTTP_HPACK_DEFAULT_TABLE_SIZE);
+
+	zassert_equal(http_hpack_decode_header(literal, sizeof(literal), &hdr, &test_table),
+		      sizeof(literal), "Failed to decode header");
+	zassert_equal(test_table.count, 1, "Header not added to the table");
+
+	/* Settings acknowledged, the next field must be a table size update */
+	http_hpack_table_set_limit(&test_table, 256);
+
+	zassert_equal(http_hpack_decode_header(indexed, sizeof(indexed), &hdr, &test_table),
+		      -EBADMSG, "Missing table size update not detected");
+	zassert_equal(http_hpack_decode_header(update_512, sizeof(update_512), &hdr,
+					       &test_table),
+		      -EBADMSG, "Table size update above the limit accepted");
+	zassert_equal(http_hpack_decode_header(update_256, sizeof(update_256), &hdr,
+					       &test_table),
+		      sizeof(update_256), "Failed to decode table size update");
+	zassert_equal(test_table.max_size, 256, "Table size not updated");
+
+	/* The entry still fits, and can be referenced */
+	zassert_equal(http_hpack_decode_header(indexed, sizeof(indexed), &hdr, &test_table),
+		      sizeof(indexed), "Failed to decode indexed header");
+	zassert_mem_equal(hdr.value, "custom-value", hdr.value_len, "Wrong header value");
+}
+
 ZTEST_SUITE(http2_hpack, NULL, NULL, NULL, NULL, NULL);
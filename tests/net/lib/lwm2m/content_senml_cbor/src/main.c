@@ -955,6 +955,55 @@ ZTEST(net_content_senml_cbor_nomem, test_put_time_nomem)
 	zassert_equal(ret, -ENOMEM, "Invalid error code returned");
 }
 
+ZTEST(net_content_senml_cbor, test_put_obj_inst)
+{
+	int ret;
+	uint8_t *payload = test_msg.msg_data + TEST_PAYLOAD_OFFSET;
+	struct test_payload_buffer expected_first = {
+		.data = {
+			(0x04 << 5) | 10,
+			(0x05 << 5) | 3,
+			(0x01 << 5) | 1,
+			(0x03 << 5) | 9,
+			'/', '6', '5', '5', '3', '5', '/', '0', '/',
+			(0x00 << 5) | 0,
+			(0x03 << 5) | 1,
+			'0',
+			(0x00 << 5) | 2,
+			(0x00 << 5) | 0
+		},
+		.len = 18
+	};
+	struct test_payload_buffer expected_last = {
+		.data = {
+			(0x05 << 5) | 2,
+			(0x00 << 5) | 0,
+			(0x03 << 5) | 1,
+			'9',
+			(0x00 << 5) | 2,
+			(0x00 << 5) | 26,
+			0x45, 0xbe, 0x7c, 0x70
+		},
+		.len = 10
+	};
+
+	/* All the resources of the instance, more records than the decoder can hold with
+	 * a small CONFIG_LWM2M_RW_SENML_CBOR_RECORDS.
+	 */
+	test_msg.path.level = LWM2M_PATH_LEVEL_OBJECT_INST;
+	test_s8 = 0;
+	test_time = 1170111600;
+
+	ret = do_read_op_senml_cbor(&test_msg);
+	zassert_true(ret >= 0, "Error reported");
+
+	zassert_mem_equal(payload, expected_first.data, expected_first.len,
+			  "Invalid payload format");
+	zassert_mem_equal(test_msg.msg_data + test_msg.cpkt.offset - expected_last.len,
+			  expected_last.data, expected_last.len,
+			  "Invalid payload format");
+}
+
 ZTEST(net_content_senml_cbor, test_get_s32)
 {
 	int ret;
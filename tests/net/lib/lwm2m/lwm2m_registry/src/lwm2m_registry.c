@@ -458,6 +458,40 @@ ZTEST(lwm2m_registry, test_next_engine_obj_inst)
 	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 1)));
 }
 
+ZTEST(lwm2m_registry, test_obj_inst_order)
+{
+	static const uint16_t create_order[] = {2, 0, 3, 1};
+	struct lwm2m_engine_obj_inst *oi;
+	int expected = 0;
+
+	ARRAY_FOR_EACH(create_order, i) {
+		zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, create_order[i])), 0);
+	}
+
+	/* Instances are found and iterated in ID order regardless of creation order */
+	for (oi = next_engine_obj_inst(3303, -1); oi != NULL;
+	     oi = next_engine_obj_inst(3303, oi->obj_inst_id)) {
+		zassert_equal(oi->obj_inst_id, expected);
+		zassert_equal(oi, lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, expected)));
+		expected++;
+	}
+	zassert_equal(expected, ARRAY_SIZE(create_order));
+
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 2)), 0);
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 2)));
+	oi = next_engine_obj_inst(3303, 1);
+	zassert_not_null(oi);
+	zassert_equal(oi->obj_inst_id, 3);
+
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, UINT16_MAX)));
+	zassert_is_null(next_engine_obj_inst(3303, UINT16_MAX));
+
+	ARRAY_FOR_EACH(create_order, i) {
+		(void)lwm2m_delete_object_inst(&LWM2M_OBJ(3303, create_order[i]));
+	}
+	zassert_is_null(next_engine_obj_inst(3303, -1));
+}
+
 ZTEST(lwm2m_registry, test_null_strings)
 {
 	int ret;
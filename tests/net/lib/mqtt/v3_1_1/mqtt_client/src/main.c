@@ -27,6 +27,9 @@ static uint8_t broker_topic[32];
 static uint8_t rx_buffer[BUFFER_SIZE];
 static uint8_t tx_buffer[BUFFER_SIZE];
 static struct mqtt_client client_ctx;
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+static uint8_t pub_queue_buffer[4 * BUFFER_SIZE];
+#endif
 static struct sockaddr broker;
 int s_sock = -1, c_sock = -1;
 static struct zsock_pollfd client_fds[1];
@@ -41,6 +44,10 @@ static struct mqtt_test_ctx {
 	bool suback_handled;
 	bool unsuback_handled;
 	uint16_t msg_id;
+	bool queued;
+	int puback_count;
+	int pubrec_count;
+	int pubcomp_count;
 	int payload_left;
 	const uint8_t *payload;
 } test_ctx;
@@ -497,9 +504,12 @@ static void mqtt_evt_handler(struct mqtt_client *const client,
 
 	case MQTT_EVT_PUBACK:
 		zassert_ok(evt->result, "MQTT PUBACK error %d", evt->result);
-		zassert_equal(evt->param.puback.message_id, test_ctx.msg_id,
-			      "Invalid packet ID received.");
+		if (!test_ctx.queued) {
+			zassert_equal(evt->param.puback.message_id, test_ctx.msg_id,
+				      "Invalid packet ID received.");
+		}
 		test_ctx.puback_handled = true;
+		test_ctx.puback_count++;
 
 		break;
 
@@ -509,6 +519,10 @@ static void mqtt_evt_handler(struct mqtt_client *const client,
 		};
 
 		zassert_ok(evt->result, "MQTT PUBREC error %d", evt->result);
+		zassert_false(test_ctx.queued,
+			      "PUBREC of a queued message should not be reported");
+		test_ctx.pubrec_count++;
+
 		zassert_equal(evt->param.pubrec.message_id, test_ctx.msg_id,
 			      "Invalid packet ID received.");
 
@@ -520,9 +534,12 @@ static void mqtt_evt_handler(struct mqtt_client *const client,
 
 	case MQTT_EVT_PUBCOMP:
 		zassert_ok(evt->result, "MQTT PUBCOMP error %d", evt->result);
-		zassert_equal(evt->param.pubcomp.message_id, test_ctx.msg_id,
-			      "Invalid packet ID received.");
+		if (!test_ctx.queued) {
+			zassert_equal(evt->param.pubcomp.message_id, test_ctx.msg_id,
+				      "Invalid packet ID received.");
+		}
 		test_ctx.pubcomp_handled = true;
+		test_ctx.pubcomp_count++;
 
 		break;
 
@@ -572,6 +589,10 @@ static void client_init(struct mqtt_client *client)
 	client->rx_buf_size = sizeof(rx_buffer);
 	client->tx_buf = tx_buffer;
 	client->tx_buf_size = sizeof(tx_buffer);
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+	client->pub_queue_buf = pub_queue_buffer;
+	client->pub_queue_buf_size = sizeof(pub_queue_buffer);
+#endif
 }
 
 static void test_connect(void)
@@ -801,6 +822,202 @@ ZTEST(mqtt_client, test_mqtt_pubsub_long)
 	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
 }
 
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+static int test_enqueue(enum mqtt_qos qos)
+{
+	struct mqtt_publish_param param = { 0 };
+
+	param.message.topic.qos = qos;
+	param.message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+	param.message.topic.topic.size =
+			strlen(param.message.topic.topic.utf8);
+	param.message.payload.data = (uint8_t *)test_ctx.payload;
+	param.message.payload.len = strlen(test_ctx.payload);
+
+	return mqtt_publish_enqueue(&client_ctx, &param);
+}
+
+static void test_input_until(const int *count, int expected)
+{
+	int ret;
+
+	while (*count < expected) {
+		client_wait(false);
+		ret = mqtt_input(&client_ctx);
+		zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+	}
+}
+
+static void test_input_all(void)
+{
+	int ret;
+
+	while (zsock_poll(client_fds, client_nfds, TIMEOUT) > 0) {
+		ret = mqtt_input(&client_ctx);
+		zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+	}
+}
+
+ZTEST(mqtt_client, test_mqtt_publish_queue)
+{
+	int ret;
+
+	test_ctx.payload = payload_short;
+	test_ctx.queued = true;
+
+	test_connect();
+
+	ret = test_enqueue(MQTT_QOS_0_AT_MOST_ONCE);
+	zassert_equal(ret, 0, "QoS 0 message should have no ID (%d)", ret);
+	ret = test_enqueue(MQTT_QOS_1_AT_LEAST_ONCE);
+	zassert_true(ret > 0, "Failed to queue QoS 1 message (%d)", ret);
+	ret = test_enqueue(MQTT_QOS_2_EXACTLY_ONCE);
+	zassert_true(ret > 0, "Failed to queue QoS 2 message (%d)", ret);
+
+	ret = mqtt_publish_flush(&client_ctx);
+	zassert_equal(ret, 3, "All queued messages should be sent (%d)", ret);
+	zassert_equal(client_ctx.internal.pub_queue.count, 2,
+		      "QoS 0 message should be dequeued once sent");
+
+	for (int i = 0; i < 3; i++) {
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	test_input_until(&test_ctx.puback_count, 1);
+
+	/* PUBREL is sent by the library on PUBREC, which is not reported. */
+	test_input_all();
+	zassert_equal(test_ctx.pubrec_count, 0, "PUBREC should not be reported");
+
+	broker_process(MQTT_PKT_TYPE_PUBREL);
+	test_input_until(&test_ctx.pubcomp_count, 1);
+
+	zassert_equal(client_ctx.internal.pub_queue.count, 0,
+		      "Acknowledged messages should be dequeued");
+	zassert_equal(mqtt_publish_flush(&client_ctx), 0,
+		      "Nothing should be left to send");
+
+	test_disconnect();
+}
+
+ZTEST(mqtt_client, test_mqtt_publish_queue_inflight)
+{
+	const int count = CONFIG_MQTT_PUBLISH_INFLIGHT_MAX + 1;
+	int ret;
+
+	test_ctx.payload = payload_short;
+	test_ctx.queued = true;
+
+	ret = mqtt_publish_flush(&client_ctx);
+	zassert_equal(ret, -ENOTCONN, "Flush should fail when not connected");
+
+	/* Messages can be queued before connecting. */
+	for (int i = 0; i < count; i++) {
+		ret = test_enqueue(MQTT_QOS_1_AT_LEAST_ONCE);
+		zassert_true(ret > 0, "Failed to queue QoS 1 message (%d)", ret);
+	}
+
+	test_connect();
+
+	ret = mqtt_publish_flush(&client_ctx);
+	zassert_equal(ret, CONFIG_MQTT_PUBLISH_INFLIGHT_MAX,
+		      "Only the inflight window should be sent (%d)", ret);
+	zassert_equal(mqtt_publish_flush(&client_ctx), 0,
+		      "Window is full, nothing should be sent");
+
+	for (int i = 0; i < CONFIG_MQTT_PUBLISH_INFLIGHT_MAX; i++) {
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	test_input_until(&test_ctx.puback_count, CONFIG_MQTT_PUBLISH_INFLIGHT_MAX);
+
+	ret = mqtt_publish_flush(&client_ctx);
+	zassert_equal(ret, 1, "Last message should be sent (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+	test_input_until(&test_ctx.puback_count, count);
+
+	zassert_equal(client_ctx.internal.pub_queue.count, 0,
+		      "Acknowledged messages should be dequeued");
+
+	test_disconnect();
+}
+
+ZTEST(mqtt_client, test_mqtt_publish_queue_full)
+{
+	int queued = 0;
+	int ret;
+
+	test_ctx.payload = payload_short;
+	test_ctx.queued = true;
+
+	while ((ret = test_enqueue(MQTT_QOS_0_AT_MOST_ONCE)) == 0) {
+		queued++;
+	}
+
+	zassert_equal(ret, -ENOMEM, "Full queue should report -ENOMEM (%d)", ret);
+	zassert_true(queued > 0, "Messages should have been queued");
+
+	test_connect();
+
+	ret = mqtt_publish_flush(&client_ctx);
+	zassert_equal(ret, queued, "All messages should be sent (%d)", ret);
+
+	for (int i = 0; i < queued; i++) {
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	zassert_equal(client_ctx.internal.pub_queue.used, 0,
+		      "Queue buffer should be empty");
+
+	test_disconnect();
+}
+
+ZTEST(mqtt_client, test_mqtt_publish_queue_message_id)
+{
+	struct mqtt_publish_param param = { 0 };
+	int ret;
+
+	test_ctx.payload = payload_short;
+	test_ctx.queued = true;
+
+	param.message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE;
+	param.message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+	param.message.topic.topic.size =
+			strlen(param.message.topic.topic.utf8);
+	param.message.payload.data = (uint8_t *)test_ctx.payload;
+	param.message.payload.len = strlen(test_ctx.payload);
+	param.message_id = 1234;
+
+	ret = mqtt_publish_enqueue(&client_ctx, &param);
+	zassert_equal(ret, 1234, "Given message ID should be used (%d)", ret);
+
+	ret = mqtt_publish_enqueue(&client_ctx, &param);
+	zassert_equal(ret, -EEXIST, "Message ID in use should be rejected (%d)", ret);
+	zassert_equal(client_ctx.internal.pub_queue.count, 1,
+		      "Only one message should be queued");
+
+	/* A generated ID never collides with a queued one. */
+	ret = test_enqueue(MQTT_QOS_1_AT_LEAST_ONCE);
+	zassert_true(ret > 0 && ret != 1234, "Failed to queue QoS 1 message (%d)", ret);
+
+	test_connect();
+
+	ret = mqtt_publish_flush(&client_ctx);
+	zassert_equal(ret, 2, "All queued messages should be sent (%d)", ret);
+
+	for (int i = 0; i < 2; i++) {
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	test_input_until(&test_ctx.puback_count, 2);
+
+	zassert_equal(client_ctx.internal.pub_queue.count, 0,
+		      "Acknowledged messages should be dequeued");
+
+	test_disconnect();
+}
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+
 static void mqtt_tests_before(void *fixture)
 {
 	ARG_UNUSED(fixture);
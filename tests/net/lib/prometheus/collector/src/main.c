@@ -8,6 +8,7 @@
 
 #include <zephyr/net/prometheus/counter.h>
 #include <zephyr/net/prometheus/collector.h>
+#include <zephyr/net/prometheus/formatter.h>
 
 PROMETHEUS_COUNTER_DEFINE(test_counter_m, "Test counter",
 			  ({ .key = "test_counter", .value = "test" }), NULL);
@@ -37,12 +38,37 @@ ZTEST(test_collector, test_prometheus_collector_register)
 			  "Counter not found in collector (expected %p, got %p)",
 			  &test_counter_m, counter);
 
-	zassert_equal(test_counter_m.value, 0, "Counter value is not 0");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 0, "Counter value is not 0");
 
 	ret = prometheus_counter_inc(counter);
 	zassert_ok(ret, "Error incrementing counter");
 
-	zassert_equal(counter->value, 1, "Counter value is not 1");
+	zassert_equal(prometheus_counter_get(counter), 1, "Counter value is not 1");
 }
 
+#if defined(CONFIG_PROMETHEUS_SYSTEM_STATS)
+/**
+ * @brief Test the kernel statistics collector
+ *
+ * @details The test shall format the kernel statistics collector and check
+ * that the statistics enabled in the kernel are exported.
+ */
+ZTEST(test_collector, test_prometheus_collector_kernel_stats)
+{
+	static char formatted[1024];
+	int ret;
+
+	ret = prometheus_format_exposition(&prometheus_kernel_stats, formatted,
+					   sizeof(formatted));
+	zassert_ok(ret, "Error formatting kernel statistics");
+
+	zassert_not_null(strstr(formatted, "kernel_threads{kernel=\"threads\"}"),
+			 "Thread count not exported");
+	zassert_not_null(strstr(formatted, "kernel_cpu_busy_cycles{cpu=\"all\"}"),
+			 "CPU cycles not exported");
+	zassert_not_null(strstr(formatted, "kernel_mem_slab_free_bytes"),
+			 "Memory slab usage not exported");
+}
+#endif
+
 ZTEST_SUITE(test_collector, NULL, NULL, NULL, NULL, NULL);
@@ -21,17 +21,17 @@ ZTEST(test_counter, test_prometheus_counter_01_inc)
 {
 	int ret;
 
-	zassert_equal(test_counter_m.value, 0, "Counter value is not 0");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 0, "Counter value is not 0");
 
 	ret = prometheus_counter_inc(&test_counter_m);
 	zassert_ok(ret, "Error incrementing counter");
 
-	zassert_equal(test_counter_m.value, 1, "Counter value is not 1");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 1, "Counter value is not 1");
 
 	ret = prometheus_counter_inc(&test_counter_m);
 	zassert_ok(ret, "Error incrementing counter");
 
-	zassert_equal(test_counter_m.value, 2, "Counter value is not 2");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 2, "Counter value is not 2");
 }
 
 /**
@@ -46,12 +46,12 @@ ZTEST(test_counter, test_prometheus_counter_02_add)
 	ret = prometheus_counter_add(&test_counter_m, 2);
 	zassert_ok(ret, "Error adding counter");
 
-	zassert_equal(test_counter_m.value, 4, "Counter value is not 4");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 4, "Counter value is not 4");
 
 	ret = prometheus_counter_add(&test_counter_m, 0);
 	zassert_ok(ret, "Error adding counter");
 
-	zassert_equal(test_counter_m.value, 4, "Counter value is not 4");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 4, "Counter value is not 4");
 }
 
 /**
@@ -66,12 +66,12 @@ ZTEST(test_counter, test_prometheus_counter_03_set)
 	ret = prometheus_counter_set(&test_counter_m, 20);
 	zassert_ok(ret, "Error setting counter");
 
-	zassert_equal(test_counter_m.value, 20, "Counter value is not 20");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 20, "Counter value is not 20");
 
 	ret = prometheus_counter_set(&test_counter_m, 15);
 	zassert_equal(ret, -EINVAL, "Error setting counter");
 
-	zassert_equal(test_counter_m.value, 20, "Counter value is not 20");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 20, "Counter value is not 20");
 }
 
 ZTEST_SUITE(test_counter, NULL, NULL, NULL, NULL, NULL);
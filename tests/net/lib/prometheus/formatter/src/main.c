@@ -7,6 +7,7 @@
 #include <zephyr/ztest.h>
 
 #include <zephyr/net/prometheus/counter.h>
+#include <zephyr/net/prometheus/histogram.h>
 #include <zephyr/net/prometheus/collector.h>
 #include <zephyr/net/prometheus/formatter.h>
 
@@ -19,6 +20,19 @@ PROMETHEUS_COUNTER_DEFINE(test_counter2, "Test counter 2",
 
 PROMETHEUS_COLLECTOR_DEFINE(test_custom_collector);
 
+PROMETHEUS_COUNTER_DEFINE(test_walk_counter, "Test walk counter",
+			  ({ .key = "test", .value = "walk" }), NULL);
+PROMETHEUS_HISTOGRAM_DEFINE(test_walk_histogram, "Test walk histogram",
+			    ({ .key = "test", .value = "walk" }), NULL);
+
+PROMETHEUS_COLLECTOR_DEFINE(test_walk_collector);
+
+static struct prometheus_histogram_bucket test_walk_buckets[] = {
+	{ .upper_bound = 1.0 },
+	{ .upper_bound = 10.0 },
+	{ .upper_bound = 100.0 },
+};
+
 /**
  * @brief Test Prometheus formatter
  * @details The test shall increment the counter value by 1 and check if the
@@ -45,7 +59,7 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 
 	zassert_equal(counter, &test_counter, "Counter not found in collector");
 
-	zassert_equal(test_counter.value, 0, "Counter value is not 0");
+	zassert_equal(prometheus_counter_get(&test_counter), 0, "Counter value is not 0");
 
 	ret = prometheus_counter_inc(&test_counter);
 	zassert_ok(ret, "Error incrementing counter");
@@ -53,7 +67,7 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 	ret = prometheus_counter_inc(&test_counter2);
 	zassert_ok(ret, "Error incrementing counter 2");
 
-	zassert_equal(counter->value, 1, "Counter value is not 1");
+	zassert_equal(prometheus_counter_get(counter), 1, "Counter value is not 1");
 
 	ret = prometheus_format_exposition(&test_custom_collector, formatted, sizeof(formatted));
 	zassert_ok(ret, "Error formatting exposition data");
@@ -63,4 +77,59 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 		      exposed, formatted);
 }
 
+/**
+ * @brief Test walking the metrics of a collector in chunks
+ * @details The test shall walk the metrics of a collector with a buffer only
+ * large enough for the longest line, and check that the chunks put together
+ * are the exposition of the whole collector.
+ */
+ZTEST(test_formatter, test_prometheus_formatter_walk_chunks)
+{
+	static struct prometheus_collector_walk_context ctx;
+	char formatted[512] = { 0 };
+	char streamed[512] = { 0 };
+	uint8_t chunk[48];
+	int chunks = 0;
+	int ret;
+
+	test_walk_histogram.buckets = test_walk_buckets;
+	test_walk_histogram.num_buckets = ARRAY_SIZE(test_walk_buckets);
+
+	prometheus_collector_register_metric(&test_walk_collector, &test_walk_counter.base);
+	prometheus_collector_register_metric(&test_walk_collector, &test_walk_histogram.base);
+
+	zassert_ok(prometheus_counter_add(&test_walk_counter, 42), "Error adding counter");
+	zassert_ok(prometheus_histogram_observe(&test_walk_histogram, 0.5),
+		   "Error observing histogram");
+	zassert_ok(prometheus_histogram_observe(&test_walk_histogram, 50.0),
+		   "Error observing histogram");
+
+	ret = prometheus_format_exposition(&test_walk_collector, formatted, sizeof(formatted));
+	zassert_ok(ret, "Error formatting exposition data");
+
+	ret = prometheus_collector_walk_init(&ctx, &test_walk_collector);
+	zassert_ok(ret, "Error initializing walk context");
+
+	do {
+		ret = prometheus_collector_walk_metrics(&ctx, chunk, sizeof(chunk));
+		zassert_true(ret == 0 || ret == -EAGAIN, "Error walking metrics (%d)", ret);
+		zassert_true(strlen(chunk) < sizeof(chunk), "Chunk is not terminated");
+
+		strcat(streamed, chunk);
+		chunks++;
+	} while (ret == -EAGAIN);
+
+	zassert_true(chunks > 1, "Exposition was not split in chunks");
+	zassert_equal(strcmp(formatted, streamed), 0,
+		      "Walk is not as expected (expected\n\"%s\", got\n\"%s\")",
+		      formatted, streamed);
+
+	/* A line must fit in the buffer */
+	ret = prometheus_collector_walk_init(&ctx, &test_walk_collector);
+	zassert_ok(ret, "Error initializing walk context");
+
+	ret = prometheus_collector_walk_metrics(&ctx, chunk, 8);
+	zassert_equal(ret, -ENOMEM, "Line did not fit, but no error (%d)", ret);
+}
+
 ZTEST_SUITE(test_formatter, NULL, NULL, NULL, NULL, NULL);
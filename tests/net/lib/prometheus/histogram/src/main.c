@@ -10,6 +10,8 @@
 
 PROMETHEUS_HISTOGRAM_DEFINE(test_histogram_m, "Test histogram",
 			    ({ .key = "test", .value = "histogram" }), NULL);
+PROMETHEUS_HISTOGRAM_DEFINE(test_bucket_histogram_m, "Test bucket histogram",
+			    ({ .key = "test", .value = "buckets" }), NULL);
 
 /**
  * @brief Test prometheus_histogram_observe
@@ -24,17 +26,62 @@ ZTEST(test_histogram, test_histogram_observe)
 {
 	int ret;
 
-	zassert_equal(test_histogram_m.sum, 0, "Histogram value is not 0");
+	zassert_equal(prometheus_histogram_get_sum(&test_histogram_m), 0,
+		      "Histogram value is not 0");
+	zassert_equal(prometheus_histogram_get_count(&test_histogram_m), 0,
+		      "Histogram count is not 0");
 
 	ret = prometheus_histogram_observe(&test_histogram_m, 1);
 	zassert_ok(ret, "Error observing histogram");
 
-	zassert_equal(test_histogram_m.sum, 1.0, "Histogram value is not 1");
+	zassert_equal(prometheus_histogram_get_sum(&test_histogram_m), 1.0,
+		      "Histogram value is not 1");
+	zassert_equal(prometheus_histogram_get_count(&test_histogram_m), 1,
+		      "Histogram count is not 1");
 
 	ret = prometheus_histogram_observe(&test_histogram_m, 2);
 	zassert_ok(ret, "Error observing histogram");
 
-	zassert_equal(test_histogram_m.sum, 3.0, "Histogram value is not 2");
+	zassert_equal(prometheus_histogram_get_sum(&test_histogram_m), 3.0,
+		      "Histogram value is not 2");
+	zassert_equal(prometheus_histogram_get_count(&test_histogram_m), 2,
+		      "Histogram count is not 2");
+}
+
+/**
+ * @brief Test the bucket counts of a histogram
+ *
+ * @details The test shall observe values falling in different buckets and
+ * check the count of each bucket.
+ */
+ZTEST(test_histogram, test_histogram_buckets)
+{
+	static struct prometheus_histogram_bucket buckets[] = {
+		{ .upper_bound = 1.0 },
+		{ .upper_bound = 10.0 },
+	};
+	int ret;
+
+	test_bucket_histogram_m.buckets = buckets;
+	test_bucket_histogram_m.num_buckets = ARRAY_SIZE(buckets);
+
+	ret = prometheus_histogram_observe(&test_bucket_histogram_m, 0.5);
+	zassert_ok(ret, "Error observing histogram");
+
+	ret = prometheus_histogram_observe(&test_bucket_histogram_m, 5);
+	zassert_ok(ret, "Error observing histogram");
+
+	ret = prometheus_histogram_observe(&test_bucket_histogram_m, 7);
+	zassert_ok(ret, "Error observing histogram");
+
+	zassert_equal(prometheus_histogram_get_bucket_count(&test_bucket_histogram_m, 0), 1,
+		      "Bucket count is not 1");
+	zassert_equal(prometheus_histogram_get_bucket_count(&test_bucket_histogram_m, 1), 2,
+		      "Bucket count is not 2");
+	zassert_equal(prometheus_histogram_get_bucket_count(&test_bucket_histogram_m, 2), 0,
+		      "Count of a missing bucket is not 0");
+	zassert_equal(prometheus_histogram_get_count(&test_bucket_histogram_m), 3,
+		      "Histogram count is not 3");
 }
 
 ZTEST_SUITE(test_histogram, NULL, NULL, NULL, NULL, NULL);
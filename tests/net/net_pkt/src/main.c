@@ -1085,6 +1085,130 @@ ZTEST(net_pkt_test_suite, test_net_pkt_get_contiguous_len)
 	net_pkt_unref(pkt);
 }
 
+ZTEST(net_pkt_test_suite, test_net_pkt_hdr_pull)
+{
+	const size_t len = CONFIG_NET_BUF_DATA_SIZE * 2;
+	struct net_pkt *pkt;
+	uint8_t *first, *hdr;
+	uint8_t val;
+	int i;
+
+	/* Allocate pkt with 2 fragments */
+	pkt = net_pkt_rx_alloc_with_buffer(NULL, len, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+
+	for (i = 0; i < len; i++) {
+		zassert_equal(net_pkt_write_u8(pkt, i), 0, "Write packet failed");
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	/* Contiguous header is returned in place */
+	first = net_pkt_hdr_pull(pkt, 8);
+	zassert_equal_ptr(first, pkt->buffer->data, "Header not in place");
+	zassert_equal(net_pkt_get_current_offset(pkt), 8, "Wrong cursor");
+
+	/* Header straddling the two fragments is made contiguous */
+	zassert_equal(net_pkt_skip(pkt, CONFIG_NET_BUF_DATA_SIZE - 12), 0,
+		      "Skip failed");
+
+	hdr = net_pkt_hdr_pull(pkt, 16);
+	zassert_not_null(hdr, "Straddling header not pulled");
+
+	for (i = 0; i < 16; i++) {
+		zassert_equal(hdr[i], (uint8_t)(CONFIG_NET_BUF_DATA_SIZE - 4 + i),
+			      "Header data mismatch");
+	}
+
+	zassert_equal(net_pkt_get_current_offset(pkt),
+		      CONFIG_NET_BUF_DATA_SIZE + 12, "Wrong cursor");
+
+	/* Data before the cursor was not moved */
+	for (i = 0; i < 8; i++) {
+		zassert_equal(first[i], i, "Previous header moved");
+	}
+
+	/* And the packet content is unchanged */
+	zassert_equal(net_pkt_get_len(pkt), len, "Wrong packet length");
+
+	net_pkt_cursor_init(pkt);
+
+	for (i = 0; i < len; i++) {
+		zassert_equal(net_pkt_read_u8(pkt, &val), 0, "Read failed");
+		zassert_equal(val, (uint8_t)i, "Packet data mismatch");
+	}
+
+	/* Pulling past the end fails */
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_pkt_skip(pkt, len - 4), 0, "Skip failed");
+	zassert_is_null(net_pkt_hdr_pull(pkt, 8), "Pulled past the end");
+
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_pkt_test_suite, test_net_pkt_hdr_pull_shared)
+{
+	const size_t len = CONFIG_NET_BUF_DATA_SIZE * 2;
+	struct net_buf *frag1, *frag2;
+	struct net_pkt *pkt, *clone;
+	uint8_t *hdr;
+	uint8_t val;
+	int i;
+
+	pkt = net_pkt_rx_alloc_with_buffer(NULL, len, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+
+	for (i = 0; i < len; i++) {
+		zassert_equal(net_pkt_write_u8(pkt, i), 0, "Write packet failed");
+	}
+
+	clone = net_pkt_shallow_clone(pkt, K_NO_WAIT);
+	zassert_not_null(clone, "Pkt not cloned");
+
+	frag1 = clone->buffer;
+	frag2 = frag1->frags;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	zassert_equal(net_pkt_skip(pkt, CONFIG_NET_BUF_DATA_SIZE - 4), 0,
+		      "Skip failed");
+
+	hdr = net_pkt_hdr_pull(pkt, 16);
+	zassert_not_null(hdr, "Straddling header not pulled");
+
+	for (i = 0; i < 16; i++) {
+		zassert_equal(hdr[i], (uint8_t)(CONFIG_NET_BUF_DATA_SIZE - 4 + i),
+			      "Header data mismatch");
+	}
+
+	zassert_not_equal(pkt->buffer, frag1, "Shared buffers not copied");
+
+	/* The buffers of the clone are left untouched */
+	zassert_equal_ptr(clone->buffer, frag1, "Clone buffer replaced");
+	zassert_equal_ptr(frag1->frags, frag2, "Clone fragments relinked");
+	zassert_equal(frag1->len, CONFIG_NET_BUF_DATA_SIZE, "Clone fragment modified");
+	zassert_equal(frag2->len, CONFIG_NET_BUF_DATA_SIZE, "Clone fragment modified");
+
+	net_pkt_cursor_init(clone);
+
+	for (i = 0; i < len; i++) {
+		zassert_equal(net_pkt_read_u8(clone, &val), 0, "Read failed");
+		zassert_equal(val, (uint8_t)i, "Clone data mismatch");
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	for (i = 0; i < len; i++) {
+		zassert_equal(net_pkt_read_u8(pkt, &val), 0, "Read failed");
+		zassert_equal(val, (uint8_t)i, "Packet data mismatch");
+	}
+
+	net_pkt_unref(clone);
+	net_pkt_unref(pkt);
+}
+
 ZTEST(net_pkt_test_suite, test_net_pkt_remove_tail)
 {
 	struct net_pkt *pkt;
@@ -545,6 +545,79 @@ static void test_route_preference(void)
 }
 
 
+static void test_route_info(struct in6_addr *dst, bool found,
+			    struct net_route_entry *expected_route,
+			    struct in6_addr *expected_nexthop)
+{
+	struct net_route_entry *route = NULL;
+	struct in6_addr *nexthop = NULL;
+	bool ret;
+
+	ret = net_route_get_info(my_iface, dst, &route, &nexthop);
+	zassert_equal(ret, found, "Route info %s for %s",
+		      found ? "not found" : "found",
+		      net_sprint_ipv6_addr(dst));
+
+	if (!found) {
+		return;
+	}
+
+	zassert_equal_ptr(route, expected_route, "Route info route mismatch");
+	zassert_not_null(nexthop, "Route info nexthop missing");
+	zassert_true(net_ipv6_addr_cmp(nexthop, expected_nexthop),
+		     "Route info nexthop mismatch");
+}
+
+/* Every lookup is done twice so that the second one is served from the
+ * route cache when CONFIG_NET_ROUTE_CACHE is enabled. A change in the
+ * routing or neighbor table must be visible to the very next lookup.
+ */
+static void test_route_cache(void)
+{
+	struct net_route_entry *entry;
+
+	/* Route add */
+	test_route_info(&dest_addr, false, NULL, NULL);
+	test_route_info(&dest_addr, false, NULL, NULL);
+
+	entry = net_route_add(my_iface, &dest_addr, 128, &peer_addr,
+			      NET_IPV6_ND_INFINITE_LIFETIME,
+			      NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(entry, "Route add failed");
+
+	test_route_info(&dest_addr, true, entry, &peer_addr);
+	test_route_info(&dest_addr, true, entry, &peer_addr);
+
+	/* Route delete */
+	zassert_equal(net_route_del(entry), 0, "Route del failed");
+
+	test_route_info(&dest_addr, false, NULL, NULL);
+
+	/* Route expiry */
+	entry = net_route_add(my_iface, &dest_addr, 128, &peer_addr,
+			      NET_IPV6_ND_INFINITE_LIFETIME,
+			      NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(entry, "Route add failed");
+
+	test_route_info(&dest_addr, true, entry, &peer_addr);
+	test_route_info(&dest_addr, true, entry, &peer_addr);
+
+	net_route_update_lifetime(entry, 1);
+
+	k_sleep(K_MSEC(1200));
+
+	test_route_info(&dest_addr, false, NULL, NULL);
+
+	/* Neighbor removal, a neighbor is its own next hop */
+	test_route_info(&peer_addr_alt, true, NULL, &peer_addr_alt);
+	test_route_info(&peer_addr_alt, true, NULL, &peer_addr_alt);
+
+	zassert_true(net_ipv6_nbr_rm(my_iface, &peer_addr_alt),
+		     "Neighbor remove failed");
+
+	test_route_info(&peer_addr_alt, false, NULL, NULL);
+}
+
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
 {
@@ -566,6 +639,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_cache();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_rx_flow_steering_test, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <net_private.h>
+#include <ipv4.h>
+#include <udp_internal.h>
+
+#define ALLOC_TIMEOUT K_MSEC(100)
+#define WAIT_TIME K_MSEC(500)
+
+#define MY_PORT 4242U
+#define PEER_PORT 5353U
+#define FLOW_COUNT 64
+#define FLOW_PKT_COUNT 8
+
+/* 192.0.2.1 and 192.0.2.2 */
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *test_iface;
+
+static K_SEM_DEFINE(recv_sem, 0, FLOW_PKT_COUNT);
+static k_tid_t recv_threads[FLOW_PKT_COUNT];
+static int recv_count;
+
+static void test_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[6] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int test_iface_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api test_iface_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_iface_send,
+};
+
+NET_DEVICE_INIT(net_rx_flow_test, "net_rx_flow_test", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &test_iface_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV4_MTU);
+
+static enum net_verdict udp_data_received(struct net_conn *conn,
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  union net_proto_header *proto_hdr,
+					  void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	if (recv_count < ARRAY_SIZE(recv_threads)) {
+		recv_threads[recv_count++] = k_current_get();
+	}
+
+	net_pkt_unref(pkt);
+	k_sem_give(&recv_sem);
+
+	return NET_OK;
+}
+
+/* Create a UDP packet received from the peer */
+static struct net_pkt *prepare_udp_pkt(uint16_t src_port, uint16_t dst_port)
+{
+	static const uint8_t data[] = "flow";
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(test_iface,
+					   sizeof(struct net_udp_hdr) + sizeof(data),
+					   AF_INET, IPPROTO_UDP, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_ok(net_ipv4_create(pkt, &peer_addr, &my_addr),
+		   "Cannot create IPv4 header");
+	zassert_ok(net_udp_create(pkt, htons(src_port), htons(dst_port)),
+		   "Cannot create UDP header");
+	zassert_ok(net_pkt_write(pkt, data, sizeof(data)), "Cannot write data");
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_UDP), "Cannot finalize packet");
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static int flow_tc(uint16_t src_port, uint16_t dst_port)
+{
+	struct net_pkt *pkt = prepare_udp_pkt(src_port, dst_port);
+	int tc = net_rx_flow2tc(pkt);
+
+	net_pkt_unref(pkt);
+
+	return tc;
+}
+
+ZTEST(net_rx_flow_steering, test_flow_same_tc)
+{
+	for (uint16_t port = 1000U; port < 1000U + FLOW_COUNT; port++) {
+		int tc = flow_tc(port, MY_PORT);
+
+		zassert_true(tc >= 0 && tc < NET_TC_RX_COUNT,
+			     "Invalid queue %d", tc);
+		zassert_equal(flow_tc(port, MY_PORT), tc,
+			      "Flow %u steered to different queues", port);
+	}
+}
+
+ZTEST(net_rx_flow_steering, test_flows_spread)
+{
+	uint32_t used = 0U;
+
+	for (uint16_t port = 1000U; port < 1000U + FLOW_COUNT; port++) {
+		used |= BIT(flow_tc(port, MY_PORT));
+	}
+
+	zassert_equal(used, BIT_MASK(NET_TC_RX_COUNT),
+		      "Flows not spread over all the queues (0x%x)", used);
+}
+
+ZTEST(net_rx_flow_steering, test_driver_hash)
+{
+	struct net_pkt *pkt;
+
+	/* The hash given by the driver wins over the headers */
+	for (uint32_t hash = 1U; hash <= 2U * NET_TC_RX_COUNT; hash++) {
+		pkt = prepare_udp_pkt(1000U, MY_PORT);
+		net_pkt_set_rx_hash(pkt, hash);
+
+		zassert_equal(net_rx_flow2tc(pkt), hash % NET_TC_RX_COUNT,
+			      "Driver hash %u not used", hash);
+
+		net_pkt_unref(pkt);
+	}
+}
+
+ZTEST(net_rx_flow_steering, test_non_ip)
+{
+	static const uint8_t data[] = { 0x00, 0x01, 0x08, 0x00, 0x06, 0x04 };
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(test_iface, sizeof(data), AF_UNSPEC,
+					   0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_write(pkt, data, sizeof(data)), "Cannot write data");
+
+	zassert_true(net_rx_flow2tc(pkt) < 0, "Non-IP packet steered by flow");
+
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_rx_flow_steering, test_ipv4_fragment)
+{
+	struct net_pkt *pkt;
+	int tc = -1;
+
+	/* Fragments other than the first one have no ports, so all the
+	 * fragments of a datagram are hashed on the addresses only.
+	 */
+	for (uint16_t port = 1000U; port < 1000U + FLOW_COUNT; port++) {
+		pkt = prepare_udp_pkt(port, MY_PORT);
+		sys_put_be16(NET_IPV4_MORE_FRAG_MASK | 0x10U,
+			     NET_IPV4_HDR(pkt)->offset);
+
+		if (tc < 0) {
+			tc = net_rx_flow2tc(pkt);
+		} else {
+			zassert_equal(net_rx_flow2tc(pkt), tc,
+				      "Fragment steered by its payload");
+		}
+
+		net_pkt_unref(pkt);
+	}
+}
+
+ZTEST(net_rx_flow_steering, test_flow_same_thread)
+{
+	int tc = flow_tc(2000U, MY_PORT);
+	char name[CONFIG_THREAD_MAX_NAME_LEN];
+
+	for (int i = 0; i < FLOW_PKT_COUNT; i++) {
+		zassert_ok(net_recv_data(test_iface, prepare_udp_pkt(2000U, MY_PORT)),
+			   "Cannot receive packet");
+	}
+
+	for (int i = 0; i < FLOW_PKT_COUNT; i++) {
+		zassert_ok(k_sem_take(&recv_sem, WAIT_TIME), "Packet %d not received", i);
+	}
+
+	zassert_equal(recv_count, FLOW_PKT_COUNT, "Wrong number of packets");
+
+	snprintk(name, sizeof(name), "rx_q[%d]", tc);
+
+	for (int i = 0; i < recv_count; i++) {
+		zassert_str_equal(k_thread_name_get(recv_threads[i]), name,
+				  "Packet %d handled by %s instead of %s", i,
+				  k_thread_name_get(recv_threads[i]), name);
+	}
+}
+
+struct rx_threads {
+	int count;
+	int prio;
+	bool same_prio;
+};
+
+static void rx_thread_check(const struct k_thread *thread, void *user_data)
+{
+	struct rx_threads *threads = user_data;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+	int queue;
+
+	if (name == NULL || sscanf(name, "rx_q[%d]", &queue) != 1) {
+		return;
+	}
+
+	if (threads->count++ == 0) {
+		threads->prio = thread->base.prio;
+	} else if (thread->base.prio != threads->prio) {
+		threads->same_prio = false;
+	}
+
+#if defined(CONFIG_NET_TC_THREAD_CPU_PIN)
+	zassert_equal(thread->base.cpu_mask, BIT(queue % arch_num_cpus()),
+		      "Queue %d not pinned to its CPU", queue);
+#endif
+}
+
+ZTEST(net_rx_flow_steering, test_rx_threads)
+{
+	struct rx_threads threads = {
+		.same_prio = true,
+	};
+
+	k_thread_foreach(rx_thread_check, &threads);
+
+	zassert_equal(threads.count, NET_TC_RX_COUNT, "Wrong number of RX threads");
+	zassert_true(threads.same_prio, "RX threads do not have the same priority");
+}
+
+static void *test_setup(void)
+{
+	struct net_conn_handle *handle;
+
+	test_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(test_iface, "Interface not available");
+
+	zassert_not_null(net_if_ipv4_addr_add(test_iface, &my_addr,
+					      NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv4 address");
+
+	zassert_ok(net_udp_register(AF_INET, NULL, NULL, 0, MY_PORT, NULL,
+				    udp_data_received, NULL, &handle),
+		   "Cannot register UDP handler");
+
+	return NULL;
+}
+
+static void test_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&recv_sem);
+	recv_count = 0;
+}
+
+ZTEST_SUITE(net_rx_flow_steering, NULL, test_setup, test_before, NULL, NULL);
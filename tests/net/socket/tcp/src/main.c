@@ -2502,6 +2502,185 @@ ZTEST(net_socket_tcp, test_keepalive_timeout)
 	test_context_cleanup();
 }
 
+#if defined(CONFIG_FILE_SYSTEM)
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_sys.h>
+
+#define SENDFILE_MNTP		"/sendfile"
+#define SENDFILE_PATH		SENDFILE_MNTP "/data.bin"
+#define SENDFILE_SIZE		2000
+#define SENDFILE_OFFSET		100
+
+/* Minimal read-only file system serving sendfile_data as its only file */
+static uint8_t sendfile_data[SENDFILE_SIZE];
+static off_t sendfile_pos;
+
+static int sendfile_fs_open(struct fs_file_t *filp, const char *fs_path,
+			    fs_mode_t flags)
+{
+	sendfile_pos = 0;
+
+	return 0;
+}
+
+static ssize_t sendfile_fs_read(struct fs_file_t *filp, void *dest, size_t nbytes)
+{
+	nbytes = MIN(nbytes, sizeof(sendfile_data) - sendfile_pos);
+	memcpy(dest, sendfile_data + sendfile_pos, nbytes);
+	sendfile_pos += nbytes;
+
+	return nbytes;
+}
+
+static int sendfile_fs_lseek(struct fs_file_t *filp, off_t off, int whence)
+{
+	if (whence == FS_SEEK_CUR) {
+		off += sendfile_pos;
+	} else if (whence == FS_SEEK_END) {
+		off += sizeof(sendfile_data);
+	}
+
+	if (off < 0 || off > sizeof(sendfile_data)) {
+		return -EINVAL;
+	}
+
+	sendfile_pos = off;
+
+	return 0;
+}
+
+static off_t sendfile_fs_tell(struct fs_file_t *filp)
+{
+	return sendfile_pos;
+}
+
+static int sendfile_fs_close(struct fs_file_t *filp)
+{
+	return 0;
+}
+
+static int sendfile_fs_mount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static int sendfile_fs_unmount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static const struct fs_file_system_t sendfile_fs = {
+	.open = sendfile_fs_open,
+	.read = sendfile_fs_read,
+	.lseek = sendfile_fs_lseek,
+	.tell = sendfile_fs_tell,
+	.close = sendfile_fs_close,
+	.mount = sendfile_fs_mount,
+	.unmount = sendfile_fs_unmount,
+};
+
+static struct fs_mount_t sendfile_mnt = {
+	.type = FS_TYPE_EXTERNAL_BASE,
+	.mnt_point = SENDFILE_MNTP,
+};
+
+static void sendfile_create(struct fs_file_t *file)
+{
+	int ret;
+
+	for (int i = 0; i < sizeof(sendfile_data); i++) {
+		sendfile_data[i] = i % 251;
+	}
+
+	ret = fs_register(FS_TYPE_EXTERNAL_BASE, &sendfile_fs);
+	zassert_ok(ret, "fs_register failed (%d)", ret);
+	ret = fs_mount(&sendfile_mnt);
+	zassert_ok(ret, "fs_mount failed (%d)", ret);
+
+	fs_file_t_init(file);
+	ret = fs_open(file, SENDFILE_PATH, FS_O_READ);
+	zassert_ok(ret, "fs_open failed (%d)", ret);
+}
+
+static void sendfile_recv(int sock, const uint8_t *expected, size_t len)
+{
+	uint8_t rx_buf[256];
+	size_t total = 0;
+	ssize_t ret;
+
+	while (total < len) {
+		ret = zsock_recv(sock, rx_buf, MIN(sizeof(rx_buf), len - total), 0);
+		zassert_true(ret > 0, "recv failed (%d)", errno);
+		zassert_mem_equal(rx_buf, expected + total, ret, "unexpected data");
+		total += ret;
+	}
+}
+
+ZTEST(net_socket_tcp, test_v4_sendfile)
+{
+	/* Test if sendfile() streams file data correctly to a TCP socket. */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct fs_file_t file;
+	off_t offset = SENDFILE_OFFSET;
+	ssize_t ret;
+
+	sendfile_create(&file);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	/* Explicit offset, the file position must not change */
+	ret = zsock_sendfile(c_sock, &file, &offset, SENDFILE_SIZE);
+	zassert_equal(ret, SENDFILE_SIZE - SENDFILE_OFFSET,
+		      "unexpected sent bytes (%d, %d)", ret, errno);
+	zassert_equal(offset, SENDFILE_SIZE, "offset not updated");
+	zassert_equal(fs_tell(&file), 0, "file position changed");
+
+	sendfile_recv(new_sock, sendfile_data + SENDFILE_OFFSET,
+		      SENDFILE_SIZE - SENDFILE_OFFSET);
+
+	/* Current file position */
+	ret = zsock_sendfile(c_sock, &file, NULL, SENDFILE_OFFSET);
+	zassert_equal(ret, SENDFILE_OFFSET, "unexpected sent bytes (%d, %d)",
+		      ret, errno);
+	zassert_equal(fs_tell(&file), SENDFILE_OFFSET, "file position not advanced");
+
+	sendfile_recv(new_sock, sendfile_data, SENDFILE_OFFSET);
+
+	/* End of file */
+	offset = SENDFILE_SIZE - 10;
+	ret = zsock_sendfile(c_sock, &file, &offset, SENDFILE_SIZE);
+	zassert_equal(ret, 10, "unexpected sent bytes (%d, %d)", ret, errno);
+
+	sendfile_recv(new_sock, sendfile_data + SENDFILE_SIZE - 10, 10);
+
+	test_close(c_sock);
+	test_eof(new_sock);
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	zassert_ok(fs_close(&file), "fs_close failed");
+	zassert_ok(fs_unmount(&sendfile_mnt), "fs_unmount failed");
+	zassert_ok(fs_unregister(FS_TYPE_EXTERNAL_BASE, &sendfile_fs),
+		   "fs_unregister failed");
+
+	test_context_cleanup();
+}
+#endif /* CONFIG_FILE_SYSTEM */
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -12,6 +12,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/net/loopback.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/tls_credentials.h>
+#include <zephyr/sys/byteorder.h>
 #include <mbedtls/ssl.h>
 
 #include "../../socket_helpers.h"
@@ -801,6 +802,406 @@ ZTEST(net_socket_tls, test_v6_dtls_sendmsg)
 	test_dtls_sendmsg(AF_INET6);
 }
 
+#define TLS_TAP_PORT (SERVER_PORT + 1)
+#define TLS_TAP_STACK_SIZE 2048
+
+#define TLS_RECORD_HEADER_LEN 5
+#define TLS_RECORD_CHANGE_CIPHER_SPEC 20
+#define TLS_RECORD_HANDSHAKE 22
+#define TLS_RECORD_APPLICATION_DATA 23
+#define TLS_HANDSHAKE_NEW_SESSION_TICKET 4
+
+enum tls_tap_dir {
+	TLS_TAP_FROM_CLIENT,
+	TLS_TAP_FROM_SERVER,
+	TLS_TAP_DIRS,
+};
+
+/* Plain TCP relay between a TLS client and a TLS server, counting the TLS
+ * records going through it.
+ */
+struct tls_tap_stream {
+	uint8_t hdr[TLS_RECORD_HEADER_LEN];
+	size_t hdr_len;
+	size_t body_left;
+	bool ccs_sent;
+	bool hs_type_next;
+	int app_data_records;
+	int new_session_tickets;
+};
+
+struct tls_tap {
+	int listen_sock;
+	int sock[TLS_TAP_DIRS];
+	struct sockaddr_in6 server_addr;
+	struct tls_tap_stream stream[TLS_TAP_DIRS];
+	/* Side that sent the first ChangeCipherSpec. The server sends it
+	 * first only when it resumes a session.
+	 */
+	int first_ccs;
+};
+
+K_THREAD_STACK_DEFINE(tls_tap_stack, TLS_TAP_STACK_SIZE);
+static struct k_thread tls_tap_thread;
+static struct tls_tap tls_tap;
+
+static void tls_tap_count(struct tls_tap *tap, enum tls_tap_dir dir,
+			  const uint8_t *buf, size_t len)
+{
+	struct tls_tap_stream *stream = &tap->stream[dir];
+	size_t skip;
+
+	while (len > 0) {
+		if (stream->body_left > 0) {
+			/* Handshake messages are only readable before the
+			 * ChangeCipherSpec.
+			 */
+			if (stream->hs_type_next) {
+				stream->hs_type_next = false;
+				if (*buf == TLS_HANDSHAKE_NEW_SESSION_TICKET) {
+					stream->new_session_tickets++;
+				}
+			}
+
+			skip = MIN(len, stream->body_left);
+			stream->body_left -= skip;
+			buf += skip;
+			len -= skip;
+			continue;
+		}
+
+		stream->hdr[stream->hdr_len++] = *buf++;
+		len--;
+
+		if (stream->hdr_len < TLS_RECORD_HEADER_LEN) {
+			continue;
+		}
+
+		stream->hdr_len = 0;
+		stream->body_left = sys_get_be16(&stream->hdr[3]);
+
+		switch (stream->hdr[0]) {
+		case TLS_RECORD_CHANGE_CIPHER_SPEC:
+			stream->ccs_sent = true;
+			if (tap->first_ccs < 0) {
+				tap->first_ccs = dir;
+			}
+			break;
+		case TLS_RECORD_HANDSHAKE:
+			stream->hs_type_next = !stream->ccs_sent;
+			break;
+		case TLS_RECORD_APPLICATION_DATA:
+			stream->app_data_records++;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static void tls_tap_thread_fn(void *p1, void *p2, void *p3)
+{
+	struct tls_tap *tap = p1;
+	struct zsock_pollfd fds[TLS_TAP_DIRS];
+	uint8_t buf[128];
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	test_accept(tap->listen_sock, &tap->sock[TLS_TAP_FROM_CLIENT], NULL, 0);
+	test_connect(tap->sock[TLS_TAP_FROM_SERVER],
+		     (struct sockaddr *)&tap->server_addr,
+		     sizeof(tap->server_addr));
+
+	for (int i = 0; i < TLS_TAP_DIRS; i++) {
+		fds[i].fd = tap->sock[i];
+		fds[i].events = ZSOCK_POLLIN;
+	}
+
+	/* Relay until either side closes the connection */
+	while (zsock_poll(fds, ARRAY_SIZE(fds), -1) > 0) {
+		for (int i = 0; i < TLS_TAP_DIRS; i++) {
+			if (fds[i].revents == 0) {
+				continue;
+			}
+
+			ret = zsock_recv(tap->sock[i], buf, sizeof(buf), 0);
+			if (ret <= 0) {
+				goto out;
+			}
+
+			tls_tap_count(tap, i, buf, ret);
+
+			if (zsock_send(tap->sock[1 - i], buf, ret, 0) != ret) {
+				goto out;
+			}
+		}
+	}
+
+out:
+	for (int i = 0; i < TLS_TAP_DIRS; i++) {
+		test_close(tap->sock[i]);
+		tap->sock[i] = -1;
+	}
+}
+
+/* Listen for TLS clients on the tap address, relaying to server_addr */
+static void tls_tap_init(struct tls_tap *tap, const struct sockaddr_in6 *server_addr,
+			 struct sockaddr_in6 *tap_addr)
+{
+	tap->server_addr = *server_addr;
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, TLS_TAP_PORT, &tap->listen_sock, tap_addr);
+	test_bind(tap->listen_sock, (struct sockaddr *)tap_addr, sizeof(*tap_addr));
+	test_listen(tap->listen_sock);
+}
+
+/* Relay and count the records of the next connection */
+static void tls_tap_start(struct tls_tap *tap)
+{
+	struct sockaddr_in6 addr;
+
+	memset(tap->stream, 0, sizeof(tap->stream));
+	tap->first_ccs = -1;
+	tap->sock[TLS_TAP_FROM_CLIENT] = -1;
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, ANY_PORT, &tap->sock[TLS_TAP_FROM_SERVER], &addr);
+
+	k_thread_create(&tls_tap_thread, tls_tap_stack,
+			K_THREAD_STACK_SIZEOF(tls_tap_stack),
+			tls_tap_thread_fn, tap, NULL, NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+}
+
+/* Wait for the relayed connection to be closed */
+static void tls_tap_wait(struct tls_tap *tap)
+{
+	ARG_UNUSED(tap);
+
+	zassert_ok(k_thread_join(&tls_tap_thread, K_SECONDS(1)),
+		   "Tap connection not closed");
+}
+
+static void tls_tap_close(struct tls_tap *tap)
+{
+	test_close(tap->listen_sock);
+	tap->listen_sock = -1;
+}
+
+ZTEST(net_socket_tls, test_tls_sendmsg)
+{
+	static uint8_t large_buf[600];
+	static uint8_t rx_buf[sizeof(large_buf) + 3 * (sizeof(TEST_STR_SMALL) - 1)];
+	struct iovec iov[5] = {
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+		{},
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+		{
+			.iov_base = large_buf,
+			.iov_len = sizeof(large_buf),
+		},
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+	};
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	size_t off = 0;
+	uint8_t *ptr;
+	int ret;
+
+	memset(large_buf, 'a', sizeof(large_buf));
+
+	test_prepare_tls_connection(AF_INET6);
+
+	/* Small buffers are coalesced, a large one in the middle flushes them */
+	test_sendmsg(c_sock, &msg, 0);
+
+	while (off < sizeof(rx_buf)) {
+		ret = zsock_recv(new_sock, rx_buf + off, sizeof(rx_buf) - off, 0);
+		zassert_true(ret > 0, "recv() failed");
+		off += ret;
+	}
+
+	ptr = rx_buf;
+	for (int i = 0; i < ARRAY_SIZE(iov); i++) {
+		zassert_mem_equal(ptr, iov[i].iov_base, iov[i].iov_len,
+				  "Invalid data received from iov %d", i);
+		ptr += iov[i].iov_len;
+	}
+
+	ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "recv() should've failed");
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+#define TLS_RECORD_OVERHEAD 81
+
+ZTEST(net_socket_tls, test_tls_sendmsg_partial)
+{
+	static const char second_str[] = "TEST";
+	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1] = { 0 };
+	int buf_optval = TLS_RECORD_OVERHEAD + sizeof(TEST_STR_SMALL) - 1;
+	struct iovec iov[2] = {
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+		{
+			.iov_base = (void *)second_str,
+			.iov_len = sizeof(second_str) - 1,
+		},
+	};
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	int ret;
+
+	/* Coalesced buffers are sent in a single record */
+	if (CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE > 0) {
+		ztest_test_skip();
+	}
+
+	test_prepare_tls_connection(AF_INET6);
+
+	/* Leave room in the window for a single record */
+	ret = zsock_setsockopt(new_sock, SOL_SOCKET, SO_RCVBUF, &buf_optval,
+			       sizeof(buf_optval));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	test_send(c_sock, TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1, 0);
+
+	/* Wait for ACK (empty window, min. 100 ms due to silly window
+	 * protection).
+	 */
+	k_sleep(K_MSEC(150));
+
+	ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(ret, sizeof(rx_buf), "recv() failed");
+
+	/* Wait for the window to update. */
+	k_sleep(K_MSEC(10));
+
+	/* Only the first buffer fits, the data sent is reported */
+	ret = zsock_sendmsg(c_sock, &msg, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, iov[0].iov_len, "sendmsg() should've sent %zu bytes, got %d",
+		      iov[0].iov_len, ret);
+
+	ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(ret, sizeof(rx_buf), "recv() failed");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, ret, "Invalid data received");
+
+	k_sleep(K_MSEC(10));
+
+	/* Sending the rest must not duplicate the data sent already */
+	test_send(c_sock, second_str, sizeof(second_str) - 1, 0);
+
+	ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(ret, sizeof(second_str) - 1, "recv() failed");
+	zassert_mem_equal(rx_buf, second_str, ret, "Invalid data received");
+
+	ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "recv() should've failed");
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST(net_socket_tls, test_tls_sendmsg_records)
+{
+	uint8_t rx_buf[3 * (sizeof(TEST_STR_SMALL) - 1)];
+	struct iovec iov[3] = {
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+	};
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	/* Coalesced buffers are sent in a single record, otherwise each
+	 * buffer is sent in a record of its own.
+	 */
+	int records = CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE > 0 ? 1 : ARRAY_SIZE(iov);
+	struct sockaddr_in6 c_saddr, s_saddr, tap_saddr;
+	struct connect_data test_data;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	size_t off = 0;
+	int ret;
+
+	prepare_sock_tls_v6(MY_IPV6_ADDR, ANY_PORT, &c_sock, &c_saddr,
+			    IPPROTO_TLS_1_2);
+	prepare_sock_tls_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_saddr,
+			    IPPROTO_TLS_1_2);
+
+	test_config_psk(s_sock, c_sock);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	tls_tap_init(&tls_tap, &s_saddr, &tap_saddr);
+	tls_tap_start(&tls_tap);
+
+	test_data.sock = c_sock;
+	test_data.addr = (struct sockaddr *)&tap_saddr;
+	k_work_init_delayable(&test_data.work, client_connect_work_handler);
+	test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	test_work_wait(&test_data.work);
+
+	test_sendmsg(c_sock, &msg, 0);
+
+	while (off < sizeof(rx_buf)) {
+		ret = zsock_recv(new_sock, rx_buf + off, sizeof(rx_buf) - off, 0);
+		zassert_true(ret > 0, "recv() failed");
+		off += ret;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(iov); i++) {
+		zassert_mem_equal(rx_buf + i * iov[i].iov_len, iov[i].iov_base,
+				  iov[i].iov_len, "Invalid data received from iov %d", i);
+	}
+
+	/* The records are counted before the tap relays them */
+	zassert_equal(tls_tap.stream[TLS_TAP_FROM_CLIENT].app_data_records, records,
+		      "sendmsg() sent %d records, expected %d",
+		      tls_tap.stream[TLS_TAP_FROM_CLIENT].app_data_records, records);
+
+	test_sockets_close();
+	tls_tap_wait(&tls_tap);
+	tls_tap_close(&tls_tap);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 struct close_data {
 	struct k_work_delayable work;
 	int *fd;
@@ -1165,8 +1566,6 @@ ZTEST(net_socket_tls, test_recv_eof_on_close)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
-#define TLS_RECORD_OVERHEAD 81
-
 ZTEST(net_socket_tls, test_send_non_block)
 {
 	int ret;
@@ -1542,6 +1941,121 @@ ZTEST(net_socket_tls, test_send_while_recv)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+#define WRONG_PSK_TAG 2
+
+static const unsigned char wrong_psk[] = {
+	0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
+	0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00
+};
+
+/* Connect a client with session caching to the server through the tap, and
+ * exchange data.
+ */
+static void test_session_ticket_connect(sec_tag_t sec_tag, struct sockaddr_in6 *tap_saddr)
+{
+	sec_tag_t sec_tag_list[] = { sec_tag };
+	int cache = TLS_SESSION_CACHE_ENABLED;
+	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1];
+	struct sockaddr_in6 c_saddr;
+	struct connect_data test_data;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int ret;
+
+	prepare_sock_tls_v6(MY_IPV6_ADDR, ANY_PORT, &c_sock, &c_saddr,
+			    IPPROTO_TLS_1_2);
+
+	zassert_ok(zsock_setsockopt(c_sock, SOL_TLS, TLS_SEC_TAG_LIST,
+				    sec_tag_list, sizeof(sec_tag_list)),
+		   "Failed to set PSK on client socket");
+	zassert_ok(zsock_setsockopt(c_sock, SOL_TLS, TLS_SESSION_CACHE,
+				    &cache, sizeof(cache)),
+		   "Failed to enable session cache on client socket");
+
+	tls_tap_start(&tls_tap);
+
+	test_data.sock = c_sock;
+	test_data.addr = (struct sockaddr *)tap_saddr;
+	k_work_init_delayable(&test_data.work, client_connect_work_handler);
+	test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	test_work_wait(&test_data.work);
+
+	test_send(c_sock, TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1, 0);
+
+	ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(ret, sizeof(TEST_STR_SMALL) - 1, "recv() failed");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, ret, "Invalid data received");
+
+	test_close(c_sock);
+	c_sock = -1;
+	test_close(new_sock);
+	new_sock = -1;
+
+	tls_tap_wait(&tls_tap);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST(net_socket_tls, test_session_ticket_resumption)
+{
+	int cache = TLS_SESSION_CACHE_ENABLED;
+	struct sockaddr_in6 s_saddr, tap_saddr;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_MBEDTLS_TLS_SESSION_TICKETS);
+
+	prepare_sock_tls_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_saddr,
+			    IPPROTO_TLS_1_2);
+
+	test_config_psk(s_sock, -1);
+
+	(void)tls_credential_delete(WRONG_PSK_TAG, TLS_CREDENTIAL_PSK);
+	(void)tls_credential_delete(WRONG_PSK_TAG, TLS_CREDENTIAL_PSK_ID);
+
+	zassert_ok(tls_credential_add(WRONG_PSK_TAG, TLS_CREDENTIAL_PSK,
+				      wrong_psk, sizeof(wrong_psk)),
+		   "Failed to register PSK");
+	zassert_ok(tls_credential_add(WRONG_PSK_TAG, TLS_CREDENTIAL_PSK_ID,
+				      psk_id, strlen(psk_id)),
+		   "Failed to register PSK ID");
+
+	zassert_ok(zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE,
+				    &cache, sizeof(cache)),
+		   "Failed to enable session cache on server socket");
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	tls_tap_init(&tls_tap, &s_saddr, &tap_saddr);
+
+	/* Full handshake, the client keeps the ticket issued by the server */
+	test_session_ticket_connect(PSK_TAG, &tap_saddr);
+
+	zassert_equal(tls_tap.first_ccs, TLS_TAP_FROM_CLIENT,
+		      "First handshake resumed a session");
+	zassert_equal(tls_tap.stream[TLS_TAP_FROM_SERVER].new_session_tickets, 1,
+		      "Server did not issue a session ticket");
+
+	/* A full handshake would fail with the wrong key, resuming the
+	 * session from the ticket does not use it.
+	 */
+	test_session_ticket_connect(WRONG_PSK_TAG, &tap_saddr);
+
+	zassert_equal(tls_tap.first_ccs, TLS_TAP_FROM_SERVER,
+		      "Session not resumed");
+
+	tls_tap_close(&tls_tap);
+
+	zassert_ok(zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE_PURGE,
+				    NULL, 0),
+		   "Failed to purge session cache");
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 ZTEST(net_socket_tls, test_poll_tls_pollin)
 {
 	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1];
@@ -3106,6 +3106,86 @@ ZTEST(net_socket_udp, test_40_clamp_udp_tcp_port_range)
 #endif
 }
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+static K_SEM_DEFINE(zerocopy_done, 0, 1);
+static const void *zerocopy_buf;
+static size_t zerocopy_len;
+
+static void zerocopy_cb(const void *buf, size_t len, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	zerocopy_buf = buf;
+	zerocopy_len = len;
+
+	k_sem_give(&zerocopy_done);
+}
+#endif
+
+ZTEST(net_socket_udp, test_41_v4_zerocopy_send_recv_pkt)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	static const char tx_data[] = TEST_STR2;
+	struct zsock_zerocopy zc = {
+		.cb = zerocopy_cb,
+	};
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct net_pkt *pkt;
+	int client_sock;
+	int server_sock;
+	ssize_t sent;
+	ssize_t recved;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = zsock_setsockopt(client_sock, SOL_SOCKET, SO_ZEROCOPY, &zc,
+			      sizeof(zc));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	k_sem_reset(&zerocopy_done);
+
+	sent = zsock_sendto(client_sock, tx_data, STRLEN(TEST_STR2),
+			    ZSOCK_MSG_ZEROCOPY, (struct sockaddr *)&server_addr,
+			    sizeof(server_addr));
+	zassert_equal(sent, STRLEN(TEST_STR2), "sendto failed (%d)", errno);
+
+	/* The buffer is released once the packet has been sent */
+	rv = k_sem_take(&zerocopy_done, K_MSEC(100));
+	zassert_equal(rv, 0, "No zero-copy completion");
+	zassert_equal_ptr(zerocopy_buf, tx_data, "Wrong buffer completed");
+	zassert_equal(zerocopy_len, STRLEN(TEST_STR2), "Wrong length completed");
+
+	recved = zsock_recv_pkt(server_sock, &pkt, 0);
+	zassert_equal(recved, STRLEN(TEST_STR2), "recv_pkt failed (%d)", errno);
+	zassert_not_null(pkt, "No packet received");
+
+	clear_buf(rx_buf);
+	rv = net_pkt_read(pkt, rx_buf, recved);
+	zassert_equal(rv, 0, "Cannot read packet data");
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR2), "wrong data");
+
+	net_pkt_unref(pkt);
+
+	recved = zsock_recv_pkt(server_sock, &pkt, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(recved, -1, "Unexpected packet");
+	zassert_equal(errno, EAGAIN, "Unexpected errno (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -27,6 +27,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include <zephyr/net/ethernet.h>
 #include <zephyr/net/dummy.h>
 #include <zephyr/net/net_pkt.h>
+#include <zephyr/net/socket.h>
 
 #include "ipv4.h"
 #include "ipv6.h"
@@ -114,6 +115,10 @@ static enum test_case_no {
 	TEST_CLIENT_CLOSING_FAILURE_IPV6 = 16,
 	TEST_CLIENT_FIN_WAIT_2_IPV4_FAILURE = 17,
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
+	TEST_CLIENT_ZEROCOPY = 19,
+	TEST_CLIENT_WINDOW_SCALE = 20,
+	TEST_CLIENT_WINDOW_CLAMP = 21,
+	TEST_CLIENT_AUTOTUNE = 22,
 } test_case_no;
 
 static enum test_state t_state;
@@ -138,6 +143,8 @@ static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
+static void handle_client_zerocopy_test(struct net_pkt *pkt, struct tcphdr *th);
+static void handle_client_window_test(struct net_pkt *pkt, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -246,9 +253,12 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	struct net_pkt *pkt;
 	struct tcphdr *th;
 	uint8_t opts_len = 0;
+	bool with_opts;
 	int ret = -EINVAL;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	with_opts = (test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4 ||
+		     test_case_no == TEST_CLIENT_WINDOW_SCALE) && (flags & SYN);
+	if (with_opts) {
 		opts_len = sizeof(tcp_options);
 	}
 
@@ -284,7 +294,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (with_opts) {
 		th->th_off = 10U;
 	} else {
 		th->th_off = 5U;
@@ -303,7 +313,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (with_opts) {
 		/* Add TCP Options */
 		ret = net_pkt_write(pkt, tcp_options, opts_len);
 		if (ret < 0) {
@@ -490,6 +500,14 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_CLIENT_FIN_ACK_WITH_DATA:
 		handle_client_fin_ack_with_data_test(net_pkt_family(pkt), &th);
 		break;
+	case TEST_CLIENT_ZEROCOPY:
+		handle_client_zerocopy_test(pkt, &th);
+		break;
+	case TEST_CLIENT_WINDOW_SCALE:
+	case TEST_CLIENT_WINDOW_CLAMP:
+	case TEST_CLIENT_AUTOTUNE:
+		handle_client_window_test(pkt, &th);
+		break;
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -719,6 +737,12 @@ static void handle_server_test(sa_family_t af, struct tcphdr *th)
 		break;
 	case T_SYN_ACK:
 		test_verify_flags(th, SYN | ACK);
+
+		/* MSS option, and window scale option if the peer sent one */
+		zassert_equal(th->th_off,
+			      (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+			       test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) ? 7U : 6U,
+			      "Invalid TCP header length %u", th->th_off);
 		seq++;
 		ack = ntohl(th->th_seq) + 1U;
 		reply = prepare_ack_packet(af, htons(MY_PORT),
@@ -2602,4 +2626,426 @@ ZTEST(net_tcp, test_client_fin_ack_with_data)
 	}
 }
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+static K_SEM_DEFINE(zerocopy_done, 0, 1);
+static uint8_t zerocopy_data = 0x5a; /* "Z" */
+static bool zerocopy_referenced;
+static const void *zerocopy_buf;
+static size_t zerocopy_len;
+
+static void zerocopy_cb(const void *buf, size_t len, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	zerocopy_buf = buf;
+	zerocopy_len = len;
+
+	k_sem_give(&zerocopy_done);
+}
+
+static void handle_client_zerocopy_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	if (t_state == T_DATA) {
+		/* The segment must point to the application buffer */
+		for (struct net_buf *buf = pkt->buffer; buf; buf = buf->frags) {
+			if (buf->data == &zerocopy_data && buf->len == 1U) {
+				zerocopy_referenced = true;
+			}
+		}
+
+		zassert_equal(k_sem_count_get(&zerocopy_done), 0,
+			      "Buffer completed before the ACK");
+	}
+
+	handle_client_test(net_pkt_family(pkt), th);
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   send zero-copy Data,
+ *   expect the segment to reference the application buffer,
+ *   expect ACK,
+ *   expect the buffer to be completed,
+ *   send FIN,
+ *   expect FIN ACK,
+ *   send ACK.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_zerocopy)
+{
+	struct net_context_zerocopy zc = {
+		.cb = zerocopy_cb,
+	};
+	struct iovec io_vector = {
+		.iov_base = &zerocopy_data,
+		.iov_len = sizeof(zerocopy_data),
+	};
+	struct msghdr msg = {
+		.msg_iov = &io_vector,
+		.msg_iovlen = 1,
+	};
+	struct net_context *ctx;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = TEST_CLIENT_ZEROCOPY;
+	seq = ack = 0;
+	zerocopy_referenced = false;
+	zerocopy_buf = NULL;
+	zerocopy_len = 0;
+	k_sem_reset(&zerocopy_done);
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_set_option(ctx, NET_OPT_ZEROCOPY, &zc, sizeof(zc));
+	zassert_equal(ret, 0, "Failed to set zero-copy option");
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to SYN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	ret = net_context_sendmsg(ctx, &msg, ZSOCK_MSG_ZEROCOPY, NULL,
+				  K_NO_WAIT, NULL);
+	zassert_equal(ret, sizeof(zerocopy_data), "Failed to send data to peer");
+
+	/* Peer will release the semaphore after it sends ACK for data */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_true(zerocopy_referenced, "Segment did not reference the buffer");
+
+	ret = k_sem_take(&zerocopy_done, K_MSEC(100));
+	zassert_equal(ret, 0, "Buffer not completed after the ACK");
+	zassert_equal_ptr(zerocopy_buf, &zerocopy_data, "Wrong buffer completed");
+	zassert_equal(zerocopy_len, sizeof(zerocopy_data), "Wrong length completed");
+
+	net_context_put(ctx);
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to FIN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Connection is in TIME_WAIT state, context will be released
+	 * after K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY), so wait for it.
+	 */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+#else
+static void handle_client_zerocopy_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(th);
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
+/* Window scale shift offered by the client in its SYN, -1 if none */
+static int window_shift;
+/* Window field of the last ACK sent by the client */
+static uint16_t window_adv;
+static uint16_t window_port;
+static struct net_context *window_ctx;
+static K_SEM_DEFINE(window_recv, 0, 1);
+
+static int read_window_scale(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t opts[40];
+	size_t len = th->th_off * 4U - sizeof(struct tcphdr);
+	int ret = -ENOENT;
+
+	zassert_true(len <= sizeof(opts), "Invalid TCP header length");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 sizeof(struct tcphdr)) < 0 ||
+	    net_pkt_read(pkt, opts, len) < 0) {
+		zassert_true(false, "Failed to read TCP options");
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	for (size_t i = 0; i < len && opts[i] != NET_TCP_END_OPT;) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (i + 2U > len || opts[i + 1] < 2U) {
+			break;
+		}
+
+		if (opts[i] == NET_TCP_WINDOW_SCALE_OPT &&
+		    opts[i + 1] == NET_TCP_WINDOW_SCALE_SIZE) {
+			ret = opts[i + 2];
+			break;
+		}
+
+		i += opts[i + 1];
+	}
+
+	return ret;
+}
+
+static void handle_client_window_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	switch (t_state) {
+	case T_SYN:
+		window_shift = read_window_scale(pkt, th);
+		window_port = th->th_sport;
+
+		if (test_case_no == TEST_CLIENT_WINDOW_CLAMP) {
+			struct tcp *conn = window_ctx->tcp;
+
+			/* Windows larger than 64 kB, as configured with
+			 * NET_TCP_MAX_RECV_WINDOW_SIZE or grown by autotuning.
+			 */
+			conn->recv_win_max = 2U * UINT16_MAX;
+			conn->recv_win = conn->recv_win_max;
+			conn->send_win_max = 2U * UINT16_MAX;
+			conn->send_win = conn->send_win_max;
+		}
+		break;
+	case T_SYN_ACK:
+		window_adv = ntohs(th->th_win);
+		break;
+	case T_DATA:
+		/* ACKs of the data sent by the tester */
+		test_verify_flags(th, ACK);
+		window_adv = ntohs(th->th_win);
+		test_sem_give();
+		return;
+	default:
+		break;
+	}
+
+	handle_client_test(net_pkt_family(pkt), th);
+}
+
+static void window_recv_cb(struct net_context *context, struct net_pkt *pkt,
+			   union net_ip_header *ip_hdr,
+			   union net_proto_header *proto_hdr,
+			   int status, void *user_data)
+{
+	if (!pkt) {
+		return;
+	}
+
+	/* The application has read the data, open the window again */
+	if (test_case_no == TEST_CLIENT_AUTOTUNE) {
+		net_context_update_recv_wnd(context, net_pkt_remaining_data(pkt));
+	}
+
+	net_pkt_unref(pkt);
+	k_sem_give(&window_recv);
+}
+
+static struct net_context *window_connect(enum test_case_no test)
+{
+	struct net_context *ctx;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = test;
+	seq = ack = 0;
+	window_shift = -1;
+	window_adv = 0;
+	k_sem_reset(&window_recv);
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+	window_ctx = ctx;
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to SYN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	ret = net_context_recv(ctx, window_recv_cb, K_NO_WAIT, NULL);
+	zassert_equal(ret, 0, "Failed to recv data from peer");
+
+	/* SYN | ACK of the peer */
+	seq++;
+
+	return ctx;
+}
+
+/* Send data to the client, and wait for its ACK and the application */
+static void window_send_data(size_t len)
+{
+	struct net_pkt *data;
+
+	data = prepare_data_packet(AF_INET, htons(MY_PORT), window_port,
+				   (const uint8_t *)lorem_ipsum, len);
+	zassert_not_null(data, "Failed to prepare data");
+	zassert_ok(net_recv_data(net_iface, data), "Failed to receive data");
+
+	seq += len;
+
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_ok(k_sem_take(&window_recv, K_MSEC(100)), "Data not received");
+}
+
+static void window_close(struct net_context *ctx)
+{
+	t_state = T_FIN;
+
+	net_context_put(ctx);
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to FIN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Connection is in TIME_WAIT state, context will be released
+	 * after K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY), so wait for it.
+	 */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+
+/* Test case scenario IPv4
+ *   send SYN with the window scale option,
+ *   expect SYN ACK with the window scale option,
+ *   send ACK with a scaled window,
+ *   send Data,
+ *   expect the peer window to be scaled,
+ *   expect ACK with a scaled window,
+ *   send FIN,
+ *   expect FIN ACK,
+ *   send ACK.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_window_scale)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	/* Window field of the segments sent by the tester */
+	uint32_t peer_win = ntohs(NET_IPV6_MTU);
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_WINDOW_SCALE);
+
+	ctx = window_connect(TEST_CLIENT_WINDOW_SCALE);
+	conn = ctx->tcp;
+
+	zassert_true(window_shift > 0, "Window scale not offered");
+	zassert_equal(conn->rcv_wscale, window_shift, "Wrong receive shift %u",
+		      conn->rcv_wscale);
+	zassert_equal(conn->snd_wscale, tcp_options[sizeof(tcp_options) - 1],
+		      "Wrong send shift %u", conn->snd_wscale);
+	zassert_equal(window_adv, conn->recv_win >> conn->rcv_wscale,
+		      "Window %u not scaled", window_adv);
+
+	window_send_data(100);
+
+	zassert_equal(conn->send_win, MIN(peer_win << conn->snd_wscale, conn->send_win_max),
+		      "Peer window %u not scaled", conn->send_win);
+	zassert_equal(window_adv, (conn->recv_win_max - 100U) >> conn->rcv_wscale,
+		      "Window %u not scaled", window_adv);
+
+	window_close(ctx);
+}
+
+/* Test case scenario IPv4
+ *   send SYN with windows larger than 64 kB,
+ *   expect SYN ACK without the window scale option,
+ *   send ACK with a window of at most 64 kB,
+ *   send Data,
+ *   expect the peer window not to be scaled,
+ *   expect ACK,
+ *   send FIN,
+ *   expect FIN ACK,
+ *   send ACK.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_window_clamp)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t peer_win = ntohs(NET_IPV6_MTU);
+
+	ctx = window_connect(TEST_CLIENT_WINDOW_CLAMP);
+	conn = ctx->tcp;
+
+	zassert_equal(conn->rcv_wscale, 0U, "Receive window scaled");
+	zassert_equal(conn->snd_wscale, 0U, "Send window scaled");
+	zassert_equal(conn->recv_win_max, UINT16_MAX, "Receive window %u not clamped",
+		      conn->recv_win_max);
+	zassert_equal(conn->send_win_max, UINT16_MAX, "Send window %u not clamped",
+		      conn->send_win_max);
+	zassert_equal(window_adv, UINT16_MAX, "Window %u not clamped", window_adv);
+
+	window_send_data(100);
+
+	zassert_equal(conn->send_win, peer_win, "Peer window %u scaled", conn->send_win);
+	zassert_equal(window_adv, UINT16_MAX - 100U, "Wrong window %u", window_adv);
+
+	window_close(ctx);
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   send Data filling the window during more than a round trip,
+ *   expect the receive window to grow,
+ *   expect ACK with the larger window,
+ *   send FIN,
+ *   expect FIN ACK,
+ *   send ACK.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_autotune)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t win_max;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_AUTOTUNE);
+
+	ctx = window_connect(TEST_CLIENT_AUTOTUNE);
+	conn = ctx->tcp;
+	win_max = conn->recv_win_max;
+
+	/* The first segment starts the round trip measurement, which ends
+	 * when the data reaches the window edge advertised then.
+	 */
+	window_send_data(500);
+	k_sleep(K_MSEC(20));
+
+	for (size_t sent = 0; sent <= win_max; sent += 500U) {
+		window_send_data(500);
+	}
+
+#if defined(CONFIG_NET_TCP_AUTOTUNE)
+	zassert_true(conn->tune.rcv_rtt >= 20U, "Round trip %u ms not measured",
+		     conn->tune.rcv_rtt);
+#endif
+	zassert_true(conn->recv_win_max > win_max, "Receive window %u not grown",
+		     conn->recv_win_max);
+	zassert_true((uint32_t)window_adv << conn->rcv_wscale > win_max,
+		     "Window %u not advertised", window_adv);
+
+	window_close(ctx);
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -1367,6 +1367,85 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+static uint8_t copydata[CHECKSUM_TEST_LENGTH + 8];
+
+ZTEST(test_utils_fn, test_ip_checksum_copy)
+{
+	uint16_t sum_got;
+	uint16_t sum_exp;
+
+	for (int i = 0; i < CHECKSUM_TEST_LENGTH; i++) {
+		testdata[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	/* Cover all combinations of source and destination alignment */
+	for (int src_off = 0; src_off < 4; src_off++) {
+		for (int dst_off = 0; dst_off < 4; dst_off++) {
+			for (int length = 1; length <= 67; length++) {
+				memset(copydata, 0, sizeof(copydata));
+
+				sum_exp = calc_chksum_ref(length ^ 0x4d21, testdata + src_off,
+							  length);
+				sum_got = calc_chksum_copy(length ^ 0x4d21, copydata + dst_off,
+							   testdata + src_off, length);
+
+				zassert_equal(sum_got, sum_exp,
+					      "Mismatch between reference and copied checksum\n");
+				zassert_mem_equal(copydata + dst_off, testdata + src_off, length,
+						  "Data not copied\n");
+				zassert_equal(copydata[dst_off + length], 0, "Copied too much\n");
+			}
+		}
+	}
+
+	sum_exp = calc_chksum_ref(0, testdata, CHECKSUM_TEST_LENGTH);
+	sum_got = calc_chksum_copy(0, copydata, testdata, CHECKSUM_TEST_LENGTH);
+
+	zassert_equal(sum_got, sum_exp, "Mismatch for a full sized packet\n");
+}
+
+ZTEST(test_utils_fn, test_ip_checksum_update)
+{
+	uint8_t hdr[] = {
+		0x45, 0x00, 0x00, 0x54, 0x12, 0x34, 0x40, 0x00,
+		0x40, 0x01, 0x00, 0x00, 0xc0, 0x00, 0x02, 0x01,
+		0xc0, 0x00, 0x02, 0x02,
+	};
+	uint16_t *chksum = (uint16_t *)&hdr[10];
+	uint16_t old_val, new_val;
+	uint32_t old_addr, new_addr;
+
+	*chksum = ~calc_chksum(0, hdr, sizeof(hdr));
+	*chksum = htons(*chksum);
+
+	/* Decrement TTL, as a router would do */
+	old_val = UNALIGNED_GET((uint16_t *)&hdr[8]);
+	hdr[8]--;
+	new_val = UNALIGNED_GET((uint16_t *)&hdr[8]);
+
+	*chksum = net_chksum_update16(*chksum, old_val, new_val);
+	zassert_equal(calc_chksum(0, hdr, sizeof(hdr)), 0xffff,
+		      "Invalid checksum after TTL update\n");
+
+	/* Change total length */
+	old_val = UNALIGNED_GET((uint16_t *)&hdr[2]);
+	new_val = htons(1500);
+	UNALIGNED_PUT(new_val, (uint16_t *)&hdr[2]);
+
+	*chksum = net_chksum_update16(*chksum, old_val, new_val);
+	zassert_equal(calc_chksum(0, hdr, sizeof(hdr)), 0xffff,
+		      "Invalid checksum after length update\n");
+
+	/* Rewrite the source address, as NAT would do */
+	old_addr = UNALIGNED_GET((uint32_t *)&hdr[12]);
+	new_addr = htonl(0x0a000001);
+	UNALIGNED_PUT(new_addr, (uint32_t *)&hdr[12]);
+
+	*chksum = net_chksum_update32(*chksum, old_addr, new_addr);
+	zassert_equal(calc_chksum(0, hdr, sizeof(hdr)), 0xffff,
+		      "Invalid checksum after address update\n");
+}
+
 /* Verify that the net_pkt pointer to the received link layer address
  * is correct.
  */
@@ -16,6 +16,17 @@
 #define CONFIG_LOG_BUFFER_SIZE 4
 #endif
 
+#ifndef CONFIG_LOG_RATE_LIMIT_REPORT_DELAY
+#define CONFIG_LOG_RATE_LIMIT_REPORT_DELAY 0
+#endif
+
+/* Messages logged by the test thread go to the buffer of its CPU. */
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+#define TEST_LOG_BUFFER_SIZE (CONFIG_LOG_BUFFER_SIZE / CONFIG_MP_MAX_NUM_CPUS)
+#else
+#define TEST_LOG_BUFFER_SIZE CONFIG_LOG_BUFFER_SIZE
+#endif
+
 #ifndef NO_BACKENDS
 #define NO_BACKENDS 0
 #endif
@@ -345,7 +356,7 @@ ZTEST(test_log_api, test_log_backend_runtime_filtering)
 
 static size_t get_max_hexdump(void)
 {
-	return CONFIG_LOG_BUFFER_SIZE - sizeof(struct log_msg_hdr);
+	return TEST_LOG_BUFFER_SIZE - sizeof(struct log_msg_hdr);
 }
 
 #if defined(CONFIG_ARCH_POSIX)
@@ -373,7 +384,7 @@ static size_t get_long_hexdump(void)
 		extra_msg_sz += sizeof(uint8_t); /* Location of format string. */
 	}
 
-	return CONFIG_LOG_BUFFER_SIZE -
+	return TEST_LOG_BUFFER_SIZE -
 		/* First message */
 		ROUND_UP(LOG_SIMPLE_MSG_LEN + 2 * sizeof(int) + extra_msg_sz,
 			 CBPRINTF_PACKAGE_ALIGNMENT) -
@@ -387,7 +398,7 @@ static size_t get_long_hexdump(void)
  * there is no room. However, if after discarding all messages there is still no
  * room then current log is discarded.
  */
-static uint8_t log_buf[CONFIG_LOG_BUFFER_SIZE];
+static uint8_t log_buf[TEST_LOG_BUFFER_SIZE];
 
 ZTEST(test_log_api, test_log_overflow)
 {
@@ -403,7 +414,7 @@ ZTEST(test_log_api, test_log_overflow)
 		ztest_test_skip();
 	}
 
-	for (int i = 0; i < CONFIG_LOG_BUFFER_SIZE; i++) {
+	for (int i = 0; i < TEST_LOG_BUFFER_SIZE; i++) {
 		log_buf[i] = i;
 	}
 
@@ -597,7 +608,7 @@ ZTEST(test_log_api, test_log_from_declared_module)
  */
 static size_t get_short_msg_capacity(void)
 {
-	return CONFIG_LOG_BUFFER_SIZE / LOG_SIMPLE_MSG_LEN;
+	return TEST_LOG_BUFFER_SIZE / LOG_SIMPLE_MSG_LEN;
 }
 
 static void log_n_messages(uint32_t n_msg, uint32_t exp_dropped)
@@ -662,6 +673,142 @@ ZTEST(test_log_api_1cpu, test_log_msg_dropped_notification)
 	log_n_messages(capacity + 2, 2);
 }
 
+/*
+ * Test checks that messages dropped from the buffer of a CPU are accounted
+ * to that CPU.
+ */
+ZTEST(test_log_api_1cpu, test_log_cpu_dropped)
+{
+	uint32_t dropped_before;
+	uint32_t dropped;
+	unsigned int cpu;
+	unsigned int key;
+	int err;
+
+	if (!IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS) || !IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW)) {
+		zassert_equal(log_cpu_dropped_get(0, &dropped), -ENOTSUP);
+		ztest_test_skip();
+	}
+
+	zassert_equal(log_cpu_dropped_get(CONFIG_MP_MAX_NUM_CPUS, &dropped), -EINVAL);
+
+	/* Other CPUs are stopped, the test thread stays on this one. */
+	key = arch_irq_lock();
+	cpu = CPU_ID;
+	arch_irq_unlock(key);
+
+	err = log_cpu_dropped_get(cpu, &dropped_before);
+	zassert_equal(err, 0);
+
+	log_n_messages(get_short_msg_capacity() + 2, 2);
+
+	err = log_cpu_dropped_get(cpu, &dropped);
+	zassert_equal(err, 0);
+	zassert_equal(dropped - dropped_before, 2);
+}
+
+/*
+ * Test checks that messages of a source exceeding its rate limit or sampling
+ * and duplicate messages are dropped before they are allocated, and that the
+ * number of dropped messages is reported before the next logged message or
+ * once the source stays quiet.
+ */
+ZTEST(test_log_api, test_log_rate_limit)
+{
+	log_timestamp_t exp_timestamp = TIMESTAMP_INIT_VAL;
+	int16_t id = LOG_CURRENT_MODULE_ID();
+	struct log_rate_limit_config config;
+	struct log_rate_limit_stats stats;
+
+	if (!IS_ENABLED(CONFIG_LOG_RATE_LIMIT)) {
+		zassert_equal(log_rate_limit_get(id, &config), -ENOTSUP);
+		ztest_test_skip();
+	}
+
+	log_setup(false);
+
+	zassert_equal(log_rate_limit_get(-1, &config), -EINVAL);
+	zassert_equal(log_rate_limit_get(id, &config), 0);
+
+	/* Burst of 2 messages, then 1 message every 100 ms */
+	config.rate = 10;
+	config.burst = 2;
+	zassert_equal(log_rate_limit_set(id, &config), 0);
+
+	mock_log_backend_record(&backend1, id, Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_INF,
+				exp_timestamp++, "test 0");
+	mock_log_backend_record(&backend1, id, Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_INF,
+				exp_timestamp++, "test 1");
+	mock_log_backend_record(&backend1, id, Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_WRN,
+				exp_timestamp++, "1 messages dropped by rate limiting");
+	mock_log_backend_record(&backend1, id, Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_INF,
+				exp_timestamp++, "test 3");
+
+	for (int i = 0; i < 3; i++) {
+		LOG_INF("test %d", i);
+	}
+
+	k_msleep(100);
+	LOG_INF("test %d", 3);
+
+	process_and_validate(false, false);
+
+	/* Duplicates of the last message are suppressed */
+	config.rate = 0;
+	config.duplicates = true;
+	zassert_equal(log_rate_limit_set(id, &config), 0);
+
+	mock_log_backend_reset(&backend1);
+	mock_log_backend_record(&backend1, id, Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_INF,
+				exp_timestamp++, "test 4");
+	mock_log_backend_record(&backend1, id, Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_WRN,
+				exp_timestamp++, "last message repeated 2 times");
+	mock_log_backend_record(&backend1, id, Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_INF,
+				exp_timestamp++, "test 5");
+
+	for (int i = 0; i < 3; i++) {
+		LOG_INF("test %d", 4);
+	}
+
+	LOG_INF("test %d", 5);
+
+	process_and_validate(false, false);
+
+	/* 1 in 2 messages is logged */
+	config.sample = 2;
+	config.duplicates = false;
+	zassert_equal(log_rate_limit_set(id, &config), 0);
+
+	mock_log_backend_reset(&backend1);
+	mock_log_backend_record(&backend1, id, Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_INF,
+				exp_timestamp++, "test 6");
+	mock_log_backend_record(&backend1, id, Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_WRN,
+				exp_timestamp++, "1 messages dropped by rate limiting");
+	mock_log_backend_record(&backend1, id, Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_INF,
+				exp_timestamp++, "test 8");
+
+	for (int i = 6; i < 10; i++) {
+		LOG_INF("test %d", i);
+	}
+
+	process_and_validate(false, false);
+
+	zassert_equal(log_rate_limit_stats_get(id, &stats), 0);
+	zassert_equal(stats.logged, 7);
+	zassert_equal(stats.rate_dropped, 1);
+	zassert_equal(stats.sampled_out, 2);
+	zassert_equal(stats.repeated, 2);
+
+	/* Messages suppressed last are reported once the source stays quiet */
+	mock_log_backend_reset(&backend1);
+	mock_log_backend_record(&backend1, id, Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_WRN,
+				exp_timestamp++, "1 messages dropped by rate limiting");
+
+	k_msleep(CONFIG_LOG_RATE_LIMIT_REPORT_DELAY + 10);
+
+	process_and_validate(false, false);
+}
+
 /* Test checks if panic is correctly executed. On panic logger should flush all
  * messages and process logs in place (not in deferred way).
  */
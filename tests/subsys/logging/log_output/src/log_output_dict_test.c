@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test framed dictionary based log stream
+ */
+
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define TEST_STR "test"
+
+static uint8_t mock_buffer[256];
+static uint32_t mock_len;
+static uint8_t log_output_buf[4];
+
+static uint8_t __aligned(Z_LOG_MSG_ALIGNMENT) msg_buf[128];
+
+static int mock_output_func(uint8_t *buf, size_t size, void *ctx)
+{
+	memcpy(&mock_buffer[mock_len], buf, size);
+	mock_len += size;
+
+	return size;
+}
+
+LOG_OUTPUT_DEFINE(log_output_dict, mock_output_func,
+		  log_output_buf, sizeof(log_output_buf));
+
+static uint16_t crc16_ccitt_false(const uint8_t *buf, size_t len)
+{
+	uint16_t crc = 0xFFFF;
+
+	for (size_t i = 0; i < len; i++) {
+		crc ^= (uint16_t)buf[i] << 8;
+
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+
+	return crc;
+}
+
+static struct log_msg *msg_create(log_timestamp_t timestamp)
+{
+	struct log_msg *msg = (struct log_msg *)msg_buf;
+	int len;
+
+	memset(msg_buf, 0, sizeof(msg_buf));
+
+	len = cbprintf_package(msg->data, sizeof(msg_buf) - sizeof(struct log_msg), 0,
+			       TEST_STR);
+	zassert_true(len > 0);
+
+	msg->hdr.desc.type = Z_LOG_MSG_LOG;
+	msg->hdr.desc.level = LOG_LEVEL_INF;
+	msg->hdr.desc.package_len = len;
+	msg->hdr.timestamp = timestamp;
+
+	return msg;
+}
+
+/* Check the frame at the offset and return the offset of its payload. */
+static size_t frame_check(size_t offset, uint16_t exp_seq)
+{
+	struct log_dict_output_frame_hdr_t frame;
+	uint16_t crc;
+
+	zassert_true(offset + sizeof(frame) <= mock_len);
+	memcpy(&frame, &mock_buffer[offset], sizeof(frame));
+
+	zassert_equal(frame.sof[0], LOG_DICT_OUTPUT_FRAME_SOF0);
+	zassert_equal(frame.sof[1], LOG_DICT_OUTPUT_FRAME_SOF1);
+	zassert_equal(frame.seq, exp_seq);
+	zassert_true(offset + sizeof(frame) + frame.len + sizeof(crc) <= mock_len);
+
+	memcpy(&crc, &mock_buffer[offset + sizeof(frame) + frame.len], sizeof(crc));
+	zassert_equal(crc, crc16_ccitt_false(&mock_buffer[offset + sizeof(frame.sof)],
+					     sizeof(frame) - sizeof(frame.sof) + frame.len));
+
+	return offset + sizeof(frame);
+}
+
+ZTEST(test_log_output_dict, test_stream)
+{
+	struct log_msg *msg = msg_create(1000);
+	size_t package_len = msg->hdr.desc.package_len;
+	size_t offset;
+	size_t second;
+
+	log_dict_output_msg_process(&log_output_dict, msg, 0);
+	second = mock_len;
+
+	msg = msg_create(1010);
+	log_dict_output_msg_process(&log_output_dict, msg, 0);
+
+	/* First frame carries the full timestamp, 1000 shifted left with bit 0 set */
+	offset = frame_check(0, 0);
+	zassert_equal(mock_buffer[offset++], MSG_NORMAL_COMPACT);
+	zassert_equal(mock_buffer[offset++], LOG_LEVEL_INF << 4);
+	zassert_equal(mock_buffer[offset++], 0, "source");
+	zassert_equal(mock_buffer[offset++], 0xD1);
+	zassert_equal(mock_buffer[offset++], 0x0F);
+	zassert_equal(mock_buffer[offset++], package_len);
+	zassert_equal(mock_buffer[offset++], 0, "data length");
+	zassert_mem_equal(&mock_buffer[offset], msg->data, package_len);
+
+	/* Second frame carries the difference with the first timestamp */
+	offset = frame_check(second, 1);
+	zassert_equal(mock_buffer[offset + 3], 10 << 1);
+}
+
+ZTEST(test_log_output_dict, test_dropped)
+{
+	uint16_t dropped;
+	size_t offset;
+
+	log_dict_output_dropped_process(&log_output_dict, 5);
+
+	offset = frame_check(0, 0);
+	zassert_equal(mock_buffer[offset], MSG_DROPPED_MSG);
+	memcpy(&dropped, &mock_buffer[offset + 1], sizeof(dropped));
+	zassert_equal(dropped, 5);
+}
+
+static void before(void *notused)
+{
+	mock_len = 0U;
+	memset(mock_buffer, 0, sizeof(mock_buffer));
+	memset(log_output_dict.control_block, 0, sizeof(*log_output_dict.control_block));
+}
+
+ZTEST_SUITE(test_log_output_dict, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/profiling/latency.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/ztest.h>
+
+#define SLEEP_MS 10
+
+struct latency_test_result {
+	void *func;
+	struct latency_stats stats;
+	bool found;
+};
+
+void __noinline latency_test_sleep(void)
+{
+	k_msleep(SLEEP_MS);
+}
+
+void __noinline latency_test_outer(void)
+{
+	latency_test_sleep();
+	latency_test_sleep();
+}
+
+static int latency_test_find(void *func, const struct latency_stats *stats, void *user_data)
+{
+	struct latency_test_result *result = user_data;
+
+	if (func == result->func) {
+		result->stats = *stats;
+		result->found = true;
+		return 1;
+	}
+
+	return 0;
+}
+
+static bool latency_test_get(void *func, struct latency_stats *stats)
+{
+	struct latency_test_result result = { .func = func };
+
+	(void)latency_foreach(latency_test_find, &result);
+	*stats = result.stats;
+
+	return result.found;
+}
+
+ZTEST(latency, test_latency_measure)
+{
+	struct latency_stats stats;
+	uint32_t histogram_count = 0;
+
+	zassert_ok(latency_start());
+	for (int i = 0; i < 5; i++) {
+		latency_test_sleep();
+	}
+	zassert_ok(latency_stop());
+
+	zassert_true(latency_test_get(latency_test_sleep, &stats), "function not measured");
+	zassert_equal(stats.count, 5);
+	zassert_true(stats.min > 0);
+	zassert_true(stats.min <= stats.max);
+	zassert_true(stats.total >= stats.min * 5);
+	zassert_true(timing_cycles_to_ns(stats.min) >= SLEEP_MS * NSEC_PER_MSEC);
+
+	for (int i = 0; i < ARRAY_SIZE(stats.histogram); i++) {
+		histogram_count += stats.histogram[i];
+	}
+	zassert_equal(histogram_count, stats.count);
+}
+
+ZTEST(latency, test_latency_nested)
+{
+	struct latency_stats inner, outer;
+
+	zassert_ok(latency_start());
+	latency_test_outer();
+	zassert_ok(latency_stop());
+
+	zassert_true(latency_test_get(latency_test_sleep, &inner), "function not measured");
+	zassert_equal(inner.count, 2);
+
+	/* Not instrumented when in the exclude list */
+	if (sizeof(CONFIG_PROFILING_LATENCY_EXCLUDE_FUNCTIONS) > 1) {
+		zassert_false(latency_test_get(latency_test_outer, &outer),
+			      "excluded function measured");
+		return;
+	}
+
+	zassert_true(latency_test_get(latency_test_outer, &outer), "function not measured");
+	zassert_equal(outer.count, 1);
+	zassert_true(outer.total >= inner.total);
+}
+
+ZTEST(latency, test_latency_stopped)
+{
+	struct latency_stats stats;
+
+	zassert_false(latency_is_running());
+	zassert_equal(latency_stop(), -EALREADY);
+
+	latency_test_sleep();
+	zassert_false(latency_test_get(latency_test_sleep, &stats), "function measured");
+
+	zassert_ok(latency_start());
+	zassert_true(latency_is_running());
+	zassert_equal(latency_start(), -EALREADY);
+	zassert_ok(latency_stop());
+}
+
+static void latency_test_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	latency_clear();
+}
+
+ZTEST_SUITE(latency, NULL, NULL, latency_test_before, NULL, NULL);
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/tracing/tracing.h>
+#include <tracing_core.h>
+
+/**
+ * @brief Tests for the per-CPU tracing buffers
+ * @defgroup tracing_per_cpu_buffers_tests Tracing per-CPU buffers
+ * @ingroup all_tests
+ * @{
+ * @}
+ */
+
+/* Magic number and packet header, must match subsys/tracing/ctf/ctf_top.c */
+#define CTF_PACKET_MAGIC 0xC1FC1FC1U
+
+struct ctf_packet_header {
+	uint32_t magic;
+	uint8_t stream_instance_id;
+	uint32_t timestamp_begin;
+	uint32_t timestamp_end;
+	uint32_t content_size;
+	uint32_t packet_size;
+	uint8_t cpu_id;
+} __packed;
+
+/* Layout of a CTF named event: timestamp, event id, name, arg0 and arg1 */
+#define CTF_NAME_LEN      20
+#define CTF_NAME_OFFSET   (sizeof(uint32_t) + sizeof(uint8_t))
+#define CTF_ARG0_OFFSET   (CTF_NAME_OFFSET + CTF_NAME_LEN)
+#define CTF_NAMED_EV_SIZE (CTF_ARG0_OFFSET + 2 * sizeof(uint32_t))
+
+#define EVENT_PREFIX "per_cpu_"
+#define EVENT_COUNT  64
+
+#define STACK_SIZE 1024
+
+/* Captured by the RAM backend, see subsys/tracing/tracing_backend_ram.c */
+extern uint8_t ram_tracing[];
+
+static K_THREAD_STACK_ARRAY_DEFINE(tracer_stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread tracer_threads[CONFIG_MP_MAX_NUM_CPUS];
+
+static uint32_t ran_on[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Timestamps are 32 bit nanoseconds and may wrap */
+static inline bool ts_before_eq(uint32_t a, uint32_t b)
+{
+	return (int32_t)(b - a) >= 0;
+}
+
+static void tracer(void *p1, void *p2, void *p3)
+{
+	unsigned int cpu = POINTER_TO_UINT(p1);
+	char name[CTF_NAME_LEN];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	snprintk(name, sizeof(name), EVENT_PREFIX "%u", cpu);
+
+	for (uint32_t i = 0; i < EVENT_COUNT; i++) {
+		sys_trace_named_event(name, i, cpu);
+		k_yield();
+	}
+
+	ran_on[cpu] = arch_curr_cpu()->id;
+}
+
+static void tracing_set(bool enable)
+{
+	uint8_t cmd_enable[] = "enable";
+	uint8_t cmd_disable[] = "disable";
+
+	if (enable) {
+		tracing_cmd_handle(cmd_enable, sizeof(cmd_enable));
+	} else {
+		tracing_cmd_handle(cmd_disable, sizeof(cmd_disable));
+	}
+}
+
+/**
+ * @brief Test the packets of the per-CPU streams
+ *
+ * @details Trace named events from a thread pinned on each CPU, then walk
+ * the CTF packets captured by the RAM backend. Each packet must only hold
+ * events of the CPU of its stream. Per stream, the packets must follow each
+ * other in time, the events must be within the time range of their packet
+ * and no event may be lost or reordered when the buffers are cut at the
+ * marks.
+ *
+ * @ingroup tracing_per_cpu_buffers_tests
+ */
+ZTEST(tracing_per_cpu_buffers, test_per_cpu_streams)
+{
+	uint32_t last_end[CONFIG_MP_MAX_NUM_CPUS] = { 0 };
+	uint32_t last_event[CONFIG_MP_MAX_NUM_CPUS] = { 0 };
+	uint32_t next_arg[CONFIG_MP_MAX_NUM_CPUS] = { 0 };
+	unsigned int num_cpus = arch_num_cpus();
+	struct ctf_packet_header hdr;
+	size_t pos = 0;
+	int packets = 0;
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		k_thread_create(&tracer_threads[cpu], tracer_stacks[cpu], STACK_SIZE,
+				tracer, UINT_TO_POINTER(cpu), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_FOREVER);
+		zassert_ok(k_thread_cpu_pin(&tracer_threads[cpu], cpu),
+			   "Cannot pin thread to CPU %u", cpu);
+		k_thread_start(&tracer_threads[cpu]);
+	}
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		k_thread_join(&tracer_threads[cpu], K_FOREVER);
+		zassert_equal(ran_on[cpu], cpu, "Thread did not run on CPU %u", cpu);
+	}
+
+	/* Let the tracing thread output all the buffers, then stop tracing so
+	 * that the capture does not change while it is checked.
+	 */
+	k_sleep(K_MSEC(2 * CONFIG_TRACING_THREAD_WAIT_THRESHOLD));
+	tracing_set(false);
+	k_sleep(K_MSEC(2 * CONFIG_TRACING_THREAD_WAIT_THRESHOLD));
+
+	while (pos + sizeof(hdr) <= CONFIG_RAM_TRACING_BUFFER_SIZE) {
+		uint32_t packet_len, content_len;
+		const uint8_t *content;
+		unsigned int cpu;
+
+		memcpy(&hdr, &ram_tracing[pos], sizeof(hdr));
+		if (hdr.magic != CTF_PACKET_MAGIC) {
+			break;
+		}
+
+		cpu = hdr.cpu_id;
+		zassert_true(cpu < num_cpus, "Invalid CPU %u", cpu);
+		zassert_equal(hdr.stream_instance_id, cpu, "Stream is not the CPU");
+		zassert_equal(hdr.content_size, hdr.packet_size, "Padded packet");
+
+		packet_len = hdr.packet_size / 8U;
+		zassert_true(packet_len > sizeof(hdr), "Empty packet");
+		if (pos + packet_len > CONFIG_RAM_TRACING_BUFFER_SIZE) {
+			/* Cut by the end of the capture */
+			break;
+		}
+
+		/* The packet starts at the mark the previous one ended at */
+		zassert_equal(hdr.timestamp_begin, last_end[cpu],
+			      "CPU %u packet begins at %u, previous ended at %u",
+			      cpu, hdr.timestamp_begin, last_end[cpu]);
+		zassert_true(ts_before_eq(hdr.timestamp_begin, hdr.timestamp_end),
+			     "CPU %u packet ends before it begins", cpu);
+		last_end[cpu] = hdr.timestamp_end;
+
+		content = &ram_tracing[pos + sizeof(hdr)];
+		content_len = packet_len - sizeof(hdr);
+
+		for (uint32_t i = CTF_NAME_OFFSET;
+		     i + CTF_NAMED_EV_SIZE - CTF_NAME_OFFSET <= content_len; i++) {
+			const uint8_t *ev = &content[i - CTF_NAME_OFFSET];
+			uint32_t tstamp, arg0;
+			unsigned int ev_cpu;
+
+			if (memcmp(&content[i], EVENT_PREFIX, strlen(EVENT_PREFIX)) != 0) {
+				continue;
+			}
+
+			ev_cpu = content[i + strlen(EVENT_PREFIX)] - '0';
+			zassert_equal(ev_cpu, cpu,
+				      "Event of CPU %u in the stream of CPU %u", ev_cpu, cpu);
+
+			memcpy(&tstamp, ev, sizeof(tstamp));
+			memcpy(&arg0, &ev[CTF_ARG0_OFFSET], sizeof(arg0));
+
+			zassert_true(ts_before_eq(hdr.timestamp_begin, tstamp) &&
+				     ts_before_eq(tstamp, hdr.timestamp_end),
+				     "CPU %u event at %u out of packet [%u, %u]", cpu,
+				     tstamp, hdr.timestamp_begin, hdr.timestamp_end);
+			zassert_true(next_arg[cpu] == 0 ||
+				     ts_before_eq(last_event[cpu], tstamp),
+				     "CPU %u events out of order", cpu);
+			zassert_equal(arg0, next_arg[cpu], "CPU %u event %u lost",
+				      cpu, next_arg[cpu]);
+
+			last_event[cpu] = tstamp;
+			next_arg[cpu]++;
+			i += CTF_NAMED_EV_SIZE - CTF_NAME_OFFSET - 1;
+		}
+
+		pos += packet_len;
+		packets++;
+	}
+
+	zassert_true(packets > 0, "No packet captured");
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		zassert_equal(next_arg[cpu], EVENT_COUNT,
+			      "CPU %u: %u of %u events captured", cpu,
+			      next_arg[cpu], EVENT_COUNT);
+	}
+
+	tracing_set(true);
+}
+
+ZTEST_SUITE(tracing_per_cpu_buffers, NULL, NULL, NULL, NULL, NULL);